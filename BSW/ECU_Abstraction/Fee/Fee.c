@@ -0,0 +1,368 @@
+/***************************************************************************
+ * @file    Fee.c
+ * @brief   Định nghĩa tầng giả lập EEPROM trên flash (Flash EEPROM Emulation)
+ * @details File này triển khai các khối dữ liệu không bay hơi trên một file
+ *          ánh xạ vào bộ nhớ. Bố cục của file gồm phần đầu file và hai bản
+ *          sao (slot) cho mỗi khối. Mỗi lần ghi được thực hiện vào slot cũ
+ *          hơn với số thứ tự tăng dần, dữ liệu được ghi trước và phần đầu
+ *          slot (chứa CRC32) được ghi sau cùng, nên nếu chương trình dừng
+ *          giữa lúc ghi thì slot còn lại vẫn giữ bản hợp lệ trước đó.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#include "Fee.h"
+#include "Fee_Cfg.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include <string.h>
+#include <stddef.h>
+
+#ifdef __unix__
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**************************************************************************
+ * @brief Giới hạn và định danh của file giả lập flash
+ **************************************************************************/
+#define FEE_MAX_BLOCKS          32              /* Số khối tối đa */
+#define FEE_FILE_MAGIC          0x31454546u     /* "FEE1" */
+#define FEE_NO_SLOT             (uint8)0xFF     /* Khối chưa có bản sao hợp lệ */
+
+/**************************************************************************
+ * @struct  Fee_FileHeaderType
+ * @brief   Phần đầu của file giả lập flash
+ **************************************************************************/
+typedef struct {
+    uint32 Magic;           /* FEE_FILE_MAGIC */
+    uint32 LayoutCrc;       /* CRC32 của bảng cấu hình khối lúc tạo file */
+    uint32 Reserved[2];
+} Fee_FileHeaderType;
+
+/**************************************************************************
+ * @struct  Fee_SlotHeaderType
+ * @brief   Phần đầu của một bản sao khối, CRC tính trên các trường đứng
+ *          trước nó và dữ liệu của khối
+ **************************************************************************/
+typedef struct {
+    uint16 BlockNumber;     /* Số hiệu của khối */
+    uint16 Length;          /* Độ dài dữ liệu đã ghi */
+    uint32 Sequence;        /* Số thứ tự lần ghi, bản sao có số lớn hơn là bản mới */
+    uint32 Crc;             /* CRC32 của phần đầu và dữ liệu */
+    uint32 Reserved;
+} Fee_SlotHeaderType;
+
+/**************************************************************************
+ * @struct  Fee_BlockStateType
+ * @brief   Vị trí và bản sao mới nhất của một khối trong file
+ **************************************************************************/
+typedef struct {
+    uint32 Offset;          /* Vị trí slot đầu tiên trong file */
+    uint32 SlotSize;        /* Kích thước một slot (phần đầu + dữ liệu, làm tròn 8 byte) */
+    uint32 Sequence;        /* Số thứ tự của bản sao mới nhất */
+    uint8 NewestSlot;       /* Slot chứa bản sao mới nhất (FEE_NO_SLOT nếu không có) */
+} Fee_BlockStateType;
+
+/**************************************************************************
+ * @brief File giả lập flash đã ánh xạ và trạng thái của các khối
+ **************************************************************************/
+static uint8* Fee_Flash = NULL_PTR;
+static size_t Fee_FlashSize = 0;
+static Fee_BlockStateType Fee_BlockStates[FEE_MAX_BLOCKS];
+static uint32 Fee_CrcTable[256];
+
+/**************************************************************************
+ * @brief   Dựng bảng tra của CRC32 (đa thức 0xEDB88320)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Fee_CrcInit(void) {
+    for (uint32 i = 0; i < 256; i++) {
+        uint32 crc = i;
+        for (uint8 bit = 0; bit < 8; bit++) {
+            crc = (crc & 1U) ? (crc >> 1) ^ 0xEDB88320u : (crc >> 1);
+        }
+        Fee_CrcTable[i] = crc;
+    }
+}
+
+/**************************************************************************
+ * @brief   Cập nhật CRC32 với một vùng dữ liệu
+ * @param   Crc         Giá trị CRC hiện tại (bắt đầu bằng 0)
+ * @param   DataPtr     Con trỏ đến dữ liệu
+ * @param   Length      Độ dài dữ liệu (byte)
+ * @return 	uint32      Giá trị CRC mới
+ **************************************************************************/
+static uint32 Fee_CrcUpdate(uint32 Crc, const void* DataPtr, size_t Length) {
+    const uint8* data = (const uint8*)DataPtr;
+    Crc = ~Crc;
+    for (size_t i = 0; i < Length; i++) {
+        Crc = Fee_CrcTable[(Crc ^ data[i]) & 0xFFU] ^ (Crc >> 8);
+    }
+    return ~Crc;
+}
+
+/**************************************************************************
+ * @brief   Tính CRC32 của một bản sao khối
+ * @param   Header      Con trỏ đến phần đầu slot
+ * @param   DataPtr     Con trỏ đến dữ liệu của khối
+ * @return 	uint32      Giá trị CRC
+ **************************************************************************/
+static uint32 Fee_SlotCrc(const Fee_SlotHeaderType* Header, const void* DataPtr) {
+    uint32 crc = Fee_CrcUpdate(0, Header, offsetof(Fee_SlotHeaderType, Crc));
+    return Fee_CrcUpdate(crc, DataPtr, Header->Length);
+}
+
+/**************************************************************************
+ * @brief   Tra chỉ số cấu hình của một khối theo số hiệu
+ * @param   BlockNumber     Số hiệu của khối
+ * @return 	sint32          Chỉ số trong Fee_BlockConfigs, -1 nếu không tồn tại
+ **************************************************************************/
+static sint32 Fee_FindBlock(uint16 BlockNumber) {
+    for (uint16 i = 0; i < Fee_BlockConfigCount && i < FEE_MAX_BLOCKS; i++) {
+        if (Fee_BlockConfigs[i].BlockNumber == BlockNumber) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**************************************************************************
+ * @brief   Lấy con trỏ đến phần đầu của một slot
+ * @param   index       Chỉ số của khối
+ * @param   slot        Slot (0 hoặc 1)
+ * @return 	Fee_SlotHeaderType*     Con trỏ đến phần đầu slot trong file
+ **************************************************************************/
+static inline Fee_SlotHeaderType* Fee_GetSlot(sint32 index, uint8 slot) {
+    return (Fee_SlotHeaderType*)(Fee_Flash + Fee_BlockStates[index].Offset + (uint32)slot * Fee_BlockStates[index].SlotSize);
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra một slot có chứa bản sao hợp lệ của khối hay không
+ * @param   index       Chỉ số của khối
+ * @param   slot        Slot (0 hoặc 1)
+ * @return 	boolean     TRUE nếu bản sao hợp lệ, FALSE nếu không
+ **************************************************************************/
+static boolean Fee_SlotValid(sint32 index, uint8 slot) {
+    const Fee_SlotHeaderType* header = Fee_GetSlot(index, slot);
+    if (header->BlockNumber != Fee_BlockConfigs[index].BlockNumber ||
+        header->Length > Fee_BlockConfigs[index].BlockSize) {
+        return FALSE;
+    }
+    return (Fee_SlotCrc(header, header + 1) == header->Crc) ? TRUE : FALSE;
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra một slot có đang ở trạng thái flash trống hay không
+ * @param   index       Chỉ số của khối
+ * @param   slot        Slot (0 hoặc 1)
+ * @return 	boolean     TRUE nếu phần đầu slot chưa từng được ghi
+ **************************************************************************/
+static boolean Fee_SlotErased(sint32 index, uint8 slot) {
+    const uint8* header = (const uint8*)Fee_GetSlot(index, slot);
+    for (size_t i = 0; i < sizeof(Fee_SlotHeaderType); i++) {
+        if (header[i] != FEE_ERASED_VALUE) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**************************************************************************
+ * @brief   Đồng bộ một vùng của file giả lập flash xuống đĩa
+ * @param   Offset          Vị trí bắt đầu trong file
+ * @param   Length          Độ dài vùng cần đồng bộ
+ * @return 	Std_ReturnType  Trả về E_OK nếu đồng bộ thành công,
+ *                                 E_NOT_OK nếu thất bại
+ **************************************************************************/
+static Std_ReturnType Fee_Sync(size_t Offset, size_t Length) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = Offset & ~(page_size - 1);
+    return (msync(Fee_Flash + start, Offset + Length - start, MS_SYNC) == 0) ? E_OK : E_NOT_OK;
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo Fee trên file giả lập flash
+ * @details Hàm này tính vị trí của các khối từ bảng cấu hình, ánh xạ file
+ *          vào bộ nhớ rồi tìm bản sao hợp lệ mới nhất của từng khối.
+ * @param   FilePath        Đường dẫn đến file giả lập flash
+ * @return 	Std_ReturnType  Trả về E_OK nếu khởi tạo thành công,
+ *                                 E_NOT_OK nếu không mở hoặc ánh xạ được file
+ **************************************************************************/
+Std_ReturnType Fee_Init(const char* FilePath) {
+    if (Fee_Flash != NULL_PTR) {
+        return E_OK;
+    }
+    if (FilePath == NULL_PTR || Fee_BlockConfigCount > FEE_MAX_BLOCKS) {
+        LOG_ERROR(FEE, "Invalid Fee configuration\n");
+        return E_NOT_OK;
+    }
+
+    Fee_CrcInit();
+
+    // Tính bố cục của file từ bảng cấu hình khối
+    uint32 offset = sizeof(Fee_FileHeaderType);
+    uint32 layout_crc = 0;
+    for (uint16 i = 0; i < Fee_BlockConfigCount; i++) {
+        Fee_BlockStates[i].Offset = offset;
+        Fee_BlockStates[i].SlotSize = (sizeof(Fee_SlotHeaderType) + Fee_BlockConfigs[i].BlockSize + 7U) & ~7U;
+        Fee_BlockStates[i].NewestSlot = FEE_NO_SLOT;
+        Fee_BlockStates[i].Sequence = 0;
+        offset += 2U * Fee_BlockStates[i].SlotSize;
+        layout_crc = Fee_CrcUpdate(layout_crc, &Fee_BlockConfigs[i], sizeof(Fee_BlockConfigType));
+    }
+    Fee_FlashSize = offset;
+
+    int fd = open(FilePath, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        LOG_ERROR(FEE, "Cannot open flash emulation file %s\n", FilePath);
+        return E_NOT_OK;
+    }
+    struct stat st;
+    boolean resized = (fstat(fd, &st) != 0 || (size_t)st.st_size != Fee_FlashSize) ? TRUE : FALSE;
+    if (resized && ftruncate(fd, (off_t)Fee_FlashSize) != 0) {
+        close(fd);
+        LOG_ERROR(FEE, "Cannot resize flash emulation file %s\n", FilePath);
+        return E_NOT_OK;
+    }
+    void* flash = mmap(NULL_PTR, Fee_FlashSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (flash == MAP_FAILED) {
+        LOG_ERROR(FEE, "Cannot map flash emulation file %s\n", FilePath);
+        return E_NOT_OK;
+    }
+    Fee_Flash = (uint8*)flash;
+
+    // File mới hoặc bố cục khối đã thay đổi: xóa toàn bộ flash
+    Fee_FileHeaderType* file_header = (Fee_FileHeaderType*)Fee_Flash;
+    if (resized || file_header->Magic != FEE_FILE_MAGIC || file_header->LayoutCrc != layout_crc) {
+        memset(Fee_Flash, FEE_ERASED_VALUE, Fee_FlashSize);
+        file_header->Magic = FEE_FILE_MAGIC;
+        file_header->LayoutCrc = layout_crc;
+        file_header->Reserved[0] = 0;
+        file_header->Reserved[1] = 0;
+        Fee_Sync(0, Fee_FlashSize);
+        LOG_WARN(FEE, "Flash emulation file %s formatted (%u bytes)\n", FilePath, (uint32)Fee_FlashSize);
+    }
+
+    // Tìm bản sao hợp lệ mới nhất của từng khối
+    for (uint16 i = 0; i < Fee_BlockConfigCount; i++) {
+        for (uint8 slot = 0; slot < 2; slot++) {
+            if (!Fee_SlotValid(i, slot)) {
+                continue;
+            }
+            uint32 sequence = Fee_GetSlot(i, slot)->Sequence;
+            if (Fee_BlockStates[i].NewestSlot == FEE_NO_SLOT || (sint32)(sequence - Fee_BlockStates[i].Sequence) > 0) {
+                Fee_BlockStates[i].NewestSlot = slot;
+                Fee_BlockStates[i].Sequence = sequence;
+            }
+        }
+    }
+
+    LOG_INFO(FEE, "Flash EEPROM Emulation (Fee) Initialized, %u blocks in %s.\n", Fee_BlockConfigCount, FilePath);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc bản sao hợp lệ mới nhất của một khối
+ * @param   BlockNumber         Số hiệu của khối
+ * @param   DataPtr             Con trỏ lưu dữ liệu đọc được
+ * @param   Length              Độ dài dữ liệu cần đọc (phải bằng độ dài đã ghi)
+ * @return 	Fee_JobResultType   Kết quả đọc khối
+ **************************************************************************/
+Fee_JobResultType Fee_Read(uint16 BlockNumber, void* DataPtr, uint16 Length) {
+    sint32 index = Fee_FindBlock(BlockNumber);
+    if (Fee_Flash == NULL_PTR || index < 0 || DataPtr == NULL_PTR) {
+        return FEE_JOB_FAILED;
+    }
+
+    Fee_BlockStateType* state = &Fee_BlockStates[index];
+    if (state->NewestSlot == FEE_NO_SLOT) {
+        return (Fee_SlotErased(index, 0) && Fee_SlotErased(index, 1)) ? FEE_BLOCK_INVALID : FEE_BLOCK_INCONSISTENT;
+    }
+
+    const Fee_SlotHeaderType* header = Fee_GetSlot(index, state->NewestSlot);
+    if (header->Length != Length) {
+        return FEE_BLOCK_INCONSISTENT;  // Khối được ghi với bố cục dữ liệu khác
+    }
+    memcpy(DataPtr, header + 1, Length);
+    return FEE_JOB_OK;
+}
+
+/**************************************************************************
+ * @brief   Ghi một khối vào bản sao cũ hơn và đồng bộ xuống file
+ * @details Dữ liệu được ghi trước, phần đầu slot được ghi sau cùng. Bản sao
+ *          mới chỉ được dùng sau khi đồng bộ file thành công.
+ * @param   BlockNumber     Số hiệu của khối
+ * @param   DataPtr         Con trỏ đến dữ liệu cần ghi
+ * @param   Length          Độ dài dữ liệu (tối đa BlockSize của khối)
+ * @return 	Std_ReturnType  Trả về E_OK nếu ghi thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại, dữ liệu
+ *                                 quá dài hoặc đồng bộ file thất bại
+ **************************************************************************/
+Std_ReturnType Fee_Write(uint16 BlockNumber, const void* DataPtr, uint16 Length) {
+    sint32 index = Fee_FindBlock(BlockNumber);
+    if (Fee_Flash == NULL_PTR || index < 0 || DataPtr == NULL_PTR || Length > Fee_BlockConfigs[index].BlockSize) {
+        return E_NOT_OK;
+    }
+
+    Fee_BlockStateType* state = &Fee_BlockStates[index];
+    uint8 slot = (state->NewestSlot == 0) ? 1 : 0;
+    Fee_SlotHeaderType* target = Fee_GetSlot(index, slot);
+    Fee_SlotHeaderType header = {BlockNumber, Length, state->Sequence + 1, 0, 0};
+    header.Crc = Fee_SlotCrc(&header, DataPtr);
+
+    memcpy(target + 1, DataPtr, Length);
+    memcpy(target, &header, sizeof(header));
+    if (Fee_Sync(state->Offset + (uint32)slot * state->SlotSize, sizeof(header) + Length) != E_OK) {
+        LOG_ERROR(FEE, "Sync of block 0x%04X failed\n", BlockNumber);
+        return E_NOT_OK;
+    }
+
+    state->NewestSlot = slot;
+    state->Sequence = header.Sequence;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Xóa cả hai bản sao của một khối
+ * @param   BlockNumber     Số hiệu của khối
+ * @return 	Std_ReturnType  Trả về E_OK nếu xóa thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType Fee_InvalidateBlock(uint16 BlockNumber) {
+    sint32 index = Fee_FindBlock(BlockNumber);
+    if (Fee_Flash == NULL_PTR || index < 0) {
+        return E_NOT_OK;
+    }
+
+    Fee_BlockStateType* state = &Fee_BlockStates[index];
+    memset(Fee_Flash + state->Offset, FEE_ERASED_VALUE, 2U * state->SlotSize);
+    state->NewestSlot = FEE_NO_SLOT;
+    return Fee_Sync(state->Offset, 2U * state->SlotSize);
+}
+
+#else /* __unix__ */
+
+/**************************************************************************
+ * @brief Fee cần mmap, các nền tảng khác chạy NvM chỉ với giá trị mặc định
+ **************************************************************************/
+Std_ReturnType Fee_Init(const char* FilePath) {
+    LOG_ERROR(FEE, "Flash emulation file %s: not supported on this platform\n", FilePath);
+    return E_NOT_OK;
+}
+
+Fee_JobResultType Fee_Read(uint16 BlockNumber, void* DataPtr, uint16 Length) {
+    return FEE_JOB_FAILED;
+}
+
+Std_ReturnType Fee_Write(uint16 BlockNumber, const void* DataPtr, uint16 Length) {
+    return E_NOT_OK;
+}
+
+Std_ReturnType Fee_InvalidateBlock(uint16 BlockNumber) {
+    return E_NOT_OK;
+}
+
+#endif /* __unix__ */
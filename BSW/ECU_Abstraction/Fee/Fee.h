@@ -0,0 +1,81 @@
+/***************************************************************************
+ * @file    Fee.h
+ * @brief   Khai báo tầng giả lập EEPROM trên flash (Flash EEPROM Emulation)
+ * @details File này cung cấp giao diện để đọc và ghi các khối dữ liệu không
+ *          bay hơi. Bộ nhớ flash được giả lập bằng một file ánh xạ vào bộ
+ *          nhớ (mmap), mỗi khối có hai bản sao được bảo vệ bằng CRC32 để dữ
+ *          liệu cũ vẫn còn nguyên nếu chương trình dừng giữa lúc ghi.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef FEE_H
+#define FEE_H
+
+#include "Std_Types.h"
+
+/**************************************************************************
+ * @brief Giá trị của byte flash đã xóa
+ **************************************************************************/
+#define FEE_ERASED_VALUE            0xFF
+
+/**************************************************************************
+ * @typedef Fee_JobResultType
+ * @brief   Định nghĩa kiểu dữ liệu cho kết quả đọc một khối
+ **************************************************************************/
+typedef uint8 Fee_JobResultType;
+#define FEE_JOB_OK                  (Fee_JobResultType)0x00     /* Đọc thành công */
+#define FEE_JOB_FAILED              (Fee_JobResultType)0x01     /* Khối không tồn tại hoặc Fee chưa sẵn sàng */
+#define FEE_BLOCK_INCONSISTENT      (Fee_JobResultType)0x02     /* Cả hai bản sao đều sai CRC hoặc sai độ dài */
+#define FEE_BLOCK_INVALID           (Fee_JobResultType)0x03     /* Khối chưa từng được ghi */
+
+/**************************************************************************
+ * @struct  Fee_BlockConfigType
+ * @brief   Định nghĩa cấu trúc cấu hình của một khối Fee
+ **************************************************************************/
+typedef struct {
+    uint16 BlockNumber;     /* Số hiệu của khối */
+    uint16 BlockSize;       /* Kích thước dữ liệu tối đa của khối (byte) */
+} Fee_BlockConfigType;
+
+/**************************************************************************
+ * @brief   Khởi tạo Fee trên file giả lập flash
+ * @details File được tạo nếu chưa tồn tại. Nếu file không khớp với bảng
+ *          cấu hình khối (ví dụ sau khi đổi kích thước khối), toàn bộ file
+ *          được xóa về trạng thái flash trống.
+ * @param   FilePath        Đường dẫn đến file giả lập flash
+ * @return 	Std_ReturnType  Trả về E_OK nếu khởi tạo thành công,
+ *                                 E_NOT_OK nếu không mở hoặc ánh xạ được file
+ **************************************************************************/
+Std_ReturnType Fee_Init(const char* FilePath);
+
+/**************************************************************************
+ * @brief   Đọc bản sao hợp lệ mới nhất của một khối
+ * @param   BlockNumber         Số hiệu của khối
+ * @param   DataPtr             Con trỏ lưu dữ liệu đọc được
+ * @param   Length              Độ dài dữ liệu cần đọc (phải bằng độ dài đã ghi)
+ * @return 	Fee_JobResultType   Kết quả đọc khối
+ **************************************************************************/
+Fee_JobResultType Fee_Read(uint16 BlockNumber, void* DataPtr, uint16 Length);
+
+/**************************************************************************
+ * @brief   Ghi một khối vào bản sao cũ hơn và đồng bộ xuống file
+ * @details Hàm này có thể chặn trong lúc đồng bộ file nên chỉ được gọi từ
+ *          task nền của NvM, không gọi từ các task điều khiển.
+ * @param   BlockNumber     Số hiệu của khối
+ * @param   DataPtr         Con trỏ đến dữ liệu cần ghi
+ * @param   Length          Độ dài dữ liệu (tối đa BlockSize của khối)
+ * @return 	Std_ReturnType  Trả về E_OK nếu ghi thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại, dữ liệu
+ *                                 quá dài hoặc đồng bộ file thất bại
+ **************************************************************************/
+Std_ReturnType Fee_Write(uint16 BlockNumber, const void* DataPtr, uint16 Length);
+
+/**************************************************************************
+ * @brief   Xóa cả hai bản sao của một khối
+ * @param   BlockNumber     Số hiệu của khối
+ * @return 	Std_ReturnType  Trả về E_OK nếu xóa thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType Fee_InvalidateBlock(uint16 BlockNumber);
+
+#endif /* FEE_H */
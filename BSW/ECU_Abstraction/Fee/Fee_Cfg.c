@@ -0,0 +1,21 @@
+/***************************************************************************
+ * @file    Fee_Cfg.c
+ * @brief   Định nghĩa bảng cấu hình các khối của tầng giả lập EEPROM
+ * @details Kích thước khối được để dư so với dữ liệu hiện tại để có thể thêm
+ *          trường mới mà không phải đổi bố cục của file giả lập flash.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#include "Fee_Cfg.h"
+
+/**************************************************************************
+ * @brief Bảng cấu hình các khối Fee
+ **************************************************************************/
+const Fee_BlockConfigType Fee_BlockConfigs[] = {
+    {FEE_BLOCK_DEM_EVENT_MEMORY, 2048},
+    {FEE_BLOCK_TORQUE_CALIBRATION, 64},
+    {FEE_BLOCK_REGEN_CALIBRATION, 64},
+    {FEE_BLOCK_TRACTION_CALIBRATION, 64},
+    {FEE_BLOCK_REGEN_LEARNED, 64},
+};
+const uint16 Fee_BlockConfigCount = sizeof(Fee_BlockConfigs) / sizeof(Fee_BlockConfigs[0]);
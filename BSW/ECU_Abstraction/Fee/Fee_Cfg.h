@@ -0,0 +1,36 @@
+/***************************************************************************
+ * @file    Fee_Cfg.h
+ * @brief   Cấu hình các khối của tầng giả lập EEPROM trên flash
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef FEE_CFG_H
+#define FEE_CFG_H
+
+#include "Fee.h"
+
+/**************************************************************************
+ * @brief File giả lập flash, có thể chọn khi biên dịch, ví dụ:
+ *        -DFEE_CFG_FILE_PATH=\"ecu1_nvm.bin\" khi chạy nhiều ECU trong cùng
+ *        một thư mục
+ **************************************************************************/
+#ifndef FEE_CFG_FILE_PATH
+#define FEE_CFG_FILE_PATH               "ecu_nvm.bin"
+#endif
+
+/**************************************************************************
+ * @brief Định nghĩa số hiệu của các khối Fee
+ **************************************************************************/
+#define FEE_BLOCK_DEM_EVENT_MEMORY      (uint16)0x0001  /* Bộ nhớ sự kiện của DEM */
+#define FEE_BLOCK_TORQUE_CALIBRATION    (uint16)0x0010  /* Tham số hiệu chỉnh điều khiển mô-men xoắn */
+#define FEE_BLOCK_REGEN_CALIBRATION     (uint16)0x0011  /* Tham số hiệu chỉnh phanh tái sinh */
+#define FEE_BLOCK_TRACTION_CALIBRATION  (uint16)0x0012  /* Tham số hiệu chỉnh điều khiển lực kéo */
+#define FEE_BLOCK_REGEN_LEARNED         (uint16)0x0020  /* Giá trị học được của phanh tái sinh */
+
+/**************************************************************************
+ * @brief Bảng cấu hình các khối Fee
+ **************************************************************************/
+extern const Fee_BlockConfigType Fee_BlockConfigs[];
+extern const uint16 Fee_BlockConfigCount;
+
+#endif /* FEE_CFG_H */
@@ -0,0 +1,336 @@
+/***************************************************************************
+ * @file    IoHwAb_Acquisition.c
+ * @brief   Định nghĩa các hàm thu thập dữ liệu cảm biến theo tập
+ * @details File này triển khai các tập thu thập: mỗi tập gom kênh ADC của
+ *          các cảm biến được khai báo vào một nhóm kênh, mỗi lần quét chỉ
+ *          cần một lần chuyển đổi nhóm kênh thay vì một lần đọc ADC cho mỗi
+ *          cảm biến. Giá trị thô được chuyển đổi bằng hàm do driver của
+ *          từng cảm biến đăng ký. Kết quả của mỗi lần quét được lưu vào bộ
+ *          đệm mẫu theo cơ chế seqlock để nhiều SWC đọc mà không cần khóa.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#include "IoHwAb_Acquisition.h"
+#include "Adc\Adc.h"   // Gọi API từ MCAL để chuyển đổi nhóm kênh ADC
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Báo cho OS khi chờ kết quả chuyển đổi ADC
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+/**************************************************************************
+ * @struct  IoHwAb_SensorEntryType
+ * @brief   Thông tin đăng ký của một cảm biến
+ **************************************************************************/
+typedef struct {
+    uint8 Channel;                          /* Kênh ADC của cảm biến */
+    IoHwAb_SensorConvertType Convert;       /* Hàm chuyển đổi (NULL: chưa đăng ký) */
+    uint8 OwnerSet;                         /* ID tập sở hữu + 1 (0: chưa thuộc tập nào) */
+} IoHwAb_SensorEntryType;
+
+/**************************************************************************
+ * @struct  IoHwAb_SampleCacheType
+ * @brief   Bộ đệm mẫu mới nhất của một cảm biến
+ * @details Chỉ luồng quét tập sở hữu cảm biến được ghi. Sequence là số lẻ
+ *          khi đang ghi, luồng đọc sao chép rồi kiểm tra lại Sequence.
+ **************************************************************************/
+typedef struct {
+    atomic_uint Sequence;                   /* Bộ đếm phiên bản của mẫu (0: chưa lấy mẫu) */
+    atomic_uint Value;                      /* Giá trị float32 lưu dưới dạng bit */
+    atomic_uint Valid;                      /* Giá trị có hợp lệ hay không */
+    atomic_ullong TimestampNs;              /* Thời điểm lấy mẫu */
+} IoHwAb_SampleCacheType;
+
+/**************************************************************************
+ * @struct  IoHwAb_AcqSetStateType
+ * @brief   Trạng thái của một tập thu thập
+ **************************************************************************/
+typedef struct {
+    IoHwAb_SensorIdType Sensors[IOHWAB_ACQ_MAX_SENSORS];    /* Các cảm biến trong tập */
+    uint8 NumSensors;                                       /* Số cảm biến (0: chưa cấu hình) */
+    Adc_ValueGroupType AdcBuffer[IOHWAB_ACQ_MAX_SENSORS];   /* Bộ đệm kết quả của nhóm kênh */
+    boolean Waiting;                                        /* Có luồng đang chờ chuyển đổi xong */
+} IoHwAb_AcqSetStateType;
+
+/**************************************************************************
+ * @brief Các cảm biến đã đăng ký và các tập thu thập
+ **************************************************************************/
+static IoHwAb_SensorEntryType IoHwAb_Sensors[IOHWAB_NUM_SENSORS];
+static IoHwAb_AcqSetStateType IoHwAb_AcqSets[IOHWAB_ACQ_MAX_SETS];
+static IoHwAb_SampleCacheType IoHwAb_SampleCache[IOHWAB_NUM_SENSORS];
+
+/**************************************************************************
+ * @brief Biến đồng bộ để chờ hàm thông báo chuyển đổi xong, dùng chung cho
+ *        tất cả các tập
+ **************************************************************************/
+static pthread_mutex_t IoHwAb_AcqLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t IoHwAb_AcqConversionDone = PTHREAD_COND_INITIALIZER;
+
+/**************************************************************************
+ * @brief   Nhóm kênh ADC của một tập thu thập
+ * @param   SetId           ID của tập thu thập
+ * @return 	Adc_GroupType   Nhóm kênh ADC của tập
+ **************************************************************************/
+static inline Adc_GroupType IoHwAb_AcqGroup(IoHwAb_AcqSetIdType SetId) {
+    return (Adc_GroupType)(ADC_GROUP_ACQUISITION_FIRST + SetId);
+}
+
+/**************************************************************************
+ * @brief   Ghi mẫu mới vào bộ đệm của một cảm biến
+ * @param   Sensor          ID của cảm biến
+ * @param   Value           Giá trị đã chuyển đổi
+ * @param   Valid           Giá trị có hợp lệ hay không
+ * @param   TimestampNs     Thời điểm lấy mẫu
+ * @return 	None
+ **************************************************************************/
+static void IoHwAb_Acquisition_StoreSample(IoHwAb_SensorIdType Sensor, float32 Value, boolean Valid, uint64 TimestampNs) {
+    IoHwAb_SampleCacheType* cache = &IoHwAb_SampleCache[Sensor];
+    uint32 bits;
+    memcpy(&bits, &Value, sizeof(bits));
+
+    uint32 seq = atomic_load_explicit(&cache->Sequence, memory_order_relaxed);
+    atomic_store_explicit(&cache->Sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&cache->Value, bits, memory_order_relaxed);
+    atomic_store_explicit(&cache->Valid, Valid, memory_order_relaxed);
+    atomic_store_explicit(&cache->TimestampNs, TimestampNs, memory_order_relaxed);
+
+    atomic_store_explicit(&cache->Sequence, seq + 2, memory_order_release);
+}
+
+/**************************************************************************
+ * @brief 	Hàm thông báo khi nhóm kênh của một tập chuyển đổi xong
+ * @details Hàm này được gọi từ luồng chuyển đổi của ADC. Vì hàm thông báo
+ *          không có tham số nên mọi tập dùng chung một hàm, các luồng đang
+ *          chờ tập đã chuyển đổi xong được đánh thức.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void IoHwAb_Acquisition_Notification(void) {
+    pthread_mutex_lock(&IoHwAb_AcqLock);
+    for (IoHwAb_AcqSetIdType id = 0; id < IOHWAB_ACQ_MAX_SETS; id++) {
+        IoHwAb_AcqSetStateType* set = &IoHwAb_AcqSets[id];
+        if (set->Waiting && Adc_GetGroupStatus(IoHwAb_AcqGroup(id)) != ADC_BUSY) {
+            // Luồng đang chờ được tính là chạy lại trước khi luồng chuyển đổi ADC dừng
+            set->Waiting = FALSE;
+            Os_TimeBeginBusy();
+        }
+    }
+    pthread_cond_broadcast(&IoHwAb_AcqConversionDone);
+    pthread_mutex_unlock(&IoHwAb_AcqLock);
+}
+
+/**************************************************************************
+ * @brief   Đăng ký kênh ADC và hàm chuyển đổi của một cảm biến
+ * @param   Sensor          ID của cảm biến
+ * @param   Channel         Kênh ADC của cảm biến
+ * @param   Convert         Hàm chuyển đổi giá trị ADC thô
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_RegisterSensor(IoHwAb_SensorIdType Sensor, uint8 Channel,
+                                                 IoHwAb_SensorConvertType Convert) {
+    if (Sensor >= IOHWAB_NUM_SENSORS || Convert == NULL_PTR) {
+        LOG_ERROR(IOHWAB, "Error: Invalid sensor %d passed to IoHwAb_Acquisition_RegisterSensor.\n", Sensor);
+        return E_NOT_OK;
+    }
+
+    pthread_mutex_lock(&IoHwAb_AcqLock);
+    IoHwAb_Sensors[Sensor].Channel = Channel;
+    IoHwAb_Sensors[Sensor].Convert = Convert;
+    pthread_mutex_unlock(&IoHwAb_AcqLock);
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Cấu hình một tập thu thập
+ * @details Hàm này gom kênh ADC của các cảm biến trong tập vào nhóm kênh
+ *          của tập theo đúng thứ tự khai báo.
+ * @param   SetId           ID của tập thu thập
+ * @param   ConfigPtr       Con trỏ đến cấu hình của tập
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_SetupSet(IoHwAb_AcqSetIdType SetId, const IoHwAb_AcqSetConfigType* ConfigPtr) {
+    if (SetId >= IOHWAB_ACQ_MAX_SETS || ConfigPtr == NULL_PTR || ConfigPtr->Sensors == NULL_PTR ||
+        ConfigPtr->NumSensors == 0 || ConfigPtr->NumSensors > IOHWAB_ACQ_MAX_SENSORS) {
+        LOG_ERROR(IOHWAB, "Error: Invalid configuration passed to IoHwAb_Acquisition_SetupSet.\n");
+        return E_NOT_OK;
+    }
+
+    IoHwAb_AcqSetStateType* set = &IoHwAb_AcqSets[SetId];
+    Adc_ChannelType adcChannels[IOHWAB_ACQ_MAX_SENSORS];
+
+    pthread_mutex_lock(&IoHwAb_AcqLock);
+    for (uint8 i = 0; i < ConfigPtr->NumSensors; i++) {
+        IoHwAb_SensorIdType sensor = ConfigPtr->Sensors[i];
+        if (sensor >= IOHWAB_NUM_SENSORS || IoHwAb_Sensors[sensor].Convert == NULL_PTR) {
+            pthread_mutex_unlock(&IoHwAb_AcqLock);
+            LOG_ERROR(IOHWAB, "Error: Sensor %d of acquisition set %d is not initialized.\n", sensor, SetId);
+            return E_NOT_OK;
+        }
+        if (IoHwAb_Sensors[sensor].OwnerSet != 0 && IoHwAb_Sensors[sensor].OwnerSet != SetId + 1) {
+            pthread_mutex_unlock(&IoHwAb_AcqLock);
+            LOG_ERROR(IOHWAB, "Error: Sensor %d is already sampled by acquisition set %d.\n",
+                              sensor, IoHwAb_Sensors[sensor].OwnerSet - 1);
+            return E_NOT_OK;
+        }
+        adcChannels[i] = IoHwAb_Sensors[sensor].Channel;
+    }
+
+    // Cấu hình lại: trả các cảm biến cũ của tập trước khi nhận cảm biến mới
+    for (uint8 i = 0; i < set->NumSensors; i++) {
+        IoHwAb_Sensors[set->Sensors[i]].OwnerSet = 0;
+    }
+    for (uint8 i = 0; i < ConfigPtr->NumSensors; i++) {
+        set->Sensors[i] = ConfigPtr->Sensors[i];
+        IoHwAb_Sensors[set->Sensors[i]].OwnerSet = SetId + 1;
+    }
+    set->NumSensors = ConfigPtr->NumSensors;
+    pthread_mutex_unlock(&IoHwAb_AcqLock);
+
+    Adc_GroupConfigType adcGroupConfig = {
+        .Channels = adcChannels,
+        .NumChannels = ConfigPtr->NumSensors,
+        .Notification = IoHwAb_Acquisition_Notification
+    };
+    if (Adc_SetupGroup(IoHwAb_AcqGroup(SetId), &adcGroupConfig) != E_OK ||
+        Adc_SetupResultBuffer(IoHwAb_AcqGroup(SetId), set->AdcBuffer) != E_OK) {
+        LOG_ERROR(IOHWAB, "Error: Failed to set up ADC group for acquisition set %d.\n", SetId);
+        pthread_mutex_lock(&IoHwAb_AcqLock);
+        for (uint8 i = 0; i < set->NumSensors; i++) {
+            IoHwAb_Sensors[set->Sensors[i]].OwnerSet = 0;
+        }
+        set->NumSensors = 0;
+        pthread_mutex_unlock(&IoHwAb_AcqLock);
+        return E_NOT_OK;
+    }
+    Adc_EnableGroupNotification(IoHwAb_AcqGroup(SetId));
+
+    LOG_INFO(IOHWAB, "Acquisition set %d configured with %d sensors.\n", SetId, ConfigPtr->NumSensors);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc tất cả các cảm biến của một tập trong một lần chuyển đổi
+ * @details Hàm này bắt đầu chuyển đổi nhóm kênh của tập, chờ hàm thông báo
+ *          từ ADC rồi chuyển đổi từng giá trị thô bằng hàm của cảm biến.
+ *          Mốc thời gian chung là thời điểm đọc kết quả chuyển đổi. Kết quả
+ *          được ghi vào bộ đệm mẫu, nếu ADC lỗi thì các mẫu bị đánh dấu
+ *          không hợp lệ.
+ * @param   SetId           ID của tập thu thập
+ * @param   ResultPtr       Con trỏ lưu kết quả
+ * @return 	Std_ReturnType  Trả về E_OK nếu quét thành công,
+ *                                 E_NOT_OK nếu tập chưa cấu hình hoặc ADC lỗi
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_Scan(IoHwAb_AcqSetIdType SetId, IoHwAb_AcqResultType* ResultPtr) {
+    if (SetId >= IOHWAB_ACQ_MAX_SETS || ResultPtr == NULL_PTR || IoHwAb_AcqSets[SetId].NumSensors == 0) {
+        return E_NOT_OK;
+    }
+
+    IoHwAb_AcqSetStateType* set = &IoHwAb_AcqSets[SetId];
+    Adc_GroupType group = IoHwAb_AcqGroup(SetId);
+    Adc_ValueGroupType adcValue[IOHWAB_ACQ_MAX_SENSORS] = {0};
+
+    if (Adc_StartGroupConversion(group) != E_OK) {
+        return E_NOT_OK;
+    }
+
+    // Chờ hàm thông báo từ ADC khi nhóm kênh chuyển đổi xong
+    pthread_mutex_lock(&IoHwAb_AcqLock);
+    if (Adc_GetGroupStatus(group) == ADC_BUSY) {
+        set->Waiting = TRUE;
+        Os_TimeEndBusy();
+        while (set->Waiting) {
+            pthread_cond_wait(&IoHwAb_AcqConversionDone, &IoHwAb_AcqLock);
+        }
+    }
+    pthread_mutex_unlock(&IoHwAb_AcqLock);
+
+    if (Adc_ReadGroup(group, adcValue) != E_OK) {
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC values of acquisition set %d.\n", SetId);
+        uint64 now = Os_GetTimeNs();
+        for (uint8 i = 0; i < set->NumSensors; i++) {
+            IoHwAb_Acquisition_StoreSample(set->Sensors[i], 0.0f, FALSE, now);
+        }
+        return E_NOT_OK;
+    }
+    ResultPtr->TimestampNs = Os_GetTimeNs();
+
+    for (uint8 i = 0; i < set->NumSensors; i++) {
+        const IoHwAb_SensorEntryType* sensor = &IoHwAb_Sensors[set->Sensors[i]];
+        ResultPtr->Valid[i] = (sensor->Convert(set->Sensors[i], (uint16)adcValue[i], &ResultPtr->Values[i]) == E_OK);
+        IoHwAb_Acquisition_StoreSample(set->Sensors[i], ResultPtr->Values[i], ResultPtr->Valid[i], ResultPtr->TimestampNs);
+    }
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc mẫu mới nhất của một cảm biến từ bộ đệm
+ * @details Hàm này sao chép mẫu khi Sequence là số chẵn và đọc lại nếu
+ *          Sequence thay đổi trong lúc sao chép.
+ * @param   Sensor          ID của cảm biến
+ * @param   SamplePtr       Con trỏ lưu mẫu đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu cảm biến đã được lấy mẫu,
+ *                                 E_NOT_OK nếu cảm biến chưa được lấy mẫu lần nào
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_GetSample(IoHwAb_SensorIdType Sensor, IoHwAb_SampleType* SamplePtr) {
+    if (Sensor >= IOHWAB_NUM_SENSORS || SamplePtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    IoHwAb_SampleCacheType* cache = &IoHwAb_SampleCache[Sensor];
+    uint32 seq_begin;
+    uint32 seq_end;
+    uint32 bits;
+    uint32 valid;
+    uint64 timestamp;
+
+    do {
+        seq_begin = atomic_load_explicit(&cache->Sequence, memory_order_acquire);
+        if (seq_begin & 1U) {
+            continue;   // Luồng quét đang cập nhật, thử lại
+        }
+
+        bits = atomic_load_explicit(&cache->Value, memory_order_relaxed);
+        valid = atomic_load_explicit(&cache->Valid, memory_order_relaxed);
+        timestamp = atomic_load_explicit(&cache->TimestampNs, memory_order_relaxed);
+
+        atomic_thread_fence(memory_order_acquire);
+        seq_end = atomic_load_explicit(&cache->Sequence, memory_order_relaxed);
+    } while ((seq_begin & 1U) || seq_begin != seq_end);
+
+    if (seq_begin == 0) {
+        return E_NOT_OK;    // Cảm biến chưa được lấy mẫu lần nào
+    }
+
+    memcpy(&SamplePtr->Value, &bits, sizeof(bits));
+    SamplePtr->Valid = (boolean)valid;
+    SamplePtr->TimestampNs = timestamp;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc giá trị mới nhất của một cảm biến nếu còn dùng được
+ * @param   Sensor          ID của cảm biến
+ * @param   Value           Con trỏ lưu giá trị đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ và chưa quá
+ *                                 IOHWAB_ACQ_MAX_SAMPLE_AGE_MS,
+ *                                 E_NOT_OK nếu ngược lại
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_ReadLatest(IoHwAb_SensorIdType Sensor, float32* Value) {
+    IoHwAb_SampleType sample;
+
+    if (Value == NULL_PTR || IoHwAb_Acquisition_GetSample(Sensor, &sample) != E_OK || !sample.Valid) {
+        return E_NOT_OK;
+    }
+    if (Os_GetTimeNs() - sample.TimestampNs > (uint64)IOHWAB_ACQ_MAX_SAMPLE_AGE_MS * 1000000ULL) {
+        return E_NOT_OK;    // Mẫu quá cũ (tập sở hữu không còn được quét)
+    }
+
+    *Value = sample.Value;
+    return E_OK;
+}
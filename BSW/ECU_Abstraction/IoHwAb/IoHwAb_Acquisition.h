@@ -0,0 +1,147 @@
+/***************************************************************************
+ * @file    IoHwAb_Acquisition.h
+ * @brief   Khai báo giao diện thu thập dữ liệu cảm biến theo tập
+ * @details File này cung cấp giao diện để một SWC khai báo một lần các cảm
+ *          biến cần đọc (tập thu thập), sau đó đọc tất cả các cảm biến trong
+ *          một lần chuyển đổi nhóm kênh ADC. Mọi giá trị trong một lần quét
+ *          dùng chung một mốc thời gian. Mẫu mới nhất của mỗi cảm biến được
+ *          lưu lại để các SWC khác đọc mà không cần chuyển đổi ADC lần nữa.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef IOHWAB_ACQUISITION_H
+#define IOHWAB_ACQUISITION_H
+
+#include "Std_Types.h"
+
+/**************************************************************************
+ * @typedef IoHwAb_SensorIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của một cảm biến
+ **************************************************************************/
+typedef uint8 IoHwAb_SensorIdType;
+#define IOHWAB_SENSOR_THROTTLE          (IoHwAb_SensorIdType)0  /* Cảm biến bàn đạp ga (0..1) */
+#define IOHWAB_SENSOR_SPEED             (IoHwAb_SensorIdType)1  /* Cảm biến tốc độ xe (km/h) */
+#define IOHWAB_SENSOR_LOAD              (IoHwAb_SensorIdType)2  /* Cảm biến tải trọng (kg) */
+#define IOHWAB_SENSOR_TORQUE            (IoHwAb_SensorIdType)3  /* Cảm biến mô-men xoắn (Nm) */
+#define IOHWAB_SENSOR_BRAKE             (IoHwAb_SensorIdType)4  /* Cảm biến bàn đạp phanh (0..1) */
+#define IOHWAB_SENSOR_INCLINATION       (IoHwAb_SensorIdType)5  /* Cảm biến góc nghiêng (độ) */
+#define IOHWAB_SENSOR_BATTERY_SOC       (IoHwAb_SensorIdType)6  /* Cảm biến trạng thái pin (%) */
+#define IOHWAB_SENSOR_BATTERY_TEMP      (IoHwAb_SensorIdType)7  /* Cảm biến nhiệt độ pin (°C) */
+#define IOHWAB_NUM_SENSORS              8
+
+/**************************************************************************
+ * @typedef IoHwAb_AcqSetIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của một tập thu thập
+ * @details Mỗi tập dùng riêng một nhóm kênh ADC bắt đầu từ
+ *          ADC_GROUP_ACQUISITION_FIRST.
+ **************************************************************************/
+typedef uint8 IoHwAb_AcqSetIdType;
+#define IOHWAB_ACQ_SET_TORQUE_CONTROL   (IoHwAb_AcqSetIdType)0  /* Đầu vào của Torque Control */
+#define IOHWAB_ACQ_SET_REGEN_BRAKE      (IoHwAb_AcqSetIdType)1  /* Đầu vào của Regen Brake Control */
+#define IOHWAB_ACQ_MAX_SETS             4
+
+/**************************************************************************
+ * @brief Số cảm biến tối đa trong một tập (bằng số kênh tối đa của một
+ *        nhóm kênh ADC)
+ **************************************************************************/
+#define IOHWAB_ACQ_MAX_SENSORS          8
+
+/**************************************************************************
+ * @brief Tuổi tối đa của một mẫu trong bộ đệm (ms), mẫu cũ hơn được coi là
+ *        không còn dùng được
+ **************************************************************************/
+#ifndef IOHWAB_ACQ_MAX_SAMPLE_AGE_MS
+#define IOHWAB_ACQ_MAX_SAMPLE_AGE_MS    2500
+#endif
+
+/**************************************************************************
+ * @typedef IoHwAb_SensorConvertType
+ * @brief   Định nghĩa kiểu hàm chuyển đổi giá trị ADC thô của một cảm biến
+ * @details Hàm này do driver của cảm biến cung cấp khi đăng ký.
+ **************************************************************************/
+typedef Std_ReturnType (*IoHwAb_SensorConvertType)(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value);
+
+/**************************************************************************
+ * @struct  IoHwAb_AcqSetConfigType
+ * @brief   Định nghĩa cấu trúc cấu hình của một tập thu thập
+ **************************************************************************/
+typedef struct {
+    const IoHwAb_SensorIdType* Sensors;     /* Danh sách các cảm biến trong tập */
+    uint8 NumSensors;                       /* Số cảm biến trong tập */
+} IoHwAb_AcqSetConfigType;
+
+/**************************************************************************
+ * @struct  IoHwAb_AcqResultType
+ * @brief   Định nghĩa cấu trúc kết quả của một lần quét tập thu thập
+ * @details Giá trị được sắp xếp theo thứ tự khai báo cảm biến trong tập.
+ **************************************************************************/
+typedef struct {
+    float32 Values[IOHWAB_ACQ_MAX_SENSORS];     /* Giá trị đã chuyển đổi */
+    boolean Valid[IOHWAB_ACQ_MAX_SENSORS];      /* Giá trị có hợp lệ hay không */
+    uint64 TimestampNs;                         /* Thời điểm lấy mẫu chung (thời gian hệ thống, ns) */
+} IoHwAb_AcqResultType;
+
+/**************************************************************************
+ * @struct  IoHwAb_SampleType
+ * @brief   Định nghĩa cấu trúc mẫu mới nhất của một cảm biến
+ **************************************************************************/
+typedef struct {
+    float32 Value;                              /* Giá trị đã chuyển đổi */
+    boolean Valid;                              /* Giá trị có hợp lệ hay không */
+    uint64 TimestampNs;                         /* Thời điểm lấy mẫu (thời gian hệ thống, ns) */
+} IoHwAb_SampleType;
+
+/**************************************************************************
+ * @brief   Đăng ký kênh ADC và hàm chuyển đổi của một cảm biến
+ * @details Được driver của cảm biến gọi trong hàm khởi tạo.
+ * @param   Sensor          ID của cảm biến
+ * @param   Channel         Kênh ADC của cảm biến
+ * @param   Convert         Hàm chuyển đổi giá trị ADC thô
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_RegisterSensor(IoHwAb_SensorIdType Sensor, uint8 Channel,
+                                                 IoHwAb_SensorConvertType Convert);
+
+/**************************************************************************
+ * @brief   Cấu hình một tập thu thập
+ * @details Các cảm biến trong tập phải được khởi tạo (đăng ký) trước. Mỗi
+ *          cảm biến chỉ thuộc một tập để chỉ được lấy mẫu một lần mỗi chu kỳ.
+ * @param   SetId           ID của tập thu thập
+ * @param   ConfigPtr       Con trỏ đến cấu hình của tập
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_SetupSet(IoHwAb_AcqSetIdType SetId, const IoHwAb_AcqSetConfigType* ConfigPtr);
+
+/**************************************************************************
+ * @brief   Đọc tất cả các cảm biến của một tập trong một lần chuyển đổi
+ * @param   SetId           ID của tập thu thập
+ * @param   ResultPtr       Con trỏ lưu kết quả
+ * @return 	Std_ReturnType  Trả về E_OK nếu quét thành công,
+ *                                 E_NOT_OK nếu tập chưa cấu hình hoặc ADC lỗi
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_Scan(IoHwAb_AcqSetIdType SetId, IoHwAb_AcqResultType* ResultPtr);
+
+/**************************************************************************
+ * @brief   Đọc mẫu mới nhất của một cảm biến từ bộ đệm
+ * @details Hàm này không chuyển đổi ADC và có thể được gọi từ bất kỳ luồng
+ *          nào.
+ * @param   Sensor          ID của cảm biến
+ * @param   SamplePtr       Con trỏ lưu mẫu đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu cảm biến đã được lấy mẫu,
+ *                                 E_NOT_OK nếu cảm biến chưa được lấy mẫu lần nào
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_GetSample(IoHwAb_SensorIdType Sensor, IoHwAb_SampleType* SamplePtr);
+
+/**************************************************************************
+ * @brief   Đọc giá trị mới nhất của một cảm biến nếu còn dùng được
+ * @param   Sensor          ID của cảm biến
+ * @param   Value           Con trỏ lưu giá trị đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ và chưa quá
+ *                                 IOHWAB_ACQ_MAX_SAMPLE_AGE_MS,
+ *                                 E_NOT_OK nếu ngược lại
+ **************************************************************************/
+Std_ReturnType IoHwAb_Acquisition_ReadLatest(IoHwAb_SensorIdType Sensor, float32* Value);
+
+#endif /* IOHWAB_ACQUISITION_H */
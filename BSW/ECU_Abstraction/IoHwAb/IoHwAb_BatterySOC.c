@@ -9,10 +9,15 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_BatterySOC.h"
+#include "IoHwAb_Acquisition.h"   // Đăng ký cảm biến cho các tập thu thập
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"   // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Báo cho OS khi chờ kết quả chuyển đổi ADC
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 /**************************************************************************
  * @brief Định nghĩa phạm vi giá trị của cảm biến đọc từ ADC (giá trị thô)
@@ -31,6 +36,84 @@
  **************************************************************************/
 static BatterySOC_ConfigType BatterySOC_CurrentConfig;
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang SOC và nhiệt độ pin, tính khi
+ *        khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType BatterySOC_ConvTable;
+static IoHwAb_ConvTableType BatteryTemp_ConvTable;
+
+/**************************************************************************
+ * @brief Thứ tự các kênh trong nhóm kênh ADC của pin
+ **************************************************************************/
+#define BATTERY_GROUP_INDEX_SOC     0   /* Kênh trạng thái pin SOC */
+#define BATTERY_GROUP_INDEX_TEMP    1   /* Kênh nhiệt độ pin */
+#define BATTERY_GROUP_CHANNELS      2
+
+/**************************************************************************
+ * @brief Bộ đệm kết quả của nhóm kênh ADC và biến đồng bộ để chờ hàm thông
+ *        báo chuyển đổi xong
+ **************************************************************************/
+static Adc_ValueGroupType BatterySOC_AdcBuffer[BATTERY_GROUP_CHANNELS];
+static pthread_mutex_t BatterySOC_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t BatterySOC_ConversionDone = PTHREAD_COND_INITIALIZER;
+static boolean BatterySOC_Waiting = FALSE;
+
+/**************************************************************************
+ * @brief 	Hàm thông báo khi nhóm kênh của pin chuyển đổi xong
+ * @details Hàm này được gọi từ luồng chuyển đổi của ADC để đánh thức luồng
+ *          đang chờ kết quả trong IoHwAb_BatterySOC_Read.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void IoHwAb_BatterySOC_Notification(void) {
+    pthread_mutex_lock(&BatterySOC_Lock);
+    if (BatterySOC_Waiting) {
+        // Luồng đang chờ được tính là chạy lại trước khi luồng chuyển đổi ADC dừng
+        BatterySOC_Waiting = FALSE;
+        Os_TimeBeginBusy();
+    }
+    pthread_cond_broadcast(&BatterySOC_ConversionDone);
+    pthread_mutex_unlock(&BatterySOC_Lock);
+}
+
+/**************************************************************************
+ * @brief 	Chuyển đổi giá trị ADC thô của cảm biến trạng thái pin SOC hoặc
+ *          cảm biến nhiệt độ pin
+ * @details	Hàm này được dùng khi đọc nhóm kênh của pin và khi đọc cảm biến
+ *          trong một tập thu thập.
+ * @param   Sensor          IOHWAB_SENSOR_BATTERY_SOC hoặc IOHWAB_SENSOR_BATTERY_TEMP
+ * @param   RawValue        Giá trị ADC thô
+ * @param   Value           Con trỏ lưu giá trị SOC (%) hoặc nhiệt độ pin (°C)
+ * @return 	Std_ReturnType  Trả về E_OK nếu chuyển đổi thành công,
+ *                                 E_NOT_OK nếu cảm biến không hợp lệ
+ **************************************************************************/
+static Std_ReturnType IoHwAb_BatterySOC_Convert(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value) {
+    if (Sensor == IOHWAB_SENSOR_BATTERY_SOC) {
+        // Chuyển đổi giá trị ADC sang giá trị SOC (bảng tra đã giới hạn trong SOC_VALUE_MIN..SOC_VALUE_MAX)
+        *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&BatterySOC_ConvTable, RawValue));
+
+        // In ra giá trị SOC sau khi chuyển đổi
+        LOG_INFO(IOHWAB, "Reading Battery SOC Sensor (ADC Channel %d): SOC = %.1f%%\n",
+                          BatterySOC_CurrentConfig.BatterySOC_Channel, *Value);
+        return E_OK;
+    }
+
+    if (Sensor == IOHWAB_SENSOR_BATTERY_TEMP) {
+        // Chuyển đổi giá trị ADC sang giá trị nhiệt độ
+        *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&BatteryTemp_ConvTable, RawValue));
+
+        float32 Celsius_To_Fahrenheit = (*Value * 9.0f / 5.0f) + 32.0f;
+
+        // In ra giá trị nhiệt độ sau khi chuyển đổi
+        LOG_INFO(IOHWAB, "Reading Battery Temperature Sensor (ADC Channel %d): Temperature = %.2f\u00b0C (%.2f\u00b0F)\n",
+                          BatterySOC_CurrentConfig.BatteryTemp_Channel, *Value, Celsius_To_Fahrenheit);
+        return E_OK;
+    }
+
+    return E_NOT_OK;
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến trạng thái pin SOC
  * @details	Hàm này được gọi để khởi tạo cảm biến trạng thái pin với cấu hình 
@@ -41,7 +124,7 @@ static BatterySOC_ConfigType BatterySOC_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_BatterySOC_Init(const BatterySOC_ConfigType *ConfigPtr) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_BatterySOC_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_BatterySOC_Init.\n");
         return E_NOT_OK;
     }
 
@@ -50,6 +133,20 @@ Std_ReturnType IoHwAb_BatterySOC_Init(const BatterySOC_ConfigType *ConfigPtr) {
     BatterySOC_CurrentConfig.BatteryTemp_Channel = ConfigPtr->BatteryTemp_Channel;
     BatterySOC_CurrentConfig.BatteryTemp_MaxValue = ConfigPtr->BatteryTemp_MaxValue;
 
+    // Tính trước bảng tra cho SOC và nhiệt độ
+    const IoHwAb_ConvPointType socPoints[] = {
+        {BATTERY_SENSOR_MIN_RAW_VALUE, SOC_VALUE_MIN},
+        {BATTERY_SENSOR_MAX_RAW_VALUE, SOC_VALUE_MAX}
+    };
+    const IoHwAb_ConvPointType tempPoints[] = {
+        {0, 0.0f},
+        {BATTERY_SENSOR_MAX_RAW_VALUE, (float32)BatterySOC_CurrentConfig.BatteryTemp_MaxValue}
+    };
+    if (IoHwAb_Conversion_BuildTable(&BatterySOC_ConvTable, socPoints, 2) != E_OK ||
+        IoHwAb_Conversion_BuildTable(&BatteryTemp_ConvTable, tempPoints, 2) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // Gọi API từ MCAL để khởi tạo 2 kênh ADC cho SOC và nhiệt độ
     Adc_ConfigType adcSOC_Config;
     adcSOC_Config.Channel = BatterySOC_CurrentConfig.BatterySOC_Channel;
@@ -58,11 +155,35 @@ Std_ReturnType IoHwAb_BatterySOC_Init(const BatterySOC_ConfigType *ConfigPtr) {
     Adc_ConfigType adcTemp_Config;
     adcTemp_Config.Channel = BatterySOC_CurrentConfig.BatteryTemp_Channel;
     Adc_Init(&adcTemp_Config);
+
+    // Gom kênh SOC và kênh nhiệt độ vào một nhóm để chuyển đổi trong cùng một lần
+    Adc_ChannelType adcChannels[BATTERY_GROUP_CHANNELS];
+    adcChannels[BATTERY_GROUP_INDEX_SOC] = BatterySOC_CurrentConfig.BatterySOC_Channel;
+    adcChannels[BATTERY_GROUP_INDEX_TEMP] = BatterySOC_CurrentConfig.BatteryTemp_Channel;
+    Adc_GroupConfigType adcGroupConfig = {
+        .Channels = adcChannels,
+        .NumChannels = BATTERY_GROUP_CHANNELS,
+        .Notification = IoHwAb_BatterySOC_Notification
+    };
+    if (Adc_SetupGroup(ADC_GROUP_BATTERY, &adcGroupConfig) != E_OK ||
+        Adc_SetupResultBuffer(ADC_GROUP_BATTERY, BatterySOC_AdcBuffer) != E_OK) {
+        LOG_ERROR(IOHWAB, "Error: Failed to set up ADC group for battery sensors.\n");
+        return E_NOT_OK;
+    }
+    Adc_EnableGroupNotification(ADC_GROUP_BATTERY);
     
     // In ra thông tin cấu hình của cảm biến trạng thái pin SOC
-    printf("Battery SOC Sensor Initialized with ADC Channel %d\n", BatterySOC_CurrentConfig.BatterySOC_Channel);
-    printf("Battery Temperature Sensor Initialized with ADC Channel %d\n", BatterySOC_CurrentConfig.BatteryTemp_Channel);
-    printf("Battery Temperature Max Value: %d\u00b0C\n", BatterySOC_CurrentConfig.BatteryTemp_MaxValue);
+    LOG_INFO(IOHWAB, "Battery SOC Sensor Initialized with ADC Channel %d\n", BatterySOC_CurrentConfig.BatterySOC_Channel);
+    LOG_INFO(IOHWAB, "Battery Temperature Sensor Initialized with ADC Channel %d\n", BatterySOC_CurrentConfig.BatteryTemp_Channel);
+    LOG_INFO(IOHWAB, "Battery Temperature Max Value: %d\u00b0C\n", BatterySOC_CurrentConfig.BatteryTemp_MaxValue);
+
+    // Đăng ký hai cảm biến để có thể đọc trong các tập thu thập
+    if (IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_BATTERY_SOC, BatterySOC_CurrentConfig.BatterySOC_Channel,
+                                          IoHwAb_BatterySOC_Convert) != E_OK ||
+        IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_BATTERY_TEMP, BatterySOC_CurrentConfig.BatteryTemp_Channel,
+                                          IoHwAb_BatterySOC_Convert) != E_OK) {
+        return E_NOT_OK;
+    }
 
     return E_OK;
 }
@@ -78,48 +199,39 @@ Std_ReturnType IoHwAb_BatterySOC_Init(const BatterySOC_ConfigType *ConfigPtr) {
  **************************************************************************/
 Std_ReturnType IoHwAb_BatterySOC_Read(uint16 *BatterySOCValue, float32 *BatteryTempValue) {
     if (BatterySOCValue == NULL_PTR || BatteryTempValue == NULL_PTR) {
-        printf("Error: Null pointer passed to IoHwAb_BatterySOC_Read.\n");
+        LOG_ERROR(IOHWAB, "Error: Null pointer passed to IoHwAb_BatterySOC_Read.\n");
         return E_NOT_OK;
     }
 
-    // Đọc giá trị từ cảm biến trạng thái pin SOC
-    uint16 batterySOC_adc_value;
-    if (Adc_ReadChannel(BatterySOC_CurrentConfig.BatterySOC_Channel, &batterySOC_adc_value) == E_NOT_OK) {
-        printf("Error: Failed to read ADC value.\n");
+    // Chuyển đổi kênh SOC và kênh nhiệt độ trong một lần chuyển đổi ADC
+    Adc_ValueGroupType adcValue[BATTERY_GROUP_CHANNELS];
+    if (Adc_StartGroupConversion(ADC_GROUP_BATTERY) != E_OK) {
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị ADC sang giá trị SOC
-    *BatterySOCValue = ((uint16)batterySOC_adc_value - BATTERY_SENSOR_MIN_RAW_VALUE) / 
-                        (BATTERY_SENSOR_MAX_RAW_VALUE - BATTERY_SENSOR_MIN_RAW_VALUE) * (SOC_VALUE_MAX - SOC_VALUE_MIN);
-
-    // Đảm bảo giá trị SOC nằm trong phạm vi từ 0.0f đến 100.0f
-    if (*BatterySOCValue < SOC_VALUE_MIN) {
-        *BatterySOCValue = SOC_VALUE_MIN;
-    } else if (*BatterySOCValue > SOC_VALUE_MAX) {
-        *BatterySOCValue = SOC_VALUE_MAX;
+    // Chờ hàm thông báo từ ADC khi nhóm kênh chuyển đổi xong
+    pthread_mutex_lock(&BatterySOC_Lock);
+    if (Adc_GetGroupStatus(ADC_GROUP_BATTERY) == ADC_BUSY) {
+        BatterySOC_Waiting = TRUE;
+        Os_TimeEndBusy();
+        while (BatterySOC_Waiting) {
+            pthread_cond_wait(&BatterySOC_ConversionDone, &BatterySOC_Lock);
+        }
     }
+    pthread_mutex_unlock(&BatterySOC_Lock);
 
-    // In ra giá trị SOC sau khi chuyển đổi
-    printf("Reading Battery SOC Sensor (ADC Channel %d): SOC = %d%%\n",
-            BatterySOC_CurrentConfig.BatterySOC_Channel, *BatterySOCValue);
-
-    // Đọc giá trị từ cảm biến nhiệt độ
-    uint16 batteryTemp_adc_value;
-    if (Adc_ReadChannel(BatterySOC_CurrentConfig.BatteryTemp_Channel, &batteryTemp_adc_value) == E_NOT_OK) {
-        printf("Error: Failed to read ADC value.\n");
+    if (Adc_ReadGroup(ADC_GROUP_BATTERY, adcValue) != E_OK) {
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC value.\n");
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị ADC sang giá trị nhiệt độ
-    *BatteryTempValue = ((float32)batteryTemp_adc_value / BATTERY_SENSOR_MAX_RAW_VALUE) * 
-                        BatterySOC_CurrentConfig.BatteryTemp_MaxValue;
-
-    float32 Celsius_To_Fahrenheit = (*BatteryTempValue * 9.0f / 5.0f) + 32.0f;
-
-    // In ra giá trị nhiệt độ sau khi chuyển đổi
-    printf("Reading Battery Temperature Sensor (ADC Channel %d): Temperature = %.2f\u00b0C (%.2f\u00b0F)\n",
-            BatterySOC_CurrentConfig.BatteryTemp_Channel, *BatteryTempValue, Celsius_To_Fahrenheit);
+    // Chuyển đổi giá trị ADC sang giá trị SOC và nhiệt độ
+    float32 socValue;
+    if (IoHwAb_BatterySOC_Convert(IOHWAB_SENSOR_BATTERY_SOC, (uint16)adcValue[BATTERY_GROUP_INDEX_SOC], &socValue) != E_OK ||
+        IoHwAb_BatterySOC_Convert(IOHWAB_SENSOR_BATTERY_TEMP, (uint16)adcValue[BATTERY_GROUP_INDEX_TEMP], BatteryTempValue) != E_OK) {
+        return E_NOT_OK;
+    }
+    *BatterySOCValue = (uint16)(socValue + 0.5f);   // Làm tròn đến phần trăm gần nhất
 
     return E_OK;
 }
\ No newline at end of file
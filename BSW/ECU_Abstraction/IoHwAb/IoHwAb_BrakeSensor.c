@@ -9,8 +9,11 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_BrakeSensor.h"
+#include "IoHwAb_Acquisition.h"   // Đăng ký cảm biến cho các tập thu thập
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"   // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -31,6 +34,32 @@
  **************************************************************************/
 static BrakeSensor_ConfigType BrakeSensor_CurrentConfig;
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang vị trí bàn đạp phanh, tính khi
+ *        khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType BrakeSensor_ConvTable;
+
+/**************************************************************************
+ * @brief 	Chuyển đổi giá trị ADC thô của cảm biến bàn đạp phanh
+ * @details	Hàm này được dùng khi đọc riêng cảm biến và khi đọc cảm biến
+ *          trong một tập thu thập.
+ * @param   Sensor          ID của cảm biến (không sử dụng)
+ * @param   RawValue        Giá trị ADC thô
+ * @param   Value           Con trỏ lưu vị trí bàn đạp phanh (0..1)
+ * @return 	Std_ReturnType  Trả về E_OK
+ **************************************************************************/
+static Std_ReturnType IoHwAb_BrakeSensor_Convert(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value) {
+    // Chuyển đổi giá trị thô của ADC sang phạm vi từ 0.0 đến 1.0 (bảng tra đã giới hạn phạm vi)
+    *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&BrakeSensor_ConvTable, RawValue));
+
+    // In ra giá trị bàn đạp phanh sau khi chuyển đổi
+    LOG_INFO(IOHWAB, "Reading Brake Sensor (ADC Channel %d): Brake Position = %.2f\n",
+                      BrakeSensor_CurrentConfig.BrakeSensor_Channel, *Value);
+
+    return E_OK;
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến bàn đạp phanh 
  * @details	Hàm này được gọi để khởi tạo cảm biến bàn đạp phanh với cấu hình 
@@ -41,13 +70,22 @@ static BrakeSensor_ConfigType BrakeSensor_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_BrakeSensor_Init(const BrakeSensor_ConfigType *ConfigPtr) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_BrakeSensor_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_BrakeSensor_Init.\n");
         return E_NOT_OK;
     }
 
     // Lưu cảm biến cấu bàn đạp phanh vào biến toàn cục
     BrakeSensor_CurrentConfig.BrakeSensor_Channel = ConfigPtr->BrakeSensor_Channel;
 
+    // Tính trước bảng tra: phạm vi giá trị thô tương ứng BRAKE_POSITION_MIN..BRAKE_POSITION_MAX
+    const IoHwAb_ConvPointType convPoints[] = {
+        {BRAKE_SENSOR_MIN_RAW_VALUE, BRAKE_POSITION_MIN},
+        {BRAKE_SENSOR_MAX_RAW_VALUE, BRAKE_POSITION_MAX}
+    };
+    if (IoHwAb_Conversion_BuildTable(&BrakeSensor_ConvTable, convPoints, 2) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // Gọi API từ MCAL để khởi tạo ADC
     Adc_ConfigType adcConfig;
     adcConfig.Channel = BrakeSensor_CurrentConfig.BrakeSensor_Channel;
@@ -58,9 +96,10 @@ Std_ReturnType IoHwAb_BrakeSensor_Init(const BrakeSensor_ConfigType *ConfigPtr)
     //Dio_Init();
 
     // In ra thông tin cấu hình của cảm biến bàn đạp ga
-    printf("Brake Sensor Initialized with ADC Channel %d\n", BrakeSensor_CurrentConfig.BrakeSensor_Channel);
+    LOG_INFO(IOHWAB, "Brake Sensor Initialized with ADC Channel %d\n", BrakeSensor_CurrentConfig.BrakeSensor_Channel);
 
-    return E_OK;
+    // Đăng ký cảm biến để có thể đọc trong các tập thu thập
+    return IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_BRAKE, BrakeSensor_CurrentConfig.BrakeSensor_Channel, IoHwAb_BrakeSensor_Convert);
 }
 
 /**************************************************************************
@@ -78,24 +117,10 @@ Std_ReturnType IoHwAb_BrakeSensor_Read(float32 *BrakePosition) {
     // Đọc giá trị ADC từ cảm biến bàn đạp phanh
     uint16 raw_adc_value = 0;
     if (Adc_ReadChannel(BrakeSensor_CurrentConfig.BrakeSensor_Channel, &raw_adc_value) != E_OK) {
-        printf("Error: Failed to read ADC value.\n");
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC value.\n");
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị thô của ADC từ 0.0 đến 1.0
-    *BrakePosition = ((float32)(raw_adc_value - BRAKE_SENSOR_MIN_RAW_VALUE) / 
-                    (BRAKE_SENSOR_MAX_RAW_VALUE - BRAKE_SENSOR_MIN_RAW_VALUE));
-
-    // Đảm bảo giá trị nằm trong phạm vi từ 0.0 đến 1.0
-    if (*BrakePosition < BRAKE_POSITION_MIN) {
-        *BrakePosition = BRAKE_POSITION_MIN;
-    } else if (*BrakePosition > BRAKE_POSITION_MAX) {
-        *BrakePosition = BRAKE_POSITION_MAX;
-    }
-
-    // In ra giá trị bàn đạp phanh sau khi chuyển đổi
-    printf("Reading Brake Sensor (ADC Channel %d): Brake Position = %.2f\n",
-            BrakeSensor_CurrentConfig.BrakeSensor_Channel, *BrakePosition);
-
-    return E_OK;
+    // Chuyển đổi giá trị ADC sang bàn đạp phanh
+    return IoHwAb_BrakeSensor_Convert(IOHWAB_SENSOR_BRAKE, raw_adc_value, BrakePosition);
 }
\ No newline at end of file
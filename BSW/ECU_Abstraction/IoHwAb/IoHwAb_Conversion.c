@@ -0,0 +1,135 @@
+/***************************************************************************
+ * @file    IoHwAb_Conversion.c
+ * @brief   Định nghĩa bộ chuyển đổi giá trị ADC thô sang giá trị vật lý
+ * @details File này triển khai việc tính trước bảng tra (chỉ thực hiện khi
+ *          khởi tạo cảm biến, dùng số thực) và việc chuyển đổi từng giá trị
+ *          thô (chỉ dùng số nguyên: tra bảng, nhân và dịch bit).
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#include "IoHwAb_Conversion.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+
+/**************************************************************************
+ * @brief Giới hạn giá trị vật lý biểu diễn được ở dạng Q15.16
+ **************************************************************************/
+#define IOHWAB_CONV_VALUE_LIMIT     32767.0
+
+/**************************************************************************
+ * @brief   Tính giá trị của đường đặc tính tại một giá trị thô
+ * @details Giữa hai điểm dùng nội suy tuyến tính, ngoài các điểm đầu và
+ *          cuối dùng đoạn gần nhất để kéo dài.
+ * @param   Points          Các điểm đặc tính, Raw tăng dần
+ * @param   NumPoints       Số điểm đặc tính
+ * @param   Raw             Giá trị thô cần tính
+ * @return 	float64         Giá trị vật lý
+ **************************************************************************/
+static float64 IoHwAb_Conversion_Evaluate(const IoHwAb_ConvPointType* Points, uint8 NumPoints, float64 Raw) {
+    uint8 i = 0;
+    while (i + 2 < NumPoints && Raw > Points[i + 1].Raw) {
+        i++;
+    }
+
+    float64 x0 = Points[i].Raw;
+    float64 x1 = Points[i + 1].Raw;
+    float64 y0 = Points[i].Value;
+    float64 y1 = Points[i + 1].Value;
+    return y0 + (y1 - y0) * (Raw - x0) / (x1 - x0);
+}
+
+/**************************************************************************
+ * @brief   Đổi giá trị vật lý sang Q15.16 (làm tròn đến giá trị gần nhất)
+ * @param   Value               Giá trị vật lý
+ * @return 	IoHwAb_FixedType    Giá trị Q15.16
+ **************************************************************************/
+static IoHwAb_FixedType IoHwAb_Conversion_ToFixed(float64 Value) {
+    if (Value > IOHWAB_CONV_VALUE_LIMIT) {
+        Value = IOHWAB_CONV_VALUE_LIMIT;
+    } else if (Value < -IOHWAB_CONV_VALUE_LIMIT) {
+        Value = -IOHWAB_CONV_VALUE_LIMIT;
+    }
+    Value *= IOHWAB_FIXED_ONE;
+    return (IoHwAb_FixedType)((Value >= 0.0) ? (Value + 0.5) : (Value - 0.5));
+}
+
+/**************************************************************************
+ * @brief   Tính trước bảng tra từ đường đặc tính tuyến tính từng đoạn
+ * @param   Table           Con trỏ đến bảng tra cần tính
+ * @param   Points          Các điểm đặc tính, Raw tăng dần
+ * @param   NumPoints       Số điểm đặc tính (tối thiểu 2)
+ * @return 	Std_ReturnType  Trả về E_OK nếu tính thành công,
+ *                                 E_NOT_OK nếu đường đặc tính không hợp lệ
+ **************************************************************************/
+Std_ReturnType IoHwAb_Conversion_BuildTable(IoHwAb_ConvTableType* Table, const IoHwAb_ConvPointType* Points, uint8 NumPoints) {
+    if (Table == NULL_PTR || Points == NULL_PTR || NumPoints < 2) {
+        LOG_ERROR(IOHWAB, "Error: Invalid characteristic passed to IoHwAb_Conversion_BuildTable.\n");
+        return E_NOT_OK;
+    }
+
+    float64 minValue = Points[0].Value;
+    float64 maxValue = Points[0].Value;
+    for (uint8 i = 0; i < NumPoints; i++) {
+        if (Points[i].Raw > IOHWAB_CONV_RAW_MAX || (i > 0 && Points[i].Raw <= Points[i - 1].Raw) ||
+            Points[i].Value > IOHWAB_CONV_VALUE_LIMIT || Points[i].Value < -IOHWAB_CONV_VALUE_LIMIT) {
+            LOG_ERROR(IOHWAB, "Error: Invalid characteristic point %d (raw %d).\n", i, Points[i].Raw);
+            return E_NOT_OK;
+        }
+        if (Points[i].Value < minValue) {
+            minValue = Points[i].Value;
+        } else if (Points[i].Value > maxValue) {
+            maxValue = Points[i].Value;
+        }
+    }
+
+    for (uint32 k = 0; k <= IOHWAB_CONV_NUM_SEGMENTS; k++) {
+        float64 raw = (float64)(k << IOHWAB_CONV_SEGMENT_BITS);
+        Table->Base[k] = IoHwAb_Conversion_ToFixed(IoHwAb_Conversion_Evaluate(Points, NumPoints, raw));
+    }
+    Table->Min = IoHwAb_Conversion_ToFixed(minValue);
+    Table->Max = IoHwAb_Conversion_ToFixed(maxValue);
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Chuyển đổi một giá trị ADC thô
+ * @details Giá trị được nội suy giữa hai phần tử liên tiếp của bảng bằng
+ *          một phép nhân và một phép dịch bit, sau đó giới hạn trong khoảng
+ *          giá trị của đường đặc tính.
+ * @param   Table               Bảng tra của cảm biến
+ * @param   Raw                 Giá trị ADC thô
+ * @return 	IoHwAb_FixedType    Giá trị vật lý (Q15.16)
+ **************************************************************************/
+IoHwAb_FixedType IoHwAb_Conversion_Convert(const IoHwAb_ConvTableType* Table, uint16 Raw) {
+    if (Raw > IOHWAB_CONV_RAW_MAX) {
+        Raw = IOHWAB_CONV_RAW_MAX;
+    }
+
+    uint32 segment = (uint32)Raw >> IOHWAB_CONV_SEGMENT_BITS;
+    sint64 offset = (sint64)(Raw & ((1U << IOHWAB_CONV_SEGMENT_BITS) - 1U));
+    sint64 delta = (sint64)Table->Base[segment + 1] - Table->Base[segment];
+    IoHwAb_FixedType value = Table->Base[segment] +
+        (IoHwAb_FixedType)((delta * offset + (1 << (IOHWAB_CONV_SEGMENT_BITS - 1))) >> IOHWAB_CONV_SEGMENT_BITS);
+
+    if (value < Table->Min) {
+        value = Table->Min;
+    } else if (value > Table->Max) {
+        value = Table->Max;
+    }
+    return value;
+}
+
+/**************************************************************************
+ * @brief   Chuyển đổi kết quả của một nhóm kênh ADC
+ * @param   Tables          Bảng tra của từng kênh trong nhóm
+ * @param   RawValues       Các giá trị ADC thô
+ * @param   Values          Mảng lưu giá trị vật lý (Q15.16)
+ * @param   Count           Số kênh trong nhóm
+ * @return 	None
+ **************************************************************************/
+void IoHwAb_Conversion_ConvertGroup(const IoHwAb_ConvTableType* const Tables[], const uint16 RawValues[],
+                                    IoHwAb_FixedType Values[], uint8 Count) {
+    for (uint8 i = 0; i < Count; i++) {
+        Values[i] = IoHwAb_Conversion_Convert(Tables[i], RawValues[i]);
+    }
+}
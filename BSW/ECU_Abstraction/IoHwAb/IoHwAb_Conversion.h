@@ -0,0 +1,91 @@
+/***************************************************************************
+ * @file    IoHwAb_Conversion.h
+ * @brief   Khai báo bộ chuyển đổi giá trị ADC thô sang giá trị vật lý
+ * @details File này cung cấp bảng tra tuyến tính từng đoạn được tính trước
+ *          cho mỗi cảm biến. Mỗi lần chuyển đổi chỉ cần một lần tra bảng và
+ *          một phép nhân - dịch bit, kết quả ở dạng số thực dấu phẩy tĩnh
+ *          Q15.16 nên mọi cảm biến được chuyển đổi với cùng độ chính xác.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef IOHWAB_CONVERSION_H
+#define IOHWAB_CONVERSION_H
+
+#include "Std_Types.h"
+
+/**************************************************************************
+ * @brief Độ phân giải của giá trị ADC thô và số đoạn của bảng tra
+ * @details Mỗi đoạn dài 2^IOHWAB_CONV_SEGMENT_BITS giá trị thô, vị trí trong
+ *          đoạn được lấy bằng phép dịch bit thay vì phép chia.
+ **************************************************************************/
+#define IOHWAB_CONV_RAW_BITS        10
+#define IOHWAB_CONV_RAW_MAX         ((1U << IOHWAB_CONV_RAW_BITS) - 1U)     /* 1023 */
+#define IOHWAB_CONV_SEGMENT_BITS    5                                       /* 32 giá trị thô mỗi đoạn */
+#define IOHWAB_CONV_NUM_SEGMENTS    (1U << (IOHWAB_CONV_RAW_BITS - IOHWAB_CONV_SEGMENT_BITS))
+
+/**************************************************************************
+ * @typedef IoHwAb_FixedType
+ * @brief   Định nghĩa kiểu số thực dấu phẩy tĩnh Q15.16 của giá trị vật lý
+ **************************************************************************/
+typedef sint32 IoHwAb_FixedType;
+#define IOHWAB_FIXED_FRAC_BITS      16
+#define IOHWAB_FIXED_ONE            ((IoHwAb_FixedType)1 << IOHWAB_FIXED_FRAC_BITS)
+#define IOHWAB_FIXED_TO_FLOAT(Value)    ((float32)(Value) * (1.0f / (float32)IOHWAB_FIXED_ONE))
+
+/**************************************************************************
+ * @struct  IoHwAb_ConvPointType
+ * @brief   Định nghĩa một điểm trên đường đặc tính của cảm biến
+ **************************************************************************/
+typedef struct {
+    uint16 Raw;                 /* Giá trị ADC thô */
+    float32 Value;              /* Giá trị vật lý tương ứng */
+} IoHwAb_ConvPointType;
+
+/**************************************************************************
+ * @struct  IoHwAb_ConvTableType
+ * @brief   Định nghĩa bảng tra đã tính trước của một cảm biến
+ * @details Base[k] là giá trị tại Raw = k << IOHWAB_CONV_SEGMENT_BITS, phần
+ *          tử cuối là điểm kéo dài của đoạn cuối. Kết quả được giới hạn
+ *          trong khoảng giá trị của các điểm đặc tính.
+ **************************************************************************/
+typedef struct {
+    IoHwAb_FixedType Base[IOHWAB_CONV_NUM_SEGMENTS + 1];    /* Giá trị tại đầu mỗi đoạn */
+    IoHwAb_FixedType Min;                                   /* Giá trị nhỏ nhất */
+    IoHwAb_FixedType Max;                                   /* Giá trị lớn nhất */
+} IoHwAb_ConvTableType;
+
+/**************************************************************************
+ * @brief   Tính trước bảng tra từ đường đặc tính tuyến tính từng đoạn
+ * @details Ngoài các điểm đầu và cuối, đường đặc tính được kéo dài theo
+ *          đoạn gần nhất rồi giới hạn trong khoảng giá trị của các điểm.
+ *          Đường đặc tính tuyến tính được chuyển đổi chính xác, các điểm gấp
+ *          khúc nằm giữa một đoạn của bảng được làm mượt trong đoạn đó.
+ * @param   Table           Con trỏ đến bảng tra cần tính
+ * @param   Points          Các điểm đặc tính, Raw tăng dần
+ * @param   NumPoints       Số điểm đặc tính (tối thiểu 2)
+ * @return 	Std_ReturnType  Trả về E_OK nếu tính thành công,
+ *                                 E_NOT_OK nếu đường đặc tính không hợp lệ
+ **************************************************************************/
+Std_ReturnType IoHwAb_Conversion_BuildTable(IoHwAb_ConvTableType* Table, const IoHwAb_ConvPointType* Points, uint8 NumPoints);
+
+/**************************************************************************
+ * @brief   Chuyển đổi một giá trị ADC thô
+ * @param   Table               Bảng tra của cảm biến
+ * @param   Raw                 Giá trị ADC thô (lớn hơn IOHWAB_CONV_RAW_MAX
+ *                              được coi là IOHWAB_CONV_RAW_MAX)
+ * @return 	IoHwAb_FixedType    Giá trị vật lý (Q15.16)
+ **************************************************************************/
+IoHwAb_FixedType IoHwAb_Conversion_Convert(const IoHwAb_ConvTableType* Table, uint16 Raw);
+
+/**************************************************************************
+ * @brief   Chuyển đổi kết quả của một nhóm kênh ADC
+ * @param   Tables          Bảng tra của từng kênh trong nhóm
+ * @param   RawValues       Các giá trị ADC thô
+ * @param   Values          Mảng lưu giá trị vật lý (Q15.16)
+ * @param   Count           Số kênh trong nhóm
+ * @return 	None
+ **************************************************************************/
+void IoHwAb_Conversion_ConvertGroup(const IoHwAb_ConvTableType* const Tables[], const uint16 RawValues[],
+                                    IoHwAb_FixedType Values[], uint8 Count);
+
+#endif /* IOHWAB_CONVERSION_H */
@@ -9,8 +9,11 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_InclinationSensor.h"
+#include "IoHwAb_Acquisition.h"   // Đăng ký cảm biến cho các tập thu thập
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"   // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -19,6 +22,31 @@
  **************************************************************************/
 static InclinationSensor_ConfigType InclinationSensor_CurrentConfig;
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang góc nghiêng, tính khi khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType InclinationSensor_ConvTable;
+
+/**************************************************************************
+ * @brief 	Chuyển đổi giá trị ADC thô của cảm biến góc nghiêng
+ * @details	Hàm này được dùng khi đọc riêng cảm biến và khi đọc cảm biến
+ *          trong một tập thu thập.
+ * @param   Sensor          ID của cảm biến (không sử dụng)
+ * @param   RawValue        Giá trị ADC thô
+ * @param   Value           Con trỏ lưu góc nghiêng
+ * @return 	Std_ReturnType  Trả về E_OK
+ **************************************************************************/
+static Std_ReturnType IoHwAb_InclinationSensor_Convert(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value) {
+    // Chuyển đổi giá trị ADC sang giá trị góc nghiêng (độ)
+    *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&InclinationSensor_ConvTable, RawValue));
+
+    // In ra giá trị góc nghiêng đọc được
+    LOG_INFO(IOHWAB, "Inclination Sensor (ADC Channel %d): Inclination = %.2f\u00b0C\n",
+                      InclinationSensor_CurrentConfig.InclinationSensor_Channel, *Value);
+
+    return E_OK;
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến góc nghiêng 
  * @details	Hàm này được gọi để khởi tạo cảm biến góc nghiêng với cấu hình 
@@ -29,7 +57,7 @@ static InclinationSensor_ConfigType InclinationSensor_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_InclinationSensor_Init(const InclinationSensor_ConfigType *ConfigPtr) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_Inclination_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_Inclination_Init.\n");
         return E_NOT_OK;
     }
 
@@ -37,6 +65,15 @@ Std_ReturnType IoHwAb_InclinationSensor_Init(const InclinationSensor_ConfigType
     InclinationSensor_CurrentConfig.InclinationSensor_Channel = ConfigPtr->InclinationSensor_Channel;
     InclinationSensor_CurrentConfig.InclinationSensor_MaxValue = ConfigPtr->InclinationSensor_MaxValue;
 
+    // Tính trước bảng tra: giá trị thô 0..1023 tương ứng 0..giá trị tối đa
+    const IoHwAb_ConvPointType convPoints[] = {
+        {0, 0.0f},
+        {IOHWAB_CONV_RAW_MAX, (float32)InclinationSensor_CurrentConfig.InclinationSensor_MaxValue}
+    };
+    if (IoHwAb_Conversion_BuildTable(&InclinationSensor_ConvTable, convPoints, 2) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // Gọi API từ MCAL để khởi tạo ADC
     Adc_ConfigType adcConfig;
     adcConfig.Channel = InclinationSensor_CurrentConfig.InclinationSensor_Channel;
@@ -44,10 +81,11 @@ Std_ReturnType IoHwAb_InclinationSensor_Init(const InclinationSensor_ConfigType
     Adc_Init(&adcConfig);
 
     // In ra thông tin cấu hình của cảm biến góc nghiêng
-    printf("Inclination Sensor Initialized with ADC Channel %d\n", 
-            InclinationSensor_CurrentConfig.InclinationSensor_Channel);
+    LOG_INFO(IOHWAB, "Inclination Sensor Initialized with ADC Channel %d\n", 
+                      InclinationSensor_CurrentConfig.InclinationSensor_Channel);
 
-    return E_OK;
+    // Đăng ký cảm biến để có thể đọc trong các tập thu thập
+    return IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_INCLINATION, InclinationSensor_CurrentConfig.InclinationSensor_Channel, IoHwAb_InclinationSensor_Convert);
 }
 
 /**************************************************************************
@@ -65,16 +103,10 @@ Std_ReturnType IoHwAb_InclinationSensor_Read(float32 *InclinationValue) {
     // Đọc giá trị ADC từ cảm biến góc nghiêng
     uint16 adcValue = 0;
     if (Adc_ReadChannel(InclinationSensor_CurrentConfig.InclinationSensor_Channel, &adcValue) != E_OK) {
-        printf("Error: Failed to read ADC value.\n");
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC value.\n");
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị ADC sang giá trị góc nghiêng (độ)
-    *InclinationValue = ((float32)adcValue / 1023.0f) * InclinationSensor_CurrentConfig.InclinationSensor_MaxValue;
-
-    // In ra giá trị góc nghiêng đọc được
-    printf("Inclination Sensor (ADC Channel %d): Inclination = %.2f\u00b0C\n",
-            InclinationSensor_CurrentConfig.InclinationSensor_Channel, *InclinationValue);
-
-    return E_OK;
+    // Chuyển đổi giá trị ADC sang góc nghiêng
+    return IoHwAb_InclinationSensor_Convert(IOHWAB_SENSOR_INCLINATION, adcValue, InclinationValue);
 }
\ No newline at end of file
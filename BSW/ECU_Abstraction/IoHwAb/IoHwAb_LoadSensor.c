@@ -9,8 +9,11 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_LoadSensor.h"
+#include "IoHwAb_Acquisition.h"   // Đăng ký cảm biến cho các tập thu thập
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"    // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 
 /**************************************************************************
@@ -18,6 +21,31 @@
  **************************************************************************/
 static LoadSensor_ConfigType LoadSensor_CurrentConfig;
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang tải trọng, tính khi khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType LoadSensor_ConvTable;
+
+/**************************************************************************
+ * @brief 	Chuyển đổi giá trị ADC thô của cảm biến tải trọng
+ * @details	Hàm này được dùng khi đọc riêng cảm biến và khi đọc cảm biến
+ *          trong một tập thu thập.
+ * @param   Sensor          ID của cảm biến (không sử dụng)
+ * @param   RawValue        Giá trị ADC thô
+ * @param   Value           Con trỏ lưu tải trọng (kg)
+ * @return 	Std_ReturnType  Trả về E_OK
+ **************************************************************************/
+static Std_ReturnType IoHwAb_LoadSensor_Convert(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value) {
+    // Chuyển đổi giá trị ADC sang giá trị tải trọng (kg)
+    *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&LoadSensor_ConvTable, RawValue));
+
+    // In ra giá trị tải trọng
+    LOG_INFO(IOHWAB, "Load Sensor (ADC Channel %d): Load = %.2f kg\n",
+                      LoadSensor_CurrentConfig.LoadSensor_Channel, *Value);
+
+    return E_OK;
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến tải trọng 
  * @details	Hàm này được gọi để khởi tạo cảm biến tải trọng với cấu hình 
@@ -28,7 +56,7 @@ static LoadSensor_ConfigType LoadSensor_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_LoadSensor_Init(const LoadSensor_ConfigType* ConfigPtr) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_LoadSensor_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_LoadSensor_Init.\n");
         return E_NOT_OK;
     }
 
@@ -36,16 +64,26 @@ Std_ReturnType IoHwAb_LoadSensor_Init(const LoadSensor_ConfigType* ConfigPtr) {
     LoadSensor_CurrentConfig.LoadSensor_Channel = ConfigPtr->LoadSensor_Channel;
     LoadSensor_CurrentConfig.LoadSensor_MaxValue = ConfigPtr->LoadSensor_MaxValue;
 
+    // Tính trước bảng tra: giá trị thô 0..1023 tương ứng 0..giá trị tối đa
+    const IoHwAb_ConvPointType convPoints[] = {
+        {0, 0.0f},
+        {IOHWAB_CONV_RAW_MAX, (float32)LoadSensor_CurrentConfig.LoadSensor_MaxValue}
+    };
+    if (IoHwAb_Conversion_BuildTable(&LoadSensor_ConvTable, convPoints, 2) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // Gọi API từ MCAL để khởi tạo ADC
     Adc_ConfigType adcConfig;
     adcConfig.Channel = ConfigPtr->LoadSensor_Channel;
     Adc_Init(&adcConfig);
 
     // In ra thông tin cấu hình cảm biến tải trọng
-    printf("Load Sensor Initialized with Configuration:\n");
-    printf(" - ADC Channel: %d\n", LoadSensor_CurrentConfig.LoadSensor_Channel);
-    printf(" - Max Load Value: %d kg\n", LoadSensor_CurrentConfig.LoadSensor_MaxValue);
-    return E_OK;
+    LOG_INFO(IOHWAB, "Load Sensor Initialized with Configuration:\n");
+    LOG_INFO(IOHWAB, " - ADC Channel: %d\n", LoadSensor_CurrentConfig.LoadSensor_Channel);
+    LOG_INFO(IOHWAB, " - Max Load Value: %d kg\n", LoadSensor_CurrentConfig.LoadSensor_MaxValue);
+    // Đăng ký cảm biến để có thể đọc trong các tập thu thập
+    return IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_LOAD, LoadSensor_CurrentConfig.LoadSensor_Channel, IoHwAb_LoadSensor_Convert);
 }
 
 /**************************************************************************
@@ -63,16 +101,10 @@ Std_ReturnType IoHwAb_LoadSensor_Read(float32* LoadValue) {
     // Đọc giá trị ADC từ MCAL
     uint16 adcValue = 0;
     if (Adc_ReadChannel(LoadSensor_CurrentConfig.LoadSensor_Channel, &adcValue) != E_OK) {
-        printf("Error: Failed to read ADC value.\n");
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC value.\n");
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị ADC sang giá trị tải trọng (kg)
-    *LoadValue = ((float32)adcValue / 1023.0f) * LoadSensor_CurrentConfig.LoadSensor_MaxValue;
-
-    // In ra giá trị tải trọng
-    printf("Load Sensor (ADC Channel %d): Load = %.2f kg\n",
-            LoadSensor_CurrentConfig.LoadSensor_Channel, *LoadValue);
-
-    return E_OK;
+    // Chuyển đổi giá trị ADC sang tải trọng
+    return IoHwAb_LoadSensor_Convert(IOHWAB_SENSOR_LOAD, adcValue, LoadValue);
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "IoHwAb_MotorDriver.h"
 #include "Pwm.h"  // Gọi API PWM từ MCAL
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -27,7 +28,7 @@ static MotorDriver_ConfigType MotorDriver_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_MotorDriver_Init(const MotorDriver_ConfigType* ConfigPtr) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_MotorDriver_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_MotorDriver_Init.\n");
         return E_NOT_OK;
     }
 
@@ -44,9 +45,9 @@ Std_ReturnType IoHwAb_MotorDriver_Init(const MotorDriver_ConfigType* ConfigPtr)
     Pwm_Init(&pwmConfig);
 
     // In ra thông tin cấu hình MotorDriver
-    printf("Motor Driver Initialized with Configuration:\n");
-    printf(" - Motor Channel: %d\n", MotorDriver_CurrentConfig.Motor_Channel);
-    printf(" - Max Torque: %d Nm\n", MotorDriver_CurrentConfig.Motor_MaxTorque);
+    LOG_INFO(IOHWAB, "Motor Driver Initialized with Configuration:\n");
+    LOG_INFO(IOHWAB, " - Motor Channel: %d\n", MotorDriver_CurrentConfig.Motor_Channel);
+    LOG_INFO(IOHWAB, " - Max Torque: %d Nm\n", MotorDriver_CurrentConfig.Motor_MaxTorque);
 
     return E_OK;
 }
@@ -61,7 +62,7 @@ Std_ReturnType IoHwAb_MotorDriver_Init(const MotorDriver_ConfigType* ConfigPtr)
 Std_ReturnType IoHwAb_MotorDriver_SetTorque(float32 TorqueValue) {
     // Kiểm tra giá trị mô-men xoắn hợp lệ
     if (TorqueValue < 0.0f || TorqueValue > MotorDriver_CurrentConfig.Motor_MaxTorque) {
-        printf("Error: Torque value %.2f Nm out of range (Max: %d Nm).\n", TorqueValue, MotorDriver_CurrentConfig.Motor_MaxTorque);
+        LOG_ERROR(IOHWAB, "Error: Torque value %.2f Nm out of range (Max: %d Nm).\n", TorqueValue, MotorDriver_CurrentConfig.Motor_MaxTorque);
         return E_NOT_OK;
     }
 
@@ -72,7 +73,7 @@ Std_ReturnType IoHwAb_MotorDriver_SetTorque(float32 TorqueValue) {
     Pwm_SetDutyCycle(MotorDriver_CurrentConfig.Motor_Channel, dutyCycle);
 
     // In ra giá trị mô-men xoắn đã đặt
-    printf("Setting Motor Torque to %.2f Nm on Channel %d\n", TorqueValue, MotorDriver_CurrentConfig.Motor_Channel);
+    LOG_INFO(IOHWAB, "Setting Motor Torque to %.2f Nm on Channel %d\n", TorqueValue, MotorDriver_CurrentConfig.Motor_Channel);
 
     return E_OK;
 }
\ No newline at end of file
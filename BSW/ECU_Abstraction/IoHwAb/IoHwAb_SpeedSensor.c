@@ -9,8 +9,11 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_SpeedSensor.h"
+#include "IoHwAb_Acquisition.h"   // Đăng ký cảm biến cho các tập thu thập
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"   // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -19,6 +22,31 @@
  **************************************************************************/
 static SpeedSensor_ConfigType SpeedSensor_CurrentConfig;
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang tốc độ, tính khi khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType SpeedSensor_ConvTable;
+
+/**************************************************************************
+ * @brief 	Chuyển đổi giá trị ADC thô của cảm biến tốc độ
+ * @details	Hàm này được dùng khi đọc riêng cảm biến và khi đọc cảm biến
+ *          trong một tập thu thập.
+ * @param   Sensor          ID của cảm biến (không sử dụng)
+ * @param   RawValue        Giá trị ADC thô
+ * @param   Value           Con trỏ lưu tốc độ (km/h)
+ * @return 	Std_ReturnType  Trả về E_OK
+ **************************************************************************/
+static Std_ReturnType IoHwAb_SpeedSensor_Convert(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value) {
+    // Chuyển đổi giá trị ADC sang tốc độ (giả lập)
+    *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&SpeedSensor_ConvTable, RawValue));
+
+    // In ra giá trị tốc độ
+    LOG_INFO(IOHWAB, "Reading Speed Sensor (ADC Channel %d): Speed = %.2f km/h\n",
+                     SpeedSensor_CurrentConfig.SpeedSensor_Channel, *Value);
+
+    return E_OK;
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến tốc độ 
  * @details	Hàm này được gọi để khởi tạo cảm biến tốc độ với cấu hình 
@@ -29,7 +57,7 @@ static SpeedSensor_ConfigType SpeedSensor_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_SpeedSensor_Init(const SpeedSensor_ConfigType* ConfigPtr) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_SpeedSensor_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_SpeedSensor_Init.\n");
         return E_NOT_OK;
     }
 
@@ -37,17 +65,27 @@ Std_ReturnType IoHwAb_SpeedSensor_Init(const SpeedSensor_ConfigType* ConfigPtr)
     SpeedSensor_CurrentConfig.SpeedSensor_Channel = ConfigPtr->SpeedSensor_Channel;
     SpeedSensor_CurrentConfig.SpeedSensor_MaxValue = ConfigPtr->SpeedSensor_MaxValue;
 
+    // Tính trước bảng tra: giá trị thô 0..1023 tương ứng 0..giá trị tối đa
+    const IoHwAb_ConvPointType convPoints[] = {
+        {0, 0.0f},
+        {IOHWAB_CONV_RAW_MAX, (float32)SpeedSensor_CurrentConfig.SpeedSensor_MaxValue}
+    };
+    if (IoHwAb_Conversion_BuildTable(&SpeedSensor_ConvTable, convPoints, 2) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // Gọi API từ MCAL để khởi tạo ADC
     Adc_ConfigType adcConfig;
     adcConfig.Channel = ConfigPtr->SpeedSensor_Channel;
     Adc_Init(&adcConfig);
 
     // In ra thông tin cấu hình cảm biến tốc độ
-    printf("Speed Sensor Initialized with Configuration:\n");
-    printf(" - ADC Channel: %d\n", SpeedSensor_CurrentConfig.SpeedSensor_Channel);
-    printf(" - Max Speed Value: %d km/h\n", SpeedSensor_CurrentConfig.SpeedSensor_MaxValue);
+    LOG_INFO(IOHWAB, "Speed Sensor Initialized with Configuration:\n");
+    LOG_INFO(IOHWAB, " - ADC Channel: %d\n", SpeedSensor_CurrentConfig.SpeedSensor_Channel);
+    LOG_INFO(IOHWAB, " - Max Speed Value: %d km/h\n", SpeedSensor_CurrentConfig.SpeedSensor_MaxValue);
 
-    return E_OK;
+    // Đăng ký cảm biến để có thể đọc trong các tập thu thập
+    return IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_SPEED, SpeedSensor_CurrentConfig.SpeedSensor_Channel, IoHwAb_SpeedSensor_Convert);
 }
 
 /**************************************************************************
@@ -65,16 +103,10 @@ Std_ReturnType IoHwAb_SpeedSensor_Read(float32* SpeedValue) {
     // Đọc giá trị từ kênh ADC
     uint16 adcValue = 0;
     if (Adc_ReadChannel(SpeedSensor_CurrentConfig.SpeedSensor_Channel, &adcValue) != E_OK) {
-        printf("Error: Failed to read ADC value.\n");
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC value.\n");
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị ADC sang tốc độ (giả lập)
-    *SpeedValue = ((float32)adcValue / 1023.0f) * SpeedSensor_CurrentConfig.SpeedSensor_MaxValue;
-
-    // In ra giá trị tốc độ
-    printf("Reading Speed Sensor (ADC Channel %d): Speed = %.2f km/h\n",
-           SpeedSensor_CurrentConfig.SpeedSensor_Channel, *SpeedValue);
-
-    return E_OK;
+    // Chuyển đổi giá trị ADC sang tốc độ
+    return IoHwAb_SpeedSensor_Convert(IOHWAB_SENSOR_SPEED, adcValue, SpeedValue);
 }
\ No newline at end of file
@@ -9,8 +9,11 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_ThrottleSensor.h"
+#include "IoHwAb_Acquisition.h"   // Đăng ký cảm biến cho các tập thu thập
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"   // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -31,6 +34,32 @@
  **************************************************************************/
 static ThrottleSensor_ConfigType ThrottleSensor_CurrentConfig;
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang vị trí bàn đạp ga, tính khi
+ *        khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType ThrottleSensor_ConvTable;
+
+/**************************************************************************
+ * @brief 	Chuyển đổi giá trị ADC thô của cảm biến bàn đạp ga
+ * @details	Hàm này được dùng khi đọc riêng cảm biến và khi đọc cảm biến
+ *          trong một tập thu thập.
+ * @param   Sensor          ID của cảm biến (không sử dụng)
+ * @param   RawValue        Giá trị ADC thô
+ * @param   Value           Con trỏ lưu vị trí bàn đạp ga (0..1)
+ * @return 	Std_ReturnType  Trả về E_OK
+ **************************************************************************/
+static Std_ReturnType IoHwAb_ThrottleSensor_Convert(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value) {
+    // Chuyển đổi giá trị thô của ADC sang phạm vi từ 0.0 đến 1.0 (bảng tra đã giới hạn phạm vi)
+    *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&ThrottleSensor_ConvTable, RawValue));
+
+    // In ra giá trị bàn đạp ga sau khi chuyển đổi
+    LOG_INFO(IOHWAB, "Reading Throttle Sensor (ADC Channel %d): Throttle Position = %.2f\n",
+                     ThrottleSensor_CurrentConfig.ThrottleSensor_Channel, *Value);
+
+    return E_OK;
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến bàn đạp ga 
  * @details	Hàm này được gọi để khởi tạo cảm biến bàn đạp ga với cấu hình 
@@ -41,13 +70,22 @@ static ThrottleSensor_ConfigType ThrottleSensor_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_ThrottleSensor_Init(const ThrottleSensor_ConfigType* ConfigPtr) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_ThrottleSensor_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_ThrottleSensor_Init.\n");
         return E_NOT_OK;
     }
 
     // Lưu cấu hình cảm biến bàn đạp ga vào biến toàn cục
     ThrottleSensor_CurrentConfig.ThrottleSensor_Channel = ConfigPtr->ThrottleSensor_Channel;
 
+    // Tính trước bảng tra: phạm vi giá trị thô tương ứng THROTTLE_POSITION_MIN..THROTTLE_POSITION_MAX
+    const IoHwAb_ConvPointType convPoints[] = {
+        {THROTTLE_SENSOR_MIN_RAW_VALUE, THROTTLE_POSITION_MIN},
+        {THROTTLE_SENSOR_MAX_RAW_VALUE, THROTTLE_POSITION_MAX}
+    };
+    if (IoHwAb_Conversion_BuildTable(&ThrottleSensor_ConvTable, convPoints, 2) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // Gọi API từ MCAL để khởi tạo ADC
     Adc_ConfigType adcConfig;
     adcConfig.Channel = ThrottleSensor_CurrentConfig.ThrottleSensor_Channel;
@@ -58,9 +96,10 @@ Std_ReturnType IoHwAb_ThrottleSensor_Init(const ThrottleSensor_ConfigType* Confi
     //Dio_Init();
 
     // In ra thông tin cấu hình của cảm biến bàn đạp ga
-    printf("Throttle Sensor Initialized with ADC Channel %d\n", ThrottleSensor_CurrentConfig.ThrottleSensor_Channel);
+    LOG_INFO(IOHWAB, "Throttle Sensor Initialized with ADC Channel %d\n", ThrottleSensor_CurrentConfig.ThrottleSensor_Channel);
 
-    return E_OK;
+    // Đăng ký cảm biến để có thể đọc trong các tập thu thập
+    return IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_THROTTLE, ThrottleSensor_CurrentConfig.ThrottleSensor_Channel, IoHwAb_ThrottleSensor_Convert);
 }
 
 /**************************************************************************
@@ -78,24 +117,10 @@ Std_ReturnType IoHwAb_ThrottleSensor_Read(float32* ThrottlePosition) {
     // Đọc giá trị ADC từ kênh cảm biến bàn đạp ga
     uint16 raw_adc_value = 0;
     if (Adc_ReadChannel(ThrottleSensor_CurrentConfig.ThrottleSensor_Channel, &raw_adc_value) != E_OK) {
-        printf("Error: Failed to read ADC value.\n");
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC value.\n");
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị thô của ADC sang phạm vi từ 0.0 đến 1.0
-    *ThrottlePosition = ((float32)(raw_adc_value - THROTTLE_SENSOR_MIN_RAW_VALUE) / 
-                        (THROTTLE_SENSOR_MAX_RAW_VALUE - THROTTLE_SENSOR_MIN_RAW_VALUE));
-
-    // Đảm bảo giá trị nằm trong phạm vi từ 0.0 đến 1.0
-    if (*ThrottlePosition < THROTTLE_POSITION_MIN) {
-        *ThrottlePosition = THROTTLE_POSITION_MIN;
-    } else if (*ThrottlePosition > THROTTLE_POSITION_MAX) {
-        *ThrottlePosition = THROTTLE_POSITION_MAX;
-    }
-
-    // In ra giá trị bàn đạp ga sau khi chuyển đổi
-    printf("Reading Throttle Sensor (ADC Channel %d): Throttle Position = %.2f\n",
-           ThrottleSensor_CurrentConfig.ThrottleSensor_Channel, *ThrottlePosition);
-
-    return E_OK;
+    // Chuyển đổi giá trị ADC sang bàn đạp ga
+    return IoHwAb_ThrottleSensor_Convert(IOHWAB_SENSOR_THROTTLE, raw_adc_value, ThrottlePosition);
 }
\ No newline at end of file
@@ -9,8 +9,11 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_TorqueSensor.h"
+#include "IoHwAb_Acquisition.h"   // Đăng ký cảm biến cho các tập thu thập
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"   // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -19,6 +22,31 @@
  **************************************************************************/
 static TorqueSensor_ConfigType TorqueSensor_CurrentConfig;
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang mô-men xoắn, tính khi khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType TorqueSensor_ConvTable;
+
+/**************************************************************************
+ * @brief 	Chuyển đổi giá trị ADC thô của cảm biến mô-men xoắn
+ * @details	Hàm này được dùng khi đọc riêng cảm biến và khi đọc cảm biến
+ *          trong một tập thu thập.
+ * @param   Sensor          ID của cảm biến (không sử dụng)
+ * @param   RawValue        Giá trị ADC thô
+ * @param   Value           Con trỏ lưu mô-men xoắn (Nm)
+ * @return 	Std_ReturnType  Trả về E_OK
+ **************************************************************************/
+static Std_ReturnType IoHwAb_TorqueSensor_Convert(IoHwAb_SensorIdType Sensor, uint16 RawValue, float32* Value) {
+    // Chuyển đổi giá trị ADC sang mô-men xoắn (giả lập)
+    *Value = IOHWAB_FIXED_TO_FLOAT(IoHwAb_Conversion_Convert(&TorqueSensor_ConvTable, RawValue));
+
+    // In ra giá trị mô-men xoắn
+    LOG_INFO(IOHWAB, "Reading Torque Sensor (ADC Channel %d): Torque = %.2f Nm\n",
+                     TorqueSensor_CurrentConfig.TorqueSensor_Channel, *Value);
+
+    return E_OK;
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến mô-men xoắn 
  * @details	Hàm này được gọi để khởi tạo cảm biến mô-men xoắn với cấu hình 
@@ -29,7 +57,7 @@ static TorqueSensor_ConfigType TorqueSensor_CurrentConfig;
  **************************************************************************/
 Std_ReturnType IoHwAb_TorqueSensor_Init(const TorqueSensor_ConfigType* ConfigPtr) {
     if (ConfigPtr == NULL) {
-        printf("Error: Null configuration pointer passed to IoHwAb_TorqueSensor_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_TorqueSensor_Init.\n");
         return E_NOT_OK;
     }
 
@@ -37,17 +65,27 @@ Std_ReturnType IoHwAb_TorqueSensor_Init(const TorqueSensor_ConfigType* ConfigPtr
     TorqueSensor_CurrentConfig.TorqueSensor_Channel = ConfigPtr->TorqueSensor_Channel;
     TorqueSensor_CurrentConfig.TorqueSensor_MaxValue = ConfigPtr->TorqueSensor_MaxValue;
 
+    // Tính trước bảng tra: giá trị thô 0..1023 tương ứng 0..giá trị tối đa
+    const IoHwAb_ConvPointType convPoints[] = {
+        {0, 0.0f},
+        {IOHWAB_CONV_RAW_MAX, (float32)TorqueSensor_CurrentConfig.TorqueSensor_MaxValue}
+    };
+    if (IoHwAb_Conversion_BuildTable(&TorqueSensor_ConvTable, convPoints, 2) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // Gọi API từ MCAL để khởi tạo ADC
     Adc_ConfigType adcConfig;
     adcConfig.Channel = TorqueSensor_CurrentConfig.TorqueSensor_Channel;
     Adc_Init(&adcConfig);
 
     // In ra thông tin cấu hình của cảm biến mô-men xoắn
-    printf("Torque Sensor Initialized with Configuration:\n");
-    printf(" - ADC Channel: %d\n", TorqueSensor_CurrentConfig.TorqueSensor_Channel);
-    printf(" - Max Torque Value: %d Nm\n", TorqueSensor_CurrentConfig.TorqueSensor_MaxValue);
+    LOG_INFO(IOHWAB, "Torque Sensor Initialized with Configuration:\n");
+    LOG_INFO(IOHWAB, " - ADC Channel: %d\n", TorqueSensor_CurrentConfig.TorqueSensor_Channel);
+    LOG_INFO(IOHWAB, " - Max Torque Value: %d Nm\n", TorqueSensor_CurrentConfig.TorqueSensor_MaxValue);
 
-    return E_OK;
+    // Đăng ký cảm biến để có thể đọc trong các tập thu thập
+    return IoHwAb_Acquisition_RegisterSensor(IOHWAB_SENSOR_TORQUE, TorqueSensor_CurrentConfig.TorqueSensor_Channel, IoHwAb_TorqueSensor_Convert);
 }
 
 /**************************************************************************
@@ -65,16 +103,10 @@ Std_ReturnType IoHwAb_TorqueSensor_Read(float32* TorqueValue) {
     // Đọc giá trị ADC từ MCAL
     uint16_t adcValue = 0;
     if (Adc_ReadChannel(TorqueSensor_CurrentConfig.TorqueSensor_Channel, &adcValue) != E_OK) {
-        printf("Error: Failed to read ADC value.\n");
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC value.\n");
         return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị ADC sang mô-men xoắn (giả lập)
-    *TorqueValue = ((float32)adcValue / 1023.0f) * TorqueSensor_CurrentConfig.TorqueSensor_MaxValue;
-
-    // In ra giá trị mô-men xoắn
-    printf("Reading Torque Sensor (ADC Channel %d): Torque = %.2f Nm\n",
-           TorqueSensor_CurrentConfig.TorqueSensor_Channel, *TorqueValue);
-
-    return E_OK;
+    // Chuyển đổi giá trị ADC sang mô-men xoắn
+    return IoHwAb_TorqueSensor_Convert(IOHWAB_SENSOR_TORQUE, adcValue, TorqueValue);
 }
\ No newline at end of file
@@ -9,16 +9,57 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "IoHwAb_WheelAngularVelocity.h"
+#include "IoHwAb_Conversion.h"    // Bảng tra chuyển đổi giá trị ADC
 #include "Adc\Adc.h"   // Gọi API từ MCAL để đọc giá trị từ ADC
 #include "Dio.h"   // Gọi API từ MCAL để kiểm tra trạng thái DIO nếu cần
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Báo cho OS khi chờ kết quả chuyển đổi ADC
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 /**************************************************************************
  * @brief Giả lập cấu hình của cảm biến vận tốc góc cho tất cả các bánh xe
  **************************************************************************/
 static WheelAngularVel_ConfigType WheelAngularVel_CurrentConfig[WHEEL_NUMBERS];
 
+/**************************************************************************
+ * @brief Bảng tra chuyển đổi giá trị ADC sang vận tốc góc của từng bánh xe,
+ *        tính khi khởi tạo
+ **************************************************************************/
+static IoHwAb_ConvTableType WheelAngularVel_ConvTable[WHEEL_NUMBERS];
+static const IoHwAb_ConvTableType* const WheelAngularVel_ConvTables[WHEEL_NUMBERS] = {
+    &WheelAngularVel_ConvTable[0], &WheelAngularVel_ConvTable[1],
+    &WheelAngularVel_ConvTable[2], &WheelAngularVel_ConvTable[3]
+};
+
+/**************************************************************************
+ * @brief Bộ đệm kết quả của nhóm kênh ADC và biến đồng bộ để chờ hàm thông
+ *        báo chuyển đổi xong
+ **************************************************************************/
+static Adc_ValueGroupType WheelAngularVel_AdcBuffer[WHEEL_NUMBERS];
+static pthread_mutex_t WheelAngularVel_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t WheelAngularVel_ConversionDone = PTHREAD_COND_INITIALIZER;
+static boolean WheelAngularVel_Waiting = FALSE;
+
+/**************************************************************************
+ * @brief 	Hàm thông báo khi nhóm kênh vận tốc góc chuyển đổi xong
+ * @details Hàm này được gọi từ luồng chuyển đổi của ADC để đánh thức luồng
+ *          đang chờ kết quả trong IoHwAb_WheelAngularVel_Read.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void IoHwAb_WheelAngularVel_Notification(void) {
+    pthread_mutex_lock(&WheelAngularVel_Lock);
+    if (WheelAngularVel_Waiting) {
+        // Luồng đang chờ được tính là chạy lại trước khi luồng chuyển đổi ADC dừng
+        WheelAngularVel_Waiting = FALSE;
+        Os_TimeBeginBusy();
+    }
+    pthread_cond_broadcast(&WheelAngularVel_ConversionDone);
+    pthread_mutex_unlock(&WheelAngularVel_Lock);
+}
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến vận tốc góc góc bánh xe
  * @details Hàm này được gọi để khởi tạo cảm biến vận tốc góc với cấu hình 
@@ -29,7 +70,7 @@ static WheelAngularVel_ConfigType WheelAngularVel_CurrentConfig[WHEEL_NUMBERS];
  **************************************************************************/
 Std_ReturnType IoHwAb_WheelAngularVel_Init(const WheelAngularVel_ConfigType ConfigPtr[WHEEL_NUMBERS]) {
     if (ConfigPtr == NULL_PTR) {
-        printf("Error: Null configuration pointer passed to IoHwAb_WheelAngularVel_Init.\n");
+        LOG_ERROR(IOHWAB, "Error: Null configuration pointer passed to IoHwAb_WheelAngularVel_Init.\n");
         return E_NOT_OK;
     }
 
@@ -39,6 +80,15 @@ Std_ReturnType IoHwAb_WheelAngularVel_Init(const WheelAngularVel_ConfigType Conf
     for (i = 0; i < WHEEL_NUMBERS; i++) {
         WheelAngularVel_CurrentConfig[i].WheelAngularVel_Channel = ConfigPtr[i].WheelAngularVel_Channel;
         WheelAngularVel_CurrentConfig[i].WheelAngularVel_MaxValue = ConfigPtr[i].WheelAngularVel_MaxValue;
+
+        // Tính trước bảng tra: giá trị thô 0..1023 tương ứng 0..vận tốc góc tối đa
+        const IoHwAb_ConvPointType convPoints[] = {
+            {0, 0.0f},
+            {IOHWAB_CONV_RAW_MAX, (float32)ConfigPtr[i].WheelAngularVel_MaxValue}
+        };
+        if (IoHwAb_Conversion_BuildTable(&WheelAngularVel_ConvTable[i], convPoints, 2) != E_OK) {
+            return E_NOT_OK;
+        }
     }
 
     // Gọi API từ MCAL để khởi tạo ADC cho các cảm biến vận tốc góc
@@ -47,13 +97,30 @@ Std_ReturnType IoHwAb_WheelAngularVel_Init(const WheelAngularVel_ConfigType Conf
         adcConfig[i].Channel = ConfigPtr[i].WheelAngularVel_Channel;
         Adc_Init(&adcConfig[i]);
     }
+
+    // Gom các kênh vận tốc góc vào một nhóm để chuyển đổi trong cùng một lần
+    Adc_ChannelType adcChannels[WHEEL_NUMBERS];
+    for (i = 0; i < WHEEL_NUMBERS; i++) {
+        adcChannels[i] = ConfigPtr[i].WheelAngularVel_Channel;
+    }
+    Adc_GroupConfigType adcGroupConfig = {
+        .Channels = adcChannels,
+        .NumChannels = WHEEL_NUMBERS,
+        .Notification = IoHwAb_WheelAngularVel_Notification
+    };
+    if (Adc_SetupGroup(ADC_GROUP_WHEEL_ANGULAR_VEL, &adcGroupConfig) != E_OK ||
+        Adc_SetupResultBuffer(ADC_GROUP_WHEEL_ANGULAR_VEL, WheelAngularVel_AdcBuffer) != E_OK) {
+        LOG_ERROR(IOHWAB, "Error: Failed to set up ADC group for wheel angular velocity sensors.\n");
+        return E_NOT_OK;
+    }
+    Adc_EnableGroupNotification(ADC_GROUP_WHEEL_ANGULAR_VEL);
     
     // In ra thông tin cấu hình cảm biến vận tốc góc
-    printf("Wheel Angular Velocity Sensor Initialized with Configuration:\n");
+    LOG_INFO(IOHWAB, "Wheel Angular Velocity Sensor Initialized with Configuration:\n");
     for (i = 0; i < WHEEL_NUMBERS; i++) {
-        printf(" - ADC Channel: %d, Max Speed Value: %d rad/s\n", 
-                WheelAngularVel_CurrentConfig[i].WheelAngularVel_Channel, 
-                WheelAngularVel_CurrentConfig[i].WheelAngularVel_MaxValue);
+        LOG_INFO(IOHWAB, " - ADC Channel: %d, Max Speed Value: %d rad/s\n", 
+                          WheelAngularVel_CurrentConfig[i].WheelAngularVel_Channel, 
+                          WheelAngularVel_CurrentConfig[i].WheelAngularVel_MaxValue);
     }
     
     return E_OK;
@@ -69,25 +136,43 @@ Std_ReturnType IoHwAb_WheelAngularVel_Init(const WheelAngularVel_ConfigType Conf
 Std_ReturnType IoHwAb_WheelAngularVel_Read(float32 AngularVelocity[WHEEL_NUMBERS]) {
     uint8 i;
 
-    // Đọc giá trị từ kênh ADC
-    uint16 adcValue[WHEEL_NUMBERS] = {0};
-    for (i = 0; i < WHEEL_NUMBERS; i++) {
-        if (Adc_ReadChannel(WheelAngularVel_CurrentConfig[i].WheelAngularVel_Channel, &adcValue[i]) != E_OK) {
-            printf("Error: Failed to read ADC value in channel %d.\n", 
-                    WheelAngularVel_CurrentConfig[i].WheelAngularVel_Channel);
-            return E_NOT_OK;
-        }  
+    // Chuyển đổi tất cả các kênh vận tốc góc trong một lần chuyển đổi ADC
+    Adc_ValueGroupType adcValue[WHEEL_NUMBERS] = {0};
+    if (Adc_StartGroupConversion(ADC_GROUP_WHEEL_ANGULAR_VEL) != E_OK) {
+        return E_NOT_OK;
     }
 
-    // Chuyển đổi giá trị ADC sang vận tốc góc (giả lập)
+    // Chờ hàm thông báo từ ADC khi nhóm kênh chuyển đổi xong
+    pthread_mutex_lock(&WheelAngularVel_Lock);
+    if (Adc_GetGroupStatus(ADC_GROUP_WHEEL_ANGULAR_VEL) == ADC_BUSY) {
+        WheelAngularVel_Waiting = TRUE;
+        Os_TimeEndBusy();
+        while (WheelAngularVel_Waiting) {
+            pthread_cond_wait(&WheelAngularVel_ConversionDone, &WheelAngularVel_Lock);
+        }
+    }
+    pthread_mutex_unlock(&WheelAngularVel_Lock);
+
+    if (Adc_ReadGroup(ADC_GROUP_WHEEL_ANGULAR_VEL, adcValue) != E_OK) {
+        LOG_ERROR(IOHWAB, "Error: Failed to read ADC values of wheel angular velocity group.\n");
+        return E_NOT_OK;
+    }
+
+    // Chuyển đổi giá trị ADC của cả nhóm sang vận tốc góc bằng bảng tra của từng bánh xe
+    uint16 rawValue[WHEEL_NUMBERS];
+    IoHwAb_FixedType fixedValue[WHEEL_NUMBERS];
+    for (i = 0; i < WHEEL_NUMBERS; i++) {
+        rawValue[i] = (uint16)adcValue[i];
+    }
+    IoHwAb_Conversion_ConvertGroup(WheelAngularVel_ConvTables, rawValue, fixedValue, WHEEL_NUMBERS);
     for (i = 0; i < WHEEL_NUMBERS; i++) {
-        AngularVelocity[i] = ((float32)adcValue[i] / 1023.0f) * WheelAngularVel_CurrentConfig->WheelAngularVel_MaxValue; 
+        AngularVelocity[i] = IOHWAB_FIXED_TO_FLOAT(fixedValue[i]);
     }
 
     // In ra giá trị vận tốc góc
     for (i = 0; i < WHEEL_NUMBERS; i++) {
-        printf("Reading Angular Velocity Sensor (ADC Channel %d): Angular velocity = %.2f rad/s\n",
-                WheelAngularVel_CurrentConfig[i].WheelAngularVel_Channel, AngularVelocity[i]);
+        LOG_INFO(IOHWAB, "Reading Angular Velocity Sensor (ADC Channel %d): Angular velocity = %.2f rad/s\n",
+                          WheelAngularVel_CurrentConfig[i].WheelAngularVel_Channel, AngularVelocity[i]);
     }
     
     return E_OK;   
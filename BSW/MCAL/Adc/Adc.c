@@ -9,12 +9,39 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Adc.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Độ trễ đi qua thời gian hệ thống của OS
 
 /**************************************************************************
  * @brief Giả lập ADC hardware với các giá trị cấu hình
  **************************************************************************/
 static Adc_ConfigType Adc_CurrentConfig;  /* Lưu trữ cấu hình hiện tại của ADC */ 
 
+/**************************************************************************
+ * @struct  Adc_GroupStateType
+ * @brief 	Trạng thái giả lập của một nhóm kênh ADC
+ **************************************************************************/
+typedef struct {
+    Adc_ChannelType Channels[ADC_MAX_GROUP_CHANNELS];   /* Danh sách các kênh trong nhóm */
+    uint8 NumChannels;                                  /* Số kênh trong nhóm (0: chưa cấu hình) */
+    Adc_NotificationType Notification;                  /* Hàm thông báo khi chuyển đổi xong */
+    boolean NotificationEnabled;                        /* Hàm thông báo có được bật hay không */
+    Adc_ValueGroupType* ResultBuffer;                   /* Bộ đệm kết quả do người dùng khai báo */
+    Adc_StatusType Status;                              /* Trạng thái chuyển đổi của nhóm */
+    uint64 DoneNs;                                      /* Thời điểm chuyển đổi xong (thời gian hệ thống) */
+} Adc_GroupStateType;
+
+/**************************************************************************
+ * @brief Giả lập bộ chuyển đổi nhóm kênh: một luồng nền hoàn thành mỗi nhóm
+ *        sau ADC_CONVERSION_TIME_US kể từ lúc nhóm được yêu cầu
+ **************************************************************************/
+static Adc_GroupStateType Adc_Groups[ADC_MAX_GROUPS];
+static uint8 Adc_PendingGroupCount = 0;
+static boolean Adc_EngineBusy = FALSE;     /* Luồng chuyển đổi có đang được OS tính là đang chạy */
+static pthread_mutex_t Adc_GroupLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Adc_GroupPending = PTHREAD_COND_INITIALIZER;
+static pthread_once_t Adc_EngineOnce = PTHREAD_ONCE_INIT;
+
 /**************************************************************************
  * @brief 	Khởi tạo ADC 
  * @details	Hàm này được gọi để khởi tạo ADC với cấu hình được truyền vào.
@@ -24,7 +51,7 @@ static Adc_ConfigType Adc_CurrentConfig;  /* Lưu trữ cấu hình hiện tại
 void Adc_Init(const Adc_ConfigType* ConfigPtr) {
     // Kiểm tra con trỏ cấu hình 
     if (ConfigPtr == NULL) {
-        printf("Error: Null configuration pointer passed to Adc_Init.\n");
+        LOG_ERROR(ADC, "Error: Null configuration pointer passed to Adc_Init.\n");
         return;
     }
 
@@ -44,11 +71,11 @@ void Adc_Init(const Adc_ConfigType* ConfigPtr) {
     Adc_CurrentConfig.ConversionMode = (rand() % 2) ? ADC_CONV_MODE_SCAN : ADC_CONV_MODE_SINGLE;  // Giả lập chế độ chuyển đổi
 
     // In ra thông tin cấu hình ADC
-    printf("ADC Initialized with Configuration:\n");
+    LOG_INFO(ADC, "ADC Initialized with Configuration:\n");
     //printf(" - Channel: %d\n", Adc_CurrentConfig.Channel);
-    printf(" - Sampling Rate: %d MHz\n", Adc_CurrentConfig.SamplingTime);
-    printf(" - Resolution: %d-bit\n", Adc_CurrentConfig.Resolution);
-    printf(" - Conversion Mode: %s\n", (Adc_CurrentConfig.ConversionMode == ADC_CONV_MODE_SINGLE) ? "Single" : "Scan");
+    LOG_INFO(ADC, " - Sampling Rate: %d MHz\n", Adc_CurrentConfig.SamplingTime);
+    LOG_INFO(ADC, " - Resolution: %d-bit\n", Adc_CurrentConfig.Resolution);
+    LOG_INFO(ADC, " - Conversion Mode: %s\n", (Adc_CurrentConfig.ConversionMode == ADC_CONV_MODE_SINGLE) ? "Single" : "Scan");
 }
 
 /**************************************************************************
@@ -74,7 +101,7 @@ Std_ReturnType Adc_ReadChannel(Adc_ChannelType Channel, uint16* adcValue) {
     adc_value = rand() % 1024;
 
     // In giá trị đọc được từ kênh ADC
-    printf("Reading ADC Channel %d: Value = %d\n", Channel, adc_value);
+    LOG_DEBUG(ADC, "Reading ADC Channel %d: Value = %d\n", Channel, adc_value);
 
     // Trả giá trị đọc được thông qua tham chiếu
     *adcValue = adc_value;
@@ -82,12 +109,290 @@ Std_ReturnType Adc_ReadChannel(Adc_ChannelType Channel, uint16* adcValue) {
     return E_OK;  // Trả về E_OK nếu đọc thành công
 }
 
+/**************************************************************************
+ * @brief 	Luồng chuyển đổi nhóm kênh ADC
+ * @details	Luồng này chờ đến khi có nhóm kênh được yêu cầu chuyển đổi, ngủ
+ *          đến thời điểm xong của nhóm được yêu cầu sớm nhất, ghi kết quả vào
+ *          bộ đệm của các nhóm đã đến hạn và gọi hàm thông báo tương ứng.
+ *          Mỗi nhóm có thời điểm xong riêng nên nhóm được yêu cầu trong lúc
+ *          nhóm khác đang chuyển đổi không phải chờ thêm một lần chuyển đổi.
+ *          Luồng chạy SCHED_FIFO với độ ưu tiên ADC_CFG_ENGINE_RT_PRIORITY.
+ * @param   arg         Không sử dụng
+ * @return 	None
+ **************************************************************************/
+static void* Adc_GroupEngineMain(void* arg) {
+    Adc_NotificationType notifications[ADC_MAX_GROUPS];
+    uint64 done_ns;
+    uint64 now_ns;
+    uint8 i, j;
+
+    (void)arg;
+
+#if (ADC_CFG_ENGINE_RT_PRIORITY > 0)
+    // Không được phép dùng SCHED_FIFO thì chạy với lịch mặc định (OS đã cảnh báo)
+    struct sched_param param = {0};
+    param.sched_priority = ADC_CFG_ENGINE_RT_PRIORITY;
+    (void)pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+#endif
+
+    while (1) {
+        // Chờ đến khi có nhóm kênh cần chuyển đổi
+        pthread_mutex_lock(&Adc_GroupLock);
+        while (Adc_PendingGroupCount == 0) {
+            // Không còn nhóm nào cần chuyển đổi, trả lại lượt chạy cho thời gian hệ thống
+            if (Adc_EngineBusy) {
+                Adc_EngineBusy = FALSE;
+                Os_TimeEndBusy();
+            }
+            pthread_cond_wait(&Adc_GroupPending, &Adc_GroupLock);
+        }
+
+        // Mọi nhóm có cùng thời gian chuyển đổi nên nhóm được yêu cầu sau
+        // trong lúc ngủ luôn xong muộn hơn, không cần đánh thức luồng sớm
+        done_ns = UINT64_MAX;
+        for (i = 0; i < ADC_MAX_GROUPS; i++) {
+            if (Adc_Groups[i].Status == ADC_BUSY && Adc_Groups[i].DoneNs < done_ns) {
+                done_ns = Adc_Groups[i].DoneNs;
+            }
+        }
+        pthread_mutex_unlock(&Adc_GroupLock);
+
+        // Mô phỏng thời gian chuyển đổi của nhóm đến hạn sớm nhất
+        Os_SleepUntilNs(done_ns);
+
+        pthread_mutex_lock(&Adc_GroupLock);
+        now_ns = Os_GetTimeNs();
+        for (i = 0; i < ADC_MAX_GROUPS; i++) {
+            notifications[i] = NULL_PTR;
+
+            Adc_GroupStateType* group = &Adc_Groups[i];
+            if (group->Status != ADC_BUSY || group->DoneNs > now_ns) {
+                continue;
+            }
+
+            for (j = 0; j < group->NumChannels; j++) {
+                // Giả lập giá trị ngẫu nhiên từ 0 đến 1023 (giá trị ADC 10-bit)
+                group->ResultBuffer[j] = rand() % 1024;
+                LOG_DEBUG(ADC, "Reading ADC Channel %d: Value = %d\n", group->Channels[j], group->ResultBuffer[j]);
+            }
+            group->Status = ADC_STREAM_COMPLETED;
+            Adc_PendingGroupCount--;
+
+            if (group->NotificationEnabled) {
+                notifications[i] = group->Notification;
+            }
+        }
+        pthread_mutex_unlock(&Adc_GroupLock);
+
+        // Gọi hàm thông báo ngoài vùng khóa để hàm thông báo có thể gọi lại API của ADC
+        for (i = 0; i < ADC_MAX_GROUPS; i++) {
+            if (notifications[i] != NULL_PTR) {
+                notifications[i]();
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**************************************************************************
+ * @brief 	Khởi động luồng chuyển đổi nhóm kênh ADC (chỉ gọi một lần)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Adc_StartGroupEngine(void) {
+    pthread_t engine_thread;
+    if (pthread_create(&engine_thread, NULL, Adc_GroupEngineMain, NULL) != 0) {
+        LOG_ERROR(ADC, "Error: Failed to create ADC group conversion thread.\n");
+        return;
+    }
+    pthread_detach(engine_thread);
+}
+
+/**************************************************************************
+ * @brief 	Cấu hình một nhóm kênh ADC
+ * @details	Hàm này lưu danh sách kênh và hàm thông báo của nhóm, đồng thời
+ *          khởi động luồng chuyển đổi nhóm kênh nếu chưa được khởi động.
+ * @param   Group           Nhóm kênh ADC cần cấu hình
+ * @param   ConfigPtr       Con trỏ trỏ đến cấu hình nhóm kênh
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Adc_SetupGroup(Adc_GroupType Group, const Adc_GroupConfigType* ConfigPtr) {
+    if (Group >= ADC_MAX_GROUPS || ConfigPtr == NULL_PTR || ConfigPtr->Channels == NULL_PTR || 
+        ConfigPtr->NumChannels == 0 || ConfigPtr->NumChannels > ADC_MAX_GROUP_CHANNELS) {
+        LOG_ERROR(ADC, "Error: Invalid configuration passed to Adc_SetupGroup.\n");
+        return E_NOT_OK;
+    }
+
+    pthread_once(&Adc_EngineOnce, Adc_StartGroupEngine);
+
+    pthread_mutex_lock(&Adc_GroupLock);
+    Adc_GroupStateType* group = &Adc_Groups[Group];
+    if (group->Status == ADC_BUSY) {
+        pthread_mutex_unlock(&Adc_GroupLock);
+        return E_NOT_OK;
+    }
+
+    for (uint8 i = 0; i < ConfigPtr->NumChannels; i++) {
+        group->Channels[i] = ConfigPtr->Channels[i];
+    }
+    group->NumChannels = ConfigPtr->NumChannels;
+    group->Notification = ConfigPtr->Notification;
+    group->NotificationEnabled = FALSE;
+    group->Status = ADC_IDLE;
+    pthread_mutex_unlock(&Adc_GroupLock);
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief 	Khai báo bộ đệm lưu kết quả chuyển đổi của một nhóm kênh
+ * @details	Luồng chuyển đổi ghi kết quả trực tiếp vào bộ đệm này, mỗi kênh
+ *          trong nhóm tương ứng với một phần tử theo thứ tự cấu hình.
+ * @param   Group           Nhóm kênh ADC
+ * @param   DataBufferPtr   Bộ đệm kết quả (mỗi kênh trong nhóm một phần tử)
+ * @return 	Std_ReturnType  Trả về E_OK nếu khai báo thành công,
+ *                                 E_NOT_OK nếu nhóm kênh đang chuyển đổi hoặc không hợp lệ
+ **************************************************************************/
+Std_ReturnType Adc_SetupResultBuffer(Adc_GroupType Group, Adc_ValueGroupType* DataBufferPtr) {
+    if (Group >= ADC_MAX_GROUPS || DataBufferPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType status = E_NOT_OK;
+    pthread_mutex_lock(&Adc_GroupLock);
+    if (Adc_Groups[Group].NumChannels != 0 && Adc_Groups[Group].Status == ADC_IDLE) {
+        Adc_Groups[Group].ResultBuffer = DataBufferPtr;
+        status = E_OK;
+    }
+    pthread_mutex_unlock(&Adc_GroupLock);
+
+    return status;
+}
+
+/**************************************************************************
+ * @brief 	Bắt đầu chuyển đổi một nhóm kênh ADC (không chờ kết quả)
+ * @details	Hàm này chỉ đánh dấu nhóm kênh đang chờ chuyển đổi, ghi thời điểm
+ *          xong (sau ADC_CONVERSION_TIME_US) và đánh thức luồng chuyển đổi,
+ *          hàm trả về ngay mà không chờ kết quả.
+ * @param   Group           Nhóm kênh ADC cần chuyển đổi
+ * @return 	Std_ReturnType  Trả về E_OK nếu bắt đầu chuyển đổi thành công,
+ *                                 E_NOT_OK nếu nhóm kênh đang chuyển đổi hoặc không hợp lệ
+ **************************************************************************/
+Std_ReturnType Adc_StartGroupConversion(Adc_GroupType Group) {
+    if (Group >= ADC_MAX_GROUPS) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType status = E_NOT_OK;
+    pthread_mutex_lock(&Adc_GroupLock);
+    Adc_GroupStateType* group = &Adc_Groups[Group];
+    if (group->NumChannels != 0 && group->ResultBuffer != NULL_PTR && group->Status != ADC_BUSY) {
+        group->Status = ADC_BUSY;
+        group->DoneNs = Os_GetTimeNs() + (uint64)ADC_CONVERSION_TIME_US * 1000ULL;
+        Adc_PendingGroupCount++;
+        if (!Adc_EngineBusy) {
+            // Luồng chuyển đổi được tính là đang chạy ngay từ lúc có yêu cầu
+            Adc_EngineBusy = TRUE;
+            Os_TimeBeginBusy();
+        }
+        pthread_cond_signal(&Adc_GroupPending);
+        status = E_OK;
+    }
+    pthread_mutex_unlock(&Adc_GroupLock);
+
+    if (status != E_OK) {
+        LOG_ERROR(ADC, "Error: Failed to start conversion of ADC group %d.\n", Group);
+    }
+    return status;
+}
+
+/**************************************************************************
+ * @brief 	Đọc trạng thái chuyển đổi của một nhóm kênh ADC
+ * @param   Group           Nhóm kênh ADC
+ * @return 	Adc_StatusType  Trạng thái chuyển đổi hiện tại của nhóm kênh
+ **************************************************************************/
+Adc_StatusType Adc_GetGroupStatus(Adc_GroupType Group) {
+    if (Group >= ADC_MAX_GROUPS) {
+        return ADC_IDLE;
+    }
+
+    pthread_mutex_lock(&Adc_GroupLock);
+    Adc_StatusType status = Adc_Groups[Group].Status;
+    pthread_mutex_unlock(&Adc_GroupLock);
+
+    return status;
+}
+
+/**************************************************************************
+ * @brief 	Đọc kết quả chuyển đổi của một nhóm kênh ADC
+ * @details	Hàm này sao chép kết quả từ bộ đệm của nhóm và đưa nhóm về trạng
+ *          thái ADC_IDLE để có thể bắt đầu lần chuyển đổi tiếp theo.
+ * @param   Group           Nhóm kênh ADC
+ * @param   DataBufferPtr   Con trỏ lưu kết quả (mỗi kênh trong nhóm một phần tử)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc kết quả thành công,
+ *                                 E_NOT_OK nếu nhóm kênh chưa chuyển đổi xong
+ **************************************************************************/
+Std_ReturnType Adc_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType* DataBufferPtr) {
+    if (Group >= ADC_MAX_GROUPS || DataBufferPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType status = E_NOT_OK;
+    pthread_mutex_lock(&Adc_GroupLock);
+    Adc_GroupStateType* group = &Adc_Groups[Group];
+    if (group->Status == ADC_COMPLETED || group->Status == ADC_STREAM_COMPLETED) {
+        for (uint8 i = 0; i < group->NumChannels; i++) {
+            DataBufferPtr[i] = group->ResultBuffer[i];
+        }
+        group->Status = ADC_IDLE;
+        status = E_OK;
+    }
+    pthread_mutex_unlock(&Adc_GroupLock);
+
+    return status;
+}
+
+/**************************************************************************
+ * @brief 	Bật hàm thông báo của một nhóm kênh ADC
+ * @param   Group       Nhóm kênh ADC
+ * @return 	None
+ **************************************************************************/
+void Adc_EnableGroupNotification(Adc_GroupType Group) {
+    if (Group >= ADC_MAX_GROUPS) {
+        return;
+    }
+
+    pthread_mutex_lock(&Adc_GroupLock);
+    if (Adc_Groups[Group].Notification != NULL_PTR) {
+        Adc_Groups[Group].NotificationEnabled = TRUE;
+    }
+    pthread_mutex_unlock(&Adc_GroupLock);
+}
+
+/**************************************************************************
+ * @brief 	Tắt hàm thông báo của một nhóm kênh ADC
+ * @param   Group       Nhóm kênh ADC
+ * @return 	None
+ **************************************************************************/
+void Adc_DisableGroupNotification(Adc_GroupType Group) {
+    if (Group >= ADC_MAX_GROUPS) {
+        return;
+    }
+
+    pthread_mutex_lock(&Adc_GroupLock);
+    Adc_Groups[Group].NotificationEnabled = FALSE;
+    pthread_mutex_unlock(&Adc_GroupLock);
+}
+
 /**************************************************************************
  * @brief   Tạo độ trễ (delay)
- * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds).
+ * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds) theo
+ *          thời gian hệ thống của OS (thời gian thực, tăng tốc hoặc rời rạc).
  * @param   milliseconds    Thời gian độ trễ cần tạo (tính theo mili giây)
  * @return 	None  
  **************************************************************************/
 void Adc_Delay(uint32 milliseconds) {
-    usleep(milliseconds * 1000); // Hàm usleep tính theo micro giây, nhân với 1000 để thành mili giây
+    Os_Delay(milliseconds);
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include <stdlib.h>  // Thư viện hỗ trợ tạo giá trị ngẫu nhiên
 #include <time.h>    // Thư viện hỗ trợ thời gian (sử dụng cho random)
 #include <unistd.h>  // Thư viện hỗ trợ hàm sleep (sử dụng cho delay)
+#include <pthread.h> // Thư viện hỗ trợ luồng (sử dụng cho luồng chuyển đổi nhóm kênh)
 #include "Std_Types.h"
 
 /**************************************************************************
@@ -133,6 +134,67 @@ typedef struct {
     Adc_ConversionModeType ConversionMode;  /* Chế độ chuyển đổi ADC */
 } Adc_ConfigType;
 
+/**************************************************************************
+ * @brief Định nghĩa các nhóm kênh ADC được sử dụng trong hệ thống
+ **************************************************************************/
+#define ADC_GROUP_WHEEL_ANGULAR_VEL     (Adc_GroupType)0    /* Nhóm kênh cảm biến vận tốc góc bánh xe */
+#define ADC_GROUP_BATTERY               (Adc_GroupType)1    /* Nhóm kênh cảm biến trạng thái và nhiệt độ pin */
+#define ADC_GROUP_ACQUISITION_FIRST     (Adc_GroupType)2    /* Nhóm kênh đầu tiên của các tập thu thập IoHwAb */
+// Các nhóm kênh khác (nếu có)
+
+/**************************************************************************
+ * @brief Giới hạn số nhóm kênh, số kênh trong một nhóm và thời gian của
+ *        một lần chuyển đổi nhóm kênh ADC (giả lập, micro giây), ví dụ:
+ *        -DADC_CONVERSION_TIME_US=500. Phải nhỏ hơn chu kỳ của task nhanh
+ *        nhất có đọc nhóm kênh
+ **************************************************************************/
+#define ADC_MAX_GROUPS                  8
+#define ADC_MAX_GROUP_CHANNELS          8
+#ifndef ADC_CONVERSION_TIME_US
+#define ADC_CONVERSION_TIME_US          200
+#endif
+
+/**************************************************************************
+ * @brief Độ ưu tiên SCHED_FIFO của luồng chuyển đổi nhóm kênh (0: không dùng)
+ * @details Luồng giả lập phần cứng ADC vốn chạy song song với CPU, nên phải
+ *          cao hơn mọi task chờ kết quả, nếu không task đang chạy làm trễ kết
+ *          quả chuyển đổi của task khác.
+ **************************************************************************/
+#ifndef ADC_CFG_ENGINE_RT_PRIORITY
+#define ADC_CFG_ENGINE_RT_PRIORITY      85
+#endif
+
+/**************************************************************************
+ * @enum    Adc_StatusType
+ * @brief 	Định nghĩa trạng thái chuyển đổi của một nhóm kênh ADC
+ **************************************************************************/
+typedef enum {
+    ADC_IDLE = 0,               /* Chưa bắt đầu chuyển đổi hoặc đã đọc kết quả */
+    ADC_BUSY = 1,               /* Đang chuyển đổi */
+    ADC_COMPLETED = 2,          /* Đã chuyển đổi xong, kết quả sẵn sàng để đọc */
+    ADC_STREAM_COMPLETED = 3    /* Đã chuyển đổi xong toàn bộ bộ đệm kết quả */
+} Adc_StatusType;
+
+/**************************************************************************
+ * @typedef Adc_NotificationType
+ * @brief 	Định nghĩa kiểu hàm thông báo khi một nhóm kênh chuyển đổi xong
+ * @details Hàm thông báo được gọi từ luồng chuyển đổi của ADC, không được
+ *          gọi các hàm chặn trong thời gian dài.
+ **************************************************************************/
+typedef void (*Adc_NotificationType)(void);
+
+/**************************************************************************
+ * @struct  Adc_GroupConfigType
+ * @brief 	Định nghĩa cấu trúc cấu hình cho một nhóm kênh ADC
+ * @details	Tất cả các kênh trong nhóm được chuyển đổi trong cùng một lần
+ *          chuyển đổi của ADC.
+ **************************************************************************/
+typedef struct {
+    const Adc_ChannelType* Channels;        /* Danh sách các kênh trong nhóm */
+    uint8 NumChannels;                      /* Số kênh trong nhóm */
+    Adc_NotificationType Notification;      /* Hàm thông báo khi chuyển đổi xong (có thể NULL) */
+} Adc_GroupConfigType;
+
 /**************************************************************************
  * @brief 	Khởi tạo ADC 
  * @param   ConfigPtr    Con trỏ trỏ đến cấu hình ADC
@@ -149,6 +211,62 @@ void Adc_Init(const Adc_ConfigType* ConfigPtr);
  **************************************************************************/
 Std_ReturnType Adc_ReadChannel(Adc_ChannelType Channel, uint16* adcValue);
 
+/**************************************************************************
+ * @brief 	Cấu hình một nhóm kênh ADC
+ * @param   Group           Nhóm kênh ADC cần cấu hình
+ * @param   ConfigPtr       Con trỏ trỏ đến cấu hình nhóm kênh
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Adc_SetupGroup(Adc_GroupType Group, const Adc_GroupConfigType* ConfigPtr);
+
+/**************************************************************************
+ * @brief 	Khai báo bộ đệm lưu kết quả chuyển đổi của một nhóm kênh
+ * @param   Group           Nhóm kênh ADC
+ * @param   DataBufferPtr   Bộ đệm kết quả (mỗi kênh trong nhóm một phần tử)
+ * @return 	Std_ReturnType  Trả về E_OK nếu khai báo thành công,
+ *                                 E_NOT_OK nếu nhóm kênh đang chuyển đổi hoặc không hợp lệ
+ **************************************************************************/
+Std_ReturnType Adc_SetupResultBuffer(Adc_GroupType Group, Adc_ValueGroupType* DataBufferPtr);
+
+/**************************************************************************
+ * @brief 	Bắt đầu chuyển đổi một nhóm kênh ADC (không chờ kết quả)
+ * @param   Group           Nhóm kênh ADC cần chuyển đổi
+ * @return 	Std_ReturnType  Trả về E_OK nếu bắt đầu chuyển đổi thành công,
+ *                                 E_NOT_OK nếu nhóm kênh đang chuyển đổi hoặc không hợp lệ
+ **************************************************************************/
+Std_ReturnType Adc_StartGroupConversion(Adc_GroupType Group);
+
+/**************************************************************************
+ * @brief 	Đọc trạng thái chuyển đổi của một nhóm kênh ADC
+ * @param   Group           Nhóm kênh ADC
+ * @return 	Adc_StatusType  Trạng thái chuyển đổi hiện tại của nhóm kênh
+ **************************************************************************/
+Adc_StatusType Adc_GetGroupStatus(Adc_GroupType Group);
+
+/**************************************************************************
+ * @brief 	Đọc kết quả chuyển đổi của một nhóm kênh ADC
+ * @param   Group           Nhóm kênh ADC
+ * @param   DataBufferPtr   Con trỏ lưu kết quả (mỗi kênh trong nhóm một phần tử)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc kết quả thành công,
+ *                                 E_NOT_OK nếu nhóm kênh chưa chuyển đổi xong
+ **************************************************************************/
+Std_ReturnType Adc_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType* DataBufferPtr);
+
+/**************************************************************************
+ * @brief 	Bật hàm thông báo của một nhóm kênh ADC
+ * @param   Group       Nhóm kênh ADC
+ * @return 	None
+ **************************************************************************/
+void Adc_EnableGroupNotification(Adc_GroupType Group);
+
+/**************************************************************************
+ * @brief 	Tắt hàm thông báo của một nhóm kênh ADC
+ * @param   Group       Nhóm kênh ADC
+ * @return 	None
+ **************************************************************************/
+void Adc_DisableGroupNotification(Adc_GroupType Group);
+
 /**************************************************************************
  * @brief   Tạo độ trễ (delay)
  * @param   milliseconds    Thời gian độ trễ cần tạo (tính theo mili giây)
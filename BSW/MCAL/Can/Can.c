@@ -9,6 +9,246 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Can.h"
+#include "Can_VirtualBus.h"   // Bus CAN ảo giữa nhiều tiến trình ECU
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Độ trễ đi qua thời gian hệ thống của OS
+#include <stdatomic.h>
+#include <string.h>
+
+/**************************************************************************
+ * @brief Chuỗi định dạng thông điệp CAN theo độ dài dữ liệu (0 - 8 byte)
+ **************************************************************************/
+static const char* const Can_MessageFormats[9] = {
+    "ID: %d, Data Length: %d, Data: []\n",
+    "ID: %d, Data Length: %d, Data: [%d]\n",
+    "ID: %d, Data Length: %d, Data: [%d, %d]\n",
+    "ID: %d, Data Length: %d, Data: [%d, %d, %d]\n",
+    "ID: %d, Data Length: %d, Data: [%d, %d, %d, %d]\n",
+    "ID: %d, Data Length: %d, Data: [%d, %d, %d, %d, %d]\n",
+    "ID: %d, Data Length: %d, Data: [%d, %d, %d, %d, %d, %d]\n",
+    "ID: %d, Data Length: %d, Data: [%d, %d, %d, %d, %d, %d, %d]\n",
+    "ID: %d, Data Length: %d, Data: [%d, %d, %d, %d, %d, %d, %d, %d]\n"
+};
+
+/**************************************************************************
+ * @struct  Can_QueueEntryType
+ * @brief   Cấu trúc một thông điệp trong hàng đợi của hardware object
+ * @details Dữ liệu của thông điệp nằm trong bộ đệm PDU, hàng đợi chỉ giữ
+ *          handle (và một tham chiếu) của bộ đệm.
+ **************************************************************************/
+typedef struct {
+    PduIdType PduId;            /* ID của PDU (chỉ dùng cho mailbox gửi) */
+    Can_IdType Id;              /* ID của thông điệp CAN */
+    PduBuf_HandleType Buffer;   /* Bộ đệm chứa dữ liệu (PDUBUF_INVALID_HANDLE nếu không có) */
+} Can_QueueEntryType;
+
+/**************************************************************************
+ * @struct  Can_QueueSlotType
+ * @brief   Cấu trúc một phần tử trong hàng đợi của hardware object
+ * @details Sequence cho biết phần tử đang trống (bằng vị trí ghi) hay đã có
+ *          dữ liệu (bằng vị trí ghi + 1).
+ **************************************************************************/
+typedef struct {
+    atomic_uint Sequence;       /* Bộ đếm trạng thái của phần tử */
+    Can_QueueEntryType Entry;   /* Thông điệp */
+} Can_QueueSlotType;
+
+/**************************************************************************
+ * @struct  Can_QueueType
+ * @brief   Hàng đợi vòng có giới hạn, không khóa, nhiều luồng ghi và nhiều
+ *          luồng đọc
+ **************************************************************************/
+typedef struct {
+    atomic_uint Head;                           /* Vị trí ghi tiếp theo */
+    atomic_uint Tail;                           /* Vị trí đọc tiếp theo */
+    Can_QueueSlotType Slots[CAN_QUEUE_SIZE];    /* Các phần tử */
+} Can_QueueType;
+
+/**************************************************************************
+ * @struct  Can_HardwareObjectType
+ * @brief   Cấu trúc lưu trạng thái nội bộ của một hardware object
+ **************************************************************************/
+typedef struct {
+    Can_HardwareObjectConfigType Config;    /* Cấu hình của hardware object */
+    boolean Configured;                     /* Hardware object đã được cấu hình hay chưa */
+    Can_QueueType Queue;                    /* Hàng đợi thông điệp */
+    Can_QueueType Confirmations;            /* Hàng đợi xác nhận gửi xong (mailbox gửi, bus ảo) */
+    atomic_uint Overruns;                   /* Số thông điệp bị bỏ do hàng đợi đầy */
+} Can_HardwareObjectType;
+
+static Can_HardwareObjectType Can_HardwareObjects[CAN_MAX_HW_OBJECTS];
+
+/**************************************************************************
+ * @brief Hàm báo có thông điệp mới trong mailbox nhận (NULL nếu không dùng)
+ **************************************************************************/
+static _Atomic(Can_RxNotificationType) Can_RxNotification = NULL_PTR;
+
+/**************************************************************************
+ * @brief   Xóa hàng đợi
+ * @param   queue       Con trỏ đến hàng đợi
+ * @return 	None
+ **************************************************************************/
+static void Can_QueueReset(Can_QueueType* queue) {
+    atomic_store_explicit(&queue->Head, 0, memory_order_relaxed);
+    atomic_store_explicit(&queue->Tail, 0, memory_order_relaxed);
+    for (uint32 i = 0; i < CAN_QUEUE_SIZE; i++) {
+        atomic_store_explicit(&queue->Slots[i].Sequence, i, memory_order_relaxed);
+    }
+}
+
+/**************************************************************************
+ * @brief   Đưa một thông điệp vào hàng đợi
+ * @param   queue           Con trỏ đến hàng đợi
+ * @param   entry           Con trỏ đến thông điệp
+ * @return 	Std_ReturnType  Trả về E_OK nếu thành công,
+ *                                 E_NOT_OK nếu hàng đợi đầy
+ **************************************************************************/
+static Std_ReturnType Can_QueuePush(Can_QueueType* queue, const Can_QueueEntryType* entry) {
+    Can_QueueSlotType* slot;
+    uint32 pos = atomic_load_explicit(&queue->Head, memory_order_relaxed);
+
+    for (;;) {
+        slot = &queue->Slots[pos & (CAN_QUEUE_SIZE - 1)];
+        uint32 seq = atomic_load_explicit(&slot->Sequence, memory_order_acquire);
+        sint32 diff = (sint32)(seq - pos);
+
+        if (diff == 0) {
+            // Phần tử trống, giành vị trí ghi
+            if (atomic_compare_exchange_weak_explicit(&queue->Head, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return E_NOT_OK;    // Hàng đợi đầy
+        } else {
+            pos = atomic_load_explicit(&queue->Head, memory_order_relaxed);
+        }
+    }
+
+    slot->Entry = *entry;
+    atomic_store_explicit(&slot->Sequence, pos + 1, memory_order_release);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Lấy thông điệp cũ nhất ra khỏi hàng đợi
+ * @param   queue           Con trỏ đến hàng đợi
+ * @param   entry           Con trỏ lưu thông điệp
+ * @return 	Std_ReturnType  Trả về E_OK nếu thành công,
+ *                                 E_NOT_OK nếu hàng đợi rỗng
+ **************************************************************************/
+static Std_ReturnType Can_QueuePop(Can_QueueType* queue, Can_QueueEntryType* entry) {
+    Can_QueueSlotType* slot;
+    uint32 pos = atomic_load_explicit(&queue->Tail, memory_order_relaxed);
+
+    for (;;) {
+        slot = &queue->Slots[pos & (CAN_QUEUE_SIZE - 1)];
+        uint32 seq = atomic_load_explicit(&slot->Sequence, memory_order_acquire);
+        sint32 diff = (sint32)(seq - (pos + 1));
+
+        if (diff == 0) {
+            // Phần tử có dữ liệu, giành vị trí đọc
+            if (atomic_compare_exchange_weak_explicit(&queue->Tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return E_NOT_OK;    // Hàng đợi rỗng
+        } else {
+            pos = atomic_load_explicit(&queue->Tail, memory_order_relaxed);
+        }
+    }
+
+    *entry = slot->Entry;
+    atomic_store_explicit(&slot->Sequence, pos + CAN_QUEUE_SIZE, memory_order_release);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc thông điệp cũ nhất trong hàng đợi mà không lấy ra
+ * @details Chỉ dùng khi hàng đợi có duy nhất một luồng đọc (hàng đợi của
+ *          mailbox gửi chỉ được đọc bởi Can_MainFunction_Write).
+ * @param   queue           Con trỏ đến hàng đợi
+ * @param   entry           Con trỏ lưu thông điệp
+ * @return 	Std_ReturnType  Trả về E_OK nếu thành công,
+ *                                 E_NOT_OK nếu hàng đợi rỗng
+ **************************************************************************/
+static Std_ReturnType Can_QueuePeek(Can_QueueType* queue, Can_QueueEntryType* entry) {
+    uint32 pos = atomic_load_explicit(&queue->Tail, memory_order_relaxed);
+    Can_QueueSlotType* slot = &queue->Slots[pos & (CAN_QUEUE_SIZE - 1)];
+
+    if (atomic_load_explicit(&slot->Sequence, memory_order_acquire) != pos + 1) {
+        return E_NOT_OK;    // Hàng đợi rỗng
+    }
+
+    *entry = slot->Entry;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đưa một bộ đệm PDU vào mailbox nhận đầu tiên có bộ lọc ID phù hợp
+ * @details Hàng đợi của mailbox nhận giữ một tham chiếu của bộ đệm.
+ * @param   id              ID của thông điệp CAN
+ * @param   buffer          Bộ đệm chứa dữ liệu của thông điệp
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được đưa vào mailbox nhận,
+ *                                 E_NOT_OK nếu không có mailbox phù hợp hoặc hàng đợi đầy
+ **************************************************************************/
+static Std_ReturnType Can_DeliverToMailbox(Can_IdType id, PduBuf_HandleType buffer) {
+    for (Can_HwHandleType hrh = 0; hrh < CAN_MAX_HW_OBJECTS; hrh++) {
+        Can_HardwareObjectType* hoh = &Can_HardwareObjects[hrh];
+        if (!hoh->Configured || hoh->Config.ObjectType != CAN_OBJECT_TYPE_RECEIVE) {
+            continue;
+        }
+        if ((id & hoh->Config.IdMask) != (hoh->Config.IdValue & hoh->Config.IdMask)) {
+            continue;
+        }
+
+        Can_QueueEntryType entry = {0, id, buffer};
+        PduBuf_Retain(buffer);
+        if (Can_QueuePush(&hoh->Queue, &entry) != E_OK) {
+            PduBuf_Release(buffer);
+            atomic_fetch_add_explicit(&hoh->Overruns, 1, memory_order_relaxed);
+            return E_NOT_OK;
+        }
+
+        Can_RxNotificationType notification = atomic_load_explicit(&Can_RxNotification, memory_order_acquire);
+        if (notification != NULL_PTR) {
+            notification();
+        }
+        return E_OK;
+    }
+
+    return E_NOT_OK;
+}
+
+/**************************************************************************
+ * @brief   Sao chép dữ liệu từ bộ đệm PDU ra thông điệp CAN
+ * @param   entry       Con trỏ đến thông điệp trong hàng đợi
+ * @param   message     Con trỏ lưu thông điệp CAN
+ * @return 	None
+ **************************************************************************/
+static void Can_EntryToMessage(const Can_QueueEntryType* entry, Can_MessageType* message) {
+    PduInfoType info = {NULL_PTR, 0};
+
+    PduBuf_GetInfo(entry->Buffer, &info);
+    message->id = entry->Id;
+    message->length = (uint8)info.SduLength;
+    memcpy(message->data, info.SduDataPtr, info.SduLength);
+}
+
+/**************************************************************************
+ * @brief   Ghi log nội dung một thông điệp CAN
+ * @details Toàn bộ thông điệp được ghi trong một bản ghi log thay vì in
+ *          từng byte.
+ * @param   message     Con trỏ đến thông điệp CAN cần ghi log
+ * @return 	None
+ **************************************************************************/
+static void Can_LogMessage(const Can_MessageType* message) {
+    uint8 length = (message->length <= 8) ? message->length : 8;
+    LOG_DEBUG(CAN, Can_MessageFormats[length], message->id, message->length,
+              message->data[0], message->data[1], message->data[2], message->data[3],
+              message->data[4], message->data[5], message->data[6], message->data[7]);
+}
 
 /**************************************************************************
  * @brief   Khởi tạo CAN
@@ -17,41 +257,293 @@
  * @return 	None  
  **************************************************************************/
 void Can_Init() {
-    printf("CAN Initialized.\n");
+    static const Can_HardwareObjectConfigType default_tx = {CAN_OBJECT_TYPE_TRANSMIT, 0, 0, NULL_PTR, NULL_PTR};
+    static const Can_HardwareObjectConfigType default_rx = {CAN_OBJECT_TYPE_RECEIVE, 0, 0, NULL_PTR, NULL_PTR};
+
+    for (Can_HwHandleType hoh = 0; hoh < CAN_MAX_HW_OBJECTS; hoh++) {
+        Can_HardwareObjects[hoh].Configured = FALSE;
+        Can_QueueReset(&Can_HardwareObjects[hoh].Queue);
+        Can_QueueReset(&Can_HardwareObjects[hoh].Confirmations);
+        atomic_store_explicit(&Can_HardwareObjects[hoh].Overruns, 0, memory_order_relaxed);
+    }
+    Can_SetupHardwareObject(CAN_HOH_TX_DEFAULT, &default_tx);
+    Can_SetupHardwareObject(CAN_HOH_RX_DEFAULT, &default_rx);
+
+    LOG_INFO(CAN, "CAN Initialized.\n");
+}
+
+/**************************************************************************
+ * @brief   Cấu hình một hardware object (gọi trước khi bắt đầu lập lịch)
+ * @details Hàm này lưu cấu hình và xóa hàng đợi của hardware object.
+ * @param   Hoh             Hardware object cần cấu hình
+ * @param   ConfigPtr       Con trỏ đến cấu hình hardware object
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Can_SetupHardwareObject(Can_HwHandleType Hoh, const Can_HardwareObjectConfigType* ConfigPtr) {
+    if (Hoh >= CAN_MAX_HW_OBJECTS || ConfigPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    if (ConfigPtr->ObjectType != CAN_OBJECT_TYPE_TRANSMIT && ConfigPtr->ObjectType != CAN_OBJECT_TYPE_RECEIVE) {
+        return E_NOT_OK;
+    }
+
+    Can_HardwareObjects[Hoh].Config = *ConfigPtr;
+    Can_QueueReset(&Can_HardwareObjects[Hoh].Queue);
+    Can_QueueReset(&Can_HardwareObjects[Hoh].Confirmations);
+    Can_HardwareObjects[Hoh].Configured = TRUE;
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đưa một thông điệp vào hàng đợi của mailbox gửi (không chờ)
+ * @details Thông điệp được gửi lên bus trong lần gọi Can_MainFunction_Write
+ *          tiếp theo, sau đó hàm TxConfirmation của mailbox được gọi với
+ *          TxPduId. Hàm có thể được gọi đồng thời từ nhiều task. Dữ liệu
+ *          được chép vào một bộ đệm PDU, tầng trên đã có sẵn bộ đệm nên
+ *          dùng Can_WriteBuffer để tránh sao chép.
+ * @param   Hth             Mailbox gửi
+ * @param   TxPduId         ID của PDU, được trả lại qua hàm TxConfirmation
+ * @param   message         Con trỏ đến thông điệp CAN cần gửi
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu hàng đợi đầy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Can_Write(Can_HwHandleType Hth, PduIdType TxPduId, const Can_MessageType* message) {
+    PduBuf_HandleType buffer;
+    PduInfoType info;
+
+    if (message == NULL_PTR || message->length > 8) {
+        return E_NOT_OK;
+    }
+    if (PduBuf_Alloc(message->length, &buffer) != E_OK) {
+        return E_NOT_OK;
+    }
+
+    PduBuf_GetInfo(buffer, &info);
+    memcpy(info.SduDataPtr, message->data, message->length);
+
+    Std_ReturnType ret = Can_WriteBuffer(Hth, TxPduId, message->id, buffer);
+    PduBuf_Release(buffer);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Đưa một bộ đệm PDU vào hàng đợi của mailbox gửi (không chờ)
+ * @details Hàng đợi giữ một tham chiếu của bộ đệm cho đến khi thông điệp
+ *          được gửi, người gọi vẫn giữ tham chiếu của mình. Dữ liệu không
+ *          bị sao chép cho đến khi thông điệp được gửi lên bus.
+ * @param   Hth             Mailbox gửi
+ * @param   TxPduId         ID của PDU, được trả lại qua hàm TxConfirmation
+ * @param   CanId           ID của thông điệp CAN
+ * @param   Buffer          Bộ đệm chứa dữ liệu (tối đa 8 byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu hàng đợi đầy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Can_WriteBuffer(Can_HwHandleType Hth, PduIdType TxPduId, Can_IdType CanId, PduBuf_HandleType Buffer) {
+    PduInfoType info;
+
+    if (Hth >= CAN_MAX_HW_OBJECTS || PduBuf_GetInfo(Buffer, &info) != E_OK || info.SduLength > 8) {
+        return E_NOT_OK;
+    }
+
+    Can_HardwareObjectType* hoh = &Can_HardwareObjects[Hth];
+    if (!hoh->Configured || hoh->Config.ObjectType != CAN_OBJECT_TYPE_TRANSMIT) {
+        return E_NOT_OK;
+    }
+
+    Can_QueueEntryType entry = {TxPduId, CanId, Buffer};
+    PduBuf_Retain(Buffer);
+    if (Can_QueuePush(&hoh->Queue, &entry) != E_OK) {
+        PduBuf_Release(Buffer);
+        atomic_fetch_add_explicit(&hoh->Overruns, 1, memory_order_relaxed);
+        return E_NOT_OK;
+    }
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Gửi các thông điệp đang chờ trong các mailbox gửi
+ * @details Mỗi lần gọi gửi tối đa CAN_MAIN_FUNCTION_BATCH thông điệp, lần
+ *          lượt từ các mailbox gửi theo thứ tự ID của mailbox. Khi ECU nối
+ *          vào bus CAN ảo, thông điệp được chuyển sang bus để phân xử và
+ *          TxConfirmation được gọi khi thông điệp đã lên bus. Nếu không, ở
+ *          chế độ loopback thông điệp được đưa vào các mailbox nhận của ECU.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Can_MainFunction_Write() {
+    Can_MessageType message;
+    Can_QueueEntryType entry;
+    uint32 sent = 0;
+
+    for (Can_HwHandleType hth = 0; hth < CAN_MAX_HW_OBJECTS && sent < CAN_MAIN_FUNCTION_BATCH; hth++) {
+        Can_HardwareObjectType* hoh = &Can_HardwareObjects[hth];
+        if (!hoh->Configured || hoh->Config.ObjectType != CAN_OBJECT_TYPE_TRANSMIT) {
+            continue;
+        }
+
+        if (Can_VirtualBus_IsAttached()) {
+            while (sent < CAN_MAIN_FUNCTION_BATCH && Can_QueuePeek(&hoh->Queue, &entry) == E_OK) {
+                Can_EntryToMessage(&entry, &message);
+                if (Can_VirtualBus_Transmit(hth, entry.PduId, &message) != E_OK) {
+                    break;  // Bộ đệm gửi của node đầy, gửi lại ở lần gọi sau
+                }
+                Can_QueuePop(&hoh->Queue, &entry);
+                PduBuf_Release(entry.Buffer);
+                sent++;
+            }
+            while (Can_QueuePop(&hoh->Confirmations, &entry) == E_OK) {
+                if (hoh->Config.TxConfirmation != NULL_PTR) {
+                    hoh->Config.TxConfirmation(entry.PduId);
+                }
+            }
+            continue;
+        }
+
+        while (sent < CAN_MAIN_FUNCTION_BATCH && Can_QueuePop(&hoh->Queue, &entry) == E_OK) {
+            sent++;
+#if (CAN_CFG_LOOPBACK == 1)
+            // Mailbox nhận dùng chung bộ đệm với mailbox gửi, không sao chép
+            Can_DeliverToMailbox(entry.Id, entry.Buffer);
+#endif
+            PduBuf_Release(entry.Buffer);
+            if (hoh->Config.TxConfirmation != NULL_PTR) {
+                hoh->Config.TxConfirmation(entry.PduId);
+            }
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Chuyển các thông điệp đã nhận trong các mailbox nhận lên tầng trên
+ * @details Mỗi lần gọi xử lý tối đa CAN_MAIN_FUNCTION_BATCH thông điệp và
+ *          gọi hàm RxIndication của mailbox nhận cho từng thông điệp. Bộ đệm
+ *          được trả lại sau khi RxIndication kết thúc, tầng trên cần giữ
+ *          bộ đệm lâu hơn phải gọi PduBuf_Retain.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Can_MainFunction_Read() {
+    Can_QueueEntryType entry;
+    uint32 received = 0;
+
+    for (Can_HwHandleType hrh = 0; hrh < CAN_MAX_HW_OBJECTS && received < CAN_MAIN_FUNCTION_BATCH; hrh++) {
+        Can_HardwareObjectType* hoh = &Can_HardwareObjects[hrh];
+        if (!hoh->Configured || hoh->Config.ObjectType != CAN_OBJECT_TYPE_RECEIVE) {
+            continue;
+        }
+
+        while (received < CAN_MAIN_FUNCTION_BATCH && Can_QueuePop(&hoh->Queue, &entry) == E_OK) {
+            received++;
+            if (hoh->Config.RxIndication != NULL_PTR) {
+                hoh->Config.RxIndication(hrh, entry.Id, entry.Buffer);
+            }
+            PduBuf_Release(entry.Buffer);
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Đăng ký hàm báo có thông điệp mới trong mailbox nhận
+ * @details Khi có hàm thông báo, tầng trên có thể gọi Can_MainFunction_Read
+ *          ngay khi nhận được thông điệp thay vì chờ chu kỳ tiếp theo.
+ * @param   Notification    Hàm thông báo (NULL để tắt)
+ * @return 	None
+ **************************************************************************/
+void Can_SetRxNotification(Can_RxNotificationType Notification) {
+    atomic_store_explicit(&Can_RxNotification, Notification, memory_order_release);
+}
+
+/**************************************************************************
+ * @brief   Đưa một thông điệp trên bus vào mailbox nhận phù hợp
+ * @details Hàm này mô phỏng phần cứng CAN nhận một thông điệp từ bus: dữ
+ *          liệu được chép một lần duy nhất vào bộ đệm PDU (như DMA), bộ đệm
+ *          được đưa vào mailbox nhận đầu tiên có bộ lọc ID phù hợp.
+ * @param   message         Con trỏ đến thông điệp CAN nhận được
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được đưa vào mailbox nhận,
+ *                                 E_NOT_OK nếu không có mailbox phù hợp, hàng đợi
+ *                                 đầy hoặc hết bộ đệm PDU
+ **************************************************************************/
+Std_ReturnType Can_SimulateReception(const Can_MessageType* message) {
+    PduBuf_HandleType buffer;
+    PduInfoType info;
+
+    if (message == NULL_PTR || message->length > 8) {
+        return E_NOT_OK;
+    }
+    if (PduBuf_Alloc(message->length, &buffer) != E_OK) {
+        return E_NOT_OK;
+    }
+
+    PduBuf_GetInfo(buffer, &info);
+    memcpy(info.SduDataPtr, message->data, message->length);
+
+    Std_ReturnType ret = Can_DeliverToMailbox(message->id, buffer);
+    PduBuf_Release(buffer);
+    return ret;
 }
 
 /**************************************************************************
- * @brief   Gửi thông điệp CAN
- * @details Hàm này gửi một thông điệp CAN, bao gồm ID, dữ liệu và độ dài 
- *          của dữ liệu.
+ * @brief   Báo một thông điệp của mailbox gửi đã được gửi lên bus
+ * @details Hàm này mô phỏng ngắt gửi xong của phần cứng CAN, hàm
+ *          TxConfirmation được gọi trong lần gọi Can_MainFunction_Write tiếp theo.
+ * @param   Hth             Mailbox gửi chứa thông điệp
+ * @param   TxPduId         ID của PDU đã được gửi
+ * @return 	None
+ **************************************************************************/
+void Can_ConfirmTransmission(Can_HwHandleType Hth, PduIdType TxPduId) {
+    if (Hth >= CAN_MAX_HW_OBJECTS || Can_HardwareObjects[Hth].Config.ObjectType != CAN_OBJECT_TYPE_TRANSMIT) {
+        return;
+    }
+    Can_QueueEntryType entry = {TxPduId, 0, PDUBUF_INVALID_HANDLE};
+    if (Can_QueuePush(&Can_HardwareObjects[Hth].Confirmations, &entry) != E_OK) {
+        atomic_fetch_add_explicit(&Can_HardwareObjects[Hth].Overruns, 1, memory_order_relaxed);
+    }
+}
+
+/**************************************************************************
+ * @brief   Đọc số thông điệp bị bỏ do hàng đợi của hardware object bị đầy
+ * @param   Hoh         Hardware object
+ * @return 	uint32      Số thông điệp bị bỏ (0 nếu Hoh không hợp lệ)
+ **************************************************************************/
+uint32 Can_GetOverrunCount(Can_HwHandleType Hoh) {
+    if (Hoh >= CAN_MAX_HW_OBJECTS) {
+        return 0;
+    }
+    return atomic_load_explicit(&Can_HardwareObjects[Hoh].Overruns, memory_order_relaxed);
+}
+
+/**************************************************************************
+ * @brief   Gửi thông điệp CAN qua mailbox gửi mặc định
+ * @details Hàm này đưa một thông điệp CAN, bao gồm ID, dữ liệu và độ dài 
+ *          của dữ liệu vào hàng đợi của CAN_HOH_TX_DEFAULT, thông điệp được
+ *          gửi trong lần gọi Can_MainFunction_Write tiếp theo.
  * @param   message     Con trỏ đến thông điệp CAN cần gửi
  * @return 	None  
  **************************************************************************/
 void Can_SendMessage(Can_MessageType* message) {
-    // Gọi hàm delay để mô phỏng thời gian gửi CAN
-    Can_Delay(200);  // Tạo độ trễ 200ms để mô phỏng
+    if (Can_Write(CAN_HOH_TX_DEFAULT, 0, message) != E_OK) {
+        LOG_WARN(CAN, "CAN Message Dropped (TX queue full):\n");
+        Can_LogMessage(message);
+        return;
+    }
 
     // In ra thông tin thông điệp được gửi
-    printf("CAN Message Sent:\n");
-    printf("ID: %d, Data Length: %d, Data: [", message->id, message->length);
-    for (int i = 0; i < message->length; i++) {
-        printf("%d", message->data[i]);
-        if (i < message->length - 1) printf(", ");
-    }
-    printf("]\n");
+    LOG_DEBUG(CAN, "CAN Message Queued:\n");
+    Can_LogMessage(message);
 }
 
 /**************************************************************************
  * @brief   Nhận thông điệp CAN
- * @details Hàm này nhận một thông điệp CAN (giả lập nhận ngẫu nhiên).
+ * @details Hàm này giả lập một node khác gửi thông điệp ngẫu nhiên lên bus,
+ *          thông điệp được đưa vào mailbox nhận phù hợp và được trả về.
  * @param   None
  * @return 	Can_MessageType    Thông điệp CAN nhận được  
  **************************************************************************/
 Can_MessageType Can_ReceiveMessage() {
-    Can_MessageType message;
-
-    // Gọi hàm delay để mô phỏng thời gian nhận CAN
-    Can_Delay(300);  // Tạo độ trễ 300ms để mô phỏng
+    Can_MessageType message = {0};
 
     // Giả lập dữ liệu ngẫu nhiên cho thông điệp CAN
     message.id = rand() % 2048;  // Giả lập ID ngẫu nhiên từ 0 đến 2047 (CAN Standard 11-bit)
@@ -60,24 +552,23 @@ Can_MessageType Can_ReceiveMessage() {
         message.data[i] = rand() % 256;  // Giả lập dữ liệu ngẫu nhiên từ 0 đến 255 (0 - 8 byte)
     }
 
+    // Đưa thông điệp vào mailbox nhận như khi phần cứng nhận từ bus
+    Can_SimulateReception(&message);
+
     // In ra thông tin thông điệp nhận được
-    printf("CAN Message Received:\n");
-    printf("ID: %d, Data Length: %d, Data: [", message.id, message.length);
-    for (int i = 0; i < message.length; i++) {
-        printf("%d", message.data[i]);
-        if (i < message.length - 1) printf(", ");
-    }
-    printf("]\n");
+    LOG_DEBUG(CAN, "CAN Message Received:\n");
+    Can_LogMessage(&message);
 
     return message;
 }
 
 /**************************************************************************
  * @brief   Tạo độ trễ (delay)
- * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds).
+ * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds) theo
+ *          thời gian hệ thống của OS (thời gian thực, tăng tốc hoặc rời rạc).
  * @param   milliseconds    Thời gian độ trễ cần tạo (tính theo mili giây)
  * @return 	None  
  **************************************************************************/
 void Can_Delay(uint32 milliseconds) {
-    usleep(milliseconds * 1000); // Hàm usleep tính theo micro giây, nhân với 1000 để thành mili giây
+    Os_Delay(milliseconds);
 }
\ No newline at end of file
@@ -15,6 +15,8 @@
 #include <stdlib.h>
 #include <unistd.h>  // Thư viện hỗ trợ hàm sleep (sử dụng cho delay)
 #include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "Pdu_Buffer.h"
 
 /**************************************************************************
  * @typedef Can_IdType
@@ -36,6 +38,88 @@ typedef struct {
     uint8 length;       /* Độ dài dữ liệu (tối đa 8 byte) */
 } Can_MessageType;
 
+/**************************************************************************
+ * @typedef Can_HwHandleType
+ * @brief 	Định nghĩa kiểu dữ liệu cho một hardware object (mailbox) của CAN
+ * @details Mỗi hardware object là một mailbox gửi (HTH) hoặc nhận (HRH),
+ *          có hàng đợi riêng chứa các thông điệp đang chờ xử lý.
+ **************************************************************************/
+typedef uint8   Can_HwHandleType;
+
+/**************************************************************************
+ * @brief Định nghĩa các hardware object được sử dụng trong hệ thống
+ * @details Hai hardware object mặc định được cấu hình trong Can_Init, các
+ *          hardware object khác được cấu hình bằng Can_SetupHardwareObject.
+ **************************************************************************/
+#define CAN_HOH_TX_DEFAULT      (Can_HwHandleType)0     /* Mailbox gửi mặc định */
+#define CAN_HOH_RX_DEFAULT      (Can_HwHandleType)1     /* Mailbox nhận mặc định (nhận mọi ID) */
+// Các hardware object khác (nếu có)
+
+/**************************************************************************
+ * @brief Giới hạn số hardware object, kích thước hàng đợi của một hardware
+ *        object và số thông điệp tối đa được xử lý trong một lần gọi
+ *        Can_MainFunction_Write/Can_MainFunction_Read
+ **************************************************************************/
+#define CAN_MAX_HW_OBJECTS          8
+#define CAN_QUEUE_SIZE              64      /* Lũy thừa của 2 */
+#define CAN_MAIN_FUNCTION_BATCH     32
+
+/**************************************************************************
+ * @brief Chế độ loopback: thông điệp gửi đi được đưa lại vào các mailbox
+ *        nhận của chính ECU (dùng khi giả lập một ECU đơn lẻ)
+ **************************************************************************/
+#ifndef CAN_CFG_LOOPBACK
+#define CAN_CFG_LOOPBACK            1       /* 1: bật, 0: tắt */
+#endif
+
+/**************************************************************************
+ * @enum    Can_ObjectType
+ * @brief 	Định nghĩa loại của một hardware object
+ **************************************************************************/
+typedef enum {
+    CAN_OBJECT_TYPE_TRANSMIT = 0,   /* Mailbox gửi */
+    CAN_OBJECT_TYPE_RECEIVE = 1     /* Mailbox nhận */
+} Can_ObjectType;
+
+/**************************************************************************
+ * @typedef Can_TxConfirmationType
+ * @brief 	Định nghĩa kiểu hàm báo cho tầng trên một PDU đã được gửi xong
+ * @details Hàm được gọi từ Can_MainFunction_Write.
+ **************************************************************************/
+typedef void (*Can_TxConfirmationType)(PduIdType TxPduId);
+
+/**************************************************************************
+ * @typedef Can_RxIndicationType
+ * @brief 	Định nghĩa kiểu hàm báo cho tầng trên đã nhận được một thông điệp
+ * @details Hàm được gọi từ Can_MainFunction_Read. Driver trả lại bộ đệm sau
+ *          khi hàm kết thúc, tầng trên muốn giữ bộ đệm lâu hơn phải gọi
+ *          PduBuf_Retain (không sao chép dữ liệu).
+ **************************************************************************/
+typedef void (*Can_RxIndicationType)(Can_HwHandleType Hrh, Can_IdType CanId, PduBuf_HandleType Buffer);
+
+/**************************************************************************
+ * @typedef Can_RxNotificationType
+ * @brief 	Định nghĩa kiểu hàm báo có thông điệp mới trong mailbox nhận
+ * @details Hàm mô phỏng ngắt nhận của phần cứng CAN, được gọi ngay khi thông
+ *          điệp vào mailbox nhận (từ luồng đang gửi hoặc luồng của bus ảo)
+ *          nên chỉ được làm việc ngắn, ví dụ kích hoạt task đọc mailbox.
+ **************************************************************************/
+typedef void (*Can_RxNotificationType)(void);
+
+/**************************************************************************
+ * @struct  Can_HardwareObjectConfigType
+ * @brief 	Định nghĩa cấu trúc cấu hình cho một hardware object
+ * @details	Mailbox nhận chỉ nhận các thông điệp thỏa mãn
+ *          (id & IdMask) == (IdValue & IdMask), IdMask = 0 để nhận mọi ID.
+ **************************************************************************/
+typedef struct {
+    Can_ObjectType ObjectType;              /* Loại hardware object (gửi hoặc nhận) */
+    Can_IdType IdValue;                     /* ID dùng để lọc thông điệp nhận */
+    Can_IdType IdMask;                      /* Mặt nạ lọc ID của thông điệp nhận */
+    Can_TxConfirmationType TxConfirmation;  /* Hàm báo gửi xong (mailbox gửi, có thể NULL) */
+    Can_RxIndicationType RxIndication;      /* Hàm báo nhận được (mailbox nhận, có thể NULL) */
+} Can_HardwareObjectConfigType;
+
 /**************************************************************************
  * @brief   Khởi tạo CAN
  * @param   None
@@ -44,7 +128,86 @@ typedef struct {
 void Can_Init(void);
 
 /**************************************************************************
- * @brief   Gửi thông điệp CAN
+ * @brief   Cấu hình một hardware object (gọi trước khi bắt đầu lập lịch)
+ * @param   Hoh             Hardware object cần cấu hình
+ * @param   ConfigPtr       Con trỏ đến cấu hình hardware object
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Can_SetupHardwareObject(Can_HwHandleType Hoh, const Can_HardwareObjectConfigType* ConfigPtr);
+
+/**************************************************************************
+ * @brief   Đưa một thông điệp vào hàng đợi của mailbox gửi (không chờ)
+ * @param   Hth             Mailbox gửi
+ * @param   TxPduId         ID của PDU, được trả lại qua hàm TxConfirmation
+ * @param   message         Con trỏ đến thông điệp CAN cần gửi
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu hàng đợi đầy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Can_Write(Can_HwHandleType Hth, PduIdType TxPduId, const Can_MessageType* message);
+
+/**************************************************************************
+ * @brief   Đưa một bộ đệm PDU vào hàng đợi của mailbox gửi (không chờ)
+ * @details Hàng đợi giữ một tham chiếu của bộ đệm cho đến khi thông điệp
+ *          được gửi, người gọi vẫn giữ tham chiếu của mình.
+ * @param   Hth             Mailbox gửi
+ * @param   TxPduId         ID của PDU, được trả lại qua hàm TxConfirmation
+ * @param   CanId           ID của thông điệp CAN
+ * @param   Buffer          Bộ đệm chứa dữ liệu (tối đa 8 byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu hàng đợi đầy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Can_WriteBuffer(Can_HwHandleType Hth, PduIdType TxPduId, Can_IdType CanId, PduBuf_HandleType Buffer);
+
+/**************************************************************************
+ * @brief   Gửi các thông điệp đang chờ trong các mailbox gửi
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Can_MainFunction_Write(void);
+
+/**************************************************************************
+ * @brief   Chuyển các thông điệp đã nhận trong các mailbox nhận lên tầng trên
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Can_MainFunction_Read(void);
+
+/**************************************************************************
+ * @brief   Đăng ký hàm báo có thông điệp mới trong mailbox nhận
+ * @param   Notification    Hàm thông báo (NULL để tắt)
+ * @return 	None
+ **************************************************************************/
+void Can_SetRxNotification(Can_RxNotificationType Notification);
+
+/**************************************************************************
+ * @brief   Đưa một thông điệp trên bus vào mailbox nhận phù hợp
+ * @details Hàm này mô phỏng phần cứng CAN nhận một thông điệp từ bus.
+ * @param   message         Con trỏ đến thông điệp CAN nhận được
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được đưa vào mailbox nhận,
+ *                                 E_NOT_OK nếu không có mailbox phù hợp hoặc hàng đợi đầy
+ **************************************************************************/
+Std_ReturnType Can_SimulateReception(const Can_MessageType* message);
+
+/**************************************************************************
+ * @brief   Báo một thông điệp của mailbox gửi đã được gửi lên bus
+ * @details Hàm này mô phỏng ngắt gửi xong của phần cứng CAN, hàm
+ *          TxConfirmation được gọi trong lần gọi Can_MainFunction_Write tiếp theo.
+ * @param   Hth             Mailbox gửi chứa thông điệp
+ * @param   TxPduId         ID của PDU đã được gửi
+ * @return 	None
+ **************************************************************************/
+void Can_ConfirmTransmission(Can_HwHandleType Hth, PduIdType TxPduId);
+
+/**************************************************************************
+ * @brief   Đọc số thông điệp bị bỏ do hàng đợi của hardware object bị đầy
+ * @param   Hoh         Hardware object
+ * @return 	uint32      Số thông điệp bị bỏ
+ **************************************************************************/
+uint32 Can_GetOverrunCount(Can_HwHandleType Hoh);
+
+/**************************************************************************
+ * @brief   Gửi thông điệp CAN qua mailbox gửi mặc định
  * @param   message     Con trỏ đến thông điệp CAN cần gửi
  * @return 	None  
  **************************************************************************/
@@ -52,7 +215,8 @@ void Can_SendMessage(Can_MessageType* message);
 
 /**************************************************************************
  * @brief   Nhận thông điệp CAN
- * @details Hàm này nhận một thông điệp CAN (giả lập nhận ngẫu nhiên).
+ * @details Hàm này giả lập một node khác gửi thông điệp ngẫu nhiên lên bus,
+ *          thông điệp được đưa vào mailbox nhận phù hợp và được trả về.
  * @param   None
  * @return 	Can_MessageType    Thông điệp CAN nhận được  
  **************************************************************************/
@@ -0,0 +1,517 @@
+/***************************************************************************
+ * @file    Can_VirtualBus.c
+ * @brief   Định nghĩa bus CAN ảo dùng chung giữa nhiều tiến trình ECU
+ * @details File này triển khai bus CAN ảo trong bộ nhớ chia sẻ POSIX. Mỗi
+ *          tiến trình là một node có bộ đệm gửi riêng, thông điệp có ID nhỏ
+ *          nhất trong các bộ đệm gửi thắng phân xử khi bus rảnh và được ghi
+ *          vào bộ đệm vòng chung của bus. Mỗi node có một luồng điều khiển
+ *          (mô phỏng bộ điều khiển CAN) chờ trên futex, đọc các thông điệp
+ *          mới và đưa vào mailbox nhận của driver CAN.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#include "Can_VirtualBus.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+
+#ifdef __linux__
+
+#include <stdatomic.h>
+#include <pthread.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/**************************************************************************
+ * @brief Giá trị nhận dạng bộ nhớ chia sẻ đã được khởi tạo xong
+ **************************************************************************/
+#define CAN_VBUS_MAGIC              0x43414E31U     /* "CAN1" */
+#define CAN_VBUS_WRITING_FLAG       0x80000000U     /* Đánh dấu phần tử đang được ghi */
+#define CAN_VBUS_NS_PER_SEC         1000000000ULL
+
+/**************************************************************************
+ * @struct  Can_VirtualBusPendingType
+ * @brief   Một thông điệp đang chờ phân xử trong bộ đệm gửi của node
+ **************************************************************************/
+typedef struct {
+    uint8 Used;                 /* Phần tử có đang chứa thông điệp hay không */
+    Can_HwHandleType Hth;       /* Mailbox gửi chứa thông điệp */
+    PduIdType PduId;            /* ID của PDU */
+    Can_MessageType Message;    /* Thông điệp CAN */
+} Can_VirtualBusPendingType;
+
+/**************************************************************************
+ * @struct  Can_VirtualBusNodeType
+ * @brief   Trạng thái của một node trên bus (được bảo vệ bởi khóa của bus)
+ **************************************************************************/
+typedef struct {
+    pid_t Pid;                                                  /* Tiến trình sở hữu node (0: trống) */
+    Can_VirtualBusPendingType Pending[CAN_VBUS_NODE_TX_SLOTS];  /* Bộ đệm gửi */
+} Can_VirtualBusNodeType;
+
+/**************************************************************************
+ * @struct  Can_VirtualBusFrameType
+ * @brief   Một thông điệp đã xuất hiện trên bus
+ * @details Phần tử được ghi dưới khóa của bus và được đọc không khóa:
+ *          Sequence bằng số thứ tự của thông điệp + 1 khi dữ liệu ổn định.
+ **************************************************************************/
+typedef struct {
+    atomic_uint Sequence;       /* Số thứ tự của thông điệp + 1 */
+    atomic_uint Id;             /* ID của thông điệp CAN */
+    atomic_uint Info;           /* Độ dài | node gửi << 8 | mailbox gửi << 16 */
+    atomic_uint PduId;          /* ID của PDU ở node gửi */
+    atomic_uint Data[2];        /* Dữ liệu (8 byte) */
+} Can_VirtualBusFrameType;
+
+/**************************************************************************
+ * @struct  Can_VirtualBusShmType
+ * @brief   Bố cục của bộ nhớ chia sẻ của bus
+ **************************************************************************/
+typedef struct {
+    atomic_uint Magic;                                  /* CAN_VBUS_MAGIC khi đã khởi tạo xong */
+    atomic_uint Doorbell;                               /* Futex, tăng khi bus có thay đổi */
+    atomic_uint Head;                                   /* Số thông điệp đã xuất hiện trên bus */
+    uint32 BaudRate;                                    /* Tốc độ baud của bus (bit/s) */
+    pthread_mutex_t Lock;                               /* Khóa của bus (dùng chung giữa các tiến trình) */
+    uint64 BusFreeAtNs;                                 /* Thời điểm bus rảnh (CLOCK_MONOTONIC) */
+    Can_VirtualBusNodeType Nodes[CAN_VBUS_MAX_NODES];   /* Các node */
+    Can_VirtualBusFrameType Ring[CAN_VBUS_RING_SIZE];   /* Các thông điệp gần nhất */
+} Can_VirtualBusShmType;
+
+static Can_VirtualBusShmType* vbus = NULL_PTR;      /* Bus đang nối (NULL nếu không nối) */
+static uint8 vbus_node;                             /* Node của tiến trình này */
+static uint32 vbus_cursor;                          /* Số thứ tự thông điệp tiếp theo cần đọc */
+static atomic_uint vbus_lost;                       /* Số thông điệp bị mất */
+static atomic_bool vbus_running;                    /* Luồng điều khiển có đang chạy hay không */
+static pthread_t vbus_thread;                       /* Luồng điều khiển của node */
+
+/**************************************************************************
+ * @brief   Đọc thời gian CLOCK_MONOTONIC (dùng chung giữa các tiến trình)
+ * @param   None
+ * @return 	uint64  Thời gian hiện tại (nano giây)
+ **************************************************************************/
+static uint64 Can_VirtualBus_NowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * CAN_VBUS_NS_PER_SEC + (uint64)ts.tv_nsec;
+}
+
+/**************************************************************************
+ * @brief   Chờ trên futex của bus cho đến khi giá trị thay đổi
+ * @param   expected    Giá trị futex đã đọc trước đó
+ * @param   timeout_ns  Thời gian chờ tối đa (0: chờ vô hạn)
+ * @return 	None
+ **************************************************************************/
+static void Can_VirtualBus_Wait(uint32 expected, uint64 timeout_ns) {
+    struct timespec ts;
+    struct timespec* ts_ptr = NULL_PTR;
+
+    if (timeout_ns > 0) {
+        ts.tv_sec = (time_t)(timeout_ns / CAN_VBUS_NS_PER_SEC);
+        ts.tv_nsec = (long)(timeout_ns % CAN_VBUS_NS_PER_SEC);
+        ts_ptr = &ts;
+    }
+    syscall(SYS_futex, &vbus->Doorbell, FUTEX_WAIT, expected, ts_ptr, NULL_PTR, 0);
+}
+
+/**************************************************************************
+ * @brief   Đánh thức luồng điều khiển của tất cả các node
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Can_VirtualBus_Ring(void) {
+    atomic_fetch_add_explicit(&vbus->Doorbell, 1, memory_order_release);
+    syscall(SYS_futex, &vbus->Doorbell, FUTEX_WAKE, INT_MAX, NULL_PTR, NULL_PTR, 0);
+}
+
+/**************************************************************************
+ * @brief   Khóa bus, khôi phục khóa nếu tiến trình giữ khóa đã kết thúc
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Can_VirtualBus_Lock(void) {
+    if (pthread_mutex_lock(&vbus->Lock) == EOWNERDEAD) {
+        pthread_mutex_consistent(&vbus->Lock);
+    }
+}
+
+/**************************************************************************
+ * @brief   Phân xử bus: thông điệp có ID nhỏ nhất được gửi khi bus rảnh
+ * @details Hàm phải được gọi khi đang giữ khóa của bus. Bus bận trong thời
+ *          gian truyền thông điệp theo tốc độ baud, các thông điệp còn lại
+ *          được phân xử ở lần gọi tiếp theo sau khi bus rảnh.
+ * @param   now_ns      Thời gian hiện tại (nano giây)
+ * @return 	boolean     TRUE nếu còn thông điệp đang chờ phân xử
+ **************************************************************************/
+static boolean Can_VirtualBus_Arbitrate(uint64 now_ns) {
+    Can_VirtualBusPendingType* winner = NULL_PTR;
+    uint8 winner_node = 0;
+    uint32 pending = 0;
+
+    for (uint8 node = 0; node < CAN_VBUS_MAX_NODES; node++) {
+        if (vbus->Nodes[node].Pid == 0) {
+            continue;
+        }
+        for (uint8 slot = 0; slot < CAN_VBUS_NODE_TX_SLOTS; slot++) {
+            Can_VirtualBusPendingType* candidate = &vbus->Nodes[node].Pending[slot];
+            if (!candidate->Used) {
+                continue;
+            }
+            pending++;
+            if (winner == NULL_PTR || candidate->Message.id < winner->Message.id) {
+                winner = candidate;
+                winner_node = node;
+            }
+        }
+    }
+
+    if (winner == NULL_PTR || vbus->BusFreeAtNs > now_ns) {
+        return (pending > 0) ? TRUE : FALSE;
+    }
+
+    // Ghi thông điệp thắng phân xử vào bộ đệm vòng của bus
+    uint32 index = atomic_load_explicit(&vbus->Head, memory_order_relaxed);
+    Can_VirtualBusFrameType* frame = &vbus->Ring[index & (CAN_VBUS_RING_SIZE - 1)];
+    uint32 data[2];
+    memcpy(data, winner->Message.data, sizeof(data));
+
+    atomic_store_explicit(&frame->Sequence, (index + 1) ^ CAN_VBUS_WRITING_FLAG, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&frame->Id, winner->Message.id, memory_order_relaxed);
+    atomic_store_explicit(&frame->Info, (uint32)winner->Message.length | ((uint32)winner_node << 8) | ((uint32)winner->Hth << 16),
+                          memory_order_relaxed);
+    atomic_store_explicit(&frame->PduId, winner->PduId, memory_order_relaxed);
+    atomic_store_explicit(&frame->Data[0], data[0], memory_order_relaxed);
+    atomic_store_explicit(&frame->Data[1], data[1], memory_order_relaxed);
+    atomic_store_explicit(&frame->Sequence, index + 1, memory_order_release);
+    atomic_store_explicit(&vbus->Head, index + 1, memory_order_release);
+
+    // Bus bận trong thời gian truyền thông điệp
+    uint64 bits = CAN_VBUS_FRAME_OVERHEAD_BITS + 8ULL * winner->Message.length;
+    vbus->BusFreeAtNs = now_ns + bits * CAN_VBUS_NS_PER_SEC / vbus->BaudRate;
+    winner->Used = FALSE;
+
+    return (pending > 1) ? TRUE : FALSE;
+}
+
+/**************************************************************************
+ * @brief   Đọc các thông điệp mới trên bus và chuyển cho driver CAN
+ * @details Thông điệp của node khác được đưa vào mailbox nhận, thông điệp
+ *          của chính node là xác nhận đã gửi thành công.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Can_VirtualBus_Poll(void) {
+    uint32 head = atomic_load_explicit(&vbus->Head, memory_order_acquire);
+
+    while (vbus_cursor != head) {
+        if (head - vbus_cursor > CAN_VBUS_RING_SIZE) {
+            // Node đọc chậm hơn bus, bỏ qua các thông điệp đã bị ghi đè
+            atomic_fetch_add_explicit(&vbus_lost, head - vbus_cursor - CAN_VBUS_RING_SIZE, memory_order_relaxed);
+            vbus_cursor = head - CAN_VBUS_RING_SIZE;
+        }
+
+        Can_VirtualBusFrameType* frame = &vbus->Ring[vbus_cursor & (CAN_VBUS_RING_SIZE - 1)];
+        uint32 seq = atomic_load_explicit(&frame->Sequence, memory_order_acquire);
+        Can_MessageType message;
+        uint32 data[2];
+
+        message.id = atomic_load_explicit(&frame->Id, memory_order_relaxed);
+        uint32 info = atomic_load_explicit(&frame->Info, memory_order_relaxed);
+        PduIdType pdu_id = (PduIdType)atomic_load_explicit(&frame->PduId, memory_order_relaxed);
+        data[0] = atomic_load_explicit(&frame->Data[0], memory_order_relaxed);
+        data[1] = atomic_load_explicit(&frame->Data[1], memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+
+        if (seq != vbus_cursor + 1 || atomic_load_explicit(&frame->Sequence, memory_order_relaxed) != seq) {
+            // Phần tử bị ghi đè trong lúc đọc
+            atomic_fetch_add_explicit(&vbus_lost, 1, memory_order_relaxed);
+            vbus_cursor++;
+            continue;
+        }
+        vbus_cursor++;
+
+        message.length = (uint8)(info & 0xFFU);
+        memcpy(message.data, data, sizeof(message.data));
+
+        if ((uint8)((info >> 8) & 0xFFU) == vbus_node) {
+            Can_ConfirmTransmission((Can_HwHandleType)((info >> 16) & 0xFFU), pdu_id);
+        } else {
+            Can_SimulateReception(&message);
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Luồng điều khiển của node (mô phỏng bộ điều khiển CAN)
+ * @details Luồng đọc các thông điệp mới, phân xử khi bus rảnh và ngủ trên
+ *          futex đến khi bus thay đổi hoặc đến lúc bus rảnh.
+ * @param   arg     Không sử dụng
+ * @return 	void*   NULL
+ **************************************************************************/
+static void* Can_VirtualBus_ControllerMain(void* arg) {
+    (void)arg;
+
+    while (atomic_load_explicit(&vbus_running, memory_order_acquire)) {
+        uint32 doorbell = atomic_load_explicit(&vbus->Doorbell, memory_order_acquire);
+
+        Can_VirtualBus_Poll();
+
+        uint64 now_ns = Can_VirtualBus_NowNs();
+        Can_VirtualBus_Lock();
+        boolean pending = Can_VirtualBus_Arbitrate(now_ns);
+        uint64 bus_free_ns = vbus->BusFreeAtNs;
+        pthread_mutex_unlock(&vbus->Lock);
+
+        if (atomic_load_explicit(&vbus->Head, memory_order_acquire) != vbus_cursor) {
+            continue;   // Có thông điệp mới (có thể do chính node vừa phân xử)
+        }
+        if (pending && bus_free_ns > now_ns) {
+            Can_VirtualBus_Wait(doorbell, bus_free_ns - now_ns);
+        } else if (!pending) {
+            Can_VirtualBus_Wait(doorbell, 0);
+        }
+    }
+
+    return NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Mở (hoặc tạo) bộ nhớ chia sẻ của bus
+ * @param   BusName     Tên của bus
+ * @return 	Can_VirtualBusShmType*  Con trỏ đến bus, NULL nếu thất bại
+ **************************************************************************/
+static Can_VirtualBusShmType* Can_VirtualBus_Open(const char* BusName) {
+    char path[64];
+    boolean creator = TRUE;
+    struct stat st;
+
+    snprintf(path, sizeof(path), "/ecu_can_%s", BusName);
+    int fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0666);
+    if (fd < 0 && errno == EEXIST) {
+        creator = FALSE;
+        fd = shm_open(path, O_RDWR, 0666);
+    }
+    if (fd < 0) {
+        return NULL_PTR;
+    }
+
+    if (creator) {
+        if (ftruncate(fd, sizeof(Can_VirtualBusShmType)) != 0) {
+            close(fd);
+            shm_unlink(path);
+            return NULL_PTR;
+        }
+    } else {
+        // Chờ node tạo bus cấp phát xong bộ nhớ
+        for (uint32 retry = 0; fstat(fd, &st) == 0 && (size_t)st.st_size < sizeof(Can_VirtualBusShmType); retry++) {
+            if (retry >= 1000) {
+                close(fd);
+                return NULL_PTR;
+            }
+            usleep(1000);
+        }
+    }
+
+    Can_VirtualBusShmType* shm = mmap(NULL_PTR, sizeof(Can_VirtualBusShmType), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        return NULL_PTR;
+    }
+
+    if (creator) {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&shm->Lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+
+        shm->BaudRate = CAN_VBUS_BAUDRATE;
+        shm->BusFreeAtNs = 0;
+        atomic_store_explicit(&shm->Magic, CAN_VBUS_MAGIC, memory_order_release);
+    } else {
+        // Chờ node tạo bus khởi tạo xong
+        for (uint32 retry = 0; atomic_load_explicit(&shm->Magic, memory_order_acquire) != CAN_VBUS_MAGIC; retry++) {
+            if (retry >= 1000) {
+                munmap(shm, sizeof(Can_VirtualBusShmType));
+                return NULL_PTR;
+            }
+            usleep(1000);
+        }
+    }
+
+    return shm;
+}
+
+/**************************************************************************
+ * @brief   Nối ECU vào bus CAN ảo
+ * @details Hàm này mở bộ nhớ chia sẻ của bus, chiếm một node trống (hoặc
+ *          node của tiến trình đã kết thúc) và khởi động luồng điều khiển.
+ *          Các thông điệp đã có trên bus trước khi nối bị bỏ qua.
+ * @param   BusName         Tên của bus (chuỗi hằng)
+ * @return 	Std_ReturnType  Trả về E_OK nếu nối thành công,
+ *                                 E_NOT_OK nếu bus đầy node hoặc không hỗ trợ
+ **************************************************************************/
+Std_ReturnType Can_VirtualBus_Attach(const char* BusName) {
+    if (BusName == NULL_PTR || vbus != NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Can_VirtualBusShmType* shm = Can_VirtualBus_Open(BusName);
+    if (shm == NULL_PTR) {
+        LOG_ERROR(CAN, "Virtual CAN bus %s: cannot open shared memory\n", BusName);
+        return E_NOT_OK;
+    }
+    vbus = shm;
+
+    // Chiếm một node trống
+    Can_VirtualBus_Lock();
+    uint8 node;
+    for (node = 0; node < CAN_VBUS_MAX_NODES; node++) {
+        pid_t pid = vbus->Nodes[node].Pid;
+        if (pid == 0 || (kill(pid, 0) != 0 && errno == ESRCH)) {
+            memset(&vbus->Nodes[node], 0, sizeof(vbus->Nodes[node]));
+            vbus->Nodes[node].Pid = getpid();
+            break;
+        }
+    }
+    vbus_cursor = atomic_load_explicit(&vbus->Head, memory_order_acquire);
+    pthread_mutex_unlock(&vbus->Lock);
+
+    if (node >= CAN_VBUS_MAX_NODES) {
+        munmap(vbus, sizeof(Can_VirtualBusShmType));
+        vbus = NULL_PTR;
+        LOG_ERROR(CAN, "Virtual CAN bus %s: no free node\n", BusName);
+        return E_NOT_OK;
+    }
+    vbus_node = node;
+    atomic_store_explicit(&vbus_lost, 0, memory_order_relaxed);
+
+    atomic_store_explicit(&vbus_running, TRUE, memory_order_release);
+    if (pthread_create(&vbus_thread, NULL_PTR, Can_VirtualBus_ControllerMain, NULL_PTR) != 0) {
+        atomic_store_explicit(&vbus_running, FALSE, memory_order_release);
+        Can_VirtualBus_Detach();
+        return E_NOT_OK;
+    }
+
+    LOG_INFO(CAN, "Attached to virtual CAN bus %s as node %u (%u bit/s)\n", BusName, node, vbus->BaudRate);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Tách ECU khỏi bus CAN ảo
+ * @details Hàm này dừng luồng điều khiển, trả lại node và bỏ các thông điệp
+ *          chưa được gửi trong bộ đệm gửi của node.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Can_VirtualBus_Detach(void) {
+    if (vbus == NULL_PTR) {
+        return;
+    }
+
+    if (atomic_exchange_explicit(&vbus_running, FALSE, memory_order_acq_rel)) {
+        Can_VirtualBus_Ring();
+        pthread_join(vbus_thread, NULL_PTR);
+    }
+
+    Can_VirtualBus_Lock();
+    memset(&vbus->Nodes[vbus_node], 0, sizeof(vbus->Nodes[vbus_node]));
+    pthread_mutex_unlock(&vbus->Lock);
+
+    munmap(vbus, sizeof(Can_VirtualBusShmType));
+    vbus = NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra ECU có đang nối vào bus CAN ảo hay không
+ * @param   None
+ * @return 	boolean     TRUE nếu đang nối vào bus, FALSE nếu không
+ **************************************************************************/
+boolean Can_VirtualBus_IsAttached(void) {
+    return (vbus != NULL_PTR) ? TRUE : FALSE;
+}
+
+/**************************************************************************
+ * @brief   Đưa một thông điệp vào bộ đệm gửi của node để tham gia phân xử
+ * @details Nếu bus đang rảnh, thông điệp được phân xử ngay. Xác nhận gửi
+ *          thành công được báo qua Can_ConfirmTransmission khi luồng điều
+ *          khiển thấy thông điệp xuất hiện trên bus.
+ * @param   Hth             Mailbox gửi chứa thông điệp
+ * @param   TxPduId         ID của PDU, được trả lại khi thông điệp lên bus
+ * @param   message         Con trỏ đến thông điệp CAN cần gửi
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được nhận,
+ *                                 E_NOT_OK nếu bộ đệm gửi của node đầy
+ **************************************************************************/
+Std_ReturnType Can_VirtualBus_Transmit(Can_HwHandleType Hth, PduIdType TxPduId, const Can_MessageType* message) {
+    if (vbus == NULL_PTR || message == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    Can_VirtualBus_Lock();
+    for (uint8 slot = 0; slot < CAN_VBUS_NODE_TX_SLOTS; slot++) {
+        Can_VirtualBusPendingType* pending = &vbus->Nodes[vbus_node].Pending[slot];
+        if (!pending->Used) {
+            pending->Used = TRUE;
+            pending->Hth = Hth;
+            pending->PduId = TxPduId;
+            pending->Message = *message;
+            ret = E_OK;
+            break;
+        }
+    }
+    if (ret == E_OK) {
+        Can_VirtualBus_Arbitrate(Can_VirtualBus_NowNs());
+    }
+    pthread_mutex_unlock(&vbus->Lock);
+
+    if (ret == E_OK) {
+        Can_VirtualBus_Ring();
+    }
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Đọc số thông điệp bị mất do ECU đọc bus chậm hơn tốc độ bus
+ * @param   None
+ * @return 	uint32  Số thông điệp bị mất
+ **************************************************************************/
+uint32 Can_VirtualBus_GetLostCount(void) {
+    return atomic_load_explicit(&vbus_lost, memory_order_relaxed);
+}
+
+#else /* __linux__ */
+
+/**************************************************************************
+ * @brief Bus CAN ảo chỉ hỗ trợ Linux, các nền tảng khác dùng chế độ loopback
+ **************************************************************************/
+Std_ReturnType Can_VirtualBus_Attach(const char* BusName) {
+    LOG_ERROR(CAN, "Virtual CAN bus %s: not supported on this platform\n", BusName);
+    return E_NOT_OK;
+}
+
+void Can_VirtualBus_Detach(void) {
+}
+
+boolean Can_VirtualBus_IsAttached(void) {
+    return FALSE;
+}
+
+Std_ReturnType Can_VirtualBus_Transmit(Can_HwHandleType Hth, PduIdType TxPduId, const Can_MessageType* message) {
+    return E_NOT_OK;
+}
+
+uint32 Can_VirtualBus_GetLostCount(void) {
+    return 0;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,76 @@
+/***************************************************************************
+ * @file    Can_VirtualBus.h
+ * @brief   Khai báo bus CAN ảo dùng chung giữa nhiều tiến trình ECU
+ * @details File này cung cấp giao diện để nối driver CAN vào một bus CAN ảo
+ *          nằm trong bộ nhớ chia sẻ POSIX, cho phép nhiều tiến trình ECU
+ *          trên cùng một máy Linux trao đổi thông điệp với nhau. Bus mô
+ *          phỏng phân xử theo ID (ID nhỏ hơn thắng) và thời gian truyền một
+ *          thông điệp theo tốc độ baud.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef CAN_VIRTUALBUS_H
+#define CAN_VIRTUALBUS_H
+
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "Can.h"
+
+/**************************************************************************
+ * @brief Giới hạn của bus CAN ảo
+ **************************************************************************/
+#define CAN_VBUS_MAX_NODES          16      /* Số node (tiến trình ECU) tối đa trên một bus */
+#define CAN_VBUS_NODE_TX_SLOTS      8       /* Số thông điệp chờ phân xử tối đa của một node */
+#define CAN_VBUS_RING_SIZE          1024    /* Số thông điệp gần nhất được giữ trên bus (lũy thừa của 2) */
+#define CAN_VBUS_FRAME_OVERHEAD_BITS 47     /* Số bit của một thông điệp chuẩn ngoài phần dữ liệu */
+
+/**************************************************************************
+ * @brief Tốc độ baud của bus (bit/s), do node tạo bus quyết định
+ **************************************************************************/
+#ifndef CAN_VBUS_BAUDRATE
+#define CAN_VBUS_BAUDRATE           500000
+#endif
+
+/**************************************************************************
+ * @brief   Nối ECU vào bus CAN ảo
+ * @details Bộ nhớ chia sẻ /dev/shm/ecu_can_<BusName> được tạo nếu chưa tồn
+ *          tại. Bus luôn chạy theo thời gian thực nên chỉ dùng cùng với
+ *          OS_TIME_MODE_REALTIME.
+ * @param   BusName         Tên của bus (chuỗi hằng)
+ * @return 	Std_ReturnType  Trả về E_OK nếu nối thành công,
+ *                                 E_NOT_OK nếu bus đầy node hoặc không hỗ trợ
+ **************************************************************************/
+Std_ReturnType Can_VirtualBus_Attach(const char* BusName);
+
+/**************************************************************************
+ * @brief   Tách ECU khỏi bus CAN ảo
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Can_VirtualBus_Detach(void);
+
+/**************************************************************************
+ * @brief   Kiểm tra ECU có đang nối vào bus CAN ảo hay không
+ * @param   None
+ * @return 	boolean     TRUE nếu đang nối vào bus, FALSE nếu không
+ **************************************************************************/
+boolean Can_VirtualBus_IsAttached(void);
+
+/**************************************************************************
+ * @brief   Đưa một thông điệp vào bộ đệm gửi của node để tham gia phân xử
+ * @param   Hth             Mailbox gửi chứa thông điệp
+ * @param   TxPduId         ID của PDU, được trả lại khi thông điệp lên bus
+ * @param   message         Con trỏ đến thông điệp CAN cần gửi
+ * @return 	Std_ReturnType  Trả về E_OK nếu thông điệp được nhận,
+ *                                 E_NOT_OK nếu bộ đệm gửi của node đầy
+ **************************************************************************/
+Std_ReturnType Can_VirtualBus_Transmit(Can_HwHandleType Hth, PduIdType TxPduId, const Can_MessageType* message);
+
+/**************************************************************************
+ * @brief   Đọc số thông điệp bị mất do ECU đọc bus chậm hơn tốc độ bus
+ * @param   None
+ * @return 	uint32  Số thông điệp bị mất
+ **************************************************************************/
+uint32 Can_VirtualBus_GetLostCount(void);
+
+#endif /* CAN_VIRTUALBUS_H */
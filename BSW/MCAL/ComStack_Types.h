@@ -0,0 +1,39 @@
+/***************************************************************************
+ * @file    ComStack_Types.h
+ * @brief   Định nghĩa các kiểu dữ liệu dùng chung cho ngăn xếp truyền thông
+ * @details File này chứa các kiểu dữ liệu được dùng chung giữa các module
+ *          truyền thông (Can, PduR, ...) theo chuẩn AUTOSAR.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef COMSTACK_TYPES_H
+#define COMSTACK_TYPES_H
+
+#include "Std_Types.h"
+
+/**************************************************************************
+ * @typedef PduIdType
+ * @brief 	Định nghĩa kiểu dữ liệu cho ID của một PDU
+ * @details ID được dùng để xác định PDU giữa các tầng truyền thông, ví dụ
+ *          để báo cho tầng trên biết PDU nào đã được gửi xong.
+ **************************************************************************/
+typedef uint16  PduIdType;
+
+/**************************************************************************
+ * @typedef PduLengthType
+ * @brief 	Định nghĩa kiểu dữ liệu cho độ dài của một PDU (byte)
+ **************************************************************************/
+typedef uint16  PduLengthType;
+
+/**************************************************************************
+ * @struct  PduInfoType
+ * @brief 	Định nghĩa cấu trúc mô tả dữ liệu của một PDU
+ * @details Cấu trúc chỉ trỏ đến dữ liệu của PDU nên các tầng truyền thông
+ *          chuyển PDU cho nhau mà không cần sao chép dữ liệu.
+ **************************************************************************/
+typedef struct {
+    uint8* SduDataPtr;          /* Con trỏ đến dữ liệu của PDU */
+    PduLengthType SduLength;    /* Độ dài dữ liệu (byte) */
+} PduInfoType;
+
+#endif /* COMSTACK_TYPES_H */
@@ -9,6 +9,8 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Dio.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Độ trễ đi qua thời gian hệ thống của OS
 
 /**************************************************************************
  * @brief   Khởi tạo DIO
@@ -19,7 +21,7 @@
 void Dio_Init() {
     // Khởi tạo seed cho random số ngẫu nhiên
     srand(time(0));
-    printf("DIO Initialized.\n");
+    LOG_INFO(DIO, "DIO Initialized.\n");
 }
 
 /**************************************************************************
@@ -39,7 +41,7 @@ Dio_LevelType Dio_ReadChannel(Dio_ChannelType ChannelId) {
     dio_value = (rand() % 2) ? STD_HIGH : STD_LOW;
 
     // In trạng thái đọc được từ kênh DIO
-    printf("Reading DIO Channel %d: Value = %d\n", ChannelId, dio_value);
+    LOG_DEBUG(DIO, "Reading DIO Channel %d: Value = %d\n", ChannelId, dio_value);
 
     return dio_value;
 }
@@ -56,15 +58,16 @@ void Dio_WriteChannel(Dio_ChannelType ChannelId, Dio_LevelType Level) {
     Dio_Delay(100);  // Tạo độ trễ 100ms để mô phỏng
 
     // In trạng thái được ghi vào kênh DIO
-    printf("Writing DIO Channel %d: Value = %d\n", ChannelId, Level);
+    LOG_DEBUG(DIO, "Writing DIO Channel %d: Value = %d\n", ChannelId, Level);
 }
 
 /**************************************************************************
  * @brief   Tạo độ trễ (delay)
- * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds).
+ * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds) theo
+ *          thời gian hệ thống của OS (thời gian thực, tăng tốc hoặc rời rạc).
  * @param   milliseconds    Thời gian độ trễ cần tạo (tính theo mili giây)
  * @return 	None  
  **************************************************************************/
 void Dio_Delay(uint32 milliseconds) {
-    usleep(milliseconds * 1000); // Hàm usleep tính theo micro giây, nhân với 1000 để thành mili giây
+    Os_Delay(milliseconds);
 }
\ No newline at end of file
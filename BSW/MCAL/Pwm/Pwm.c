@@ -9,6 +9,7 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Pwm.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
 #include <stdio.h>
 
 /**************************************************************************
@@ -18,8 +19,8 @@
  * @return 	None  
  **************************************************************************/
 void Pwm_Init(const Pwm_ConfigType* ConfigPtr) {
-    printf("PWM Initialized for Channel %d with Period %d ms and Duty Cycle %d%%\n", 
-           ConfigPtr->Pwm_Channel, ConfigPtr->Pwm_Period, ConfigPtr->Pwm_DutyCycle);
+    LOG_INFO(PWM, "PWM Initialized for Channel %d with Period %d ms and Duty Cycle %d%%\n", 
+                  ConfigPtr->Pwm_Channel, ConfigPtr->Pwm_Period, ConfigPtr->Pwm_DutyCycle);
 }
 
 /**************************************************************************
@@ -30,5 +31,5 @@ void Pwm_Init(const Pwm_ConfigType* ConfigPtr) {
  * @return 	None  
  **************************************************************************/
 void Pwm_SetDutyCycle(Pwm_ChannelType ChannelNumber, uint16 DutyCycle) {
-    printf("PWM Channel %d set to Duty Cycle: %d%%\n", ChannelNumber, DutyCycle);
+    LOG_INFO(PWM, "PWM Channel %d set to Duty Cycle: %d%%\n", ChannelNumber, DutyCycle);
 }
\ No newline at end of file
@@ -44,9 +44,7 @@ void Dcm_ProcessRequest(Dcm_MessageType* request) {
             printf("Processing Clear DTC...\n");
             Dcm_SendResponse(request->service_id, "Clear DTC Acknowledged");
             // Giả lập xóa các mã DTC từ hệ thống DEM
-            for (uint8 i = 0; i < MAX_DIAGNOSTIC_EVENTS; i++) {
-                Dem_ClearErrorStatus(i);
-            }
+            Dem_ClearAllErrorStatus();
             break;
 
         default:
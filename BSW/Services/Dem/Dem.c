@@ -1,117 +1,863 @@
 #include "Dem.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Thời gian hệ thống cho debounce theo thời gian và freeze frame
+#include "NvM.h"   // Lưu bộ nhớ sự kiện qua các lần khởi động
+#include "NvM_Cfg.h"
+#include <pthread.h>
+#include <stdatomic.h>
 
 /**************************************************************************
- * @brief Mảng để lưu trữ các sự kiện chẩn đoán
+ * @brief Giá trị không hợp lệ của chỉ số sự kiện/bộ nhớ sự kiện và trạng
+ *        thái chưa đo thời gian của debounce theo thời gian
  **************************************************************************/
-Dem_EventType diagnostic_events[MAX_DIAGNOSTIC_EVENTS];
+#define DEM_INVALID_INDEX           (uint16)0xFFFF
+#define DEM_DEBOUNCE_IDLE           (Dem_EventStatusType)0xFF
+#define DEM_UDS_STATUS_INIT         (Dem_UdsStatusByteType)(DEM_UDS_STATUS_TNCSLC | DEM_UDS_STATUS_TNCTOC)
 
 /**************************************************************************
- * @brief Số lượng sự kiện chẩn đoán hiện tại
+ * @struct  Dem_EventStateType
+ * @brief   Trạng thái chạy của một sự kiện chẩn đoán
  **************************************************************************/
-uint8 event_count = 0;
+typedef struct {
+    Dem_UdsStatusByteType Status;           /* Byte trạng thái UDS */
+    Dem_EventStatusType DebounceDirection;  /* Kết quả đang được đo thời gian (debounce theo thời gian) */
+    sint16 DebounceCounter;                 /* Bộ đếm debounce (debounce theo bộ đếm) */
+    uint64 DebounceStartNs;                 /* Thời điểm bắt đầu đo (debounce theo thời gian) */
+    uint8 FailedCycles;                     /* Số chu kỳ vận hành có lỗi */
+    uint16 MemoryIndex;                     /* Vị trí trong bộ nhớ sự kiện (DEM_INVALID_INDEX nếu không có) */
+} Dem_EventStateType;
+
+/**************************************************************************
+ * @struct  Dem_EventMemoryEntryType
+ * @brief   Một phần tử của bộ nhớ sự kiện, lưu bộ đếm và freeze frame
+ **************************************************************************/
+typedef struct {
+    uint16 EventIndex;                      /* Chỉ số của sự kiện (DEM_INVALID_INDEX nếu trống) */
+    uint8 OccurrenceCounter;                /* Số lần sự kiện chuyển sang lỗi */
+    uint8 AgingCounter;                     /* Số chu kỳ vận hành liên tiếp không lỗi */
+    uint64 LastFailedNs;                    /* Thời điểm lỗi gần nhất, dùng để chọn phần tử bị thay thế */
+    Dem_FreezeFrameType FreezeFrame;        /* Freeze frame chụp khi lỗi lần đầu */
+} Dem_EventMemoryEntryType;
+
+/**************************************************************************
+ * @struct  Dem_ReportType
+ * @brief   Một kết quả kiểm tra đang chờ trong hàng đợi
+ **************************************************************************/
+typedef struct {
+    uint16 EventIndex;                      /* Chỉ số của sự kiện */
+    Dem_EventStatusType EventStatus;        /* Kết quả kiểm tra */
+    uint64 TimestampNs;                     /* Thời điểm báo kết quả (cho debounce theo thời gian) */
+} Dem_ReportType;
+
+/**************************************************************************
+ * @struct  Dem_ReportQueueType
+ * @brief   Hàng đợi kết quả kiểm tra của một task
+ * @details Mỗi task chỉ ghi vào hàng đợi của mình và chỉ Dem_MainFunction
+ *          đọc, nên hàng đợi không cần khóa.
+ **************************************************************************/
+typedef struct {
+    atomic_uint Head;                       /* Vị trí ghi tiếp theo (task báo kết quả) */
+    atomic_uint Tail;                       /* Vị trí đọc tiếp theo (Dem_MainFunction) */
+    Dem_ReportType Reports[DEM_REPORT_QUEUE_SIZE];
+} Dem_ReportQueueType;
+
+/**************************************************************************
+ * @struct  Dem_SharedSlotType
+ * @brief   Một ô của hàng đợi kết quả kiểm tra dùng chung
+ * @details Sequence bằng vị trí ghi khi ô trống và bằng vị trí ghi + 1 khi ô
+ *          đã có kết quả.
+ **************************************************************************/
+typedef struct {
+    atomic_uint Sequence;                   /* Trạng thái của ô */
+    Dem_ReportType Report;                  /* Kết quả kiểm tra */
+} Dem_SharedSlotType;
+
+/**************************************************************************
+ * @struct  Dem_SharedQueueType
+ * @brief   Hàng đợi kết quả kiểm tra dùng chung cho các task không còn hàng
+ *          đợi riêng (nhiều task ghi)
+ * @details Task ghi giành vị trí bằng compare-exchange trên Head nên không
+ *          cần khóa. Chỉ Dem_MainFunction đọc (khi giữ Dem_Lock).
+ **************************************************************************/
+typedef struct {
+    atomic_uint Head;                       /* Vị trí ghi tiếp theo */
+    atomic_uint Tail;                       /* Vị trí đọc tiếp theo */
+    Dem_SharedSlotType Slots[DEM_SHARED_QUEUE_SIZE];
+} Dem_SharedQueueType;
+
+/**************************************************************************
+ * @brief Hàng đợi kết quả kiểm tra của các task
+ * @details DEM_MAX_REPORTERS task đầu tiên báo kết quả có hàng đợi riêng,
+ *          các task sau dùng hàng đợi chung Dem_SharedQueue.
+ **************************************************************************/
+static Dem_ReportQueueType Dem_ReportQueues[DEM_MAX_REPORTERS];
+static Dem_SharedQueueType Dem_SharedQueue;
+static atomic_uint Dem_ReportQueueCount = 0;        /* Số hàng đợi đã được cấp */
+static atomic_uint Dem_LostReports = 0;             /* Kết quả bị mất do hàng đợi đầy */
+static __thread Dem_ReportQueueType* Dem_ThreadQueue = NULL_PTR;
+static __thread boolean Dem_ThreadShared = FALSE;   /* Task hiện tại dùng hàng đợi chung */
+
+/**************************************************************************
+ * @brief Khóa bảo vệ trạng thái sự kiện, chỉ dùng ở Dem_MainFunction và các
+ *        hàm chẩn đoán (không dùng ở đường báo kết quả của task)
+ **************************************************************************/
+static pthread_mutex_t Dem_Lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**************************************************************************
+ * @brief Bảng băm tra chỉ số sự kiện theo mã sự kiện (dò tuyến tính)
+ **************************************************************************/
+static uint16 Dem_HashTable[DEM_HASH_TABLE_SIZE];
+
+/**************************************************************************
+ * @brief Trạng thái của các sự kiện, đánh chỉ số theo bảng Dem_EventConfigs
+ **************************************************************************/
+static Dem_EventStateType Dem_EventStates[DEM_MAX_EVENTS];
+static uint16 Dem_NumEvents = 0;
+
+/**************************************************************************
+ * @brief Bộ nhớ sự kiện và số thứ tự của chu kỳ vận hành hiện tại
+ **************************************************************************/
+static Dem_EventMemoryEntryType Dem_EventMemory[DEM_EVENT_MEMORY_SIZE];
+static uint32 Dem_OperationCycle = 0;
+
+/**************************************************************************
+ * @brief Bản sao dữ liệu lưu vào NvM và cờ báo bộ nhớ sự kiện đã thay đổi
+ **************************************************************************/
+static Dem_NvDataType Dem_NvData;
+static boolean Dem_NvModified = FALSE;
+
+/**************************************************************************
+ * @brief   Tính vị trí bắt đầu dò trong bảng băm của một mã sự kiện
+ * @param   EventId     Mã sự kiện chẩn đoán
+ * @return 	uint32      Vị trí trong bảng băm
+ **************************************************************************/
+static inline uint32 Dem_Hash(Dem_EventIdType EventId) {
+    return (((uint32)EventId * 2654435761u) >> 16) & (DEM_HASH_TABLE_SIZE - 1);
+}
+
+/**************************************************************************
+ * @brief   Tra chỉ số của một sự kiện theo mã sự kiện
+ * @param   EventId     Mã sự kiện chẩn đoán
+ * @return 	uint16      Chỉ số của sự kiện, DEM_INVALID_INDEX nếu không tồn tại
+ **************************************************************************/
+static uint16 Dem_FindEvent(Dem_EventIdType EventId) {
+    uint32 slot = Dem_Hash(EventId);
+
+    while (Dem_HashTable[slot] != DEM_INVALID_INDEX) {
+        if (Dem_EventConfigs[Dem_HashTable[slot]].EventId == EventId) {
+            return Dem_HashTable[slot];
+        }
+        slot = (slot + 1) & (DEM_HASH_TABLE_SIZE - 1);
+    }
+    return DEM_INVALID_INDEX;
+}
+
+/**************************************************************************
+ * @brief   Giải phóng phần tử bộ nhớ sự kiện của một sự kiện (nếu có)
+ * @param   index       Chỉ số của sự kiện
+ * @return 	None
+ **************************************************************************/
+static void Dem_FreeMemoryEntry(uint16 index) {
+    Dem_EventStateType* state = &Dem_EventStates[index];
+    if (state->MemoryIndex != DEM_INVALID_INDEX) {
+        Dem_EventMemory[state->MemoryIndex].EventIndex = DEM_INVALID_INDEX;
+        state->MemoryIndex = DEM_INVALID_INDEX;
+    }
+}
+
+/**************************************************************************
+ * @brief   Lấy phần tử bộ nhớ sự kiện của một sự kiện, cấp mới nếu chưa có
+ * @details Khi cấp mới, freeze frame được chụp. Nếu bộ nhớ đầy, phần tử của
+ *          sự kiện không còn lỗi và lỗi lâu nhất bị thay thế.
+ * @param   index                       Chỉ số của sự kiện
+ * @return 	Dem_EventMemoryEntryType*   Con trỏ đến phần tử, NULL nếu bộ nhớ
+ *                                      đầy các sự kiện đang lỗi
+ **************************************************************************/
+static Dem_EventMemoryEntryType* Dem_GetMemoryEntry(uint16 index) {
+    Dem_EventStateType* state = &Dem_EventStates[index];
+    if (state->MemoryIndex != DEM_INVALID_INDEX) {
+        return &Dem_EventMemory[state->MemoryIndex];
+    }
+
+    uint16 target = DEM_INVALID_INDEX;
+    for (uint16 i = 0; i < DEM_EVENT_MEMORY_SIZE; i++) {
+        uint16 owner = Dem_EventMemory[i].EventIndex;
+        if (owner == DEM_INVALID_INDEX) {
+            target = i;
+            break;
+        }
+        if ((Dem_EventStates[owner].Status & DEM_UDS_STATUS_TF) == 0 &&
+            (target == DEM_INVALID_INDEX || Dem_EventMemory[i].LastFailedNs < Dem_EventMemory[target].LastFailedNs)) {
+            target = i;
+        }
+    }
+    if (target == DEM_INVALID_INDEX) {
+        LOG_WARN(DEM, "Event memory full, event 0x%04X not stored\n", Dem_EventConfigs[index].EventId);
+        return NULL_PTR;
+    }
+    if (Dem_EventMemory[target].EventIndex != DEM_INVALID_INDEX) {
+        Dem_FreeMemoryEntry(Dem_EventMemory[target].EventIndex);
+    }
+
+    Dem_EventMemoryEntryType* entry = &Dem_EventMemory[target];
+    memset(entry, 0, sizeof(*entry));
+    entry->EventIndex = index;
+    entry->FreezeFrame.TimestampNs = Os_GetTimeNs();
+    entry->FreezeFrame.OperationCycle = Dem_OperationCycle;
+    if (Dem_EventConfigs[index].CaptureFreezeFrame != NULL_PTR) {
+        Dem_EventConfigs[index].CaptureFreezeFrame(entry->FreezeFrame.Data);
+    }
+    state->MemoryIndex = target;
+    return entry;
+}
+
+/**************************************************************************
+ * @brief   Lọc kết quả kiểm tra qua bộ debounce của sự kiện
+ * @param   index           Chỉ số của sự kiện
+ * @param   EventStatus     Kết quả kiểm tra
+ * @param   NowNs           Thời điểm báo kết quả (nano giây)
+ * @param   QualifiedPtr    Con trỏ lưu kết quả sau debounce (PASSED, FAILED
+ *                          hoặc DEM_DEBOUNCE_IDLE nếu chưa đủ điều kiện)
+ * @return 	Std_ReturnType  Trả về E_OK nếu thành công,
+ *                                 E_NOT_OK nếu kết quả không hợp lệ
+ **************************************************************************/
+static Std_ReturnType Dem_Debounce(uint16 index, Dem_EventStatusType EventStatus, uint64 NowNs, Dem_EventStatusType* QualifiedPtr) {
+    const Dem_DebounceConfigType* debounce = Dem_EventConfigs[index].Debounce;
+    Dem_EventStateType* state = &Dem_EventStates[index];
+
+    if (EventStatus == DEM_EVENT_STATUS_PASSED || EventStatus == DEM_EVENT_STATUS_FAILED) {
+        state->DebounceCounter = (EventStatus == DEM_EVENT_STATUS_FAILED) ? debounce->FailedThreshold : debounce->PassedThreshold;
+        state->DebounceDirection = DEM_DEBOUNCE_IDLE;
+        *QualifiedPtr = EventStatus;
+        return E_OK;
+    }
+    if (EventStatus != DEM_EVENT_STATUS_PREPASSED && EventStatus != DEM_EVENT_STATUS_PREFAILED) {
+        return E_NOT_OK;
+    }
+
+    *QualifiedPtr = DEM_DEBOUNCE_IDLE;
+    switch (debounce->Algorithm) {
+        case DEM_DEBOUNCE_COUNTER_BASED: {
+            sint32 counter = state->DebounceCounter;
+            if (EventStatus == DEM_EVENT_STATUS_PREFAILED) {
+                counter += debounce->IncrementStep;
+                if (counter >= debounce->FailedThreshold) {
+                    counter = debounce->FailedThreshold;
+                    *QualifiedPtr = DEM_EVENT_STATUS_FAILED;
+                }
+            } else {
+                counter -= debounce->DecrementStep;
+                if (counter <= debounce->PassedThreshold) {
+                    counter = debounce->PassedThreshold;
+                    *QualifiedPtr = DEM_EVENT_STATUS_PASSED;
+                }
+            }
+            state->DebounceCounter = (sint16)counter;
+            return E_OK;
+        }
+
+        case DEM_DEBOUNCE_TIME_BASED: {
+            if (state->DebounceDirection != EventStatus) {
+                state->DebounceDirection = EventStatus;
+                state->DebounceStartNs = NowNs;
+            }
+            sint16 threshold_ms = (EventStatus == DEM_EVENT_STATUS_PREFAILED) ? debounce->FailedThreshold : debounce->PassedThreshold;
+            if (NowNs - state->DebounceStartNs >= (uint64)threshold_ms * 1000000ULL) {
+                *QualifiedPtr = (EventStatus == DEM_EVENT_STATUS_PREFAILED) ? DEM_EVENT_STATUS_FAILED : DEM_EVENT_STATUS_PASSED;
+            }
+            return E_OK;
+        }
+
+        default:
+            return E_NOT_OK;    // Bộ giám sát tự debounce không được báo PREPASSED/PREFAILED
+    }
+}
+
+/**************************************************************************
+ * @brief   Cập nhật trạng thái khi sự kiện được xác định là lỗi
+ * @param   index       Chỉ số của sự kiện
+ * @return 	None
+ **************************************************************************/
+static void Dem_ProcessFailed(uint16 index) {
+    const Dem_EventConfigType* config = &Dem_EventConfigs[index];
+    Dem_EventStateType* state = &Dem_EventStates[index];
+
+    state->Status &= (Dem_UdsStatusByteType)~(DEM_UDS_STATUS_TNCTOC | DEM_UDS_STATUS_TNCSLC);
+
+    // Lần lỗi đầu tiên trong chu kỳ vận hành
+    if ((state->Status & DEM_UDS_STATUS_TFTOC) == 0) {
+        state->Status |= DEM_UDS_STATUS_TFTOC | DEM_UDS_STATUS_PDTC;
+        if (state->FailedCycles < 0xFF) {
+            state->FailedCycles++;
+        }
+        if (state->FailedCycles >= config->ConfirmationThreshold) {
+            state->Status |= DEM_UDS_STATUS_CDTC;
+        }
+        if (state->MemoryIndex != DEM_INVALID_INDEX) {
+            Dem_EventMemory[state->MemoryIndex].AgingCounter = 0;
+        }
+    }
+
+    if (state->Status & DEM_UDS_STATUS_TF) {
+        return;     // Đã lỗi từ trước, không phải lần xuất hiện mới
+    }
+
+    state->Status |= DEM_UDS_STATUS_TF | DEM_UDS_STATUS_TFSLC;
+    Dem_EventMemoryEntryType* entry = Dem_GetMemoryEntry(index);
+    if (entry != NULL_PTR) {
+        if (entry->OccurrenceCounter < 0xFF) {
+            entry->OccurrenceCounter++;
+        }
+        entry->LastFailedNs = Os_GetTimeNs();
+    }
+
+    LOG_WARN(DEM, "Event 0x%04X failed: %s (status 0x%02X)\n", config->EventId, config->Description, state->Status);
+}
+
+/**************************************************************************
+ * @brief   Cập nhật trạng thái khi sự kiện được xác định là đạt
+ * @param   index       Chỉ số của sự kiện
+ * @return 	None
+ **************************************************************************/
+static void Dem_ProcessPassed(uint16 index) {
+    Dem_EventStateType* state = &Dem_EventStates[index];
+
+    state->Status &= (Dem_UdsStatusByteType)~(DEM_UDS_STATUS_TNCTOC | DEM_UDS_STATUS_TNCSLC);
+    if (state->Status & DEM_UDS_STATUS_TF) {
+        state->Status &= (Dem_UdsStatusByteType)~DEM_UDS_STATUS_TF;
+        LOG_INFO(DEM, "Event 0x%04X passed (status 0x%02X)\n", Dem_EventConfigs[index].EventId, state->Status);
+    }
+}
+
+/**************************************************************************
+ * @brief   Đưa trạng thái của một sự kiện về giá trị ban đầu
+ * @param   index       Chỉ số của sự kiện
+ * @return 	None
+ **************************************************************************/
+static void Dem_ResetEvent(uint16 index) {
+    Dem_EventStateType* state = &Dem_EventStates[index];
+
+    if (state->MemoryIndex != DEM_INVALID_INDEX) {
+        Dem_NvModified = TRUE;
+    }
+    Dem_FreeMemoryEntry(index);
+    state->Status = DEM_UDS_STATUS_INIT;
+    state->DebounceDirection = DEM_DEBOUNCE_IDLE;
+    state->DebounceCounter = 0;
+    state->DebounceStartNs = 0;
+    state->FailedCycles = 0;
+}
+
+/**************************************************************************
+ * @brief   Nạp bộ nhớ sự kiện đã lưu trong NvM
+ * @details Sự kiện không còn trong bảng cấu hình bị bỏ qua. Các cờ của chu
+ *          kỳ vận hành được đặt lại vì một chu kỳ mới bắt đầu khi khởi động.
+ * @param   None
+ * @return 	uint16      Số sự kiện được nạp lại
+ **************************************************************************/
+static uint16 Dem_RestoreNvData(void) {
+    uint16 restored = 0;
+
+    if (NvM_ReadBlock(NVM_BLOCK_DEM_EVENT_MEMORY, &Dem_NvData) != E_OK) {
+        return 0;
+    }
+    Dem_OperationCycle = Dem_NvData.OperationCycle;
+
+    for (uint16 i = 0; i < Dem_NvData.NumEntries && i < DEM_EVENT_MEMORY_SIZE; i++) {
+        const Dem_NvEntryType* nv_entry = &Dem_NvData.Entries[i];
+        uint16 index = Dem_FindEvent(nv_entry->EventId);
+        if (index == DEM_INVALID_INDEX || Dem_EventStates[index].MemoryIndex != DEM_INVALID_INDEX) {
+            continue;
+        }
+
+        Dem_EventStateType* state = &Dem_EventStates[index];
+        state->Status = (Dem_UdsStatusByteType)((nv_entry->Status & ~DEM_UDS_STATUS_TFTOC) | DEM_UDS_STATUS_TNCTOC);
+        state->FailedCycles = nv_entry->FailedCycles;
+        state->MemoryIndex = restored;
+
+        Dem_EventMemoryEntryType* entry = &Dem_EventMemory[restored];
+        entry->EventIndex = index;
+        entry->OccurrenceCounter = nv_entry->OccurrenceCounter;
+        entry->AgingCounter = nv_entry->AgingCounter;
+        entry->LastFailedNs = 0;    // Cũ hơn mọi lần lỗi của lần chạy này
+        entry->FreezeFrame = nv_entry->FreezeFrame;
+        restored++;
+    }
+    return restored;
+}
+
+/**************************************************************************
+ * @brief   Ghi bộ nhớ sự kiện vào NvM nếu đã thay đổi (gọi khi đang giữ Dem_Lock)
+ * @details NvM_WriteBlock chỉ sao chép vào bản sao RAM, việc ghi xuống Fee
+ *          được task nền của NvM thực hiện.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Dem_StoreNvData(void) {
+    if (!Dem_NvModified) {
+        return;
+    }
+
+    uint16 count = 0;
+    for (uint16 i = 0; i < DEM_EVENT_MEMORY_SIZE; i++) {
+        const Dem_EventMemoryEntryType* entry = &Dem_EventMemory[i];
+        if (entry->EventIndex == DEM_INVALID_INDEX) {
+            continue;
+        }
+
+        const Dem_EventStateType* state = &Dem_EventStates[entry->EventIndex];
+        Dem_NvEntryType* nv_entry = &Dem_NvData.Entries[count++];
+        nv_entry->EventId = Dem_EventConfigs[entry->EventIndex].EventId;
+        nv_entry->Status = state->Status;
+        nv_entry->FailedCycles = state->FailedCycles;
+        nv_entry->OccurrenceCounter = entry->OccurrenceCounter;
+        nv_entry->AgingCounter = entry->AgingCounter;
+        nv_entry->FreezeFrame = entry->FreezeFrame;
+    }
+    memset(&Dem_NvData.Entries[count], 0, (DEM_EVENT_MEMORY_SIZE - count) * sizeof(Dem_NvEntryType));
+    Dem_NvData.NumEntries = count;
+    Dem_NvData.OperationCycle = Dem_OperationCycle;
+
+    NvM_WriteBlock(NVM_BLOCK_DEM_EVENT_MEMORY, &Dem_NvData);
+    Dem_NvModified = FALSE;
+}
 
 /**************************************************************************
  * @brief   Khởi tạo hệ thống DEM
- * @details Hàm này được gọi một lần duy nhất khi khởi động hệ thống.
+ * @details Hàm này được gọi một lần duy nhất khi khởi động hệ thống, dựng
+ *          bảng băm từ bảng cấu hình sự kiện, nạp bộ nhớ sự kiện đã lưu
+ *          trong NvM (NvM_ReadAll phải được gọi trước) và bắt đầu một chu kỳ
+ *          vận hành mới.
  * @param   None
- * @return 	None  
+ * @return 	None
  **************************************************************************/
 void Dem_Init() {
-    printf("Diagnostic Event Manager (DEM) Initialized.\n");
-    for (uint8 i = 0; i < MAX_DIAGNOSTIC_EVENTS; i++) {
-        diagnostic_events[i].event_id = -1;
-        diagnostic_events[i].is_active = 0;
-        strcpy(diagnostic_events[i].event_description, "");
+    for (uint32 i = 0; i < DEM_HASH_TABLE_SIZE; i++) {
+        Dem_HashTable[i] = DEM_INVALID_INDEX;
+    }
+    for (uint16 i = 0; i < DEM_EVENT_MEMORY_SIZE; i++) {
+        Dem_EventMemory[i].EventIndex = DEM_INVALID_INDEX;
+    }
+    atomic_store(&Dem_SharedQueue.Head, 0);
+    atomic_store(&Dem_SharedQueue.Tail, 0);
+    for (uint32 i = 0; i < DEM_SHARED_QUEUE_SIZE; i++) {
+        atomic_store(&Dem_SharedQueue.Slots[i].Sequence, i);
     }
-    event_count = 0;
+
+    Dem_NumEvents = (Dem_EventConfigCount < DEM_MAX_EVENTS) ? Dem_EventConfigCount : DEM_MAX_EVENTS;
+    for (uint16 index = 0; index < Dem_NumEvents; index++) {
+        Dem_EventStates[index].MemoryIndex = DEM_INVALID_INDEX;
+        Dem_ResetEvent(index);
+
+        if (Dem_FindEvent(Dem_EventConfigs[index].EventId) != DEM_INVALID_INDEX) {
+            LOG_WARN(DEM, "Duplicate event ID 0x%04X ignored\n", Dem_EventConfigs[index].EventId);
+            continue;
+        }
+        uint32 slot = Dem_Hash(Dem_EventConfigs[index].EventId);
+        while (Dem_HashTable[slot] != DEM_INVALID_INDEX) {
+            slot = (slot + 1) & (DEM_HASH_TABLE_SIZE - 1);
+        }
+        Dem_HashTable[slot] = index;
+    }
+    uint16 restored = Dem_RestoreNvData();
+    Dem_OperationCycle++;
+
+    LOG_INFO(DEM, "Diagnostic Event Manager (DEM) Initialized, %u events, %u restored from NvM.\n", Dem_NumEvents, restored);
 }
 
 /**************************************************************************
- * @brief   Kích hoạt một sự kiện chẩn đoán
- * @details Hàm này được gọi khi một sự kiện chẩn đoán xảy ra.
- * @param   event_id        Mã sự kiện chẩn đoán
- * @param   description     Mô tả sự kiện chẩn đoán
- * @return 	None  
+ * @brief   Xử lý một kết quả kiểm tra (gọi khi đang giữ Dem_Lock)
+ * @details Chỉ khi trạng thái lỗi thay đổi thì mới ghi log và cập nhật bộ
+ *          nhớ sự kiện, nên bộ giám sát có thể báo kết quả mỗi chu kỳ.
+ * @param   Report      Con trỏ đến kết quả kiểm tra
+ * @return 	None
  **************************************************************************/
-void Dem_ReportErrorStatus(uint16 event_id, const char* description) {
-    if (event_count >= MAX_DIAGNOSTIC_EVENTS) {
-        printf("Cannot report more events. Maximum diagnostic events reached.\n");
+static void Dem_ProcessReport(const Dem_ReportType* Report) {
+    Dem_EventStatusType qualified;
+
+    if (Dem_Debounce(Report->EventIndex, Report->EventStatus, Report->TimestampNs, &qualified) != E_OK) {
         return;
     }
 
-    // Kiểm tra xem sự kiện đã tồn tại chưa
-    for (uint8 i = 0; i < event_count; i++) {
-        if (diagnostic_events[i].event_id == event_id) {
-            diagnostic_events[i].is_active = 1;
-            printf("Event ID %d already exists. Updating its status to active.\n", event_id);
-            return;
+    const Dem_EventStateType* state = &Dem_EventStates[Report->EventIndex];
+    Dem_UdsStatusByteType old_status = state->Status;
+    if (qualified == DEM_EVENT_STATUS_FAILED) {
+        Dem_ProcessFailed(Report->EventIndex);
+    } else if (qualified == DEM_EVENT_STATUS_PASSED) {
+        Dem_ProcessPassed(Report->EventIndex);
+    }
+
+    // Bộ đếm và freeze frame chỉ thay đổi cùng với byte trạng thái
+    if (state->Status != old_status && state->MemoryIndex != DEM_INVALID_INDEX) {
+        Dem_NvModified = TRUE;
+    }
+}
+
+/**************************************************************************
+ * @brief   Lấy hàng đợi kết quả kiểm tra của task hiện tại (cấp mới nếu chưa có)
+ * @details Khi đã hết hàng đợi riêng, task được ghi nhận là dùng hàng đợi
+ *          chung để các kết quả của task vẫn giữ đúng thứ tự.
+ * @param   None
+ * @return 	Dem_ReportQueueType*    Con trỏ đến hàng đợi riêng, NULL nếu task
+ *                                  dùng hàng đợi chung
+ **************************************************************************/
+static Dem_ReportQueueType* Dem_GetThreadQueue(void) {
+    if (Dem_ThreadQueue == NULL_PTR && !Dem_ThreadShared) {
+        uint32 index = atomic_fetch_add(&Dem_ReportQueueCount, 1);
+        if (index >= DEM_MAX_REPORTERS) {
+            atomic_store(&Dem_ReportQueueCount, DEM_MAX_REPORTERS);
+            Dem_ThreadShared = TRUE;
+            return NULL_PTR;
         }
+        Dem_ThreadQueue = &Dem_ReportQueues[index];
     }
+    return Dem_ThreadQueue;
+}
 
-    // Thêm sự kiện mới
-    diagnostic_events[event_count].event_id = event_id;
-    diagnostic_events[event_count].is_active = 1;
-    strncpy(diagnostic_events[event_count].event_description, description, sizeof(diagnostic_events[event_count].event_description) - 1);
-    event_count++;
+/**************************************************************************
+ * @brief   Đưa một kết quả kiểm tra vào hàng đợi chung
+ * @param   Report          Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu thành công, E_NOT_OK nếu hàng đợi đầy
+ **************************************************************************/
+static Std_ReturnType Dem_SharedQueuePush(const Dem_ReportType* Report) {
+    uint32 pos = atomic_load_explicit(&Dem_SharedQueue.Head, memory_order_relaxed);
+    Dem_SharedSlotType* slot;
 
-    printf("New diagnostic event reported: ID = %d, Description = %s\n", event_id, description);
+    while (1) {
+        slot = &Dem_SharedQueue.Slots[pos & (DEM_SHARED_QUEUE_SIZE - 1)];
+        sint32 diff = (sint32)(atomic_load_explicit(&slot->Sequence, memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&Dem_SharedQueue.Head, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return E_NOT_OK;    // Ô chưa được đọc: hàng đợi đầy
+        } else {
+            pos = atomic_load_explicit(&Dem_SharedQueue.Head, memory_order_relaxed);
+        }
+    }
+
+    slot->Report = *Report;
+    atomic_store_explicit(&slot->Sequence, pos + 1, memory_order_release);
+    return E_OK;
 }
 
 /**************************************************************************
- * @brief   Xóa bỏ một sự kiện chẩn đoán
- * @details Hàm này được gọi để xóa một sự kiện chẩn đoán, tức là lỗi đã được 
- *          giải quyết.
- * @param   event_id    Mã sự kiện chẩn đoán
- * @return 	None  
+ * @brief   Xử lý các kết quả đang chờ trong hàng đợi chung (gọi khi giữ Dem_Lock)
+ * @details Dừng ở ô đầu tiên chưa ghi xong, phần còn lại được xử lý ở lần
+ *          gọi sau.
+ * @param   None
+ * @return 	None
  **************************************************************************/
-void Dem_ClearErrorStatus(uint16 event_id) {
-    for (uint8 i = 0; i < event_count; i++) {
-        if (diagnostic_events[i].event_id == event_id) {
-            diagnostic_events[i].is_active = 0;
-            printf("Event ID %d cleared (no longer active).\n", event_id);
-            return;
+static void Dem_SharedQueueDrainLocked(void) {
+    uint32 pos = atomic_load_explicit(&Dem_SharedQueue.Tail, memory_order_relaxed);
+
+    while (1) {
+        Dem_SharedSlotType* slot = &Dem_SharedQueue.Slots[pos & (DEM_SHARED_QUEUE_SIZE - 1)];
+        if (atomic_load_explicit(&slot->Sequence, memory_order_acquire) != pos + 1) {
+            break;
         }
+        Dem_ProcessReport(&slot->Report);
+        atomic_store_explicit(&slot->Sequence, pos + DEM_SHARED_QUEUE_SIZE, memory_order_release);
+        pos++;
+    }
+    atomic_store_explicit(&Dem_SharedQueue.Tail, pos, memory_order_relaxed);
+}
+
+/**************************************************************************
+ * @brief   Báo kết quả kiểm tra của một sự kiện chẩn đoán (dùng cho SWC)
+ * @details Sự kiện được tra trong bảng băm (chỉ đọc sau Dem_Init) rồi kết
+ *          quả được đưa vào hàng đợi riêng của task gọi hàm, nên chi phí
+ *          không phụ thuộc vào số sự kiện, không cần khóa và các task không
+ *          tranh chấp với nhau. Task không còn hàng đợi riêng dùng hàng đợi
+ *          chung (không khóa). Dem_MainFunction xử lý kết quả sau đó.
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại, kết quả
+ *                                 không hợp lệ hoặc hàng đợi đầy
+ **************************************************************************/
+Std_ReturnType Dem_SetEventStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus) {
+    uint16 index = Dem_FindEvent(EventId);
+    if (index == DEM_INVALID_INDEX || EventStatus > DEM_EVENT_STATUS_PREFAILED) {
+        return E_NOT_OK;
+    }
+    if ((EventStatus == DEM_EVENT_STATUS_PREPASSED || EventStatus == DEM_EVENT_STATUS_PREFAILED) &&
+        Dem_EventConfigs[index].Debounce->Algorithm == DEM_DEBOUNCE_MONITOR_INTERNAL) {
+        return E_NOT_OK;    // Bộ giám sát tự debounce chỉ được báo PASSED/FAILED
+    }
+
+    Dem_ReportQueueType* queue = Dem_GetThreadQueue();
+    if (queue == NULL_PTR) {
+        Dem_ReportType shared = {index, EventStatus, Os_GetTimeNs()};
+        if (Dem_SharedQueuePush(&shared) != E_OK) {
+            atomic_fetch_add_explicit(&Dem_LostReports, 1, memory_order_relaxed);
+            return E_NOT_OK;
+        }
+        return E_OK;
+    }
+
+    uint32 head = atomic_load_explicit(&queue->Head, memory_order_relaxed);
+    uint32 tail = atomic_load_explicit(&queue->Tail, memory_order_acquire);
+    if (head - tail >= DEM_REPORT_QUEUE_SIZE) {
+        atomic_fetch_add_explicit(&Dem_LostReports, 1, memory_order_relaxed);
+        return E_NOT_OK;
     }
-    printf("Event ID %d not found.\n", event_id);
+
+    Dem_ReportType* report = &queue->Reports[head & (DEM_REPORT_QUEUE_SIZE - 1)];
+    report->EventIndex = index;
+    report->EventStatus = EventStatus;
+    report->TimestampNs = Os_GetTimeNs();
+    atomic_store_explicit(&queue->Head, head + 1, memory_order_release);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Báo kết quả kiểm tra của một sự kiện chẩn đoán (dùng cho BSW)
+ * @details Hàm này dùng chung đường báo kết quả với Dem_SetEventStatus.
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại, kết quả
+ *                                 không hợp lệ hoặc hàng đợi đầy
+ **************************************************************************/
+Std_ReturnType Dem_ReportErrorStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(EventId, EventStatus);
+}
+
+/**************************************************************************
+ * @brief   Xử lý các kết quả kiểm tra đang chờ trong hàng đợi của các task
+ * @details Hàm này được gọi định kỳ, mỗi lần xử lý hết các kết quả đang chờ
+ *          trong hàng đợi riêng rồi đến hàng đợi chung. Kết quả của cùng một
+ *          task được xử lý theo đúng thứ tự đã báo.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Dem_MainFunction() {
+    uint32 count = atomic_load_explicit(&Dem_ReportQueueCount, memory_order_acquire);
+    if (count > DEM_MAX_REPORTERS) {
+        count = DEM_MAX_REPORTERS;
+    }
+
+    pthread_mutex_lock(&Dem_Lock);
+    for (uint32 q = 0; q < count; q++) {
+        Dem_ReportQueueType* queue = &Dem_ReportQueues[q];
+        uint32 tail = atomic_load_explicit(&queue->Tail, memory_order_relaxed);
+        uint32 head = atomic_load_explicit(&queue->Head, memory_order_acquire);
+
+        while (tail != head) {
+            Dem_ProcessReport(&queue->Reports[tail & (DEM_REPORT_QUEUE_SIZE - 1)]);
+            tail++;
+        }
+        atomic_store_explicit(&queue->Tail, tail, memory_order_release);
+    }
+    Dem_SharedQueueDrainLocked();
+    Dem_StoreNvData();
+    pthread_mutex_unlock(&Dem_Lock);
+}
+
+/**************************************************************************
+ * @brief   Đọc số kết quả kiểm tra bị mất do hàng đợi đầy
+ * @param   None
+ * @return 	uint32  Số kết quả bị mất
+ **************************************************************************/
+uint32 Dem_GetLostReportCount() {
+    return atomic_load_explicit(&Dem_LostReports, memory_order_relaxed);
+}
+
+/**************************************************************************
+ * @brief   Xóa trạng thái, bộ đếm và freeze frame của một sự kiện chẩn đoán
+ * @details Hàm này được gọi khi lỗi đã được giải quyết (ví dụ: dịch vụ xóa
+ *          DTC của Dcm).
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @return 	Std_ReturnType  Trả về E_OK nếu xóa thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại
+ **************************************************************************/
+Std_ReturnType Dem_ClearErrorStatus(Dem_EventIdType EventId) {
+    uint16 index = Dem_FindEvent(EventId);
+    if (index == DEM_INVALID_INDEX) {
+        return E_NOT_OK;
+    }
+
+    pthread_mutex_lock(&Dem_Lock);
+    Dem_ResetEvent(index);
+    Dem_StoreNvData();
+    pthread_mutex_unlock(&Dem_Lock);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Xóa trạng thái, bộ đếm và freeze frame của tất cả sự kiện
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Dem_ClearAllErrorStatus() {
+    pthread_mutex_lock(&Dem_Lock);
+    for (uint16 index = 0; index < Dem_NumEvents; index++) {
+        Dem_ResetEvent(index);
+    }
+    Dem_StoreNvData();
+    pthread_mutex_unlock(&Dem_Lock);
+    LOG_INFO(DEM, "All diagnostic events cleared.\n");
 }
 
 /**************************************************************************
  * @brief   Kiểm tra trạng thái của một sự kiện chẩn đoán
  * @details Hàm này được gọi để kiểm tra xem một sự kiện chẩn đoán có đang
- *          active hay không.
- * @param   event_id    Mã sự kiện chẩn đoán
- * @return 	int         Trả về trạng thái của sự kiện: 1 - active, 
- *                                                     0 - inactive, 
- *                                                     -1 - không tồn tại  
- **************************************************************************/
-int Dem_CheckErrorStatus(uint16 event_id) {
-    for (uint8 i = 0; i < event_count; i++) {
-        if (diagnostic_events[i].event_id == event_id) {
-            if (diagnostic_events[i].is_active) {
-                printf("Event ID %d is active.\n", event_id);
-                return 1;
-            } else {
-                printf("Event ID %d is inactive.\n", event_id);
-                return 0;
-            }
+ *          lỗi (testFailed) hay không.
+ * @param   EventId     Mã sự kiện chẩn đoán
+ * @return 	int         Trả về trạng thái của sự kiện: 1 - active,
+ *                                                     0 - inactive,
+ *                                                     -1 - không tồn tại
+ **************************************************************************/
+int Dem_CheckErrorStatus(Dem_EventIdType EventId) {
+    uint16 index = Dem_FindEvent(EventId);
+    if (index == DEM_INVALID_INDEX) {
+        return -1;  // Sự kiện không tồn tại
+    }
+
+    pthread_mutex_lock(&Dem_Lock);
+    int active = (Dem_EventStates[index].Status & DEM_UDS_STATUS_TF) ? 1 : 0;
+    pthread_mutex_unlock(&Dem_Lock);
+    return active;
+}
+
+/**************************************************************************
+ * @brief   Đọc byte trạng thái UDS của một sự kiện chẩn đoán
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   StatusPtr       Con trỏ lưu byte trạng thái
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại
+ **************************************************************************/
+Std_ReturnType Dem_GetEventStatus(Dem_EventIdType EventId, Dem_UdsStatusByteType* StatusPtr) {
+    uint16 index = Dem_FindEvent(EventId);
+    if (index == DEM_INVALID_INDEX || StatusPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    pthread_mutex_lock(&Dem_Lock);
+    *StatusPtr = Dem_EventStates[index].Status;
+    pthread_mutex_unlock(&Dem_Lock);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc số lần xuất hiện lỗi của một sự kiện chẩn đoán
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   CounterPtr      Con trỏ lưu số lần xuất hiện (0 nếu chưa lỗi)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại
+ **************************************************************************/
+Std_ReturnType Dem_GetOccurrenceCounter(Dem_EventIdType EventId, uint8* CounterPtr) {
+    uint16 index = Dem_FindEvent(EventId);
+    if (index == DEM_INVALID_INDEX || CounterPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    pthread_mutex_lock(&Dem_Lock);
+    uint16 memory_index = Dem_EventStates[index].MemoryIndex;
+    *CounterPtr = (memory_index != DEM_INVALID_INDEX) ? Dem_EventMemory[memory_index].OccurrenceCounter : 0;
+    pthread_mutex_unlock(&Dem_Lock);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc freeze frame của một sự kiện chẩn đoán
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   FreezeFramePtr  Con trỏ lưu freeze frame
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại hoặc
+ *                                 không có trong bộ nhớ sự kiện
+ **************************************************************************/
+Std_ReturnType Dem_GetFreezeFrame(Dem_EventIdType EventId, Dem_FreezeFrameType* FreezeFramePtr) {
+    uint16 index = Dem_FindEvent(EventId);
+    if (index == DEM_INVALID_INDEX || FreezeFramePtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&Dem_Lock);
+    if (Dem_EventStates[index].MemoryIndex != DEM_INVALID_INDEX) {
+        *FreezeFramePtr = Dem_EventMemory[Dem_EventStates[index].MemoryIndex].FreezeFrame;
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&Dem_Lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Bắt đầu hoặc kết thúc chu kỳ vận hành
+ * @details Khi kết thúc chu kỳ, sự kiện đã được kiểm tra mà không lỗi lần
+ *          nào sẽ xóa cờ pendingDTC và tăng bộ đếm aging, khi bộ đếm đạt
+ *          AgingThreshold thì DTC được xóa khỏi bộ nhớ sự kiện. Khi bắt đầu
+ *          chu kỳ, các cờ của chu kỳ vận hành được đặt lại.
+ * @param   CycleState  Trạng thái mới của chu kỳ vận hành
+ * @return 	None
+ **************************************************************************/
+void Dem_SetOperationCycleState(Dem_OperationCycleStateType CycleState) {
+    // Các kết quả của chu kỳ cũ phải được xử lý trước khi chuyển chu kỳ
+    Dem_MainFunction();
+
+    pthread_mutex_lock(&Dem_Lock);
+    for (uint16 index = 0; index < Dem_NumEvents; index++) {
+        Dem_EventStateType* state = &Dem_EventStates[index];
+
+        if (CycleState == DEM_CYCLE_STATE_START) {
+            state->Status = (Dem_UdsStatusByteType)((state->Status & ~DEM_UDS_STATUS_TFTOC) | DEM_UDS_STATUS_TNCTOC);
+            continue;
+        }
+
+        // Chỉ xét các sự kiện đã được kiểm tra và không lỗi trong chu kỳ
+        if (state->Status & (DEM_UDS_STATUS_TFTOC | DEM_UDS_STATUS_TNCTOC)) {
+            continue;
+        }
+        state->Status &= (Dem_UdsStatusByteType)~DEM_UDS_STATUS_PDTC;
+        if (state->MemoryIndex == DEM_INVALID_INDEX) {
+            continue;
+        }
+
+        Dem_EventMemoryEntryType* entry = &Dem_EventMemory[state->MemoryIndex];
+        if (entry->AgingCounter < 0xFF) {
+            entry->AgingCounter++;
         }
+        if (entry->AgingCounter >= Dem_EventConfigs[index].AgingThreshold) {
+            state->Status &= (Dem_UdsStatusByteType)~DEM_UDS_STATUS_CDTC;
+            state->FailedCycles = 0;
+            Dem_FreeMemoryEntry(index);
+            LOG_INFO(DEM, "Event 0x%04X aged out of event memory\n", Dem_EventConfigs[index].EventId);
+        }
+    }
+
+    if (CycleState == DEM_CYCLE_STATE_START) {
+        Dem_OperationCycle++;
+        LOG_INFO(DEM, "Operation cycle %u started\n", Dem_OperationCycle);
+    } else {
+        LOG_INFO(DEM, "Operation cycle %u ended, %u test results lost\n", Dem_OperationCycle, Dem_GetLostReportCount());
     }
-    printf("Event ID %d not found.\n", event_id);
-    return -1;  // Sự kiện không tồn tại
+    Dem_NvModified = TRUE;
+    Dem_StoreNvData();
+    pthread_mutex_unlock(&Dem_Lock);
 }
 
 /**************************************************************************
  * @brief   In ra danh sách sự kiện chẩn đoán
- * @details Hàm này in ra toàn bộ danh sách các sự kiện chẩn đoán.
+ * @details Hàm này in ra các sự kiện đã từng lỗi kể từ lần xóa gần nhất.
  * @param   None
- * @return 	None 
+ * @return 	None
  **************************************************************************/
 void Dem_PrintEventList() {
-    printf("Diagnostic Events List:\n");
-    for (uint8 i = 0; i < event_count; i++) {
-        printf("ID: %d, Description: %s, Status: %s\n",
-               diagnostic_events[i].event_id,
-               diagnostic_events[i].event_description,
-               diagnostic_events[i].is_active ? "Active" : "Inactive");
-    }
-}
\ No newline at end of file
+    pthread_mutex_lock(&Dem_Lock);
+    LOG_INFO(DEM, "Diagnostic Events List:\n");
+    for (uint16 index = 0; index < Dem_NumEvents; index++) {
+        const Dem_EventStateType* state = &Dem_EventStates[index];
+        if ((state->Status & DEM_UDS_STATUS_TFSLC) == 0) {
+            continue;
+        }
+
+        uint8 occurrences = (state->MemoryIndex != DEM_INVALID_INDEX) ? Dem_EventMemory[state->MemoryIndex].OccurrenceCounter : 0;
+        LOG_INFO(DEM, "ID: 0x%04X, Status: 0x%02X, Occurrences: %u, Description: %s\n",
+                 Dem_EventConfigs[index].EventId, state->Status, occurrences, Dem_EventConfigs[index].Description);
+    }
+    pthread_mutex_unlock(&Dem_Lock);
+}
@@ -6,58 +6,251 @@
 #include "Std_Types.h"
 
 /**************************************************************************
- * @brief Định nghĩa số lượng sự kiện chẩn đoán tối đa có thể theo dõi
+ * @brief Giới hạn của DEM
  **************************************************************************/
-#define MAX_DIAGNOSTIC_EVENTS 10
+#define DEM_MAX_EVENTS              4096    /* Số sự kiện chẩn đoán được cấu hình tối đa */
+#define DEM_HASH_TABLE_SIZE         8192    /* Kích thước bảng băm tra sự kiện theo ID (lũy thừa của 2, >= 2 * DEM_MAX_EVENTS) */
+#define DEM_EVENT_MEMORY_SIZE       32      /* Số sự kiện được lưu bộ đếm và freeze frame cùng lúc */
+#define DEM_FREEZE_FRAME_DATA_SIZE  8       /* Số byte dữ liệu của một freeze frame */
+#define DEM_REPORT_QUEUE_SIZE       64      /* Số kết quả chờ xử lý trong hàng đợi của một task (lũy thừa của 2) */
+#define DEM_MAX_REPORTERS           16      /* Số task tối đa có hàng đợi báo kết quả riêng */
+#define DEM_SHARED_QUEUE_SIZE       256     /* Số kết quả chờ xử lý trong hàng đợi chung của các task còn lại (lũy thừa của 2) */
 
 /**************************************************************************
- * @struct  Dem_EventType
- * @brief   Cấu trúc mô phỏng sự kiện chẩn đoán
- * @details Kiểu dữ liệu này được sử dụng để biểu diễn một sự kiện chẩn đoán 
- *          bao gồm mã sự kiện, mô tả và trạng thái.
+ * @typedef Dem_EventIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho mã sự kiện chẩn đoán
+ **************************************************************************/
+typedef uint16 Dem_EventIdType;
+
+/**************************************************************************
+ * @typedef Dem_EventStatusType
+ * @brief   Định nghĩa kết quả kiểm tra mà bộ giám sát báo cho DEM
+ * @details PASSED/FAILED là kết quả đã chắc chắn, PREPASSED/PREFAILED là
+ *          kết quả của một lần kiểm tra và được lọc qua bộ debounce.
+ **************************************************************************/
+typedef uint8 Dem_EventStatusType;
+#define DEM_EVENT_STATUS_PASSED     (Dem_EventStatusType)0x00   /* Kiểm tra đạt */
+#define DEM_EVENT_STATUS_FAILED     (Dem_EventStatusType)0x01   /* Kiểm tra lỗi */
+#define DEM_EVENT_STATUS_PREPASSED  (Dem_EventStatusType)0x02   /* Một lần kiểm tra đạt (cần debounce) */
+#define DEM_EVENT_STATUS_PREFAILED  (Dem_EventStatusType)0x03   /* Một lần kiểm tra lỗi (cần debounce) */
+
+/**************************************************************************
+ * @typedef Dem_UdsStatusByteType
+ * @brief   Định nghĩa byte trạng thái của sự kiện theo chuẩn UDS (ISO 14229)
+ **************************************************************************/
+typedef uint8 Dem_UdsStatusByteType;
+#define DEM_UDS_STATUS_TF       (Dem_UdsStatusByteType)0x01     /* testFailed */
+#define DEM_UDS_STATUS_TFTOC    (Dem_UdsStatusByteType)0x02     /* testFailedThisOperationCycle */
+#define DEM_UDS_STATUS_PDTC     (Dem_UdsStatusByteType)0x04     /* pendingDTC */
+#define DEM_UDS_STATUS_CDTC     (Dem_UdsStatusByteType)0x08     /* confirmedDTC */
+#define DEM_UDS_STATUS_TNCSLC   (Dem_UdsStatusByteType)0x10     /* testNotCompletedSinceLastClear */
+#define DEM_UDS_STATUS_TFSLC    (Dem_UdsStatusByteType)0x20     /* testFailedSinceLastClear */
+#define DEM_UDS_STATUS_TNCTOC   (Dem_UdsStatusByteType)0x40     /* testNotCompletedThisOperationCycle */
+#define DEM_UDS_STATUS_WIR      (Dem_UdsStatusByteType)0x80     /* warningIndicatorRequested */
+
+/**************************************************************************
+ * @enum    Dem_DebounceAlgorithmType
+ * @brief   Định nghĩa thuật toán debounce của một sự kiện
+ **************************************************************************/
+typedef enum {
+    DEM_DEBOUNCE_MONITOR_INTERNAL = 0,  /* Bộ giám sát tự debounce, chỉ báo PASSED/FAILED */
+    DEM_DEBOUNCE_COUNTER_BASED = 1,     /* Đếm số lần PREFAILED/PREPASSED */
+    DEM_DEBOUNCE_TIME_BASED = 2         /* Đo thời gian PREFAILED/PREPASSED liên tục */
+} Dem_DebounceAlgorithmType;
+
+/**************************************************************************
+ * @struct  Dem_DebounceConfigType
+ * @brief   Cấu hình một lớp debounce, dùng chung cho nhiều sự kiện
+ * @details Với DEM_DEBOUNCE_COUNTER_BASED, bộ đếm tăng IncrementStep mỗi lần
+ *          PREFAILED và giảm DecrementStep mỗi lần PREPASSED, sự kiện lỗi
+ *          khi bộ đếm đạt FailedThreshold và đạt khi bộ đếm xuống đến
+ *          PassedThreshold (số âm). Với DEM_DEBOUNCE_TIME_BASED, ngưỡng là
+ *          thời gian (ms) báo PREFAILED/PREPASSED liên tục.
+ **************************************************************************/
+typedef struct {
+    Dem_DebounceAlgorithmType Algorithm;    /* Thuật toán debounce */
+    sint16 FailedThreshold;                 /* Ngưỡng lỗi (giá trị bộ đếm hoặc ms) */
+    sint16 PassedThreshold;                 /* Ngưỡng đạt (giá trị bộ đếm âm hoặc ms) */
+    sint16 IncrementStep;                   /* Bước tăng của bộ đếm khi PREFAILED */
+    sint16 DecrementStep;                   /* Bước giảm của bộ đếm khi PREPASSED */
+} Dem_DebounceConfigType;
+
+/**************************************************************************
+ * @typedef Dem_FreezeFrameCaptureType
+ * @brief   Định nghĩa kiểu hàm chụp dữ liệu freeze frame khi sự kiện lỗi
+ * @details Hàm ghi tối đa DEM_FREEZE_FRAME_DATA_SIZE byte vào DataPtr.
+ **************************************************************************/
+typedef void (*Dem_FreezeFrameCaptureType)(uint8* DataPtr);
+
+/**************************************************************************
+ * @struct  Dem_EventConfigType
+ * @brief   Cấu hình một sự kiện chẩn đoán
+ **************************************************************************/
+typedef struct {
+    Dem_EventIdType EventId;                        /* Mã sự kiện chẩn đoán */
+    const char* Description;                        /* Mô tả sự kiện (chuỗi hằng) */
+    const Dem_DebounceConfigType* Debounce;         /* Lớp debounce của sự kiện */
+    uint8 ConfirmationThreshold;                    /* Số chu kỳ vận hành có lỗi để xác nhận DTC */
+    uint8 AgingThreshold;                           /* Số chu kỳ vận hành không lỗi để xóa DTC đã xác nhận */
+    Dem_FreezeFrameCaptureType CaptureFreezeFrame;  /* Hàm chụp dữ liệu freeze frame (có thể NULL) */
+} Dem_EventConfigType;
+
+/**************************************************************************
+ * @struct  Dem_FreezeFrameType
+ * @brief   Cấu trúc lưu ảnh chụp trạng thái hệ thống khi sự kiện lỗi lần đầu
+ **************************************************************************/
+typedef struct {
+    uint64 TimestampNs;                             /* Thời gian hệ thống khi chụp (nano giây) */
+    uint32 OperationCycle;                          /* Số thứ tự của chu kỳ vận hành khi chụp */
+    uint8 Data[DEM_FREEZE_FRAME_DATA_SIZE];         /* Dữ liệu do hàm CaptureFreezeFrame ghi */
+} Dem_FreezeFrameType;
+
+/**************************************************************************
+ * @struct  Dem_NvEntryType
+ * @brief   Một phần tử bộ nhớ sự kiện được lưu vào NvM
+ **************************************************************************/
+typedef struct {
+    Dem_EventIdType EventId;                        /* Mã sự kiện chẩn đoán */
+    Dem_UdsStatusByteType Status;                   /* Byte trạng thái UDS */
+    uint8 FailedCycles;                             /* Số chu kỳ vận hành có lỗi */
+    uint8 OccurrenceCounter;                        /* Số lần sự kiện chuyển sang lỗi */
+    uint8 AgingCounter;                             /* Số chu kỳ vận hành liên tiếp không lỗi */
+    Dem_FreezeFrameType FreezeFrame;                /* Freeze frame chụp khi lỗi lần đầu */
+} Dem_NvEntryType;
+
+/**************************************************************************
+ * @struct  Dem_NvDataType
+ * @brief   Dữ liệu của DEM được lưu vào khối NvM để giữ DTC qua các lần
+ *          khởi động
  **************************************************************************/
 typedef struct {
-    uint16 event_id;                /* Mã sự kiện chẩn đoán */
-    char event_description[50];     /* Mô tả sự kiện */
-    uint8 is_active;                /* Trạng thái sự kiện: 1 - active (có lỗi), 0 - inactive (không có lỗi) */
-} Dem_EventType;
+    uint32 OperationCycle;                          /* Số thứ tự của chu kỳ vận hành gần nhất */
+    uint16 NumEntries;                              /* Số phần tử hợp lệ trong Entries */
+    Dem_NvEntryType Entries[DEM_EVENT_MEMORY_SIZE];
+} Dem_NvDataType;
+
+/**************************************************************************
+ * @enum    Dem_OperationCycleStateType
+ * @brief   Định nghĩa trạng thái của chu kỳ vận hành
+ **************************************************************************/
+typedef enum {
+    DEM_CYCLE_STATE_START = 0,  /* Bắt đầu chu kỳ vận hành */
+    DEM_CYCLE_STATE_END = 1     /* Kết thúc chu kỳ vận hành */
+} Dem_OperationCycleStateType;
+
+/**************************************************************************
+ * @brief Bảng cấu hình sự kiện được sinh ra (Dem_Cfg.c)
+ **************************************************************************/
+extern const Dem_EventConfigType Dem_EventConfigs[];
+extern const uint16 Dem_EventConfigCount;
 
 /**************************************************************************
  * @brief   Khởi tạo hệ thống DEM
  * @param   None
- * @return 	None  
+ * @return 	None
  **************************************************************************/
 void Dem_Init(void);
 
 /**************************************************************************
- * @brief   Kích hoạt một sự kiện chẩn đoán
- * @param   event_id        Mã sự kiện chẩn đoán
- * @param   description     Mô tả sự kiện chẩn đoán
- * @return 	None  
+ * @brief   Báo kết quả kiểm tra của một sự kiện chẩn đoán (dùng cho SWC)
+ * @details Kết quả được đưa vào hàng đợi riêng của task gọi hàm và được xử
+ *          lý trong Dem_MainFunction, hàm không bao giờ bị chặn.
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại, kết quả
+ *                                 không hợp lệ hoặc hàng đợi đầy
+ **************************************************************************/
+Std_ReturnType Dem_SetEventStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief   Báo kết quả kiểm tra của một sự kiện chẩn đoán (dùng cho BSW)
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được đưa vào hàng đợi,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại, kết quả
+ *                                 không hợp lệ hoặc hàng đợi đầy
+ **************************************************************************/
+Std_ReturnType Dem_ReportErrorStatus(Dem_EventIdType EventId, Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief   Xử lý các kết quả kiểm tra đang chờ trong hàng đợi của các task
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Dem_MainFunction(void);
+
+/**************************************************************************
+ * @brief   Đọc số kết quả kiểm tra bị mất do hàng đợi đầy
+ * @param   None
+ * @return 	uint32  Số kết quả bị mất
+ **************************************************************************/
+uint32 Dem_GetLostReportCount(void);
+
+/**************************************************************************
+ * @brief   Xóa trạng thái, bộ đếm và freeze frame của một sự kiện chẩn đoán
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @return 	Std_ReturnType  Trả về E_OK nếu xóa thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại
  **************************************************************************/
-void Dem_ReportErrorStatus(uint16 event_id, const char* description);
+Std_ReturnType Dem_ClearErrorStatus(Dem_EventIdType EventId);
 
 /**************************************************************************
- * @brief   Xóa bỏ một sự kiện chẩn đoán
- * @param   event_id    Mã sự kiện chẩn đoán
- * @return 	None  
+ * @brief   Xóa trạng thái, bộ đếm và freeze frame của tất cả sự kiện
+ * @param   None
+ * @return 	None
  **************************************************************************/
-void Dem_ClearErrorStatus(uint16 event_id);
+void Dem_ClearAllErrorStatus(void);
 
 /**************************************************************************
  * @brief   Kiểm tra trạng thái của một sự kiện chẩn đoán
- * @param   event_id    Mã sự kiện chẩn đoán
- * @return 	int         Trả về trạng thái của sự kiện: 1 - active, 
- *                                                     0 - inactive, 
- *                                                     -1 - không tồn tại  
+ * @param   EventId     Mã sự kiện chẩn đoán
+ * @return 	int         Trả về trạng thái của sự kiện: 1 - active,
+ *                                                     0 - inactive,
+ *                                                     -1 - không tồn tại
+ **************************************************************************/
+int Dem_CheckErrorStatus(Dem_EventIdType EventId);
+
+/**************************************************************************
+ * @brief   Đọc byte trạng thái UDS của một sự kiện chẩn đoán
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   StatusPtr       Con trỏ lưu byte trạng thái
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại
+ **************************************************************************/
+Std_ReturnType Dem_GetEventStatus(Dem_EventIdType EventId, Dem_UdsStatusByteType* StatusPtr);
+
+/**************************************************************************
+ * @brief   Đọc số lần xuất hiện lỗi của một sự kiện chẩn đoán
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   CounterPtr      Con trỏ lưu số lần xuất hiện (0 nếu chưa lỗi)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại
+ **************************************************************************/
+Std_ReturnType Dem_GetOccurrenceCounter(Dem_EventIdType EventId, uint8* CounterPtr);
+
+/**************************************************************************
+ * @brief   Đọc freeze frame của một sự kiện chẩn đoán
+ * @param   EventId         Mã sự kiện chẩn đoán
+ * @param   FreezeFramePtr  Con trỏ lưu freeze frame
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu sự kiện không tồn tại hoặc
+ *                                 không có trong bộ nhớ sự kiện
+ **************************************************************************/
+Std_ReturnType Dem_GetFreezeFrame(Dem_EventIdType EventId, Dem_FreezeFrameType* FreezeFramePtr);
+
+/**************************************************************************
+ * @brief   Bắt đầu hoặc kết thúc chu kỳ vận hành
+ * @param   CycleState  Trạng thái mới của chu kỳ vận hành
+ * @return 	None
  **************************************************************************/
-int Dem_CheckErrorStatus(uint16 event_id);
+void Dem_SetOperationCycleState(Dem_OperationCycleStateType CycleState);
 
 /**************************************************************************
  * @brief   In ra danh sách sự kiện chẩn đoán
  * @param   None
- * @return 	None 
+ * @return 	None
  **************************************************************************/
 void Dem_PrintEventList(void);
 
-#endif /* DEM_H */ 
\ No newline at end of file
+#endif /* DEM_H */
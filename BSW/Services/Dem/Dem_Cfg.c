@@ -0,0 +1,37 @@
+#include "Dem_Cfg.h"
+
+/**************************************************************************
+ * @brief Các lớp debounce
+ **************************************************************************/
+static const Dem_DebounceConfigType Dem_Debounce_MonitorInternal = {
+    DEM_DEBOUNCE_MONITOR_INTERNAL, 0, 0, 0, 0
+};
+
+/* Cảm biến: lỗi sau 3 lần đọc lỗi liên tiếp, đạt sau 3 lần đọc đúng */
+static const Dem_DebounceConfigType Dem_Debounce_Sensor = {
+    DEM_DEBOUNCE_COUNTER_BASED, 3, -3, 1, 1
+};
+
+/* Tình trạng vật lý: lỗi khi kéo dài 2 giây, đạt khi bình thường 1 giây */
+static const Dem_DebounceConfigType Dem_Debounce_Condition = {
+    DEM_DEBOUNCE_TIME_BASED, 2000, 1000, 0, 0
+};
+
+/**************************************************************************
+ * @brief Bảng cấu hình các sự kiện chẩn đoán
+ **************************************************************************/
+const Dem_EventConfigType Dem_EventConfigs[] = {
+    {DEM_EVENT_THROTTLE_SENSOR, "Throttle sensor read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_SPEED_SENSOR, "Speed sensor read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_LOAD_SENSOR, "Load sensor read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_TORQUE_SENSOR, "Torque sensor read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_BRAKE_SENSOR, "Brake sensor read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_INCLINATION_SENSOR, "Inclination sensor read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_BATTERY_SENSOR, "Battery state read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_WHEEL_SPEED_SENSOR, "Wheel angular velocity sensor read failure", &Dem_Debounce_Sensor, 1, 40, NULL_PTR},
+    {DEM_EVENT_MOTOR_DRIVER, "Motor driver command failure", &Dem_Debounce_MonitorInternal, 1, 40, NULL_PTR},
+    {DEM_EVENT_BATTERY_OVER_TEMP, "Battery over temperature", &Dem_Debounce_Condition, 2, 40, NULL_PTR},
+    {DEM_EVENT_PEDAL_CONFLICT, "Accelerator and brake pressed together", &Dem_Debounce_Condition, 2, 40, NULL_PTR},
+    {DEM_EVENT_HIGH_WHEEL_SLIP, "High wheel slip", &Dem_Debounce_Condition, 2, 40, NULL_PTR},
+};
+const uint16 Dem_EventConfigCount = sizeof(Dem_EventConfigs) / sizeof(Dem_EventConfigs[0]);
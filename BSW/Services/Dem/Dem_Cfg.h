@@ -0,0 +1,22 @@
+#ifndef DEM_CFG_H
+#define DEM_CFG_H
+
+#include "Dem.h"
+
+/**************************************************************************
+ * @brief Định nghĩa mã của các sự kiện chẩn đoán
+ **************************************************************************/
+#define DEM_EVENT_THROTTLE_SENSOR       (Dem_EventIdType)0x0101     /* Lỗi đọc cảm biến bàn đạp ga */
+#define DEM_EVENT_SPEED_SENSOR          (Dem_EventIdType)0x0102     /* Lỗi đọc cảm biến tốc độ */
+#define DEM_EVENT_LOAD_SENSOR           (Dem_EventIdType)0x0103     /* Lỗi đọc cảm biến tải trọng */
+#define DEM_EVENT_TORQUE_SENSOR         (Dem_EventIdType)0x0104     /* Lỗi đọc cảm biến mô-men xoắn */
+#define DEM_EVENT_BRAKE_SENSOR          (Dem_EventIdType)0x0105     /* Lỗi đọc cảm biến bàn đạp phanh */
+#define DEM_EVENT_INCLINATION_SENSOR    (Dem_EventIdType)0x0106     /* Lỗi đọc cảm biến góc nghiêng */
+#define DEM_EVENT_BATTERY_SENSOR        (Dem_EventIdType)0x0107     /* Lỗi đọc trạng thái pin */
+#define DEM_EVENT_WHEEL_SPEED_SENSOR    (Dem_EventIdType)0x0108     /* Lỗi đọc cảm biến vận tốc góc bánh xe */
+#define DEM_EVENT_MOTOR_DRIVER          (Dem_EventIdType)0x0201     /* Lỗi gửi mô-men xoắn đến động cơ */
+#define DEM_EVENT_BATTERY_OVER_TEMP     (Dem_EventIdType)0x0202     /* Nhiệt độ pin quá cao */
+#define DEM_EVENT_PEDAL_CONFLICT        (Dem_EventIdType)0x0301     /* Bàn đạp ga và phanh được nhấn cùng lúc */
+#define DEM_EVENT_HIGH_WHEEL_SLIP       (Dem_EventIdType)0x0302     /* Độ trượt bánh xe cao */
+
+#endif /* DEM_CFG_H */
@@ -0,0 +1,475 @@
+#include "Log.h"
+#include "Os.h"
+#include <string.h>
+#include <time.h>
+
+/**************************************************************************
+ * @enum    Log_ArgClassType
+ * @brief   Kiểu của một tham số, xác định từ chuỗi định dạng
+ **************************************************************************/
+typedef enum {
+    LOG_ARG_NONE = 0,       /* Không có tham số (%%) */
+    LOG_ARG_INT,            /* int, unsigned int, char, short */
+    LOG_ARG_LONG,           /* long, unsigned long */
+    LOG_ARG_LLONG,          /* long long, unsigned long long */
+    LOG_ARG_SIZE,           /* size_t */
+    LOG_ARG_DOUBLE,         /* double, float */
+    LOG_ARG_STRING,         /* chuỗi (%s), được sao chép vào bản ghi */
+    LOG_ARG_POINTER         /* con trỏ (%p) */
+} Log_ArgClassType;
+
+/**************************************************************************
+ * @enum    Log_RingStateType
+ * @brief   Trạng thái cấp phát của một bộ đệm log
+ **************************************************************************/
+typedef enum {
+    LOG_RING_FREE = 0,      /* Chưa cấp cho luồng nào */
+    LOG_RING_USED = 1,      /* Đang được một luồng ghi */
+    LOG_RING_RELEASED = 2   /* Luồng sở hữu đã kết thúc, chờ in hết rồi thu hồi */
+} Log_RingStateType;
+
+/**************************************************************************
+ * @brief Tên hiển thị của các module và các mức log
+ **************************************************************************/
+static const char* const log_module_names[LOG_MODULE_COUNT] = {
+    "OS", "ADC", "CAN", "DIO", "PWM", "IOHWAB", "RTE", "SWC", "PDUR", "DEM", "FEE", "NVM", "MEM"
+};
+static const char* const log_level_names[] = {
+    "OFF", "ERROR", "WARN", "INFO", "DEBUG"
+};
+
+/**************************************************************************
+ * @brief Bộ đệm log của các luồng
+ * @details log_ring_key gọi Log_ReleaseRing khi luồng sở hữu bộ đệm kết thúc.
+ **************************************************************************/
+static Log_RingType log_rings[LOG_MAX_THREADS];
+static atomic_uint log_ring_count = 0;              /* Số bộ đệm đã từng được cấp (mức cao nhất) */
+static atomic_uint log_orphan_dropped = 0;          /* Bản ghi bị bỏ do hết bộ đệm cho luồng mới */
+static uint32 log_reported_dropped = 0;             /* Số bản ghi bị bỏ đã được cảnh báo (luồng định dạng) */
+static __thread Log_RingType* log_thread_ring = NULL_PTR;
+static pthread_key_t log_ring_key;
+static pthread_once_t log_key_once = PTHREAD_ONCE_INIT;
+static boolean log_key_valid = FALSE;
+
+/**************************************************************************
+ * @brief Luồng định dạng log
+ **************************************************************************/
+static pthread_t log_drain_thread;
+static pthread_once_t log_init_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t log_drain_lock = PTHREAD_MUTEX_INITIALIZER;    /* Chỉ một luồng định dạng tại một thời điểm */
+
+/**************************************************************************
+ * @brief   Phân tích một đặc tả định dạng bắt đầu bằng '%'
+ * @param   Spec        Con trỏ đến ký tự '%'
+ * @param   ClassPtr    Con trỏ lưu kiểu tham số của đặc tả
+ * @return 	const char* Con trỏ đến ký tự ngay sau đặc tả
+ **************************************************************************/
+static const char* Log_ParseSpec(const char* Spec, Log_ArgClassType* ClassPtr) {
+    const char* p = Spec + 1;
+    uint8 long_count = 0;
+    boolean is_size = FALSE;
+
+    // Bỏ qua cờ, độ rộng và độ chính xác
+    while (*p != '\0' && strchr("-+ #0", *p) != NULL_PTR) p++;
+    while (*p >= '0' && *p <= '9') p++;
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+
+    // Độ dài của tham số
+    while (*p == 'h' || *p == 'l' || *p == 'z' || *p == 'L') {
+        if (*p == 'l') long_count++;
+        if (*p == 'z') is_size = TRUE;
+        p++;
+    }
+
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            *ClassPtr = is_size ? LOG_ARG_SIZE :
+                        (long_count >= 2) ? LOG_ARG_LLONG :
+                        (long_count == 1) ? LOG_ARG_LONG : LOG_ARG_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            *ClassPtr = LOG_ARG_DOUBLE;
+            break;
+        case 's':
+            *ClassPtr = LOG_ARG_STRING;
+            break;
+        case 'p':
+            *ClassPtr = LOG_ARG_POINTER;
+            break;
+        default:
+            *ClassPtr = LOG_ARG_NONE;   // %% hoặc đặc tả không hỗ trợ
+            break;
+    }
+
+    return (*p != '\0') ? p + 1 : p;
+}
+
+/**************************************************************************
+ * @brief   Trả bộ đệm log khi luồng sở hữu kết thúc (destructor của log_ring_key)
+ * @details Bộ đệm chỉ được đánh dấu, luồng định dạng thu hồi sau khi in hết
+ *          các bản ghi còn lại.
+ * @param   arg     Con trỏ đến bộ đệm của luồng
+ * @return 	None
+ **************************************************************************/
+static void Log_ReleaseRing(void* arg) {
+    Log_RingType* ring = (Log_RingType*)arg;
+    atomic_store_explicit(&ring->State, LOG_RING_RELEASED, memory_order_release);
+}
+
+/**************************************************************************
+ * @brief   Tạo khóa TLS để biết khi nào luồng kết thúc (chỉ gọi một lần)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Log_CreateRingKey(void) {
+    log_key_valid = (pthread_key_create(&log_ring_key, Log_ReleaseRing) == 0) ? TRUE : FALSE;
+}
+
+/**************************************************************************
+ * @brief   Lấy bộ đệm log của luồng hiện tại (cấp mới nếu chưa có)
+ * @details Bộ đệm trống được tìm trong các bộ đệm đã thu hồi trước, rồi mới
+ *          đến các bộ đệm chưa từng được cấp.
+ * @param   None
+ * @return 	Log_RingType*   Con trỏ đến bộ đệm, NULL nếu đã hết bộ đệm
+ **************************************************************************/
+static Log_RingType* Log_GetThreadRing(void) {
+    if (log_thread_ring != NULL_PTR) {
+        return log_thread_ring;
+    }
+
+    pthread_once(&log_key_once, Log_CreateRingKey);
+    for (uint32 i = 0; i < LOG_MAX_THREADS; i++) {
+        uint32 expected = LOG_RING_FREE;
+        if (atomic_compare_exchange_strong(&log_rings[i].State, &expected, LOG_RING_USED)) {
+            // Cập nhật mức cao nhất để luồng định dạng duyệt đến bộ đệm này
+            uint32 count = atomic_load(&log_ring_count);
+            while (count < i + 1 && !atomic_compare_exchange_weak(&log_ring_count, &count, i + 1)) {
+            }
+            log_thread_ring = &log_rings[i];
+            if (log_key_valid) {
+                pthread_setspecific(log_ring_key, log_thread_ring);
+            }
+            return log_thread_ring;
+        }
+    }
+    return NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Ghi một bản ghi log vào bộ đệm của luồng hiện tại
+ * @details Hàm này chỉ lưu giá trị thô của các tham số theo kiểu trong chuỗi
+ *          định dạng (tham số chuỗi được sao chép), không định dạng chuỗi,
+ *          không khóa và không bao giờ bị chặn. Nếu bộ đệm đầy thì bản ghi
+ *          bị bỏ và được đếm lại.
+ * @param   Module      Module ghi log
+ * @param   Level       Mức log
+ * @param   Format      Chuỗi định dạng kiểu printf (chuỗi hằng)
+ * @return 	None
+ **************************************************************************/
+void Log_Write(Log_ModuleIdType Module, uint8 Level, const char* Format, ...) {
+    Log_RingType* ring = Log_GetThreadRing();
+    if (ring == NULL_PTR) {
+        atomic_fetch_add_explicit(&log_orphan_dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    uint32 head = atomic_load_explicit(&ring->Head, memory_order_relaxed);
+    uint32 tail = atomic_load_explicit(&ring->Tail, memory_order_acquire);
+    if (head - tail >= LOG_RING_SIZE) {
+        atomic_fetch_add_explicit(&ring->Dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    Log_RecordType* record = &ring->Records[head & (LOG_RING_SIZE - 1)];
+    record->Format = Format;
+    record->TimestampNs = Os_GetTimeNs();
+    record->Module = Module;
+    record->Level = Level;
+
+    // Lưu giá trị thô của các tham số theo kiểu trong chuỗi định dạng
+    va_list args;
+    va_start(args, Format);
+    uint8 arg_count = 0;
+    uint32 string_len = 0;
+    const char* p = Format;
+    while (*p != '\0' && arg_count < LOG_MAX_ARGS) {
+        if (*p != '%') {
+            p++;
+            continue;
+        }
+
+        Log_ArgClassType arg_class;
+        p = Log_ParseSpec(p, &arg_class);
+        switch (arg_class) {
+            case LOG_ARG_INT:
+                record->Args[arg_count++] = (uint64)(sint64)va_arg(args, int);
+                break;
+            case LOG_ARG_LONG:
+                record->Args[arg_count++] = (uint64)va_arg(args, long);
+                break;
+            case LOG_ARG_LLONG:
+                record->Args[arg_count++] = (uint64)va_arg(args, long long);
+                break;
+            case LOG_ARG_SIZE:
+                record->Args[arg_count++] = (uint64)va_arg(args, size_t);
+                break;
+            case LOG_ARG_DOUBLE: {
+                double value = va_arg(args, double);
+                memcpy(&record->Args[arg_count++], &value, sizeof(value));
+                break;
+            }
+            case LOG_ARG_STRING: {
+                // Sao chép chuỗi, cắt bớt nếu không đủ chỗ
+                const char* str = va_arg(args, const char*);
+                if (str == NULL_PTR) {
+                    str = "(null)";
+                }
+                uint32 start = (string_len < LOG_STRING_SIZE) ? string_len : LOG_STRING_SIZE - 1U;
+                uint32 room = LOG_STRING_SIZE - 1U - start;
+                size_t len = strnlen(str, room);
+                memcpy(&record->Strings[start], str, len);
+                record->Strings[start + len] = '\0';
+                string_len = start + (uint32)len + 1U;
+                record->Args[arg_count++] = start;
+                break;
+            }
+            case LOG_ARG_POINTER:
+                record->Args[arg_count++] = (uint64)(uintptr_t)va_arg(args, const void*);
+                break;
+            default:
+                break;
+        }
+    }
+    va_end(args);
+
+    atomic_store_explicit(&ring->Head, head + 1, memory_order_release);
+}
+
+/**************************************************************************
+ * @brief   Định dạng một bản ghi log và in ra màn hình console
+ * @param   record      Con trỏ đến bản ghi cần định dạng
+ * @return 	None
+ **************************************************************************/
+static void Log_FormatRecord(const Log_RecordType* record) {
+    char line[512];
+    char spec[32];
+    size_t len = 0;
+    uint8 arg_index = 0;
+
+    len += snprintf(line, sizeof(line), "[%10.6f][%-6s][%-5s] ",
+                    (double)record->TimestampNs / 1e9,
+                    (record->Module < LOG_MODULE_COUNT) ? log_module_names[record->Module] : "?",
+                    (record->Level <= LOG_LEVEL_DEBUG) ? log_level_names[record->Level] : "?");
+
+    const char* p = record->Format;
+    while (*p != '\0' && len < sizeof(line) - 1) {
+        if (*p != '%') {
+            line[len++] = *p++;
+            continue;
+        }
+
+        Log_ArgClassType arg_class;
+        const char* end = Log_ParseSpec(p, &arg_class);
+        size_t spec_len = (size_t)(end - p);
+        if (spec_len >= sizeof(spec)) {
+            spec_len = sizeof(spec) - 1;
+        }
+        memcpy(spec, p, spec_len);
+        spec[spec_len] = '\0';
+        p = end;
+
+        size_t room = sizeof(line) - len;
+        int written = 0;
+        if (arg_class == LOG_ARG_NONE) {
+            written = snprintf(&line[len], room, "%s", (spec[spec_len - 1] == '%') ? "%" : spec);
+        } else if (arg_index >= LOG_MAX_ARGS) {
+            written = snprintf(&line[len], room, "?");
+        } else {
+            uint64 raw = record->Args[arg_index++];
+            switch (arg_class) {
+                case LOG_ARG_INT:
+                    written = snprintf(&line[len], room, spec, (int)(sint64)raw);
+                    break;
+                case LOG_ARG_LONG:
+                    written = snprintf(&line[len], room, spec, (long)raw);
+                    break;
+                case LOG_ARG_LLONG:
+                    written = snprintf(&line[len], room, spec, (long long)raw);
+                    break;
+                case LOG_ARG_SIZE:
+                    written = snprintf(&line[len], room, spec, (size_t)raw);
+                    break;
+                case LOG_ARG_DOUBLE: {
+                    double value;
+                    memcpy(&value, &raw, sizeof(value));
+                    written = snprintf(&line[len], room, spec, value);
+                    break;
+                }
+                case LOG_ARG_STRING:
+                    written = snprintf(&line[len], room, spec,
+                                       &record->Strings[(raw < LOG_STRING_SIZE) ? raw : LOG_STRING_SIZE - 1U]);
+                    break;
+                default:
+                    written = snprintf(&line[len], room, spec, (const void*)(uintptr_t)raw);
+                    break;
+            }
+        }
+
+        if (written > 0) {
+            len += ((size_t)written < room) ? (size_t)written : room - 1;
+        }
+    }
+    line[len] = '\0';
+
+    fputs(line, stdout);
+}
+
+/**************************************************************************
+ * @brief   Ghi cảnh báo khi có thêm bản ghi bị bỏ (gọi khi giữ log_drain_lock)
+ * @details Dòng cảnh báo được in trực tiếp, không đi qua bộ đệm.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Log_ReportDropped(void) {
+    uint32 dropped = Log_GetDroppedCount();
+    if (dropped == log_reported_dropped) {
+        return;
+    }
+
+    printf("[%10.6f][%-6s][%-5s] %u log records dropped (ring full or no ring for thread), %u in total\n",
+           (double)Os_GetTimeNs() / 1e9, "LOG", log_level_names[LOG_LEVEL_WARN],
+           dropped - log_reported_dropped, dropped);
+    fflush(stdout);
+    log_reported_dropped = dropped;
+}
+
+/**************************************************************************
+ * @brief   Định dạng tất cả các bản ghi đang có trong các bộ đệm
+ * @details Các bản ghi của nhiều luồng được in theo thứ tự thời gian ghi.
+ *          Bộ đệm của luồng đã kết thúc được thu hồi khi đã in hết.
+ * @param   None
+ * @return 	uint32  Số bản ghi đã định dạng
+ **************************************************************************/
+static uint32 Log_DrainOnce(void) {
+    uint32 drained = 0;
+
+    pthread_mutex_lock(&log_drain_lock);
+    while (1) {
+        // Chọn bản ghi cũ nhất trong số các bản ghi đầu tiên của mỗi bộ đệm
+        uint32 ring_count = atomic_load(&log_ring_count);
+        Log_RingType* oldest = NULL_PTR;
+        uint64 oldest_ns = 0;
+        for (uint32 i = 0; i < ring_count && i < LOG_MAX_THREADS; i++) {
+            Log_RingType* ring = &log_rings[i];
+            uint32 state = atomic_load_explicit(&ring->State, memory_order_acquire);
+            uint32 tail = atomic_load_explicit(&ring->Tail, memory_order_relaxed);
+            if (tail == atomic_load_explicit(&ring->Head, memory_order_acquire)) {
+                if (state == LOG_RING_RELEASED) {
+                    atomic_store_explicit(&ring->State, LOG_RING_FREE, memory_order_release);
+                }
+                continue;
+            }
+            uint64 ts = ring->Records[tail & (LOG_RING_SIZE - 1)].TimestampNs;
+            if (oldest == NULL_PTR || ts < oldest_ns) {
+                oldest = ring;
+                oldest_ns = ts;
+            }
+        }
+        if (oldest == NULL_PTR) {
+            break;
+        }
+
+        uint32 tail = atomic_load_explicit(&oldest->Tail, memory_order_relaxed);
+        Log_FormatRecord(&oldest->Records[tail & (LOG_RING_SIZE - 1)]);
+        atomic_store_explicit(&oldest->Tail, tail + 1, memory_order_release);
+        drained++;
+    }
+    Log_ReportDropped();
+    if (drained > 0) {
+        fflush(stdout);
+    }
+    pthread_mutex_unlock(&log_drain_lock);
+
+    return drained;
+}
+
+/**************************************************************************
+ * @brief   Luồng định dạng log
+ * @details Luồng này dùng thời gian thực (không dùng thời gian hệ thống của
+ *          OS) để không ảnh hưởng đến việc nhảy thời gian khi mô phỏng.
+ * @param   arg     Không sử dụng
+ * @return 	None
+ **************************************************************************/
+static void* Log_DrainMain(void* arg) {
+    struct timespec period = {0, LOG_DRAIN_PERIOD_MS * 1000000L};
+
+    while (1) {
+        if (Log_DrainOnce() == 0) {
+            nanosleep(&period, NULL_PTR);
+        }
+    }
+
+    return NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Khởi động luồng định dạng log (chỉ gọi một lần)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Log_StartDrainThread(void) {
+    if (pthread_create(&log_drain_thread, NULL_PTR, Log_DrainMain, NULL_PTR) != 0) {
+        printf("Error: Failed to create log thread.\n");
+        return;
+    }
+    pthread_detach(log_drain_thread);
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo dịch vụ log và khởi động luồng định dạng log
+ * @details Các bản ghi được ghi trước khi gọi hàm này vẫn được giữ trong bộ
+ *          đệm và được in ra khi luồng định dạng bắt đầu chạy.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Log_Init(void) {
+    pthread_once(&log_init_once, Log_StartDrainThread);
+}
+
+/**************************************************************************
+ * @brief   Định dạng và in ra tất cả các bản ghi đang chờ
+ * @details Hàm này được gọi trước khi kết thúc chương trình để không mất log.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Log_Flush(void) {
+    Log_DrainOnce();
+}
+
+/**************************************************************************
+ * @brief   Đọc tổng số bản ghi bị bỏ do bộ đệm đầy hoặc hết bộ đệm cho luồng mới
+ * @details Bộ đếm của bộ đệm không bị xóa khi bộ đệm được thu hồi.
+ * @param   None
+ * @return 	uint32  Tổng số bản ghi bị bỏ
+ **************************************************************************/
+uint32 Log_GetDroppedCount(void) {
+    uint32 dropped = atomic_load(&log_orphan_dropped);
+    uint32 ring_count = atomic_load(&log_ring_count);
+    for (uint32 i = 0; i < ring_count && i < LOG_MAX_THREADS; i++) {
+        dropped += atomic_load(&log_rings[i].Dropped);
+    }
+    return dropped;
+}
+
+/**************************************************************************
+ * @brief   Đọc tên của một module ghi log
+ * @details Tên trả về là chuỗi hằng nên có thể dùng làm tham số %s của log.
+ * @param   Module          ID của module
+ * @return 	const char*     Tên của module, "?" nếu ID không hợp lệ
+ **************************************************************************/
+const char* Log_GetModuleName(Log_ModuleIdType Module) {
+    return (Module < LOG_MODULE_COUNT) ? log_module_names[Module] : "?";
+}
@@ -0,0 +1,192 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "Std_Types.h"
+
+/**************************************************************************
+ * @brief Định nghĩa các mức log
+ **************************************************************************/
+#define LOG_LEVEL_OFF       0   /* Tắt log */
+#define LOG_LEVEL_ERROR     1   /* Lỗi */
+#define LOG_LEVEL_WARN      2   /* Cảnh báo */
+#define LOG_LEVEL_INFO      3   /* Thông tin */
+#define LOG_LEVEL_DEBUG     4   /* Gỡ lỗi (giá trị thô của cảm biến, ...) */
+
+/**************************************************************************
+ * @typedef Log_ModuleIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của module ghi log
+ **************************************************************************/
+typedef uint8 Log_ModuleIdType;
+#define LOG_MODULE_OS       (Log_ModuleIdType)0     /* Hệ điều hành */
+#define LOG_MODULE_ADC      (Log_ModuleIdType)1     /* MCAL ADC */
+#define LOG_MODULE_CAN      (Log_ModuleIdType)2     /* MCAL CAN */
+#define LOG_MODULE_DIO      (Log_ModuleIdType)3     /* MCAL DIO */
+#define LOG_MODULE_PWM      (Log_ModuleIdType)4     /* MCAL PWM */
+#define LOG_MODULE_IOHWAB   (Log_ModuleIdType)5     /* I/O Hardware Abstraction */
+#define LOG_MODULE_RTE      (Log_ModuleIdType)6     /* Tầng RTE */
+#define LOG_MODULE_SWC      (Log_ModuleIdType)7     /* Các SWC */
+#define LOG_MODULE_PDUR     (Log_ModuleIdType)8     /* PDU Router */
+#define LOG_MODULE_DEM      (Log_ModuleIdType)9     /* Diagnostic Event Manager */
+#define LOG_MODULE_FEE      (Log_ModuleIdType)10    /* Flash EEPROM Emulation */
+#define LOG_MODULE_NVM      (Log_ModuleIdType)11    /* NVRAM Manager */
+#define LOG_MODULE_MEM      (Log_ModuleIdType)12    /* Quản lý bộ nhớ */
+#define LOG_MODULE_COUNT    13
+
+/**************************************************************************
+ * @brief Mức log của từng module, được chọn khi biên dịch
+ * @details Các lệnh log có mức lớn hơn mức của module bị trình biên dịch loại
+ *          bỏ hoàn toàn, ví dụ: -DLOG_CFG_LEVEL_ADC=LOG_LEVEL_ERROR. Các module
+ *          ghi log mỗi chu kỳ điều khiển (ADC, PWM, IOHWAB, SWC, chu kỳ đến 1 ms)
+ *          mặc định chỉ ghi cảnh báo và lỗi (LOG_CFG_LEVEL_CYCLIC), bật lại bằng
+ *          -DLOG_CFG_LEVEL_SWC=LOG_LEVEL_INFO
+ **************************************************************************/
+#ifndef LOG_CFG_LEVEL_DEFAULT
+#define LOG_CFG_LEVEL_DEFAULT   LOG_LEVEL_DEBUG
+#endif
+#ifndef LOG_CFG_LEVEL_CYCLIC
+#define LOG_CFG_LEVEL_CYCLIC    LOG_LEVEL_WARN
+#endif
+#ifndef LOG_CFG_LEVEL_OS
+#define LOG_CFG_LEVEL_OS        LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_ADC
+#define LOG_CFG_LEVEL_ADC       LOG_CFG_LEVEL_CYCLIC
+#endif
+#ifndef LOG_CFG_LEVEL_CAN
+#define LOG_CFG_LEVEL_CAN       LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_DIO
+#define LOG_CFG_LEVEL_DIO       LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_PWM
+#define LOG_CFG_LEVEL_PWM       LOG_CFG_LEVEL_CYCLIC
+#endif
+#ifndef LOG_CFG_LEVEL_IOHWAB
+#define LOG_CFG_LEVEL_IOHWAB    LOG_CFG_LEVEL_CYCLIC
+#endif
+#ifndef LOG_CFG_LEVEL_RTE
+#define LOG_CFG_LEVEL_RTE       LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_SWC
+#define LOG_CFG_LEVEL_SWC       LOG_CFG_LEVEL_CYCLIC
+#endif
+#ifndef LOG_CFG_LEVEL_PDUR
+#define LOG_CFG_LEVEL_PDUR      LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_DEM
+#define LOG_CFG_LEVEL_DEM       LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_FEE
+#define LOG_CFG_LEVEL_FEE       LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_NVM
+#define LOG_CFG_LEVEL_NVM       LOG_CFG_LEVEL_DEFAULT
+#endif
+#ifndef LOG_CFG_LEVEL_MEM
+#define LOG_CFG_LEVEL_MEM       LOG_CFG_LEVEL_DEFAULT
+#endif
+
+/**************************************************************************
+ * @brief Các macro ghi log theo module và mức log
+ * @details Chuỗi định dạng phải tồn tại suốt chương trình (chuỗi hằng) vì chỉ
+ *          con trỏ được lưu lại, việc định dạng được thực hiện sau bởi luồng
+ *          ghi log. Các tham số chuỗi (%s) được sao chép vào bản ghi (tối đa
+ *          LOG_STRING_SIZE byte cho tất cả chuỗi của bản ghi, phần thừa bị cắt).
+ **************************************************************************/
+#define LOG_WRITE(Module, Level, ...) \
+    do { \
+        if ((Level) <= LOG_CFG_LEVEL_##Module) { \
+            Log_Write(LOG_MODULE_##Module, (Level), __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_ERROR(Module, ...)  LOG_WRITE(Module, LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_WARN(Module, ...)   LOG_WRITE(Module, LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_INFO(Module, ...)   LOG_WRITE(Module, LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_DEBUG(Module, ...)  LOG_WRITE(Module, LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+/**************************************************************************
+ * @brief Giới hạn của bộ đệm log
+ **************************************************************************/
+#define LOG_MAX_ARGS        10      /* Số tham số tối đa của một bản ghi */
+#define LOG_STRING_SIZE     64      /* Số byte lưu các tham số chuỗi (%s) của một bản ghi */
+#define LOG_RING_SIZE       256     /* Số bản ghi trong bộ đệm của một luồng (lũy thừa của 2) */
+#ifndef LOG_MAX_THREADS
+#define LOG_MAX_THREADS     32      /* Số luồng tối đa có bộ đệm log cùng lúc (bộ đệm được thu hồi khi luồng kết thúc) */
+#endif
+#define LOG_DRAIN_PERIOD_MS 5       /* Chu kỳ luồng ghi log kiểm tra bộ đệm khi rảnh (ms) */
+
+/**************************************************************************
+ * @struct  Log_RecordType
+ * @brief   Cấu trúc một bản ghi log dạng nhị phân
+ * @details Bản ghi chỉ lưu con trỏ chuỗi định dạng và giá trị thô của các
+ *          tham số, chưa định dạng thành chuỗi. Tham số chuỗi được sao chép
+ *          vào Strings, giá trị thô là vị trí của chuỗi trong Strings.
+ **************************************************************************/
+typedef struct {
+    const char* Format;             /* Chuỗi định dạng kiểu printf */
+    uint64 TimestampNs;             /* Thời gian hệ thống lúc ghi log (ns) */
+    uint64 Args[LOG_MAX_ARGS];      /* Giá trị thô của các tham số */
+    Log_ModuleIdType Module;        /* Module ghi log */
+    uint8 Level;                    /* Mức log */
+    char Strings[LOG_STRING_SIZE];  /* Bản sao của các tham số chuỗi */
+} Log_RecordType;
+
+/**************************************************************************
+ * @struct  Log_RingType
+ * @brief   Bộ đệm vòng không khóa của một luồng (một luồng ghi, một luồng đọc)
+ * @details Khi luồng sở hữu kết thúc, bộ đệm được luồng định dạng thu hồi
+ *          sau khi in hết các bản ghi còn lại và có thể cấp cho luồng mới.
+ **************************************************************************/
+typedef struct {
+    atomic_uint State;                          /* Trạng thái cấp phát của bộ đệm */
+    atomic_uint Head;                           /* Vị trí ghi tiếp theo (luồng ghi log) */
+    atomic_uint Tail;                           /* Vị trí đọc tiếp theo (luồng định dạng) */
+    atomic_uint Dropped;                        /* Số bản ghi bị bỏ do bộ đệm đầy */
+    Log_RecordType Records[LOG_RING_SIZE];      /* Các bản ghi */
+} Log_RingType;
+
+/**************************************************************************
+ * @brief   Khởi tạo dịch vụ log và khởi động luồng định dạng log
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Log_Init(void);
+
+/**************************************************************************
+ * @brief   Ghi một bản ghi log vào bộ đệm của luồng hiện tại
+ * @details Nên dùng qua các macro LOG_ERROR, LOG_WARN, LOG_INFO, LOG_DEBUG.
+ * @param   Module      Module ghi log
+ * @param   Level       Mức log
+ * @param   Format      Chuỗi định dạng kiểu printf (chuỗi hằng)
+ * @return 	None
+ **************************************************************************/
+void Log_Write(Log_ModuleIdType Module, uint8 Level, const char* Format, ...);
+
+/**************************************************************************
+ * @brief   Định dạng và in ra tất cả các bản ghi đang chờ
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Log_Flush(void);
+
+/**************************************************************************
+ * @brief   Đọc tổng số bản ghi bị bỏ do bộ đệm đầy hoặc hết bộ đệm cho luồng mới
+ * @details Luồng định dạng tự ghi một dòng cảnh báo mỗi khi số này tăng.
+ * @param   None
+ * @return 	uint32  Tổng số bản ghi bị bỏ
+ **************************************************************************/
+uint32 Log_GetDroppedCount(void);
+
+/**************************************************************************
+ * @brief   Đọc tên của một module ghi log
+ * @param   Module          ID của module
+ * @return 	const char*     Tên của module (chuỗi hằng), "?" nếu ID không hợp lệ
+ **************************************************************************/
+const char* Log_GetModuleName(Log_ModuleIdType Module);
+
+#endif /* LOG_H */
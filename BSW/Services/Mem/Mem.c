@@ -1,102 +1,716 @@
 #include "Mem.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include <pthread.h>
+#include <string.h>
 
 /**************************************************************************
- * @brief Định nghĩa số lượng vùng bộ nhớ cấp phát tối đa
+ * @brief Giá trị đánh dấu trạng thái của khối và chỉ số khối không hợp lệ
  **************************************************************************/
-#define MAX_ALLOCATIONS 100
+#define MEM_BLOCK_FREE          0x45455246u     /* "FREE" */
+#define MEM_BLOCK_ALLOCATED     0x434F4C41u     /* "ALOC" */
+#define MEM_INVALID_BLOCK       0xFFFFFFFFu
+#define MEM_GUARD_BYTE          0xFDu
 
 /**************************************************************************
- * @brief Mảng giả lập để theo dõi các vùng bộ nhớ đã cấp phát
+ * @struct  Mem_BlockHeaderType
+ * @brief   Phần đầu của một khối, nằm ngay trước vùng nhớ trả về
+ * @details Kích thước phần đầu bằng MEM_BLOCK_ALIGNMENT để vùng nhớ trả về
+ *          luôn được căn lề. Size và Tag chỉ có nghĩa khi khối đang được
+ *          cấp phát.
  **************************************************************************/
-void* allocated_blocks[MAX_ALLOCATIONS];
+typedef struct {
+    atomic_uint State;          /* MEM_BLOCK_FREE hoặc MEM_BLOCK_ALLOCATED */
+    atomic_uint Next;           /* Khối trống tiếp theo trong danh sách trống */
+    uint32 Size;                /* Số byte được yêu cầu */
+    uint8 PoolIndex;            /* Pool chứa khối */
+    Mem_TagType Tag;            /* Thẻ của module cấp phát */
+    atomic_uchar Corrupted;     /* Đã phát hiện ghi tràn (chỉ đếm một lần) */
+    uint8 Reserved;
+} Mem_BlockHeaderType;
 
 /**************************************************************************
- * @brief Số lượng vùng bộ nhớ đã cấp phát
+ * @struct  Mem_PoolType
+ * @brief   Trạng thái chạy của một pool khối cố định
+ * @details Đỉnh danh sách trống gồm chỉ số khối (32 bit thấp) và bộ đếm
+ *          phiên bản (32 bit cao) để tránh lỗi ABA khi nhiều luồng lấy/trả
+ *          đồng thời. Mỗi khối có thêm MEM_CFG_GUARD_SIZE byte sau BlockSize
+ *          để byte bảo vệ luôn có chỗ.
  **************************************************************************/
-uint8 allocation_count = 0;
+typedef struct {
+    uint8* Base;                /* Khối đầu tiên trong vùng nhớ tĩnh */
+    uint32 Stride;              /* Khoảng cách giữa hai khối (phần đầu + dữ liệu) */
+    uint32 BlockSize;           /* Kích thước dữ liệu của một khối */
+    uint32 NumBlocks;           /* Số khối (0 nếu pool không vừa vùng nhớ tĩnh) */
+    atomic_ullong FreeHead;     /* Đỉnh danh sách trống */
+    atomic_uint InUse;          /* Số khối đang được cấp phát */
+    atomic_uint HighWaterMark;  /* Số khối được cấp phát cùng lúc lớn nhất */
+    atomic_uint AllocFailures;  /* Số lần pool hết khối khi được yêu cầu */
+} Mem_PoolType;
+
+/**************************************************************************
+ * @brief Vùng nhớ tĩnh chia cho các pool và trạng thái của các pool
+ **************************************************************************/
+static _Alignas(MEM_BLOCK_ALIGNMENT) uint8 Mem_PoolMemory[MEM_ARENA_SIZE];
+static Mem_PoolType Mem_Pools[MEM_MAX_POOLS];
+static uint8 Mem_NumPools = 0;
+
+/**************************************************************************
+ * @struct  Mem_UsageCountersType
+ * @brief   Bộ đếm sử dụng bộ nhớ, cập nhật đồng thời bởi nhiều luồng
+ * @details Số byte (32 bit thấp) và số khối (32 bit cao) đang dùng nằm chung
+ *          một biến để mỗi lần cấp phát/giải phóng chỉ cần một phép cộng
+ *          nguyên tử.
+ **************************************************************************/
+#define MEM_USAGE_ONE_BLOCK     (1ULL << 32)
+
+typedef struct {
+    atomic_ullong Live;
+    atomic_uint PeakBytes;
+    atomic_uint PeakBlocks;
+    atomic_uint TotalAllocs;
+    atomic_uint AllocFailures;
+    atomic_uint Corruptions;
+} Mem_UsageCountersType;
+
+/**************************************************************************
+ * @brief Thống kê sử dụng bộ nhớ của toàn hệ thống và của từng thẻ
+ **************************************************************************/
+static Mem_UsageCountersType Mem_TotalUsage;
+static Mem_UsageCountersType Mem_TagUsage[MEM_NUM_TAGS];
+
+/**************************************************************************
+ * @brief Vùng nhớ tĩnh chia cho các arena và arena gắn với luồng hiện tại
+ **************************************************************************/
+static _Alignas(MEM_BLOCK_ALIGNMENT) uint8 Mem_ScratchMemory[MEM_SCRATCH_SIZE];
+static atomic_uint Mem_ScratchUsed;
+static __thread Mem_ArenaType* Mem_CurrentArena = NULL_PTR;
+
+/**************************************************************************
+ * @brief   Lấy phần đầu của một khối theo chỉ số
+ * @param   Pool        Con trỏ đến pool
+ * @param   Index       Chỉ số của khối trong pool
+ * @return 	Mem_BlockHeaderType*    Con trỏ đến phần đầu khối
+ **************************************************************************/
+static inline Mem_BlockHeaderType* Mem_GetBlock(const Mem_PoolType* Pool, uint32 Index) {
+    return (Mem_BlockHeaderType*)(Pool->Base + (size_t)Index * Pool->Stride);
+}
+
+/**************************************************************************
+ * @brief   Đưa một khối vào danh sách trống chung của pool
+ * @param   Pool        Con trỏ đến pool
+ * @param   Index       Chỉ số của khối
+ * @return 	None
+ **************************************************************************/
+static void Mem_PushFree(Mem_PoolType* Pool, uint32 Index) {
+    Mem_BlockHeaderType* block = Mem_GetBlock(Pool, Index);
+    uint64 head = atomic_load_explicit(&Pool->FreeHead, memory_order_relaxed);
+    uint64 new_head;
+
+    do {
+        atomic_store_explicit(&block->Next, (uint32)head, memory_order_relaxed);
+        new_head = ((head >> 32) + 1) << 32 | Index;
+    } while (!atomic_compare_exchange_weak_explicit(&Pool->FreeHead, &head, new_head,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+/**************************************************************************
+ * @brief   Lấy một khối từ danh sách trống chung của pool
+ * @param   Pool        Con trỏ đến pool
+ * @return 	uint32      Chỉ số của khối, MEM_INVALID_BLOCK nếu hết khối
+ **************************************************************************/
+static uint32 Mem_PopFree(Mem_PoolType* Pool) {
+    uint64 head = atomic_load_explicit(&Pool->FreeHead, memory_order_acquire);
+    uint64 new_head;
+    uint32 index;
+
+    do {
+        index = (uint32)head;
+        if (index == MEM_INVALID_BLOCK) {
+            return MEM_INVALID_BLOCK;
+        }
+        uint32 next = atomic_load_explicit(&Mem_GetBlock(Pool, index)->Next, memory_order_relaxed);
+        new_head = ((head >> 32) + 1) << 32 | next;
+    } while (!atomic_compare_exchange_weak_explicit(&Pool->FreeHead, &head, new_head,
+                                                    memory_order_acquire, memory_order_acquire));
+    return index;
+}
+
+#if MEM_CFG_THREAD_CACHE
+/**************************************************************************
+ * @struct  Mem_ThreadCacheType
+ * @brief   Các khối do một luồng giải phóng, được giữ lại để luồng đó cấp
+ *          phát lần sau mà không phải tranh chấp danh sách trống chung
+ **************************************************************************/
+typedef struct {
+    uint32 Count[MEM_MAX_POOLS];
+    uint32 Blocks[MEM_MAX_POOLS][MEM_THREAD_CACHE_SIZE];
+    boolean Registered;         /* Đã đăng ký trả khối về pool khi luồng kết thúc */
+} Mem_ThreadCacheType;
+
+static __thread Mem_ThreadCacheType Mem_ThreadCache;
+static pthread_key_t Mem_ThreadCacheKey;
+static pthread_once_t Mem_ThreadCacheKeyOnce = PTHREAD_ONCE_INIT;
+
+/**************************************************************************
+ * @brief   Trả tất cả các khối trong bộ đệm của luồng về pool
+ * @details Hàm này được gọi tự động khi luồng kết thúc.
+ * @param   Cache       Con trỏ đến bộ đệm của luồng
+ * @return 	None
+ **************************************************************************/
+static void Mem_ThreadCacheFlush(void* Cache) {
+    Mem_ThreadCacheType* cache = (Mem_ThreadCacheType*)Cache;
+    for (uint8 p = 0; p < Mem_NumPools; p++) {
+        while (cache->Count[p] > 0) {
+            Mem_PushFree(&Mem_Pools[p], cache->Blocks[p][--cache->Count[p]]);
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Tạo khóa dữ liệu luồng để trả khối về pool khi luồng kết thúc
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Mem_ThreadCacheCreateKey(void) {
+    pthread_key_create(&Mem_ThreadCacheKey, Mem_ThreadCacheFlush);
+}
+#endif /* MEM_CFG_THREAD_CACHE */
+
+/**************************************************************************
+ * @brief   Lấy một khối của pool, ưu tiên bộ đệm của luồng
+ * @param   PoolIndex   Chỉ số của pool
+ * @return 	uint32      Chỉ số của khối, MEM_INVALID_BLOCK nếu hết khối
+ **************************************************************************/
+static uint32 Mem_TakeBlock(uint8 PoolIndex) {
+#if MEM_CFG_THREAD_CACHE
+    if (Mem_ThreadCache.Count[PoolIndex] > 0) {
+        return Mem_ThreadCache.Blocks[PoolIndex][--Mem_ThreadCache.Count[PoolIndex]];
+    }
+#endif
+    return Mem_PopFree(&Mem_Pools[PoolIndex]);
+}
+
+/**************************************************************************
+ * @brief   Trả một khối về pool, giữ lại trong bộ đệm của luồng nếu còn chỗ
+ * @param   PoolIndex   Chỉ số của pool
+ * @param   Index       Chỉ số của khối
+ * @return 	None
+ **************************************************************************/
+static void Mem_GiveBlock(uint8 PoolIndex, uint32 Index) {
+#if MEM_CFG_THREAD_CACHE
+    Mem_ThreadCacheType* cache = &Mem_ThreadCache;
+    if (!cache->Registered) {
+        pthread_once(&Mem_ThreadCacheKeyOnce, Mem_ThreadCacheCreateKey);
+        pthread_setspecific(Mem_ThreadCacheKey, cache);
+        cache->Registered = TRUE;
+    }
+    if (cache->Count[PoolIndex] < MEM_THREAD_CACHE_SIZE) {
+        cache->Blocks[PoolIndex][cache->Count[PoolIndex]++] = Index;
+        return;
+    }
+#endif
+    Mem_PushFree(&Mem_Pools[PoolIndex], Index);
+}
+
+/**************************************************************************
+ * @brief   Cập nhật mức cao nhất nếu giá trị mới lớn hơn
+ * @param   Peak        Con trỏ đến mức cao nhất
+ * @param   Value       Giá trị mới
+ * @return 	None
+ **************************************************************************/
+static inline void Mem_UpdatePeak(atomic_uint* Peak, uint32 Value) {
+    uint32 peak = atomic_load_explicit(Peak, memory_order_relaxed);
+    while (Value > peak && !atomic_compare_exchange_weak_explicit(Peak, &peak, Value,
+                                                                 memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**************************************************************************
+ * @brief   Cộng một lần cấp phát vào bộ đếm sử dụng
+ * @details Số lần cấp phát chỉ được đếm theo thẻ, tổng được tính khi đọc.
+ * @param   Usage       Con trỏ đến bộ đếm
+ * @param   Size        Số byte được cấp phát
+ * @return 	None
+ **************************************************************************/
+static void Mem_UsageAdd(Mem_UsageCountersType* Usage, uint32 Size) {
+    uint64 delta = MEM_USAGE_ONE_BLOCK | Size;
+    uint64 live = atomic_fetch_add_explicit(&Usage->Live, delta, memory_order_relaxed) + delta;
+    Mem_UpdatePeak(&Usage->PeakBytes, (uint32)live);
+    Mem_UpdatePeak(&Usage->PeakBlocks, (uint32)(live >> 32));
+}
+
+/**************************************************************************
+ * @brief   Trừ một lần giải phóng khỏi bộ đếm sử dụng
+ * @param   Usage       Con trỏ đến bộ đếm
+ * @param   Size        Số byte được giải phóng
+ * @return 	None
+ **************************************************************************/
+static void Mem_UsageRemove(Mem_UsageCountersType* Usage, uint32 Size) {
+    atomic_fetch_sub_explicit(&Usage->Live, MEM_USAGE_ONE_BLOCK | Size, memory_order_relaxed);
+}
+
+/**************************************************************************
+ * @brief   Đọc bộ đếm sử dụng
+ * @param   Usage       Con trỏ đến bộ đếm
+ * @param   UsagePtr    Con trỏ lưu thống kê
+ * @return 	None
+ **************************************************************************/
+static void Mem_UsageRead(Mem_UsageCountersType* Usage, Mem_UsageType* UsagePtr) {
+    uint64 live = atomic_load_explicit(&Usage->Live, memory_order_relaxed);
+    UsagePtr->LiveBytes = (uint32)live;
+    UsagePtr->LiveBlocks = (uint32)(live >> 32);
+    UsagePtr->PeakBytes = atomic_load_explicit(&Usage->PeakBytes, memory_order_relaxed);
+    UsagePtr->PeakBlocks = atomic_load_explicit(&Usage->PeakBlocks, memory_order_relaxed);
+    UsagePtr->TotalAllocs = atomic_load_explicit(&Usage->TotalAllocs, memory_order_relaxed);
+    UsagePtr->AllocFailures = atomic_load_explicit(&Usage->AllocFailures, memory_order_relaxed);
+    UsagePtr->Corruptions = atomic_load_explicit(&Usage->Corruptions, memory_order_relaxed);
+}
+
+/**************************************************************************
+ * @brief   Đọc thống kê của toàn hệ thống, cộng số lần cấp phát của các thẻ
+ * @param   UsagePtr    Con trỏ lưu thống kê
+ * @return 	None
+ **************************************************************************/
+static void Mem_UsageReadTotal(Mem_UsageType* UsagePtr) {
+    Mem_UsageRead(&Mem_TotalUsage, UsagePtr);
+    UsagePtr->TotalAllocs = 0;
+    for (Mem_TagType tag = 0; tag < MEM_NUM_TAGS; tag++) {
+        UsagePtr->TotalAllocs += atomic_load_explicit(&Mem_TagUsage[tag].TotalAllocs, memory_order_relaxed);
+    }
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra byte bảo vệ của một khối đang được cấp phát
+ * @details Khối bị ghi tràn được ghi log và đếm vào thống kê một lần.
+ * @param   Block       Con trỏ đến phần đầu khối
+ * @return 	boolean     TRUE nếu byte bảo vệ còn nguyên, FALSE nếu bị ghi đè
+ **************************************************************************/
+static boolean Mem_CheckGuard(Mem_BlockHeaderType* Block) {
+    const uint8* guard = (const uint8*)(Block + 1) + Block->Size;
+
+    for (uint32 i = 0; i < MEM_CFG_GUARD_SIZE; i++) {
+        if (guard[i] != MEM_GUARD_BYTE) {
+            if (!atomic_exchange_explicit(&Block->Corrupted, TRUE, memory_order_relaxed)) {
+                atomic_fetch_add_explicit(&Mem_TotalUsage.Corruptions, 1, memory_order_relaxed);
+                atomic_fetch_add_explicit(&Mem_TagUsage[Block->Tag].Corruptions, 1, memory_order_relaxed);
+                LOG_ERROR(MEM, "Buffer overrun detected: %p (%u bytes, %s), guard byte %u is 0x%02X\n",
+                          (void*)(Block + 1), Block->Size, Log_GetModuleName(Block->Tag), i, guard[i]);
+            }
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**************************************************************************
+ * @brief   Tìm pool và chỉ số khối của một con trỏ do Mem_Alloc trả về
+ * @param   ptr             Con trỏ cần tìm
+ * @param   PoolIndexPtr    Con trỏ lưu chỉ số của pool
+ * @param   IndexPtr        Con trỏ lưu chỉ số của khối
+ * @return 	Std_ReturnType  Trả về E_OK nếu con trỏ trỏ đến đầu vùng dữ liệu
+ *                                 của một khối, E_NOT_OK nếu không
+ **************************************************************************/
+static Std_ReturnType Mem_FindBlock(const void* ptr, uint8* PoolIndexPtr, uint32* IndexPtr) {
+    const uint8* address = (const uint8*)ptr - sizeof(Mem_BlockHeaderType);
+
+    for (uint8 p = 0; p < Mem_NumPools; p++) {
+        const Mem_PoolType* pool = &Mem_Pools[p];
+        if (pool->NumBlocks == 0 || address < pool->Base ||
+            address >= pool->Base + (size_t)pool->NumBlocks * pool->Stride) {
+            continue;
+        }
+        size_t offset = (size_t)(address - pool->Base);
+        if (offset % pool->Stride != 0) {
+            return E_NOT_OK;    // Trỏ vào giữa một khối
+        }
+        *PoolIndexPtr = p;
+        *IndexPtr = (uint32)(offset / pool->Stride);
+        return E_OK;
+    }
+    return E_NOT_OK;
+}
 
 /**************************************************************************
  * @brief   Khởi tạo hệ thống quản lý bộ nhớ
- * @details Hàm này sẽ khởi tạo hệ thống quản lý bộ nhớ bằng cách thiết lập
- *          mảng giả lập để theo dõi các vùng bộ nhớ đã cấp phát và số lượng 
- *          vùng bộ nhớ đã cấp phát.
+ * @details Hàm này chia vùng nhớ tĩnh thành các pool theo bảng cấu hình và
+ *          đưa tất cả các khối vào danh sách trống. Phải được gọi một lần
+ *          trước khi các task bắt đầu chạy.
  * @param   None
  * @return 	None  
  **************************************************************************/
 void Mem_Init() {
-    printf("Memory Management System Initialized.\n");
-    for (uint8 i = 0; i < MAX_ALLOCATIONS; i++) {
-        allocated_blocks[i] = NULL_PTR;
+    size_t offset = 0;
+
+    Mem_NumPools = (Mem_PoolConfigCount < MEM_MAX_POOLS) ? Mem_PoolConfigCount : MEM_MAX_POOLS;
+    for (uint8 p = 0; p < Mem_NumPools; p++) {
+        const Mem_PoolConfigType* config = &Mem_PoolConfigs[p];
+        Mem_PoolType* pool = &Mem_Pools[p];
+        uint32 stride = (sizeof(Mem_BlockHeaderType) + config->BlockSize + MEM_CFG_GUARD_SIZE + MEM_BLOCK_ALIGNMENT - 1) &
+                        ~(uint32)(MEM_BLOCK_ALIGNMENT - 1);
+
+        pool->Base = &Mem_PoolMemory[offset];
+        pool->Stride = stride;
+        pool->BlockSize = config->BlockSize;
+        pool->NumBlocks = config->NumBlocks;
+        atomic_store_explicit(&pool->FreeHead, MEM_INVALID_BLOCK, memory_order_relaxed);
+        atomic_store_explicit(&pool->InUse, 0, memory_order_relaxed);
+        atomic_store_explicit(&pool->HighWaterMark, 0, memory_order_relaxed);
+        atomic_store_explicit(&pool->AllocFailures, 0, memory_order_relaxed);
+
+        if (offset + (size_t)stride * config->NumBlocks > MEM_ARENA_SIZE) {
+            LOG_ERROR(MEM, "Pool %u (%u x %u bytes) does not fit in arena, disabled\n", p, config->NumBlocks, config->BlockSize);
+            pool->NumBlocks = 0;
+            continue;
+        }
+        offset += (size_t)stride * config->NumBlocks;
+
+        for (uint32 i = config->NumBlocks; i > 0; i--) {
+            Mem_BlockHeaderType* block = Mem_GetBlock(pool, i - 1);
+            atomic_store_explicit(&block->State, MEM_BLOCK_FREE, memory_order_relaxed);
+            block->PoolIndex = p;
+            Mem_PushFree(pool, i - 1);
+        }
     }
-    allocation_count = 0;
+    atomic_store_explicit(&Mem_ScratchUsed, 0, memory_order_relaxed);
+    memset(&Mem_TotalUsage, 0, sizeof(Mem_TotalUsage));
+    memset(Mem_TagUsage, 0, sizeof(Mem_TagUsage));
+
+    LOG_INFO(MEM, "Memory Management System Initialized, %u pools, %u of %u bytes used.\n",
+             Mem_NumPools, (uint32)offset, (uint32)MEM_ARENA_SIZE);
 }
 
 /**************************************************************************
  * @brief   Cấp phát một vùng bộ nhớ
- * @details Hàm này sẽ cấp phát một vùng bộ nhớ có kích thước size và theo dõi
- *          vùng bộ nhớ đã cấp phát bằng cách lưu trữ con trỏ của vùng bộ nhớ
- *          vào mảng giả lập.
+ * @details Vùng nhớ được gắn thẻ MEM_TAG_UNKNOWN.
  * @param   size    Kích thước vùng bộ nhớ cần cấp phát
- * @return 	None  
+ * @return 	void*   Con trỏ đến vùng nhớ, NULL nếu kích thước quá lớn hoặc
+ *                  hết khối
  **************************************************************************/
 void* Mem_Alloc(size_t size) {
-    if (allocation_count >= MAX_ALLOCATIONS) {
-        printf("Memory allocation failed: Maximum allocation count reached.\n");
-        return NULL_PTR;
+    return Mem_AllocTagged(size, MEM_TAG_UNKNOWN);
+}
+
+/**************************************************************************
+ * @brief   Cấp phát một vùng bộ nhớ và gắn thẻ của module gọi
+ * @details Hàm này lấy khối từ pool nhỏ nhất đủ lớn (hoặc pool lớn hơn nếu
+ *          pool đó hết khối), ghi byte bảo vệ ngay sau vùng nhớ được yêu cầu
+ *          và cập nhật thống kê của pool, của toàn hệ thống và của thẻ.
+ * @param   size    Kích thước vùng bộ nhớ cần cấp phát
+ * @param   Tag     Thẻ của module cấp phát (LOG_MODULE_xxx)
+ * @return 	void*   Con trỏ đến vùng nhớ, NULL nếu kích thước quá lớn hoặc
+ *                  hết khối
+ **************************************************************************/
+void* Mem_AllocTagged(size_t size, Mem_TagType Tag) {
+    boolean exhausted = FALSE;
+
+    if (Tag >= MEM_NUM_TAGS) {
+        Tag = MEM_TAG_UNKNOWN;
     }
 
-    void* ptr = malloc(size);
-    if (ptr == NULL_PTR) {
-        printf("Memory allocation failed: Not enough memory.\n");
-        return NULL_PTR;
+    for (uint8 p = 0; p < Mem_NumPools; p++) {
+        Mem_PoolType* pool = &Mem_Pools[p];
+        if (pool->BlockSize < size || pool->NumBlocks == 0) {
+            continue;
+        }
+
+        uint32 index = Mem_TakeBlock(p);
+        if (index == MEM_INVALID_BLOCK) {
+            if (!exhausted) {
+                atomic_fetch_add_explicit(&pool->AllocFailures, 1, memory_order_relaxed);
+                exhausted = TRUE;
+            }
+            continue;   // Thử pool lớn hơn
+        }
+
+        Mem_BlockHeaderType* block = Mem_GetBlock(pool, index);
+        block->Size = (uint32)size;
+        block->Tag = Tag;
+        atomic_store_explicit(&block->Corrupted, FALSE, memory_order_relaxed);
+        memset((uint8*)(block + 1) + size, MEM_GUARD_BYTE, MEM_CFG_GUARD_SIZE);
+        atomic_store_explicit(&block->State, MEM_BLOCK_ALLOCATED, memory_order_release);
+
+        uint32 in_use = atomic_fetch_add_explicit(&pool->InUse, 1, memory_order_relaxed) + 1;
+        Mem_UpdatePeak(&pool->HighWaterMark, in_use);
+        Mem_UsageAdd(&Mem_TotalUsage, (uint32)size);
+        Mem_UsageAdd(&Mem_TagUsage[Tag], (uint32)size);
+        atomic_fetch_add_explicit(&Mem_TagUsage[Tag].TotalAllocs, 1, memory_order_relaxed);
+        return block + 1;
     }
 
-    allocated_blocks[allocation_count++] = ptr;
-    printf("Memory allocated: %zu bytes at address %p\n", size, ptr);
-    return ptr;
+    atomic_fetch_add_explicit(&Mem_TotalUsage.AllocFailures, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&Mem_TagUsage[Tag].AllocFailures, 1, memory_order_relaxed);
+    LOG_ERROR(MEM, "Memory allocation of %u bytes for %s failed: %s\n", (uint32)size, Log_GetModuleName(Tag),
+              exhausted ? "pools exhausted" : "size too large");
+    return NULL_PTR;
 }
 
 /**************************************************************************
  * @brief   Giải phóng một vùng bộ nhớ
- * @details Hàm này sẽ giải phóng vùng bộ nhớ được trỏ bởi con trỏ ptr và
- *          loại bỏ con trỏ này khỏi mảng giả lập.
+ * @details Con trỏ không do Mem_Alloc trả về và khối bị giải phóng hai lần
+ *          được phát hiện và bỏ qua. Giải phóng NULL không làm gì. Khối bị
+ *          ghi tràn được ghi log rồi vẫn được trả về pool.
  * @param   ptr     Con trỏ trỏ đến vùng bộ nhớ cần giải phóng
  * @return 	None  
  **************************************************************************/
 void Mem_Free(void* ptr) {
+    uint8 pool_index;
+    uint32 index;
+
     if (ptr == NULL_PTR) {
-        printf("Memory free failed: Null pointer provided.\n");
+        return;
+    }
+    if (Mem_FindBlock(ptr, &pool_index, &index) != E_OK) {
+        LOG_ERROR(MEM, "Memory free failed: Invalid pointer %p\n", ptr);
         return;
     }
 
-    for (uint8 i = 0; i < allocation_count; i++) {
-        if (allocated_blocks[i] == ptr) {
-            printf("Memory freed at address %p\n", ptr);
-            free(ptr);
-            allocated_blocks[i] = NULL_PTR;
-            return;
-        }
+    Mem_PoolType* pool = &Mem_Pools[pool_index];
+    Mem_BlockHeaderType* block = Mem_GetBlock(pool, index);
+    if (atomic_exchange_explicit(&block->State, MEM_BLOCK_FREE, memory_order_relaxed) != MEM_BLOCK_ALLOCATED) {
+        LOG_ERROR(MEM, "Memory free failed: Double free of %p\n", ptr);
+        return;
     }
 
-    printf("Memory free failed: Invalid pointer %p\n", ptr);
+    (void)Mem_CheckGuard(block);
+    atomic_fetch_sub_explicit(&pool->InUse, 1, memory_order_relaxed);
+    Mem_UsageRemove(&Mem_TotalUsage, block->Size);
+    Mem_UsageRemove(&Mem_TagUsage[block->Tag], block->Size);
+    Mem_GiveBlock(pool_index, index);
 }
 
 /**************************************************************************
  * @brief   Kiểm tra vùng bộ nhớ có hợp lệ hay không
- * @details Hàm này sẽ kiểm tra xem con trỏ ptr trỏ đến vùng bộ nhớ nào đó
- *          có hợp lệ hay không bằng cách kiểm tra xem con trỏ này có tồn tại
- *          trong mảng giả lập không.
+ * @details Hàm này tính khối từ địa chỉ của con trỏ nên không phụ thuộc vào
+ *          số khối đang được cấp phát.
  * @param   ptr     Con trỏ trỏ đến vùng bộ nhớ cần kiểm tra
  * @return 	int     Trả về 1 nếu vùng nhớ hợp lệ,
  *                         0 nếu vùng nhớ không hợp lệ  
  **************************************************************************/
 int Mem_Check(void* ptr) {
-    for (uint8 i = 0; i < allocation_count; i++) {
-        if (allocated_blocks[i] == ptr) {
-            printf("Memory check: Valid pointer %p\n", ptr);
-            return 1;  // Vùng nhớ hợp lệ
+    uint8 pool_index;
+    uint32 index;
+
+    if (ptr == NULL_PTR || Mem_FindBlock(ptr, &pool_index, &index) != E_OK) {
+        return 0;
+    }
+    const Mem_BlockHeaderType* block = Mem_GetBlock(&Mem_Pools[pool_index], index);
+    return (atomic_load_explicit(&block->State, memory_order_relaxed) == MEM_BLOCK_ALLOCATED) ? 1 : 0;
+}
+
+/**************************************************************************
+ * @brief   Đọc thống kê sử dụng của một pool
+ * @param   PoolIndex       Chỉ số của pool trong Mem_PoolConfigs
+ * @param   StatsPtr        Con trỏ lưu thống kê
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu pool không tồn tại
+ **************************************************************************/
+Std_ReturnType Mem_GetPoolStats(uint8 PoolIndex, Mem_PoolStatsType* StatsPtr) {
+    if (PoolIndex >= Mem_NumPools || StatsPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    const Mem_PoolType* pool = &Mem_Pools[PoolIndex];
+    StatsPtr->BlockSize = pool->BlockSize;
+    StatsPtr->NumBlocks = pool->NumBlocks;
+    StatsPtr->BlocksInUse = atomic_load_explicit(&pool->InUse, memory_order_relaxed);
+    StatsPtr->HighWaterMark = atomic_load_explicit(&pool->HighWaterMark, memory_order_relaxed);
+    StatsPtr->AllocFailures = atomic_load_explicit(&pool->AllocFailures, memory_order_relaxed);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc thống kê sử dụng bộ nhớ của toàn hệ thống
+ * @param   UsagePtr        Con trỏ lưu thống kê
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu con trỏ không hợp lệ
+ **************************************************************************/
+Std_ReturnType Mem_GetUsage(Mem_UsageType* UsagePtr) {
+    if (UsagePtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    Mem_UsageReadTotal(UsagePtr);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc thống kê sử dụng bộ nhớ của một thẻ
+ * @param   Tag             Thẻ cần đọc (LOG_MODULE_xxx hoặc MEM_TAG_UNKNOWN)
+ * @param   UsagePtr        Con trỏ lưu thống kê
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu thẻ không hợp lệ
+ **************************************************************************/
+Std_ReturnType Mem_GetTagUsage(Mem_TagType Tag, Mem_UsageType* UsagePtr) {
+    if (Tag >= MEM_NUM_TAGS || UsagePtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    Mem_UsageRead(&Mem_TagUsage[Tag], UsagePtr);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra byte bảo vệ của tất cả các khối đang được cấp phát
+ * @details Hàm này duyệt mọi khối của mọi pool. Khối có thể được giải phóng
+ *          và cấp phát lại trong lúc duyệt nên kết quả chỉ chính xác khi các
+ *          task khác không cấp phát đồng thời (ví dụ khi kết thúc), việc
+ *          kiểm tra trong Mem_Free luôn chính xác.
+ * @param   None
+ * @return 	uint32  Số khối bị ghi tràn mới phát hiện
+ **************************************************************************/
+uint32 Mem_CheckIntegrity(void) {
+    uint32 before = atomic_load_explicit(&Mem_TotalUsage.Corruptions, memory_order_relaxed);
+    uint32 checked = 0;
+
+    for (uint8 p = 0; p < Mem_NumPools; p++) {
+        const Mem_PoolType* pool = &Mem_Pools[p];
+        for (uint32 i = 0; i < pool->NumBlocks; i++) {
+            Mem_BlockHeaderType* block = Mem_GetBlock(pool, i);
+            if (atomic_load_explicit(&block->State, memory_order_acquire) == MEM_BLOCK_ALLOCATED) {
+                (void)Mem_CheckGuard(block);
+                checked++;
+            }
         }
     }
-    printf("Memory check: Invalid pointer %p\n", ptr);
-    return 0;  // Vùng nhớ không hợp lệ
-}
\ No newline at end of file
+
+    uint32 found = atomic_load_explicit(&Mem_TotalUsage.Corruptions, memory_order_relaxed) - before;
+    LOG_INFO(MEM, "Integrity check: %u allocated blocks checked, %u overruns found\n", checked, found);
+    return found;
+}
+
+/**************************************************************************
+ * @brief   In báo cáo sử dụng bộ nhớ
+ * @details Hàm này in tổng số byte/khối đang dùng và mức cao nhất, thống kê
+ *          của từng pool và của từng module đã từng cấp phát. Module còn giữ
+ *          bộ nhớ khi kết thúc là dấu hiệu rò rỉ. Hàm không duyệt byte bảo vệ
+ *          nên an toàn khi gọi định kỳ, số khối bị ghi tràn là các khối đã
+ *          được Mem_Free hoặc Mem_CheckIntegrity phát hiện.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Mem_Report(void) {
+    Mem_UsageType usage;
+    Mem_PoolStatsType stats;
+
+    Mem_UsageReadTotal(&usage);
+    LOG_INFO(MEM, "Memory usage: %u bytes in %u blocks live, peak %u bytes / %u blocks, %u allocs, %u failures, %u overruns\n",
+             usage.LiveBytes, usage.LiveBlocks, usage.PeakBytes, usage.PeakBlocks,
+             usage.TotalAllocs, usage.AllocFailures, usage.Corruptions);
+
+    for (uint8 p = 0; p < Mem_NumPools; p++) {
+        (void)Mem_GetPoolStats(p, &stats);
+        LOG_INFO(MEM, " - pool %u x %4u bytes: %u/%u in use, peak %u, %u failures\n",
+                 p, stats.BlockSize, stats.BlocksInUse, stats.NumBlocks, stats.HighWaterMark, stats.AllocFailures);
+    }
+
+    for (Mem_TagType tag = 0; tag < MEM_NUM_TAGS; tag++) {
+        Mem_UsageRead(&Mem_TagUsage[tag], &usage);
+        if (usage.TotalAllocs == 0 && usage.AllocFailures == 0) {
+            continue;
+        }
+        LOG_INFO(MEM, " - %-7s %u bytes in %u blocks live, peak %u bytes / %u blocks, %u allocs\n",
+                 (tag == MEM_TAG_UNKNOWN) ? "UNKNOWN" : Log_GetModuleName(tag),
+                 usage.LiveBytes, usage.LiveBlocks, usage.PeakBytes, usage.PeakBlocks, usage.TotalAllocs);
+    }
+
+    LOG_INFO(MEM, " - scratch arenas: %u of %u bytes reserved\n",
+             atomic_load_explicit(&Mem_ScratchUsed, memory_order_relaxed), (uint32)MEM_SCRATCH_SIZE);
+}
+
+/**************************************************************************
+ * @brief   Tạo một arena từ vùng nhớ tĩnh MEM_SCRATCH_SIZE
+ * @details Vùng nhớ được cắt từ vùng nhớ tĩnh bằng phép dịch con trỏ nguyên
+ *          tử nên các luồng có thể tạo arena đồng thời.
+ * @param   Arena           Con trỏ đến arena cần tạo
+ * @param   Size            Kích thước vùng nhớ của arena (byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu tạo thành công,
+ *                                 E_NOT_OK nếu vùng nhớ tĩnh không đủ chỗ
+ **************************************************************************/
+Std_ReturnType Mem_Arena_Create(Mem_ArenaType* Arena, uint32 Size) {
+    if (Arena == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Arena->Base = NULL_PTR;
+    Arena->Size = 0;
+    Arena->Used = 0;
+    atomic_store_explicit(&Arena->HighWaterMark, 0, memory_order_relaxed);
+    atomic_store_explicit(&Arena->AllocFailures, 0, memory_order_relaxed);
+
+    uint32 aligned = (Size + MEM_BLOCK_ALIGNMENT - 1) & ~(uint32)(MEM_BLOCK_ALIGNMENT - 1);
+    uint32 offset = atomic_load_explicit(&Mem_ScratchUsed, memory_order_relaxed);
+    do {
+        if (aligned > MEM_SCRATCH_SIZE - offset) {
+            LOG_ERROR(MEM, "Arena of %u bytes does not fit in scratch memory (%u of %u bytes used)\n",
+                      Size, offset, (uint32)MEM_SCRATCH_SIZE);
+            return E_NOT_OK;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&Mem_ScratchUsed, &offset, offset + aligned,
+                                                    memory_order_relaxed, memory_order_relaxed));
+
+    Arena->Base = &Mem_ScratchMemory[offset];
+    Arena->Size = aligned;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Cấp phát một vùng nhớ từ arena
+ * @details Hàm này chỉ dịch con trỏ cấp phát lên một đoạn đã căn lề nên thời
+ *          gian cấp phát là hằng số.
+ * @param   Arena   Con trỏ đến arena
+ * @param   size    Kích thước vùng nhớ cần cấp phát
+ * @return 	void*   Con trỏ đến vùng nhớ (căn lề MEM_BLOCK_ALIGNMENT),
+ *                  NULL nếu arena không đủ chỗ
+ **************************************************************************/
+void* Mem_Arena_Alloc(Mem_ArenaType* Arena, size_t size) {
+    if (Arena == NULL_PTR) {
+        return NULL_PTR;
+    }
+
+    if (size > Arena->Size - Arena->Used) {
+        atomic_fetch_add_explicit(&Arena->AllocFailures, 1, memory_order_relaxed);
+        LOG_ERROR(MEM, "Arena allocation of %u bytes failed: %u of %u bytes used\n",
+                  (uint32)size, Arena->Used, Arena->Size);
+        return NULL_PTR;
+    }
+
+    void* ptr = Arena->Base + Arena->Used;
+    uint32 aligned = ((uint32)size + MEM_BLOCK_ALIGNMENT - 1) & ~(uint32)(MEM_BLOCK_ALIGNMENT - 1);
+    Arena->Used = (aligned < Arena->Size - Arena->Used) ? Arena->Used + aligned : Arena->Size;
+    if (Arena->Used > atomic_load_explicit(&Arena->HighWaterMark, memory_order_relaxed)) {
+        atomic_store_explicit(&Arena->HighWaterMark, Arena->Used, memory_order_relaxed);
+    }
+    return ptr;
+}
+
+/**************************************************************************
+ * @brief   Thu hồi toàn bộ vùng nhớ đã cấp phát từ arena
+ * @param   Arena   Con trỏ đến arena
+ * @return 	None
+ **************************************************************************/
+void Mem_Arena_Reset(Mem_ArenaType* Arena) {
+    if (Arena != NULL_PTR) {
+        Arena->Used = 0;
+    }
+}
+
+/**************************************************************************
+ * @brief   Gắn arena cho luồng đang gọi, dùng bởi Mem_ScratchAlloc
+ * @param   Arena   Con trỏ đến arena (NULL để gỡ arena khỏi luồng)
+ * @return 	None
+ **************************************************************************/
+void Mem_Arena_Bind(Mem_ArenaType* Arena) {
+    Mem_CurrentArena = Arena;
+}
+
+/**************************************************************************
+ * @brief   Cấp phát vùng nhớ tạm từ arena của task đang chạy
+ * @param   size    Kích thước vùng nhớ cần cấp phát
+ * @return 	void*   Con trỏ đến vùng nhớ, NULL nếu luồng không có arena
+ *                  hoặc arena không đủ chỗ
+ **************************************************************************/
+void* Mem_ScratchAlloc(size_t size) {
+    if (Mem_CurrentArena == NULL_PTR) {
+        LOG_ERROR(MEM, "Scratch allocation of %u bytes failed: no arena bound to this thread\n", (uint32)size);
+        return NULL_PTR;
+    }
+    return Mem_Arena_Alloc(Mem_CurrentArena, size);
+}
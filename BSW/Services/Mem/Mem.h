@@ -1,9 +1,109 @@
 #ifndef MEM_H
 #define MEM_H
 
-#include <stdio.h>
-#include <stdlib.h>
+#include <stddef.h>
+#include <stdatomic.h>
 #include "Std_Types.h"
+#include "Log.h"
+
+/**************************************************************************
+ * @brief Giới hạn của hệ thống quản lý bộ nhớ
+ **************************************************************************/
+#define MEM_ARENA_SIZE              131072  /* Vùng nhớ tĩnh chia cho các pool (byte) */
+#define MEM_MAX_POOLS               8       /* Số pool tối đa */
+#define MEM_BLOCK_ALIGNMENT         16      /* Căn lề của vùng nhớ trả về cho người gọi */
+#define MEM_SCRATCH_SIZE            65536   /* Vùng nhớ tĩnh chia cho các arena (byte) */
+
+/**************************************************************************
+ * @brief Bộ đệm khối riêng của từng luồng, có thể chọn khi biên dịch, ví dụ:
+ *        -DMEM_CFG_THREAD_CACHE=0 để mọi luồng dùng chung danh sách trống
+ **************************************************************************/
+#ifndef MEM_CFG_THREAD_CACHE
+#define MEM_CFG_THREAD_CACHE        1
+#endif
+#define MEM_THREAD_CACHE_SIZE       8       /* Số khối tối đa giữ lại cho mỗi pool trong một luồng */
+
+/**************************************************************************
+ * @brief Số byte bảo vệ ngay sau vùng nhớ của mỗi lần cấp phát, dùng để phát
+ *        hiện ghi tràn. Đặt bằng 0 để tắt, ví dụ: -DMEM_CFG_GUARD_SIZE=0
+ **************************************************************************/
+#ifndef MEM_CFG_GUARD_SIZE
+#define MEM_CFG_GUARD_SIZE          8
+#endif
+
+/**************************************************************************
+ * @typedef Mem_TagType
+ * @brief   Định nghĩa kiểu dữ liệu cho thẻ của một lần cấp phát
+ * @details Thẻ là ID module ghi log (LOG_MODULE_xxx) của module cấp phát,
+ *          MEM_TAG_UNKNOWN nếu cấp phát qua Mem_Alloc.
+ **************************************************************************/
+typedef Log_ModuleIdType Mem_TagType;
+#define MEM_TAG_UNKNOWN             (Mem_TagType)LOG_MODULE_COUNT
+#define MEM_NUM_TAGS                (LOG_MODULE_COUNT + 1)
+
+/**************************************************************************
+ * @brief Cấp phát có gắn thẻ của module gọi, ví dụ: MEM_ALLOC(PDUR, 64)
+ **************************************************************************/
+#define MEM_ALLOC(Module, size)     Mem_AllocTagged((size), LOG_MODULE_##Module)
+
+/**************************************************************************
+ * @struct  Mem_PoolConfigType
+ * @brief   Định nghĩa cấu trúc cấu hình của một pool khối cố định
+ **************************************************************************/
+typedef struct {
+    uint32 BlockSize;       /* Kích thước dữ liệu của một khối (byte) */
+    uint32 NumBlocks;       /* Số khối của pool */
+} Mem_PoolConfigType;
+
+/**************************************************************************
+ * @struct  Mem_PoolStatsType
+ * @brief   Định nghĩa cấu trúc thống kê sử dụng của một pool
+ **************************************************************************/
+typedef struct {
+    uint32 BlockSize;       /* Kích thước dữ liệu của một khối (byte) */
+    uint32 NumBlocks;       /* Số khối của pool */
+    uint32 BlocksInUse;     /* Số khối đang được cấp phát */
+    uint32 HighWaterMark;   /* Số khối được cấp phát cùng lúc lớn nhất */
+    uint32 AllocFailures;   /* Số lần cấp phát thất bại do hết khối */
+} Mem_PoolStatsType;
+
+/**************************************************************************
+ * @struct  Mem_UsageType
+ * @brief   Định nghĩa cấu trúc thống kê sử dụng bộ nhớ của toàn hệ thống
+ *          hoặc của một thẻ
+ * @details Số byte là số byte được yêu cầu, không tính phần đầu khối và phần
+ *          còn thừa của khối.
+ **************************************************************************/
+typedef struct {
+    uint32 LiveBytes;       /* Số byte đang được cấp phát */
+    uint32 LiveBlocks;      /* Số khối đang được cấp phát */
+    uint32 PeakBytes;       /* Số byte được cấp phát cùng lúc lớn nhất */
+    uint32 PeakBlocks;      /* Số khối được cấp phát cùng lúc lớn nhất */
+    uint32 TotalAllocs;     /* Tổng số lần cấp phát thành công */
+    uint32 AllocFailures;   /* Số lần cấp phát thất bại */
+    uint32 Corruptions;     /* Số khối bị phát hiện ghi tràn */
+} Mem_UsageType;
+
+/**************************************************************************
+ * @struct  Mem_ArenaType
+ * @brief   Định nghĩa cấu trúc của một arena cấp phát kiểu dịch con trỏ
+ * @details Arena chỉ được cấp phát bởi một luồng. Vùng nhớ cấp phát từ arena
+ *          không được giải phóng riêng lẻ mà được thu hồi toàn bộ khi gọi
+ *          Mem_Arena_Reset. Thống kê có thể được đọc từ luồng khác.
+ **************************************************************************/
+typedef struct {
+    uint8* Base;                /* Vùng nhớ của arena */
+    uint32 Size;                /* Kích thước vùng nhớ (byte) */
+    uint32 Used;                /* Số byte đã cấp phát kể từ lần reset gần nhất */
+    atomic_uint HighWaterMark;  /* Số byte đã cấp phát lớn nhất giữa hai lần reset */
+    atomic_uint AllocFailures;  /* Số lần cấp phát thất bại do hết chỗ */
+} Mem_ArenaType;
+
+/**************************************************************************
+ * @brief Bảng cấu hình các pool (Mem_Cfg.c), sắp xếp theo BlockSize tăng dần
+ **************************************************************************/
+extern const Mem_PoolConfigType Mem_PoolConfigs[];
+extern const uint8 Mem_PoolConfigCount;
 
 /**************************************************************************
  * @brief   Khởi tạo hệ thống quản lý bộ nhớ
@@ -14,13 +114,28 @@ void Mem_Init(void);
 
 /**************************************************************************
  * @brief   Cấp phát một vùng bộ nhớ
+ * @details Vùng nhớ được lấy từ pool nhỏ nhất có khối đủ lớn, nếu pool đó
+ *          hết khối thì lấy từ pool lớn hơn. Thời gian cấp phát không phụ
+ *          thuộc vào số khối đang được dùng và không bao giờ gọi malloc.
  * @param   size    Kích thước vùng bộ nhớ cần cấp phát
- * @return 	None  
+ * @return 	void*   Con trỏ đến vùng nhớ (căn lề MEM_BLOCK_ALIGNMENT),
+ *                  NULL nếu kích thước quá lớn hoặc hết khối
  **************************************************************************/
 void* Mem_Alloc(size_t size);
 
+/**************************************************************************
+ * @brief   Cấp phát một vùng bộ nhớ và gắn thẻ của module gọi
+ * @details Nên dùng qua macro MEM_ALLOC.
+ * @param   size    Kích thước vùng bộ nhớ cần cấp phát
+ * @param   Tag     Thẻ của module cấp phát (LOG_MODULE_xxx)
+ * @return 	void*   Con trỏ đến vùng nhớ, NULL nếu kích thước quá lớn hoặc
+ *                  hết khối
+ **************************************************************************/
+void* Mem_AllocTagged(size_t size, Mem_TagType Tag);
+
 /**************************************************************************
  * @brief   Giải phóng một vùng bộ nhớ
+ * @details Các byte bảo vệ của vùng nhớ được kiểm tra trước khi giải phóng.
  * @param   ptr     Con trỏ trỏ đến vùng bộ nhớ cần giải phóng
  * @return 	None  
  **************************************************************************/
@@ -28,13 +143,105 @@ void Mem_Free(void* ptr);
 
 /**************************************************************************
  * @brief   Kiểm tra vùng bộ nhớ có hợp lệ hay không
- * @details Hàm này sẽ kiểm tra xem con trỏ ptr trỏ đến vùng bộ nhớ nào đó
- *          có hợp lệ hay không bằng cách kiểm tra xem con trỏ này có tồn tại
- *          trong mảng giả lập không.
+ * @details Hàm này kiểm tra con trỏ có trỏ đến đầu một khối đang được cấp
+ *          phát của một pool hay không.
  * @param   ptr     Con trỏ trỏ đến vùng bộ nhớ cần kiểm tra
  * @return 	int     Trả về 1 nếu vùng nhớ hợp lệ,
  *                         0 nếu vùng nhớ không hợp lệ   
  **************************************************************************/
 int Mem_Check(void* ptr);
 
-#endif /* MEM_H */ 
\ No newline at end of file
+/**************************************************************************
+ * @brief   Đọc thống kê sử dụng của một pool
+ * @param   PoolIndex       Chỉ số của pool trong Mem_PoolConfigs
+ * @param   StatsPtr        Con trỏ lưu thống kê
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu pool không tồn tại
+ **************************************************************************/
+Std_ReturnType Mem_GetPoolStats(uint8 PoolIndex, Mem_PoolStatsType* StatsPtr);
+
+/**************************************************************************
+ * @brief   Đọc thống kê sử dụng bộ nhớ của toàn hệ thống
+ * @param   UsagePtr        Con trỏ lưu thống kê
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu con trỏ không hợp lệ
+ **************************************************************************/
+Std_ReturnType Mem_GetUsage(Mem_UsageType* UsagePtr);
+
+/**************************************************************************
+ * @brief   Đọc thống kê sử dụng bộ nhớ của một thẻ
+ * @param   Tag             Thẻ cần đọc (LOG_MODULE_xxx hoặc MEM_TAG_UNKNOWN)
+ * @param   UsagePtr        Con trỏ lưu thống kê
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu thẻ không hợp lệ
+ **************************************************************************/
+Std_ReturnType Mem_GetTagUsage(Mem_TagType Tag, Mem_UsageType* UsagePtr);
+
+/**************************************************************************
+ * @brief   Kiểm tra byte bảo vệ của tất cả các khối đang được cấp phát
+ * @details Mỗi khối bị ghi tràn được ghi log và chỉ bị đếm một lần, kết
+ *          quả của lần kiểm tra cũng được ghi log.
+ * @param   None
+ * @return 	uint32  Số khối bị ghi tràn mới phát hiện
+ **************************************************************************/
+uint32 Mem_CheckIntegrity(void);
+
+/**************************************************************************
+ * @brief   In báo cáo sử dụng bộ nhớ
+ * @details Báo cáo gồm tổng số byte/khối đang dùng và mức cao nhất, thống kê
+ *          của từng pool và của từng module còn giữ bộ nhớ. Hàm không kiểm
+ *          tra byte bảo vệ, khi kết thúc gọi Mem_CheckIntegrity trước để
+ *          số khối bị ghi tràn trong báo cáo đầy đủ.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Mem_Report(void);
+
+/**************************************************************************
+ * @brief   Tạo một arena từ vùng nhớ tĩnh MEM_SCRATCH_SIZE
+ * @details Vùng nhớ của arena không bao giờ được trả lại, chỉ nên gọi khi
+ *          khởi tạo (sau Mem_Init).
+ * @param   Arena           Con trỏ đến arena cần tạo
+ * @param   Size            Kích thước vùng nhớ của arena (byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu tạo thành công,
+ *                                 E_NOT_OK nếu vùng nhớ tĩnh không đủ chỗ
+ **************************************************************************/
+Std_ReturnType Mem_Arena_Create(Mem_ArenaType* Arena, uint32 Size);
+
+/**************************************************************************
+ * @brief   Cấp phát một vùng nhớ từ arena
+ * @param   Arena   Con trỏ đến arena
+ * @param   size    Kích thước vùng nhớ cần cấp phát
+ * @return 	void*   Con trỏ đến vùng nhớ (căn lề MEM_BLOCK_ALIGNMENT),
+ *                  NULL nếu arena không đủ chỗ
+ **************************************************************************/
+void* Mem_Arena_Alloc(Mem_ArenaType* Arena, size_t size);
+
+/**************************************************************************
+ * @brief   Thu hồi toàn bộ vùng nhớ đã cấp phát từ arena
+ * @param   Arena   Con trỏ đến arena
+ * @return 	None
+ **************************************************************************/
+void Mem_Arena_Reset(Mem_ArenaType* Arena);
+
+/**************************************************************************
+ * @brief   Gắn arena cho luồng đang gọi, dùng bởi Mem_ScratchAlloc
+ * @details Os gắn arena riêng của mỗi task tuần hoàn và reset arena sau mỗi
+ *          lần kích hoạt.
+ * @param   Arena   Con trỏ đến arena (NULL để gỡ arena khỏi luồng)
+ * @return 	None
+ **************************************************************************/
+void Mem_Arena_Bind(Mem_ArenaType* Arena);
+
+/**************************************************************************
+ * @brief   Cấp phát vùng nhớ tạm từ arena của task đang chạy
+ * @details Vùng nhớ chỉ có hiệu lực đến hết lần kích hoạt hiện tại của task,
+ *          không được giải phóng và không được giữ lại sau khi runnable
+ *          kết thúc.
+ * @param   size    Kích thước vùng nhớ cần cấp phát
+ * @return 	void*   Con trỏ đến vùng nhớ, NULL nếu luồng không có arena
+ *                  hoặc arena không đủ chỗ
+ **************************************************************************/
+void* Mem_ScratchAlloc(size_t size);
+
+#endif /* MEM_H */
@@ -0,0 +1,14 @@
+#include "Mem.h"
+
+/**************************************************************************
+ * @brief Bảng cấu hình các pool khối cố định (BlockSize tăng dần)
+ * @details Tổng kích thước các pool (kể cả phần đầu khối) phải nằm trong
+ *          MEM_ARENA_SIZE, pool không vừa sẽ bị bỏ qua khi khởi tạo.
+ **************************************************************************/
+const Mem_PoolConfigType Mem_PoolConfigs[] = {
+    {16, 512},
+    {64, 256},
+    {256, 64},
+    {1024, 16},
+};
+const uint8 Mem_PoolConfigCount = sizeof(Mem_PoolConfigs) / sizeof(Mem_PoolConfigs[0]);
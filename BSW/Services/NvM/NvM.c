@@ -0,0 +1,273 @@
+#include "NvM.h"
+#include "NvM_Cfg.h"
+#include "Fee.h"
+#include "Fee_Cfg.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+#include "Os.h"    // Resource bảo vệ bản sao RAM
+#include <pthread.h>
+#include <string.h>
+
+/**************************************************************************
+ * @struct  NvM_BlockStateType
+ * @brief   Trạng thái chạy của một khối NvM
+ * @details Bản sao RAM được bảo vệ bởi NvM_MirrorResource, resource chỉ được
+ *          giữ khi sao chép bản sao RAM nên các task điều khiển không bao giờ
+ *          phải chờ ghi Fee.
+ **************************************************************************/
+typedef struct {
+    uint8* RamBlock;                /* Bản sao RAM (NULL nếu khối cấu hình sai) */
+    atomic_uint Dirty;              /* Bản sao RAM đã thay đổi và chưa được ghi xuống Fee */
+    atomic_uint Result;             /* Kết quả của lần đọc/ghi Fee gần nhất */
+} NvM_BlockStateType;
+
+/**************************************************************************
+ * @brief Trạng thái và bản sao RAM của các khối
+ **************************************************************************/
+static NvM_BlockStateType NvM_BlockStates[NVM_MAX_BLOCKS];
+static uint64 NvM_RamPool[NVM_RAM_POOL_SIZE / sizeof(uint64)];
+static uint16 NvM_NumBlocks = 0;
+static boolean NvM_FeeAvailable = FALSE;
+
+/**************************************************************************
+ * @brief Resource bảo vệ bản sao RAM của các khối
+ * @details Ceiling tự động: một task nền đang sao chép bản sao RAM được nâng
+ *          lên độ ưu tiên của task điều khiển cao nhất nên task đó chỉ phải
+ *          chờ tối đa một lần sao chép.
+ **************************************************************************/
+static const Os_ResourceConfigType NvM_MirrorResourceConfig = {"NvM RAM Mirror", OS_RESOURCE_CEILING_AUTO};
+static Os_ResourceIdType NvM_MirrorResource;
+
+/**************************************************************************
+ * @brief Bộ đệm ghi Fee và khóa đảm bảo chỉ một luồng ghi Fee tại một thời
+ *        điểm (task nền hoặc NvM_WriteAll)
+ **************************************************************************/
+static uint8 NvM_FlushBuffer[NVM_MAX_BLOCK_LENGTH];
+static pthread_mutex_t NvM_FlushLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**************************************************************************
+ * @brief   Nạp giá trị mặc định vào bản sao RAM của một khối
+ * @param   BlockId     ID của khối
+ * @return 	None
+ **************************************************************************/
+static void NvM_LoadDefaults(NvM_BlockIdType BlockId) {
+    const NvM_BlockDescriptorType* descriptor = &NvM_BlockDescriptors[BlockId];
+    if (descriptor->RomBlockDataAddress != NULL_PTR) {
+        memcpy(NvM_BlockStates[BlockId].RamBlock, descriptor->RomBlockDataAddress, descriptor->Length);
+    } else {
+        memset(NvM_BlockStates[BlockId].RamBlock, 0, descriptor->Length);
+    }
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra ID của khối
+ * @param   BlockId     ID của khối
+ * @return 	boolean     TRUE nếu khối tồn tại và dùng được, FALSE nếu không
+ **************************************************************************/
+static inline boolean NvM_IsValidBlock(NvM_BlockIdType BlockId) {
+    return (BlockId < NvM_NumBlocks && NvM_BlockStates[BlockId].RamBlock != NULL_PTR) ? TRUE : FALSE;
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo NvM và tầng Fee
+ * @details Hàm này cấp bản sao RAM cho các khối từ vùng nhớ tĩnh, nạp giá
+ *          trị mặc định và mở file giả lập flash. Nếu Fee không dùng được,
+ *          NvM vẫn chạy với bản sao RAM nhưng dữ liệu không được lưu lại.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_Init() {
+    uint32 pool_offset = 0;
+
+    if (Os_CreateResource(&NvM_MirrorResourceConfig, &NvM_MirrorResource) != E_OK) {
+        LOG_ERROR(NVM, "Cannot create RAM mirror resource, NvM disabled\n");
+        NvM_NumBlocks = 0;
+        return;
+    }
+
+    NvM_NumBlocks = (NvM_BlockDescriptorCount < NVM_MAX_BLOCKS) ? NvM_BlockDescriptorCount : NVM_MAX_BLOCKS;
+    for (NvM_BlockIdType id = 0; id < NvM_NumBlocks; id++) {
+        NvM_BlockStateType* state = &NvM_BlockStates[id];
+        uint16 length = NvM_BlockDescriptors[id].Length;
+
+        atomic_store(&state->Dirty, FALSE);
+        atomic_store(&state->Result, NVM_REQ_OK);
+        state->RamBlock = NULL_PTR;
+
+        if (length > NVM_MAX_BLOCK_LENGTH || pool_offset + length > NVM_RAM_POOL_SIZE) {
+            LOG_ERROR(NVM, "Block %u (%s) does not fit in RAM pool, disabled\n", id, NvM_BlockDescriptors[id].Name);
+            atomic_store(&state->Result, NVM_REQ_NOT_OK);
+            continue;
+        }
+        state->RamBlock = (uint8*)NvM_RamPool + pool_offset;
+        pool_offset += (length + 7U) & ~7U;
+        NvM_LoadDefaults(id);
+    }
+
+    NvM_FeeAvailable = (Fee_Init(FEE_CFG_FILE_PATH) == E_OK) ? TRUE : FALSE;
+    if (!NvM_FeeAvailable) {
+        LOG_WARN(NVM, "Fee unavailable, non-volatile data will not persist\n");
+    }
+
+    LOG_INFO(NVM, "NVRAM Manager (NvM) Initialized, %u blocks, %u bytes RAM.\n", NvM_NumBlocks, pool_offset);
+}
+
+/**************************************************************************
+ * @brief   Nạp dữ liệu đã lưu của tất cả các khối vào bản sao RAM
+ * @details Khối chưa từng được lưu hoặc bị hỏng giữ giá trị mặc định đã nạp
+ *          ở NvM_Init, trạng thái của khối cho biết nguồn gốc dữ liệu.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_ReadAll() {
+    for (NvM_BlockIdType id = 0; id < NvM_NumBlocks; id++) {
+        if (!NvM_IsValidBlock(id)) {
+            continue;
+        }
+        const NvM_BlockDescriptorType* descriptor = &NvM_BlockDescriptors[id];
+        NvM_BlockStateType* state = &NvM_BlockStates[id];
+
+        Os_GetResource(NvM_MirrorResource);
+        Fee_JobResultType fee_result = NvM_FeeAvailable ? Fee_Read(descriptor->FeeBlockNumber, state->RamBlock, descriptor->Length) : FEE_JOB_FAILED;
+        Os_ReleaseResource(NvM_MirrorResource);
+
+        switch (fee_result) {
+            case FEE_JOB_OK:
+                atomic_store(&state->Result, NVM_REQ_OK);
+                LOG_DEBUG(NVM, "Block %u (%s) restored from Fee\n", id, descriptor->Name);
+                break;
+            case FEE_BLOCK_INVALID:
+                atomic_store(&state->Result, NVM_REQ_RESTORED_FROM_ROM);
+                LOG_INFO(NVM, "Block %u (%s) not stored yet, using defaults\n", id, descriptor->Name);
+                break;
+            case FEE_BLOCK_INCONSISTENT:
+                atomic_store(&state->Result, NVM_REQ_INTEGRITY_FAILED);
+                LOG_WARN(NVM, "Block %u (%s) corrupted, using defaults\n", id, descriptor->Name);
+                break;
+            default:
+                atomic_store(&state->Result, NVM_REQ_NOT_OK);
+                break;
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Đọc bản sao RAM của một khối
+ * @param   BlockId         ID của khối
+ * @param   DstPtr          Con trỏ lưu dữ liệu (Length byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType NvM_ReadBlock(NvM_BlockIdType BlockId, void* DstPtr) {
+    if (!NvM_IsValidBlock(BlockId) || DstPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    NvM_BlockStateType* state = &NvM_BlockStates[BlockId];
+    if (Os_GetResource(NvM_MirrorResource) != E_OK) {
+        return E_NOT_OK;
+    }
+    memcpy(DstPtr, state->RamBlock, NvM_BlockDescriptors[BlockId].Length);
+    Os_ReleaseResource(NvM_MirrorResource);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Ghi dữ liệu mới cho một khối
+ * @details Hàm này chỉ sao chép dữ liệu vào bản sao RAM và đánh dấu khối
+ *          chờ ghi nên có thể gọi từ các task điều khiển.
+ * @param   BlockId         ID của khối
+ * @param   SrcPtr          Con trỏ đến dữ liệu cần ghi (Length byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu ghi thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType NvM_WriteBlock(NvM_BlockIdType BlockId, const void* SrcPtr) {
+    if (!NvM_IsValidBlock(BlockId) || SrcPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    NvM_BlockStateType* state = &NvM_BlockStates[BlockId];
+    if (Os_GetResource(NvM_MirrorResource) != E_OK) {
+        return E_NOT_OK;
+    }
+    memcpy(state->RamBlock, SrcPtr, NvM_BlockDescriptors[BlockId].Length);
+    atomic_store_explicit(&state->Dirty, TRUE, memory_order_relaxed);
+    Os_ReleaseResource(NvM_MirrorResource);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc trạng thái của một khối
+ * @param   BlockId             ID của khối
+ * @param   RequestResultPtr    Con trỏ lưu trạng thái
+ * @return 	Std_ReturnType      Trả về E_OK nếu đọc thành công,
+ *                                     E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType NvM_GetErrorStatus(NvM_BlockIdType BlockId, NvM_RequestResultType* RequestResultPtr) {
+    if (BlockId >= NvM_NumBlocks || RequestResultPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    const NvM_BlockStateType* state = &NvM_BlockStates[BlockId];
+    if (atomic_load_explicit(&state->Dirty, memory_order_relaxed)) {
+        *RequestResultPtr = NVM_REQ_PENDING;
+    } else {
+        *RequestResultPtr = (NvM_RequestResultType)atomic_load_explicit(&state->Result, memory_order_relaxed);
+    }
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Ghi các khối đang chờ xuống Fee
+ * @details Bản sao RAM được chép sang bộ đệm ghi trong lúc giữ khóa của
+ *          khối, việc ghi và đồng bộ file diễn ra sau khi nhả khóa. Khối ghi
+ *          thất bại được giữ trạng thái chờ để thử lại ở lần gọi sau.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_MainFunction() {
+    if (!NvM_FeeAvailable) {
+        return;
+    }
+
+    pthread_mutex_lock(&NvM_FlushLock);
+    for (NvM_BlockIdType id = 0; id < NvM_NumBlocks; id++) {
+        NvM_BlockStateType* state = &NvM_BlockStates[id];
+        if (state->RamBlock == NULL_PTR || !atomic_load_explicit(&state->Dirty, memory_order_relaxed)) {
+            continue;
+        }
+
+        const NvM_BlockDescriptorType* descriptor = &NvM_BlockDescriptors[id];
+        if (Os_GetResource(NvM_MirrorResource) != E_OK) {
+            continue;
+        }
+        memcpy(NvM_FlushBuffer, state->RamBlock, descriptor->Length);
+        atomic_store_explicit(&state->Dirty, FALSE, memory_order_relaxed);
+        Os_ReleaseResource(NvM_MirrorResource);
+
+        if (Fee_Write(descriptor->FeeBlockNumber, NvM_FlushBuffer, descriptor->Length) == E_OK) {
+            atomic_store_explicit(&state->Result, NVM_REQ_OK, memory_order_relaxed);
+        } else {
+            atomic_store_explicit(&state->Dirty, TRUE, memory_order_relaxed);
+            if (atomic_exchange_explicit(&state->Result, NVM_REQ_NOT_OK, memory_order_relaxed) != NVM_REQ_NOT_OK) {
+                LOG_ERROR(NVM, "Writing block %u (%s) failed, will retry\n", id, descriptor->Name);
+            }
+        }
+    }
+    pthread_mutex_unlock(&NvM_FlushLock);
+}
+
+/**************************************************************************
+ * @brief   Ghi tất cả các khối đang chờ xuống Fee trước khi tắt hệ thống
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_WriteAll() {
+    NvM_MainFunction();
+
+    for (NvM_BlockIdType id = 0; id < NvM_NumBlocks; id++) {
+        if (atomic_load(&NvM_BlockStates[id].Dirty)) {
+            LOG_ERROR(NVM, "Block %u (%s) could not be saved\n", id, NvM_BlockDescriptors[id].Name);
+        }
+    }
+    LOG_INFO(NVM, "All NvM blocks written.\n");
+}
@@ -0,0 +1,105 @@
+#ifndef NVM_H
+#define NVM_H
+
+#include <stdatomic.h>
+#include "Std_Types.h"
+
+/**************************************************************************
+ * @brief Giới hạn của NvM
+ **************************************************************************/
+#define NVM_MAX_BLOCKS          32      /* Số khối NvM tối đa */
+#define NVM_RAM_POOL_SIZE       8192    /* Tổng kích thước bản sao RAM của các khối (byte) */
+#define NVM_MAX_BLOCK_LENGTH    2048    /* Kích thước tối đa của một khối (byte) */
+
+/**************************************************************************
+ * @typedef NvM_BlockIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của khối NvM (chỉ số trong bảng
+ *          NvM_BlockDescriptors)
+ **************************************************************************/
+typedef uint16 NvM_BlockIdType;
+
+/**************************************************************************
+ * @typedef NvM_RequestResultType
+ * @brief   Định nghĩa kiểu dữ liệu cho trạng thái của một khối NvM
+ **************************************************************************/
+typedef uint8 NvM_RequestResultType;
+#define NVM_REQ_OK                  (NvM_RequestResultType)0x00     /* Bản sao RAM khớp với dữ liệu đã lưu */
+#define NVM_REQ_NOT_OK              (NvM_RequestResultType)0x01     /* Đọc hoặc ghi Fee thất bại */
+#define NVM_REQ_PENDING             (NvM_RequestResultType)0x02     /* Bản sao RAM đang chờ ghi xuống Fee */
+#define NVM_REQ_INTEGRITY_FAILED    (NvM_RequestResultType)0x03     /* Dữ liệu đã lưu bị hỏng, đã nạp giá trị mặc định */
+#define NVM_REQ_RESTORED_FROM_ROM   (NvM_RequestResultType)0x08     /* Khối chưa từng được lưu, đã nạp giá trị mặc định */
+
+/**************************************************************************
+ * @struct  NvM_BlockDescriptorType
+ * @brief   Định nghĩa cấu trúc cấu hình của một khối NvM
+ **************************************************************************/
+typedef struct {
+    const char* Name;                   /* Tên của khối */
+    uint16 FeeBlockNumber;              /* Số hiệu khối Fee lưu dữ liệu */
+    uint16 Length;                      /* Độ dài dữ liệu của khối (byte) */
+    const void* RomBlockDataAddress;    /* Giá trị mặc định (NULL: toàn 0) */
+} NvM_BlockDescriptorType;
+
+/**************************************************************************
+ * @brief   Khởi tạo NvM và tầng Fee
+ * @details Bản sao RAM của các khối được nạp giá trị mặc định, dữ liệu đã
+ *          lưu được nạp sau đó bằng NvM_ReadAll.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_Init(void);
+
+/**************************************************************************
+ * @brief   Nạp dữ liệu đã lưu của tất cả các khối vào bản sao RAM
+ * @details Hàm này được gọi một lần khi khởi động, trước khi khởi tạo các
+ *          module dùng NvM (DEM, các SWC).
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_ReadAll(void);
+
+/**************************************************************************
+ * @brief   Đọc bản sao RAM của một khối
+ * @param   BlockId         ID của khối
+ * @param   DstPtr          Con trỏ lưu dữ liệu (Length byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType NvM_ReadBlock(NvM_BlockIdType BlockId, void* DstPtr);
+
+/**************************************************************************
+ * @brief   Ghi dữ liệu mới cho một khối
+ * @details Dữ liệu chỉ được sao chép vào bản sao RAM và đánh dấu chờ ghi,
+ *          NvM_MainFunction ghi xuống Fee sau đó. Nhiều lần ghi giữa hai lần
+ *          chạy NvM_MainFunction chỉ tạo ra một lần ghi Fee.
+ * @param   BlockId         ID của khối
+ * @param   SrcPtr          Con trỏ đến dữ liệu cần ghi (Length byte)
+ * @return 	Std_ReturnType  Trả về E_OK nếu ghi thành công,
+ *                                 E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType NvM_WriteBlock(NvM_BlockIdType BlockId, const void* SrcPtr);
+
+/**************************************************************************
+ * @brief   Đọc trạng thái của một khối
+ * @param   BlockId             ID của khối
+ * @param   RequestResultPtr    Con trỏ lưu trạng thái
+ * @return 	Std_ReturnType      Trả về E_OK nếu đọc thành công,
+ *                                     E_NOT_OK nếu khối không tồn tại
+ **************************************************************************/
+Std_ReturnType NvM_GetErrorStatus(NvM_BlockIdType BlockId, NvM_RequestResultType* RequestResultPtr);
+
+/**************************************************************************
+ * @brief   Ghi các khối đang chờ xuống Fee (task nền)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_MainFunction(void);
+
+/**************************************************************************
+ * @brief   Ghi tất cả các khối đang chờ xuống Fee trước khi tắt hệ thống
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void NvM_WriteAll(void);
+
+#endif /* NVM_H */
@@ -0,0 +1,34 @@
+#include "NvM_Cfg.h"
+#include "Fee_Cfg.h"
+#include "Dem.h"
+#include "Torque_Control.h"
+#include "Regen_Brake_Control.h"
+#include "Traction_Control.h"
+
+/**************************************************************************
+ * @brief Giá trị mặc định của các khối tham số hiệu chỉnh, dùng khi khối
+ *        chưa từng được lưu hoặc dữ liệu đã lưu bị hỏng
+ **************************************************************************/
+static const NvM_TorqueCalibrationType NvM_TorqueCalibrationDefault = {
+    MAX_TORQUE, MIN_TORQUE
+};
+
+static const NvM_RegenBrakeCalibrationType NvM_RegenBrakeCalibrationDefault = {
+    BRAKE_INPUT_THRESHOLD, SPEED_THRESHOLD, BRAKE_COEFFICIENT, MAX_BATTERY_TEMP, INCLINATION_THRESHOLD
+};
+
+static const NvM_TractionCalibrationType NvM_TractionCalibrationDefault = {
+    SLIP_THRESHOLD, BRAKE_THRESHOLD
+};
+
+/**************************************************************************
+ * @brief Bảng cấu hình các khối NvM (đánh chỉ số theo ID của khối)
+ **************************************************************************/
+const NvM_BlockDescriptorType NvM_BlockDescriptors[] = {
+    [NVM_BLOCK_DEM_EVENT_MEMORY] = {"Dem event memory", FEE_BLOCK_DEM_EVENT_MEMORY, sizeof(Dem_NvDataType), NULL_PTR},
+    [NVM_BLOCK_TORQUE_CALIBRATION] = {"Torque calibration", FEE_BLOCK_TORQUE_CALIBRATION, sizeof(NvM_TorqueCalibrationType), &NvM_TorqueCalibrationDefault},
+    [NVM_BLOCK_REGEN_CALIBRATION] = {"Regen brake calibration", FEE_BLOCK_REGEN_CALIBRATION, sizeof(NvM_RegenBrakeCalibrationType), &NvM_RegenBrakeCalibrationDefault},
+    [NVM_BLOCK_TRACTION_CALIBRATION] = {"Traction calibration", FEE_BLOCK_TRACTION_CALIBRATION, sizeof(NvM_TractionCalibrationType), &NvM_TractionCalibrationDefault},
+    [NVM_BLOCK_REGEN_LEARNED] = {"Regen brake learned values", FEE_BLOCK_REGEN_LEARNED, sizeof(NvM_RegenBrakeLearnedType), NULL_PTR},
+};
+const uint16 NvM_BlockDescriptorCount = sizeof(NvM_BlockDescriptors) / sizeof(NvM_BlockDescriptors[0]);
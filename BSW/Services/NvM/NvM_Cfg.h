@@ -0,0 +1,60 @@
+#ifndef NVM_CFG_H
+#define NVM_CFG_H
+
+#include "NvM.h"
+
+/**************************************************************************
+ * @brief Định nghĩa ID của các khối NvM
+ **************************************************************************/
+#define NVM_BLOCK_DEM_EVENT_MEMORY      (NvM_BlockIdType)0  /* Bộ nhớ sự kiện của DEM */
+#define NVM_BLOCK_TORQUE_CALIBRATION    (NvM_BlockIdType)1  /* Tham số hiệu chỉnh điều khiển mô-men xoắn */
+#define NVM_BLOCK_REGEN_CALIBRATION     (NvM_BlockIdType)2  /* Tham số hiệu chỉnh phanh tái sinh */
+#define NVM_BLOCK_TRACTION_CALIBRATION  (NvM_BlockIdType)3  /* Tham số hiệu chỉnh điều khiển lực kéo */
+#define NVM_BLOCK_REGEN_LEARNED         (NvM_BlockIdType)4  /* Giá trị học được của phanh tái sinh */
+
+/**************************************************************************
+ * @struct  NvM_TorqueCalibrationType
+ * @brief   Dữ liệu của khối tham số hiệu chỉnh điều khiển mô-men xoắn
+ **************************************************************************/
+typedef struct {
+    float32 MaxTorque;              /* Giá trị mô-men xoắn tối đa */
+    float32 MinTorque;              /* Giá trị mô-men xoắn tối thiểu */
+} NvM_TorqueCalibrationType;
+
+/**************************************************************************
+ * @struct  NvM_RegenBrakeCalibrationType
+ * @brief   Dữ liệu của khối tham số hiệu chỉnh phanh tái sinh
+ **************************************************************************/
+typedef struct {
+    float32 BrakeInputThreshold;    /* Ngưỡng mức độ nhấn phanh để kích hoạt phanh tái sinh */
+    float32 SpeedThreshold;         /* Ngưỡng tốc độ phanh tái sinh */
+    float32 BrakeCoefficient;       /* Hệ số phanh tái sinh */
+    float32 MaxBatteryTemp;         /* Nhiệt độ tối đa khi sạc pin */
+    float32 InclinationThreshold;   /* Ngưỡng góc nghiêng khi điều chỉnh lực phanh tái sinh */
+} NvM_RegenBrakeCalibrationType;
+
+/**************************************************************************
+ * @struct  NvM_TractionCalibrationType
+ * @brief   Dữ liệu của khối tham số hiệu chỉnh điều khiển lực kéo
+ **************************************************************************/
+typedef struct {
+    float32 SlipThreshold;          /* Ngưỡng trượt */
+    float32 BrakeThreshold;         /* Ngưỡng trượt cao (bắt đầu can thiệp phanh) */
+} NvM_TractionCalibrationType;
+
+/**************************************************************************
+ * @struct  NvM_RegenBrakeLearnedType
+ * @brief   Dữ liệu của khối giá trị học được của phanh tái sinh
+ **************************************************************************/
+typedef struct {
+    float64 RegeneratedEnergyWh;    /* Tổng năng lượng đã tái sinh (Wh) */
+    uint32 ActivationCount;         /* Số lần phanh tái sinh được kích hoạt */
+} NvM_RegenBrakeLearnedType;
+
+/**************************************************************************
+ * @brief Bảng cấu hình các khối NvM
+ **************************************************************************/
+extern const NvM_BlockDescriptorType NvM_BlockDescriptors[];
+extern const uint16 NvM_BlockDescriptorCount;
+
+#endif /* NVM_CFG_H */
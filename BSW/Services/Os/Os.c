@@ -1,9 +1,26 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         // pthread_setaffinity_np, CPU_SET
+#endif
 #include "Os.h"
+#include "Os_Alarm.h"
+#include "Os_Coroutine.h"
+#include <string.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "Log.h"
+#include "Mem.h"
+
+#ifdef __linux__
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
 
 /**************************************************************************
  * @brief Định nghĩa số lượng luồng tối đa
  **************************************************************************/
-#define MAX_TASKS 9
+#define MAX_TASKS 12
 
 /**************************************************************************
  * @brief Mảng giả lập để lưu trữ luồng
@@ -15,6 +32,709 @@ pthread_t task_threads[MAX_TASKS];
  **************************************************************************/
 uint8 task_count = 0;
 
+/**************************************************************************
+ * @brief Số nano giây trong 1 giây, 1 mili giây và 1 micro giây
+ **************************************************************************/
+#define OS_NS_PER_SEC   1000000000ULL
+#define OS_NS_PER_MS    1000000ULL
+#define OS_NS_PER_US    1000ULL
+
+/**************************************************************************
+ * @brief Khoảng thời gian từ lúc gọi Os_Start đến epoch chung (ms)
+ * @details Cho phép tất cả các luồng được tạo xong trước mốc kích hoạt đầu tiên.
+ *          Phải dài hơn một nhịp của luồng timer (nhịp 0 sớm hơn epoch một nhịp).
+ **************************************************************************/
+#define OS_START_DELAY_MS 10
+#if (OS_CFG_TIMER_TICK_US >= OS_START_DELAY_MS * 1000)
+#error "OS_CFG_TIMER_TICK_US must be shorter than OS_START_DELAY_MS"
+#endif
+
+/**************************************************************************
+ * @brief Phần stack không được chạm trước (byte), dành cho các khung hàm
+ *        đang dùng, TLS và trang bảo vệ ở cuối stack
+ **************************************************************************/
+#define OS_STACK_PREFAULT_RESERVE   (16U * 1024U)
+
+/**************************************************************************
+ * @brief Kích thước mỗi khung hàm khi chạm trước stack và khoảng cách giữa
+ *        hai lần ghi (không lớn hơn trang nhỏ nhất của hệ điều hành)
+ **************************************************************************/
+#define OS_STACK_PREFAULT_CHUNK     (8U * 1024U)
+#define OS_STACK_PREFAULT_STEP      4096U
+
+/**************************************************************************
+ * @brief Số nhóm histogram: mỗi khoảng [2^k, 2^(k+1)) us được chia thành
+ *        OS_HISTOGRAM_SUB_BUCKETS nhóm bằng nhau
+ **************************************************************************/
+#define OS_HISTOGRAM_SUB_BITS       2
+#define OS_HISTOGRAM_SUB_BUCKETS    (1U << OS_HISTOGRAM_SUB_BITS)
+#define OS_HISTOGRAM_BUCKETS        (32U * OS_HISTOGRAM_SUB_BUCKETS)
+
+/**************************************************************************
+ * @struct  Os_HistogramType
+ * @brief   Histogram của một đại lượng thời gian (us)
+ **************************************************************************/
+typedef struct {
+    uint32 Counts[OS_HISTOGRAM_BUCKETS];    /* Số lần đo rơi vào từng nhóm */
+    uint32 Samples;                         /* Tổng số lần đo */
+    uint32 MinUs;                           /* Giá trị nhỏ nhất (us) */
+    uint32 MaxUs;                           /* Giá trị lớn nhất (us) */
+    uint64 TotalUs;                         /* Tổng, dùng để tính giá trị trung bình (us) */
+} Os_HistogramType;
+
+/**************************************************************************
+ * @struct  Os_TaskType
+ * @brief   Cấu trúc lưu trạng thái nội bộ của một task tuần hoàn hoặc một
+ *          task theo sự kiện
+ * @details Task theo sự kiện có Config.PeriodMs = 0. Luồng của task chờ trên
+ *          futex WakeSeq khi không có lần kích hoạt nào (hoặc khi chờ sự
+ *          kiện), phía kích hoạt chỉ gọi futex khi Sleeping = 1. Task tuần
+ *          hoàn được kích hoạt bởi mốc Release trong timer wheel của OS.
+ **************************************************************************/
+typedef struct {
+    Os_PeriodicTaskConfigType Config;   /* Cấu hình của task (tên, runnable, độ ưu tiên, chu kỳ) */
+    uint8 MaxActivations;               /* Số lần kích hoạt tối đa được xếp hàng (task theo sự kiện) */
+    boolean Extended;                   /* Task có được chờ sự kiện hay không */
+    atomic_uint Activations;            /* Số lần kích hoạt đang chờ, kể cả lần đang chạy */
+    atomic_uint Events;                 /* Các sự kiện đã được đặt */
+    atomic_uint Sleeping;               /* 1 khi luồng của task đang (chuẩn bị) chờ trên futex */
+    atomic_uint WakeSeq;                /* Futex, tăng mỗi lần đánh thức luồng của task */
+    _Atomic uint64 ActivatedNs;         /* Thời điểm kích hoạt đầu tiên đang chờ (thời gian hệ thống, ns) */
+    Os_TimerType Release;               /* Mốc kích hoạt tiếp theo của task tuần hoàn */
+    uint64 ReleaseNs;                   /* Mốc kích hoạt tiếp theo (chỉ luồng timer ghi) */
+    uint32 ActivationCount;             /* Số lần task đã được kích hoạt */
+    atomic_uint OverrunCount;           /* Số lần task chạy vượt quá chu kỳ hoặc bị từ chối kích hoạt */
+    Os_HistogramType Jitter;            /* Histogram jitter khi bắt đầu chạy */
+    Os_HistogramType ExecTime;          /* Histogram thời gian thực thi */
+    pthread_mutex_t StatsLock;          /* Bảo vệ thống kê khi đọc từ luồng khác */
+    Mem_ArenaType Scratch;              /* Vùng nhớ tạm, reset sau mỗi lần kích hoạt */
+} Os_TaskType;
+
+/**************************************************************************
+ * @brief Danh sách các task tuần hoàn và task theo sự kiện đã đăng ký
+ **************************************************************************/
+static Os_TaskType os_tasks[MAX_TASKS];
+
+/**************************************************************************
+ * @brief Số lượng task đã đăng ký
+ **************************************************************************/
+static uint8 os_task_count = 0;
+
+/**************************************************************************
+ * @brief Số lượng task đã đăng ký nhưng chưa được tạo luồng
+ **************************************************************************/
+static uint8 os_pending_count = 0;
+
+/**************************************************************************
+ * @brief Epoch chung của tất cả các task tuần hoàn (thời gian hệ thống, ns)
+ **************************************************************************/
+static uint64 periodic_epoch_ns;
+
+/**************************************************************************
+ * @brief Cờ yêu cầu kết thúc hệ điều hành (xem Os_RequestShutdown)
+ **************************************************************************/
+static atomic_bool os_shutdown_requested = FALSE;
+
+/**************************************************************************
+ * @brief Task của luồng đang chạy (NULL nếu luồng không phải là task)
+ **************************************************************************/
+static __thread Os_TaskType* os_current_task = NULL_PTR;
+
+/**************************************************************************
+ * @struct  Os_ResourceType
+ * @brief   Cấu trúc lưu trạng thái nội bộ của một resource
+ **************************************************************************/
+typedef struct {
+    Os_ResourceConfigType Config;       /* Cấu hình của resource */
+    uint8 Ceiling;                      /* Ceiling đã tính (0: không nâng độ ưu tiên) */
+    pthread_mutex_t Lock;               /* Mutex của resource */
+} Os_ResourceType;
+
+/**************************************************************************
+ * @struct  Os_HeldResourceType
+ * @brief   Một resource đang được giữ bởi luồng hiện tại và lịch trước khi lấy
+ **************************************************************************/
+typedef struct {
+    Os_ResourceIdType Id;               /* ID của resource */
+    boolean Boosted;                    /* Luồng đã được nâng lên ceiling khi lấy resource */
+    int Policy;                         /* Chính sách lập lịch trước khi lấy resource */
+    int Priority;                       /* Độ ưu tiên trước khi lấy resource */
+} Os_HeldResourceType;
+
+/**************************************************************************
+ * @brief Danh sách các resource, số resource và các resource luồng hiện tại
+ *        đang giữ (theo thứ tự lấy)
+ **************************************************************************/
+static Os_ResourceType os_resources[OS_MAX_RESOURCES];
+static uint8 os_resource_count = 0;
+static boolean os_realtime_permitted = FALSE;   /* Tiến trình được phép dùng SCHED_FIFO (tính khi gọi Os_Start) */
+static __thread Os_HeldResourceType os_held_resources[OS_MAX_RESOURCE_NESTING];
+static __thread uint8 os_held_count = 0;
+
+#ifndef __linux__
+/**************************************************************************
+ * @brief Khóa và biến điều kiện thay cho futex khi không chạy trên Linux
+ **************************************************************************/
+static pthread_mutex_t os_futex_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t os_futex_cond = PTHREAD_COND_INITIALIZER;
+#endif
+
+/**************************************************************************
+ * @struct  Os_SleeperType
+ * @brief   Một luồng đang ngủ chờ thời gian hệ thống (chế độ DISCRETE)
+ * @details Mỗi nút nằm trên stack của luồng đang gọi Os_SleepUntilNs.
+ **************************************************************************/
+typedef struct Os_SleeperType {
+    uint64 WakeupNs;                    /* Mốc đánh thức của luồng */
+    struct Os_SleeperType* Next;        /* Luồng đang ngủ tiếp theo */
+} Os_SleeperType;
+
+/**************************************************************************
+ * @brief Trạng thái của thời gian hệ thống
+ * @details Chế độ, hệ số tăng tốc và mốc CLOCK_MONOTONIC được công bố theo
+ *          cơ chế seqlock (os_time_seq là số lẻ khi đang ghi) để
+ *          Os_GetTimeNs không phải khóa. os_time_lock chỉ dùng khi đổi chế
+ *          độ và khi nhảy thời gian ở chế độ DISCRETE.
+ **************************************************************************/
+static atomic_uint os_time_seq = 0;                             /* Phiên bản của chế độ thời gian */
+static atomic_uint os_time_mode = OS_TIME_MODE_REALTIME;        /* Chế độ thời gian */
+static atomic_uint os_time_scale = 1;                           /* Hệ số tăng tốc */
+static _Atomic uint64 os_time_base_ns = 0;                      /* Mốc CLOCK_MONOTONIC ứng với thời gian hệ thống 0 */
+static _Atomic uint64 os_virtual_now_ns = 0;                    /* Thời gian hệ thống (chế độ DISCRETE) */
+static uint32 os_busy_count = 0;                                /* Số luồng đang chạy (chế độ DISCRETE) */
+static Os_SleeperType* os_sleepers = NULL_PTR;                  /* Danh sách luồng đang ngủ (chế độ DISCRETE) */
+static pthread_mutex_t os_time_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t os_time_cond = PTHREAD_COND_INITIALIZER;
+
+/**************************************************************************
+ * @brief   Đọc CLOCK_MONOTONIC (ns)
+ * @param   None
+ * @return 	uint64  Thời gian CLOCK_MONOTONIC (nano giây)
+ **************************************************************************/
+static uint64 Os_MonotonicNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * OS_NS_PER_SEC + (uint64)ts.tv_nsec;
+}
+
+/**************************************************************************
+ * @brief   Công bố chế độ thời gian mới cho các luồng đọc không khóa
+ * @details Phải gọi khi đang giữ os_time_lock.
+ * @param   Mode        Chế độ thời gian
+ * @param   Scale       Hệ số tăng tốc
+ * @param   BaseNs      Mốc CLOCK_MONOTONIC ứng với thời gian hệ thống 0
+ * @return 	None
+ **************************************************************************/
+static void Os_TimePublishLocked(Os_TimeModeType Mode, uint32 Scale, uint64 BaseNs) {
+    uint32 seq = atomic_load_explicit(&os_time_seq, memory_order_relaxed);
+    atomic_store_explicit(&os_time_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&os_time_mode, Mode, memory_order_relaxed);
+    atomic_store_explicit(&os_time_scale, Scale, memory_order_relaxed);
+    atomic_store_explicit(&os_time_base_ns, BaseNs, memory_order_relaxed);
+
+    atomic_store_explicit(&os_time_seq, seq + 2, memory_order_release);
+}
+
+/**************************************************************************
+ * @brief   Đọc chế độ thời gian hiện tại
+ * @return 	Os_TimeModeType     Chế độ thời gian
+ **************************************************************************/
+static inline Os_TimeModeType Os_TimeMode(void) {
+    return (Os_TimeModeType)atomic_load_explicit(&os_time_mode, memory_order_acquire);
+}
+
+/**************************************************************************
+ * @brief   Nhảy thời gian hệ thống đến mốc đánh thức gần nhất
+ * @details Chỉ nhảy khi không còn luồng nào đang chạy, phải gọi khi đang
+ *          giữ os_time_lock.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Os_TimeAdvanceLocked(void) {
+    if (os_busy_count != 0 || os_sleepers == NULL_PTR) {
+        return;
+    }
+
+    uint64 next_ns = os_sleepers->WakeupNs;
+    for (Os_SleeperType* sleeper = os_sleepers->Next; sleeper != NULL_PTR; sleeper = sleeper->Next) {
+        if (sleeper->WakeupNs < next_ns) {
+            next_ns = sleeper->WakeupNs;
+        }
+    }
+
+    if (next_ns > atomic_load_explicit(&os_virtual_now_ns, memory_order_relaxed)) {
+        atomic_store_explicit(&os_virtual_now_ns, next_ns, memory_order_release);
+    }
+    pthread_cond_broadcast(&os_time_cond);
+}
+
+/**************************************************************************
+ * @brief   Tìm nhóm histogram của một giá trị
+ * @param   value_us    Giá trị cần tìm nhóm (us)
+ * @return 	uint32      Chỉ số nhóm trong histogram
+ **************************************************************************/
+static uint32 Os_HistogramBucket(uint32 value_us) {
+    if (value_us < OS_HISTOGRAM_SUB_BUCKETS) {
+        return value_us;
+    }
+
+    uint32 msb = 31U - (uint32)__builtin_clz(value_us);
+    uint32 sub = (value_us >> (msb - OS_HISTOGRAM_SUB_BITS)) & (OS_HISTOGRAM_SUB_BUCKETS - 1U);
+    return (msb - OS_HISTOGRAM_SUB_BITS + 1U) * OS_HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+/**************************************************************************
+ * @brief   Tìm giá trị lớn nhất thuộc một nhóm histogram
+ * @param   bucket      Chỉ số nhóm trong histogram
+ * @return 	uint32      Giá trị lớn nhất của nhóm (us)
+ **************************************************************************/
+static uint32 Os_HistogramBucketUpperUs(uint32 bucket) {
+    if (bucket < OS_HISTOGRAM_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    uint32 msb = bucket / OS_HISTOGRAM_SUB_BUCKETS + OS_HISTOGRAM_SUB_BITS - 1U;
+    uint32 sub = bucket % OS_HISTOGRAM_SUB_BUCKETS;
+    uint64 lower = ((uint64)(OS_HISTOGRAM_SUB_BUCKETS + sub)) << (msb - OS_HISTOGRAM_SUB_BITS);
+    uint64 upper = lower + (1ULL << (msb - OS_HISTOGRAM_SUB_BITS)) - 1ULL;
+    return (upper > UINT32_MAX) ? UINT32_MAX : (uint32)upper;
+}
+
+/**************************************************************************
+ * @brief   Xóa histogram
+ * @param   histogram   Con trỏ đến histogram cần xóa
+ * @return 	None
+ **************************************************************************/
+static void Os_HistogramReset(Os_HistogramType* histogram) {
+    memset(histogram, 0, sizeof(*histogram));
+    histogram->MinUs = UINT32_MAX;
+}
+
+/**************************************************************************
+ * @brief   Thêm một lần đo vào histogram
+ * @param   histogram   Con trỏ đến histogram
+ * @param   value_us    Giá trị đo được (us)
+ * @return 	None
+ **************************************************************************/
+static void Os_HistogramAdd(Os_HistogramType* histogram, uint64 value_us) {
+    uint32 value = (value_us > UINT32_MAX) ? UINT32_MAX : (uint32)value_us;
+
+    histogram->Counts[Os_HistogramBucket(value)]++;
+    histogram->Samples++;
+    histogram->TotalUs += value;
+    if (value < histogram->MinUs) {
+        histogram->MinUs = value;
+    }
+    if (value > histogram->MaxUs) {
+        histogram->MaxUs = value;
+    }
+}
+
+/**************************************************************************
+ * @brief   Tính thống kê min/max/mean/p99 từ histogram
+ * @param   histogram   Con trỏ đến histogram
+ * @param   stats       Con trỏ lưu thống kê
+ * @return 	None
+ **************************************************************************/
+static void Os_HistogramSummarize(const Os_HistogramType* histogram, Os_TimingStatsType* stats) {
+    if (histogram->Samples == 0) {
+        stats->MinUs = 0;
+        stats->MaxUs = 0;
+        stats->MeanUs = 0;
+        stats->P99Us = 0;
+        return;
+    }
+
+    stats->MinUs = histogram->MinUs;
+    stats->MaxUs = histogram->MaxUs;
+    stats->MeanUs = (uint32)(histogram->TotalUs / histogram->Samples);
+
+    // Tìm nhóm chứa lần đo thứ ceil(99% * Samples)
+    uint64 target = ((uint64)histogram->Samples * 99ULL + 99ULL) / 100ULL;
+    uint64 seen = 0;
+    stats->P99Us = histogram->MaxUs;
+    for (uint32 i = 0; i < OS_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->Counts[i];
+        if (seen >= target) {
+            uint32 upper = Os_HistogramBucketUpperUs(i);
+            stats->P99Us = (upper < histogram->MaxUs) ? upper : histogram->MaxUs;
+            break;
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra thuộc tính luồng của một task
+ * @param   attr            Thuộc tính cần kiểm tra (NULL: mặc định)
+ * @return 	Std_ReturnType  Trả về E_OK nếu thuộc tính hợp lệ,
+ *                                 E_NOT_OK nếu ngược lại
+ **************************************************************************/
+static Std_ReturnType Os_CheckAttributes(const Os_TaskAttrType* attr) {
+    if (attr == NULL_PTR) {
+        return E_OK;
+    }
+    if (attr->Policy > OS_SCHED_RR ||
+        (attr->Policy != OS_SCHED_DEFAULT && (attr->RtPriority < 1 || attr->RtPriority > 99))) {
+        return E_NOT_OK;
+    }
+    if (attr->StackSize != 0 && attr->StackSize < (uint32)PTHREAD_STACK_MIN) {
+        return E_NOT_OK;
+    }
+    // Chỉ chạm trước được stack có kích thước đã biết
+    if (attr->PrefaultStack && attr->StackSize <= OS_STACK_PREFAULT_RESERVE) {
+        return E_NOT_OK;
+    }
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Chạm trước một vùng trên stack của luồng đang chạy
+ * @details Mỗi trang được ghi một lần để hệ điều hành cấp trang thật ngay
+ *          từ đầu (và khóa lại nếu đã gọi mlockall), task không bị page fault
+ *          khi stack lớn dần lúc chạy. Hàm gọi đệ quy với một khung
+ *          OS_STACK_PREFAULT_CHUNK byte mỗi lần, khung được ghi sau lời gọi đệ
+ *          quy để trình biên dịch không tái sử dụng khung (tail call). Chỉ có
+ *          tác dụng trên Linux, ở hệ điều hành khác hàm không làm gì.
+ * @param   size    Số byte cần chạm trước
+ * @return 	None
+ **************************************************************************/
+#ifdef __linux__
+static void __attribute__((noinline)) Os_PrefaultStack(uint32 size) {
+    uint8 chunk[OS_STACK_PREFAULT_CHUNK];
+    volatile uint8* touch = chunk;
+
+    if (size > OS_STACK_PREFAULT_CHUNK) {
+        Os_PrefaultStack(size - OS_STACK_PREFAULT_CHUNK);
+    }
+    for (uint32 i = 0; i < OS_STACK_PREFAULT_CHUNK; i += OS_STACK_PREFAULT_STEP) {
+        touch[i] = 0;
+    }
+}
+#else
+static void Os_PrefaultStack(uint32 size) {
+    (void)size;
+}
+#endif
+
+/**************************************************************************
+ * @brief   Tính độ ưu tiên thời gian thực của một task
+ * @details Task chọn OS_SCHED_FIFO/OS_SCHED_RR dùng RtPriority của nó. Các
+ *          task khác dùng OS_CFG_TASK_RT_PRIORITY_BASE + Priority (thấp hơn
+ *          luồng timer) nếu tiến trình được phép dùng SCHED_FIFO.
+ * @param   task        Task cần tính
+ * @return 	uint8       Độ ưu tiên thời gian thực (0: SCHED_OTHER)
+ **************************************************************************/
+static uint8 Os_TaskRtPriority(const Os_TaskType* task) {
+    const Os_TaskAttrType* attr = task->Config.Attributes;
+
+    if (attr != NULL_PTR && attr->Policy != OS_SCHED_DEFAULT) {
+        return attr->RtPriority;
+    }
+    if (!os_realtime_permitted || OS_CFG_TASK_RT_PRIORITY_BASE == 0) {
+        return 0;
+    }
+
+    uint32 priority = (uint32)OS_CFG_TASK_RT_PRIORITY_BASE + task->Config.Priority;
+    return (priority < OS_CFG_TIMER_RT_PRIORITY) ? (uint8)priority : (uint8)(OS_CFG_TIMER_RT_PRIORITY - 1);
+}
+
+/**************************************************************************
+ * @brief   Áp dụng thuộc tính luồng cho luồng của task đang chạy
+ * @details Được gọi ở đầu luồng của task. Độ ưu tiên của task được áp dụng
+ *          bằng SCHED_FIFO (xem Os_TaskRtPriority). Lỗi chỉ được ghi cảnh
+ *          báo, task vẫn chạy với thuộc tính mặc định.
+ * @param   task        Task của luồng đang chạy
+ * @return 	None
+ **************************************************************************/
+static void Os_TaskApplyAttributes(const Os_TaskType* task) {
+    const Os_TaskAttrType* attr = task->Config.Attributes;
+    uint8 rt_priority = Os_TaskRtPriority(task);
+    int err;
+
+    if (rt_priority != 0) {
+        boolean rr = (attr != NULL_PTR && attr->Policy == OS_SCHED_RR) ? TRUE : FALSE;
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = rt_priority;
+        err = pthread_setschedparam(pthread_self(), rr ? SCHED_RR : SCHED_FIFO, &param);
+        if (err != 0) {
+            LOG_WARN(OS, "Task %s: cannot set %s priority %u (error %d)\n", task->Config.Name,
+                         rr ? "SCHED_RR" : "SCHED_FIFO", rt_priority, err);
+        }
+    }
+
+    if (attr == NULL_PTR) {
+        return;
+    }
+
+#ifdef __linux__
+    if (attr->CoreMask != 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (uint32 core = 0; core < 64 && core < CPU_SETSIZE; core++) {
+            if ((attr->CoreMask & (1ULL << core)) != 0) {
+                CPU_SET(core, &cpus);
+            }
+        }
+        err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (err != 0) {
+            LOG_WARN(OS, "Task %s: cannot pin to core mask 0x%llx (error %d)\n",
+                         task->Config.Name, (unsigned long long)attr->CoreMask, err);
+        }
+    }
+#endif
+
+    if (attr->PrefaultStack) {
+        Os_PrefaultStack(attr->StackSize - OS_STACK_PREFAULT_RESERVE);
+    }
+}
+
+/**************************************************************************
+ * @brief   Chờ cho đến khi giá trị của futex khác giá trị đã đọc
+ * @details Có thể trả về sớm (tín hiệu, đánh thức giả), phía gọi phải kiểm
+ *          tra lại điều kiện.
+ * @param   word        Futex cần chờ
+ * @param   expected    Giá trị futex đã đọc trước đó
+ * @return 	None
+ **************************************************************************/
+static void Os_FutexWait(atomic_uint* word, uint32 expected) {
+#ifdef __linux__
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, NULL_PTR, NULL_PTR, 0);
+#else
+    pthread_mutex_lock(&os_futex_lock);
+    while (atomic_load(word) == expected) {
+        pthread_cond_wait(&os_futex_cond, &os_futex_lock);
+    }
+    pthread_mutex_unlock(&os_futex_lock);
+#endif
+}
+
+/**************************************************************************
+ * @brief   Tăng giá trị của futex và đánh thức luồng đang chờ trên nó
+ * @param   word        Futex cần đánh thức
+ * @return 	None
+ **************************************************************************/
+static void Os_FutexWake(atomic_uint* word) {
+#ifdef __linux__
+    atomic_fetch_add(word, 1);
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL_PTR, NULL_PTR, 0);
+#else
+    pthread_mutex_lock(&os_futex_lock);
+    atomic_fetch_add(word, 1);
+    pthread_cond_broadcast(&os_futex_cond);
+    pthread_mutex_unlock(&os_futex_lock);
+#endif
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra điều kiện để luồng của task tiếp tục chạy
+ * @param   task        Task cần kiểm tra
+ * @param   WaitMask    Các sự kiện đang chờ (0: chờ lần kích hoạt tiếp theo)
+ * @return 	boolean     TRUE nếu task có lần kích hoạt hoặc sự kiện đang
+ *                              chờ, hoặc hệ điều hành đang kết thúc
+ **************************************************************************/
+static boolean Os_TaskReady(Os_TaskType* task, Os_EventMaskType WaitMask) {
+    if (atomic_load(&os_shutdown_requested)) {
+        return TRUE;
+    }
+    if (WaitMask == 0) {
+        return (atomic_load(&task->Activations) > 0) ? TRUE : FALSE;
+    }
+    return ((atomic_load(&task->Events) & WaitMask) != 0) ? TRUE : FALSE;
+}
+
+/**************************************************************************
+ * @brief   Chờ đến khi task có lần kích hoạt hoặc sự kiện đang chờ
+ * @details Luồng đặt Sleeping rồi kiểm tra lại điều kiện trước khi chờ trên
+ *          futex nên không bỏ lỡ lần đánh thức nào. Bên nào đưa Sleeping về 0
+ *          thì bên đó gọi Os_TimeBeginBusy cho luồng, để ở chế độ DISCRETE
+ *          thời gian hệ thống có thể nhảy khi luồng đang chờ.
+ * @param   task        Task của luồng đang gọi
+ * @param   WaitMask    Các sự kiện cần chờ (0: chờ lần kích hoạt tiếp theo)
+ * @return 	None
+ **************************************************************************/
+static void Os_TaskBlock(Os_TaskType* task, Os_EventMaskType WaitMask) {
+    while (!Os_TaskReady(task, WaitMask)) {
+        uint32 seq = atomic_load(&task->WakeSeq);
+        atomic_store(&task->Sleeping, 1);
+        Os_TimeEndBusy();
+
+        if (!Os_TaskReady(task, WaitMask)) {
+            Os_FutexWait(&task->WakeSeq, seq);
+        }
+
+        // Phía đánh thức chưa lấy lại Sleeping: luồng tự báo đang chạy
+        if (atomic_exchange(&task->Sleeping, 0) == 1) {
+            Os_TimeBeginBusy();
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Đánh thức luồng của task nếu luồng đang chờ
+ * @details Không gọi futex khi luồng của task đang chạy.
+ * @param   task        Task cần đánh thức
+ * @return 	None
+ **************************************************************************/
+static void Os_TaskWake(Os_TaskType* task) {
+    if (atomic_exchange(&task->Sleeping, 0) == 1) {
+        Os_TimeBeginBusy();
+        Os_FutexWake(&task->WakeSeq);
+    }
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo trạng thái chung của một task khi đăng ký
+ * @param   task        Task cần khởi tạo
+ * @return 	None
+ **************************************************************************/
+static void Os_TaskInit(Os_TaskType* task) {
+    atomic_store(&task->Activations, 0);
+    atomic_store(&task->Events, 0);
+    atomic_store(&task->Sleeping, 0);
+    atomic_store(&task->WakeSeq, 0);
+    atomic_store(&task->ActivatedNs, 0);
+    task->ActivationCount = 0;
+    atomic_store(&task->OverrunCount, 0);
+    Os_HistogramReset(&task->Jitter);
+    Os_HistogramReset(&task->ExecTime);
+    pthread_mutex_init(&task->StatsLock, NULL_PTR);
+    if (Mem_Arena_Create(&task->Scratch, OS_CFG_TASK_SCRATCH_SIZE) != E_OK) {
+        LOG_WARN(OS, "Task %s has no scratch arena, Mem_ScratchAlloc will fail\n", task->Config.Name);
+    }
+}
+
+/**************************************************************************
+ * @brief   Kích hoạt một task tuần hoàn khi mốc Release hết hạn
+ * @details Hàm này được gọi trong luồng timer. Mốc tiếp theo được tính từ
+ *          mốc trước (không phải từ thời điểm hết hạn) nên chu kỳ không bị
+ *          trôi, và được đặt lại trước khi đánh thức task. Nếu lần kích hoạt
+ *          trước chưa chạy xong thì tính là overrun và bỏ qua mốc này để giữ
+ *          nguyên pha.
+ * @param   Arg     Con trỏ đến Os_TaskType của task
+ * @return 	None
+ **************************************************************************/
+static void Os_PeriodicRelease(void* Arg) {
+    Os_TaskType* task = (Os_TaskType*)Arg;
+    uint64 release_ns = task->ReleaseNs;
+
+    if (atomic_load(&os_shutdown_requested)) {
+        return;     // Không đặt lại mốc khi hệ điều hành đang kết thúc
+    }
+
+    task->ReleaseNs += (uint64)task->Config.PeriodMs * OS_NS_PER_MS;
+    (void)Os_Timer_StartAbs(&task->Release, task->ReleaseNs);
+
+    if (atomic_load(&task->Activations) != 0) {
+        atomic_fetch_add_explicit(&task->OverrunCount, 1, memory_order_relaxed);
+        return;
+    }
+
+    atomic_store(&task->ActivatedNs, release_ns);
+    atomic_fetch_add(&task->Activations, 1);
+    Os_TaskWake(task);
+}
+
+/**************************************************************************
+ * @brief   Luồng thực thi của một task tuần hoàn
+ * @details Luồng chờ trên futex đến khi mốc Release của task hết hạn (xem
+ *          Os_PeriodicRelease) nên mọi task tuần hoàn dùng chung một lần
+ *          đánh thức của luồng timer thay vì mỗi task một clock_nanosleep.
+ *          Jitter là độ trễ từ mốc kích hoạt đến lúc runnable bắt đầu. Arena
+ *          vùng nhớ tạm của task được gắn với luồng và được reset sau mỗi
+ *          lần kích hoạt. Luồng kết thúc khi có yêu cầu kết thúc hệ điều hành.
+ * @param   arg     Con trỏ đến Os_TaskType của task
+ * @return 	None
+ **************************************************************************/
+static void* Os_PeriodicTaskMain(void* arg) {
+    Os_TaskType* task = (Os_TaskType*)arg;
+
+    Os_TaskApplyAttributes(task);
+    os_current_task = task;
+    Mem_Arena_Bind(&task->Scratch);
+
+    while (1) {
+        // Chờ đến mốc kích hoạt
+        Os_TaskBlock(task, 0);
+        if (atomic_load(&os_shutdown_requested)) {
+            break;
+        }
+
+        // Mốc kích hoạt, thời điểm bắt đầu và kết thúc của task
+        uint64 release_ns = atomic_load(&task->ActivatedNs);
+        uint64 start_ns = Os_GetTimeNs();
+        task->Config.Runnable();
+        uint64 end_ns = Os_GetTimeNs();
+        Mem_Arena_Reset(&task->Scratch);
+        atomic_fetch_sub(&task->Activations, 1);
+
+        uint64 jitter_us = (start_ns > release_ns) ? (start_ns - release_ns) / OS_NS_PER_US : 0;
+        uint64 exec_us = (end_ns - start_ns) / OS_NS_PER_US;
+
+        // Cập nhật thống kê jitter và thời gian thực thi
+        pthread_mutex_lock(&task->StatsLock);
+        task->ActivationCount++;
+        Os_HistogramAdd(&task->Jitter, jitter_us);
+        Os_HistogramAdd(&task->ExecTime, exec_us);
+        pthread_mutex_unlock(&task->StatsLock);
+    }
+
+    // Luồng không còn chạy, ở chế độ DISCRETE thời gian hệ thống được nhảy tiếp
+    Os_TimeEndBusy();
+    return NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Luồng thực thi của một task theo sự kiện
+ * @details Luồng chờ trên futex đến khi task được kích hoạt, chạy runnable
+ *          một lần cho mỗi lần kích hoạt đã xếp hàng. Các sự kiện của task
+ *          được xóa khi bắt đầu một lần kích hoạt. Jitter là độ trễ từ lúc
+ *          kích hoạt (hoặc từ lúc lần chạy trước kết thúc, nếu lần kích hoạt
+ *          đã phải xếp hàng) đến lúc runnable bắt đầu. Luồng kết thúc khi
+ *          có yêu cầu kết thúc hệ điều hành, các lần kích hoạt còn xếp hàng
+ *          bị bỏ qua.
+ * @param   arg     Con trỏ đến Os_TaskType của task
+ * @return 	None
+ **************************************************************************/
+static void* Os_EventTaskMain(void* arg) {
+    Os_TaskType* task = (Os_TaskType*)arg;
+
+    Os_TaskApplyAttributes(task);
+    os_current_task = task;
+    Mem_Arena_Bind(&task->Scratch);
+
+    while (1) {
+        Os_TaskBlock(task, 0);
+        if (atomic_load(&os_shutdown_requested)) {
+            break;
+        }
+
+        uint64 activated_ns = atomic_load(&task->ActivatedNs);
+        atomic_store(&task->Events, 0);
+
+        uint64 start_ns = Os_GetTimeNs();
+        task->Config.Runnable();
+        uint64 end_ns = Os_GetTimeNs();
+        Mem_Arena_Reset(&task->Scratch);
+
+        // Lần kích hoạt đã xếp hàng tiếp theo được tính từ lúc lần này kết thúc
+        atomic_store(&task->ActivatedNs, end_ns);
+        atomic_fetch_sub(&task->Activations, 1);
+
+        uint64 jitter_us = (start_ns > activated_ns) ? (start_ns - activated_ns) / OS_NS_PER_US : 0;
+        pthread_mutex_lock(&task->StatsLock);
+        task->ActivationCount++;
+        Os_HistogramAdd(&task->Jitter, jitter_us);
+        Os_HistogramAdd(&task->ExecTime, (end_ns - start_ns) / OS_NS_PER_US);
+        pthread_mutex_unlock(&task->StatsLock);
+    }
+
+    Os_TimeEndBusy();
+    return NULL_PTR;
+}
+
 /**************************************************************************
  * @brief   Khởi tạo hệ điều hành (OS)
  * @details Hàm này được gọi để khởi tạo hệ điều hành.
@@ -22,8 +742,23 @@ uint8 task_count = 0;
  * @return 	None  
  **************************************************************************/
 void Os_Init() {
-    printf("OS Initialized.\n");
     task_count = 0;
+    os_task_count = 0;
+    os_pending_count = 0;
+    os_resource_count = 0;
+    atomic_store(&os_shutdown_requested, FALSE);
+
+    // Thời gian hệ thống bắt đầu từ 0 tại thời điểm khởi tạo OS
+    pthread_mutex_lock(&os_time_lock);
+    Os_TimePublishLocked(Os_TimeMode(), atomic_load_explicit(&os_time_scale, memory_order_relaxed), Os_MonotonicNs());
+    atomic_store_explicit(&os_virtual_now_ns, 0, memory_order_release);
+    os_busy_count = 0;
+    os_sleepers = NULL_PTR;
+    pthread_mutex_unlock(&os_time_lock);
+
+    Os_Alarm_Init();
+    Os_Co_Init();
+    LOG_INFO(OS, "OS Initialized.\n");
 }
 
 /**************************************************************************
@@ -34,36 +769,744 @@ void Os_Init() {
  * @return 	None  
  **************************************************************************/
 void Os_CreateTask(void* (*task_func)(void*), const char* task_name) {
-    if (task_count >= MAX_TASKS) {
-        printf("Cannot create more tasks. Maximum task count reached.\n");
+    if (task_count + os_pending_count >= MAX_TASKS) {
+        LOG_ERROR(OS, "Cannot create more tasks. Maximum task count reached.\n");
         return;
     }
     
-    printf("Creating task: %s\n", task_name);
+    LOG_INFO(OS, "Creating task: %s\n", task_name);
     pthread_create(&task_threads[task_count], NULL_PTR, task_func, NULL_PTR);
     task_count++;
 }
 
+/**************************************************************************
+ * @brief   Đăng ký một task tuần hoàn
+ * @details Hàm này lưu cấu hình của task tuần hoàn. Luồng của task chỉ được
+ *          tạo khi gọi Os_Start để tất cả các task dùng chung một epoch.
+ * @param   ConfigPtr       Con trỏ đến cấu hình của task tuần hoàn
+ * @param   TaskIdPtr       Con trỏ lưu ID của task được cấp (có thể NULL)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ hoặc hết chỗ
+ **************************************************************************/
+Std_ReturnType Os_CreatePeriodicTask(const Os_PeriodicTaskConfigType* ConfigPtr, Os_TaskIdType* TaskIdPtr) {
+    if (ConfigPtr == NULL_PTR || ConfigPtr->Runnable == NULL_PTR || ConfigPtr->PeriodMs == 0 ||
+        Os_CheckAttributes(ConfigPtr->Attributes) != E_OK) {
+        LOG_ERROR(OS, "Error: Invalid configuration passed to Os_CreatePeriodicTask.\n");
+        return E_NOT_OK;
+    }
+
+    if (task_count + os_pending_count >= MAX_TASKS) {
+        LOG_ERROR(OS, "Cannot create more tasks. Maximum task count reached.\n");
+        return E_NOT_OK;
+    }
+
+    Os_TaskType* task = &os_tasks[os_task_count];
+    task->Config = *ConfigPtr;
+    task->MaxActivations = 0;
+    task->Extended = FALSE;
+    Os_TaskInit(task);
+
+    LOG_INFO(OS, "Registering periodic task: %s (period %u ms, offset %u ms, priority %u)\n",
+                 ConfigPtr->Name, ConfigPtr->PeriodMs, ConfigPtr->OffsetMs, ConfigPtr->Priority);
+
+    if (TaskIdPtr != NULL_PTR) {
+        *TaskIdPtr = os_task_count;
+    }
+    os_task_count++;
+    os_pending_count++;
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đăng ký một task theo sự kiện
+ * @details Luồng của task được tạo khi gọi Os_Start, task chỉ chạy khi được
+ *          kích hoạt bằng Os_ActivateTask.
+ * @param   ConfigPtr       Con trỏ đến cấu hình của task theo sự kiện
+ * @param   TaskIdPtr       Con trỏ lưu ID của task được cấp (có thể NULL)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ hoặc hết chỗ
+ **************************************************************************/
+Std_ReturnType Os_CreateEventTask(const Os_EventTaskConfigType* ConfigPtr, Os_TaskIdType* TaskIdPtr) {
+    if (ConfigPtr == NULL_PTR || ConfigPtr->Runnable == NULL_PTR || ConfigPtr->MaxActivations == 0 ||
+        Os_CheckAttributes(ConfigPtr->Attributes) != E_OK) {
+        LOG_ERROR(OS, "Error: Invalid configuration passed to Os_CreateEventTask.\n");
+        return E_NOT_OK;
+    }
+
+    if (task_count + os_pending_count >= MAX_TASKS) {
+        LOG_ERROR(OS, "Cannot create more tasks. Maximum task count reached.\n");
+        return E_NOT_OK;
+    }
+
+    Os_TaskType* task = &os_tasks[os_task_count];
+    task->Config.Name = ConfigPtr->Name;
+    task->Config.Runnable = ConfigPtr->Runnable;
+    task->Config.PeriodMs = 0;
+    task->Config.OffsetMs = 0;
+    task->Config.Priority = ConfigPtr->Priority;
+    task->Config.Attributes = ConfigPtr->Attributes;
+    task->MaxActivations = ConfigPtr->MaxActivations;
+    task->Extended = ConfigPtr->Extended;
+    Os_TaskInit(task);
+
+    LOG_INFO(OS, "Registering %s task: %s (max activations %u, priority %u)\n",
+                 ConfigPtr->Extended ? "extended" : "basic", ConfigPtr->Name,
+                 ConfigPtr->MaxActivations, ConfigPtr->Priority);
+
+    if (TaskIdPtr != NULL_PTR) {
+        *TaskIdPtr = os_task_count;
+    }
+    os_task_count++;
+    os_pending_count++;
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Kích hoạt một task theo sự kiện
+ * @details Lần kích hoạt được xếp hàng nếu task đang chạy. Hàm không khóa:
+ *          hàng đợi kích hoạt và bộ đếm overrun là biến atomic, thời gian
+ *          hệ thống được đọc không khóa, và futex chỉ được gọi khi luồng
+ *          của task đang chờ, nên có thể gọi từ hàm thông báo của driver
+ *          (nhận CAN, chuyển đổi ADC xong). Riêng ở chế độ DISCRETE, việc
+ *          đánh thức luồng còn lấy khóa thời gian để tính luồng đang chạy.
+ * @param   TaskId          ID của task theo sự kiện
+ * @return 	Std_ReturnType  Trả về E_OK nếu task được kích hoạt,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc số lần
+ *                                 kích hoạt đang chờ đã đạt MaxActivations
+ **************************************************************************/
+Std_ReturnType Os_ActivateTask(Os_TaskIdType TaskId) {
+    if (TaskId >= os_task_count || os_tasks[TaskId].Config.PeriodMs != 0) {
+        return E_NOT_OK;
+    }
+
+    Os_TaskType* task = &os_tasks[TaskId];
+    uint32 count = atomic_load(&task->Activations);
+    do {
+        if (count >= task->MaxActivations) {
+            atomic_fetch_add_explicit(&task->OverrunCount, 1, memory_order_relaxed);
+            return E_NOT_OK;
+        }
+        // Mốc tính độ trễ được ghi trước khi luồng của task thấy lần kích hoạt
+        if (count == 0) {
+            atomic_store(&task->ActivatedNs, Os_GetTimeNs());
+        }
+    } while (!atomic_compare_exchange_weak(&task->Activations, &count, count + 1));
+
+    Os_TaskWake(task);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đặt sự kiện cho một extended task
+ * @details Luồng của task chỉ được đánh thức nếu đang chờ.
+ * @param   TaskId          ID của extended task
+ * @param   Mask            Các sự kiện cần đặt
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc task
+ *                                 không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_SetEvent(Os_TaskIdType TaskId, Os_EventMaskType Mask) {
+    if (TaskId >= os_task_count || !os_tasks[TaskId].Extended) {
+        return E_NOT_OK;
+    }
+
+    Os_TaskType* task = &os_tasks[TaskId];
+    atomic_fetch_or(&task->Events, Mask);
+    Os_TaskWake(task);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Chờ đến khi có ít nhất một sự kiện trong Mask được đặt
+ * @details Chỉ được gọi từ runnable của extended task. Các sự kiện không bị
+ *          xóa, runnable gọi Os_ClearEvent sau khi xử lý.
+ * @param   Mask            Các sự kiện cần chờ
+ * @return 	Std_ReturnType  Trả về E_OK khi có sự kiện,
+ *                                 E_NOT_OK nếu luồng gọi không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_WaitEvent(Os_EventMaskType Mask) {
+    Os_TaskType* task = os_current_task;
+    if (task == NULL_PTR || !task->Extended || Mask == 0) {
+        LOG_ERROR(OS, "Error: Os_WaitEvent called outside an extended task.\n");
+        return E_NOT_OK;
+    }
+
+    Os_TaskBlock(task, Mask);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Xóa các sự kiện của extended task đang chạy
+ * @param   Mask            Các sự kiện cần xóa
+ * @return 	Std_ReturnType  Trả về E_OK nếu xóa thành công,
+ *                                 E_NOT_OK nếu luồng gọi không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_ClearEvent(Os_EventMaskType Mask) {
+    Os_TaskType* task = os_current_task;
+    if (task == NULL_PTR || !task->Extended) {
+        return E_NOT_OK;
+    }
+
+    atomic_fetch_and(&task->Events, ~Mask);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc các sự kiện đang được đặt của một extended task
+ * @param   TaskId          ID của extended task
+ * @param   MaskPtr         Con trỏ lưu các sự kiện
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc task
+ *                                 không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_GetEvent(Os_TaskIdType TaskId, Os_EventMaskType* MaskPtr) {
+    if (TaskId >= os_task_count || !os_tasks[TaskId].Extended || MaskPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    *MaskPtr = atomic_load(&os_tasks[TaskId].Events);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra tiến trình có được phép dùng SCHED_FIFO hay không
+ * @details Luồng gọi được chuyển thử sang SCHED_FIFO rồi trả lại lịch cũ.
+ * @param   None
+ * @return 	boolean     TRUE nếu được phép
+ **************************************************************************/
+static boolean Os_ProbeRealTime(void) {
+    int policy;
+    struct sched_param param;
+    struct sched_param probe = {0};
+    probe.sched_priority = sched_get_priority_min(SCHED_FIFO);
+
+    pthread_getschedparam(pthread_self(), &policy, &param);
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &probe) != 0) {
+        return FALSE;
+    }
+    pthread_setschedparam(pthread_self(), policy, &param);
+    return TRUE;
+}
+
+/**************************************************************************
+ * @brief   Tính ceiling và khởi tạo lại mutex của các resource
+ * @details Gọi trong Os_Start, trước khi tạo luồng của các task và khi không
+ *          resource nào đang bị giữ. Ceiling tự động là độ ưu tiên thời
+ *          gian thực cao nhất của các task (xem Os_TaskRtPriority). Nếu được hỗ trợ, mutex dùng
+ *          PTHREAD_PRIO_PROTECT để hệ điều hành cũng áp dụng ceiling và từ
+ *          chối luồng có độ ưu tiên cao hơn ceiling.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Os_ResourceFinalize(void) {
+    if (os_resource_count == 0) {
+        return;
+    }
+
+    uint8 max_priority = 0;
+    for (uint8 i = 0; i < os_task_count; i++) {
+        uint8 priority = Os_TaskRtPriority(&os_tasks[i]);
+        if (priority > max_priority) {
+            max_priority = priority;
+        }
+    }
+
+    for (uint8 i = 0; i < os_resource_count; i++) {
+        Os_ResourceType* res = &os_resources[i];
+        res->Ceiling = (res->Config.CeilingPriority == OS_RESOURCE_CEILING_AUTO) ? max_priority : res->Config.CeilingPriority;
+        if (!os_realtime_permitted) {
+            res->Ceiling = 0;
+        }
+
+#if defined(_POSIX_THREAD_PRIO_PROTECT) && (_POSIX_THREAD_PRIO_PROTECT > 0)
+        if (res->Ceiling != 0) {
+            pthread_mutexattr_t attr;
+            pthread_mutexattr_init(&attr);
+            if (pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_PROTECT) == 0 &&
+                pthread_mutexattr_setprioceiling(&attr, res->Ceiling) == 0) {
+                pthread_mutex_destroy(&res->Lock);
+                pthread_mutex_init(&res->Lock, &attr);
+            }
+            pthread_mutexattr_destroy(&attr);
+        }
+#endif
+        LOG_INFO(OS, "Resource %s: ceiling priority %d\n", res->Config.Name, res->Ceiling);
+    }
+}
+
+/**************************************************************************
+ * @brief   Tạo một resource
+ * @details Trước khi gọi Os_Start, resource là một mutex thường (chỉ có luồng
+ *          chính chạy), ceiling được tính khi gọi Os_Start.
+ * @param   ConfigPtr       Con trỏ đến cấu hình của resource
+ * @param   ResIdPtr        Con trỏ lưu ID của resource
+ * @return 	Std_ReturnType  Trả về E_OK nếu tạo thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ hoặc
+ *                                 đã đạt số resource tối đa
+ **************************************************************************/
+Std_ReturnType Os_CreateResource(const Os_ResourceConfigType* ConfigPtr, Os_ResourceIdType* ResIdPtr) {
+    if (ConfigPtr == NULL_PTR || ResIdPtr == NULL_PTR ||
+        ConfigPtr->CeilingPriority > sched_get_priority_max(SCHED_FIFO)) {
+        LOG_ERROR(OS, "Invalid configuration passed to Os_CreateResource.\n");
+        return E_NOT_OK;
+    }
+    if (os_resource_count >= OS_MAX_RESOURCES) {
+        LOG_ERROR(OS, "Cannot create more resources. Maximum resource count reached.\n");
+        return E_NOT_OK;
+    }
+
+    Os_ResourceType* res = &os_resources[os_resource_count];
+    res->Config = *ConfigPtr;
+    res->Ceiling = 0;
+    pthread_mutex_init(&res->Lock, NULL_PTR);
+
+    *ResIdPtr = os_resource_count;
+    os_resource_count++;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Lấy một resource
+ * @details Luồng được nâng lên SCHED_FIFO với độ ưu tiên bằng ceiling trước
+ *          khi khóa (giao thức priority ceiling tức thời), nên thời gian một
+ *          task có độ ưu tiên cao phải chờ không vượt quá độ dài của một
+ *          đoạn giữ resource. Luồng đã có độ ưu tiên bằng ceiling thì không
+ *          phải đổi lịch.
+ * @param   ResId           ID của resource
+ * @return 	Std_ReturnType  Trả về E_OK nếu lấy thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ, luồng đã giữ
+ *                                 quá nhiều resource hoặc có độ ưu tiên cao
+ *                                 hơn ceiling
+ **************************************************************************/
+Std_ReturnType Os_GetResource(Os_ResourceIdType ResId) {
+    if (ResId >= os_resource_count || os_held_count >= OS_MAX_RESOURCE_NESTING) {
+        return E_NOT_OK;
+    }
+
+    Os_ResourceType* res = &os_resources[ResId];
+    Os_HeldResourceType* held = &os_held_resources[os_held_count];
+    held->Id = ResId;
+    held->Boosted = FALSE;
+
+    if (res->Ceiling != 0) {
+        int policy;
+        struct sched_param param;
+        pthread_getschedparam(pthread_self(), &policy, &param);
+
+        boolean realtime = (policy == SCHED_FIFO || policy == SCHED_RR) ? TRUE : FALSE;
+        if (realtime && param.sched_priority > res->Ceiling) {
+            LOG_ERROR(OS, "Priority %d is above the ceiling of resource %s.\n", param.sched_priority, res->Config.Name);
+            return E_NOT_OK;
+        }
+        if (!realtime || param.sched_priority < res->Ceiling) {
+            struct sched_param boosted = {0};
+            boosted.sched_priority = res->Ceiling;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &boosted) == 0) {
+                held->Boosted = TRUE;
+                held->Policy = policy;
+                held->Priority = param.sched_priority;
+            }
+        }
+    }
+
+    int err = pthread_mutex_lock(&res->Lock);
+    if (err != 0) {
+        if (held->Boosted) {
+            struct sched_param param = {0};
+            param.sched_priority = held->Priority;
+            pthread_setschedparam(pthread_self(), held->Policy, &param);
+        }
+        LOG_ERROR(OS, "Cannot lock resource %s (error %d).\n", res->Config.Name, err);
+        return E_NOT_OK;
+    }
+
+    os_held_count++;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Trả một resource
+ * @details Mutex được mở khóa trước rồi luồng mới trở về lịch cũ, để task có
+ *          độ ưu tiên cao đang chờ resource chạy ngay khi luồng bị hạ.
+ * @param   ResId           ID của resource
+ * @return 	Std_ReturnType  Trả về E_OK nếu trả thành công,
+ *                                 E_NOT_OK nếu resource không phải resource
+ *                                 được lấy gần nhất của luồng gọi
+ **************************************************************************/
+Std_ReturnType Os_ReleaseResource(Os_ResourceIdType ResId) {
+    if (os_held_count == 0 || os_held_resources[os_held_count - 1].Id != ResId) {
+        LOG_ERROR(OS, "Resource %d is not the last resource taken by this thread.\n", ResId);
+        return E_NOT_OK;
+    }
+
+    os_held_count--;
+    const Os_HeldResourceType* held = &os_held_resources[os_held_count];
+    pthread_mutex_unlock(&os_resources[ResId].Lock);
+
+    if (held->Boosted) {
+        struct sched_param param = {0};
+        param.sched_priority = held->Priority;
+        pthread_setschedparam(pthread_self(), held->Policy, &param);
+    }
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Khởi động bộ lập lịch tuần hoàn
+ * @details Hàm này chọn một epoch chung rồi tạo luồng cho các task tuần hoàn
+ *          và task theo sự kiện theo thứ tự độ ưu tiên giảm dần, mỗi luồng tự
+ *          áp dụng độ ưu tiên của task bằng SCHED_FIFO nếu được phép. Các luồng
+ *          được tính là đang chạy ngay từ trước khi tạo để thời gian hệ thống
+ *          không nhảy qua epoch. Ceiling của các resource được tính trước
+ *          khi tạo luồng. Sau đó luồng timer (xem Os_Alarm.h) được khởi động
+ *          và mốc kích hoạt đầu tiên của mỗi task tuần hoàn được đặt vào
+ *          timer wheel, cuối cùng là các worker của runnable dạng coroutine
+ *          (xem Os_Coroutine.h).
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Start() {
+    boolean started[MAX_TASKS] = {FALSE};
+
+#if (OS_CFG_PROFILE_DUMP_PERIOD_MS > 0)
+    // Task in báo cáo thống kê định kỳ, độ ưu tiên thấp nhất
+    static const Os_PeriodicTaskConfigType profile_dump_config = {
+        "Os Profile Dump", Os_ProfileDump, OS_CFG_PROFILE_DUMP_PERIOD_MS, OS_CFG_PROFILE_DUMP_PERIOD_MS, 0, NULL_PTR
+    };
+    Os_CreatePeriodicTask(&profile_dump_config, NULL_PTR);
+#endif
+
+#if (OS_CFG_LOCK_MEMORY == 1) && defined(__linux__)
+    // Khóa vùng nhớ hiện tại và vùng nhớ cấp phát sau này (kể cả stack của các task)
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        LOG_WARN(OS, "Cannot lock process memory (mlockall), tasks may page fault\n");
+    } else {
+        LOG_INFO(OS, "Process memory locked.\n");
+    }
+#endif
+
+    // Độ ưu tiên của task chỉ được áp dụng nếu được phép dùng SCHED_FIFO,
+    // ngược lại nó chỉ quyết định thứ tự tạo luồng
+    os_realtime_permitted = Os_ProbeRealTime();
+    if (!os_realtime_permitted) {
+        LOG_WARN(OS, "Real-time scheduling not permitted, task priorities only order thread start-up "
+                     "and resources fall back to plain mutexes\n");
+    }
+
+    // Ceiling tự động phụ thuộc vào các task đã đăng ký
+    Os_ResourceFinalize();
+
+    // Task tuần hoàn được kích hoạt bởi luồng timer
+    for (uint8 i = 0; i < os_task_count; i++) {
+        if (os_tasks[i].Config.PeriodMs != 0) {
+            Os_Timer_Init(&os_tasks[i].Release, Os_PeriodicRelease, &os_tasks[i]);
+        }
+    }
+
+    periodic_epoch_ns = Os_GetTimeNs() + (uint64)OS_START_DELAY_MS * OS_NS_PER_MS;
+
+    for (uint8 n = 0; n < os_task_count; n++) {
+        // Chọn task có độ ưu tiên cao nhất chưa được khởi động
+        uint8 next = 0;
+        boolean found = FALSE;
+        for (uint8 i = 0; i < os_task_count; i++) {
+            if (!started[i] && (!found || os_tasks[i].Config.Priority > os_tasks[next].Config.Priority)) {
+                next = i;
+                found = TRUE;
+            }
+        }
+        started[next] = TRUE;
+
+        Os_TaskType* task = &os_tasks[next];
+        boolean periodic = (task->Config.PeriodMs != 0) ? TRUE : FALSE;
+        LOG_INFO(OS, "Starting %s task: %s\n", periodic ? "periodic" : "event", task->Config.Name);
+
+        // Kích thước stack phải được chọn khi tạo luồng, các thuộc tính khác
+        // được luồng tự áp dụng để lỗi thiếu quyền không làm hỏng việc tạo luồng
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (task->Config.Attributes != NULL_PTR && task->Config.Attributes->StackSize != 0) {
+            pthread_attr_setstacksize(&attr, task->Config.Attributes->StackSize);
+        }
+
+        Os_TimeBeginBusy();
+        pthread_create(&task_threads[task_count], &attr, periodic ? Os_PeriodicTaskMain : Os_EventTaskMain, task);
+        pthread_attr_destroy(&attr);
+        task_count++;
+        os_pending_count--;
+    }
+
+    // Luồng timer phục vụ task tuần hoàn, counter, alarm, schedule table và
+    // độ trễ của coroutine. Nhịp 0 sớm hơn epoch một nhịp, nếu không mốc
+    // kích hoạt tại epoch bị đẩy sang nhịp sau và task có chu kỳ bằng một
+    // nhịp bị trễ một nhịp ở mọi lần kích hoạt
+    Os_Alarm_Start(periodic_epoch_ns - (uint64)OS_CFG_TIMER_TICK_US * OS_NS_PER_US);
+    for (uint8 i = 0; i < os_task_count; i++) {
+        Os_TaskType* task = &os_tasks[i];
+        if (task->Config.PeriodMs != 0) {
+            task->ReleaseNs = periodic_epoch_ns + (uint64)task->Config.OffsetMs * OS_NS_PER_MS;
+            (void)Os_Timer_StartAbs(&task->Release, task->ReleaseNs);
+        }
+    }
+    Os_Co_Start(periodic_epoch_ns);
+}
+
+/**************************************************************************
+ * @brief   Đọc thống kê jitter, thời gian thực thi và overrun của một task
+ * @details Hàm này tính thống kê hiện tại của task từ histogram.
+ * @param   TaskId          ID của task
+ * @param   StatsPtr        Con trỏ lưu thống kê đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_GetTaskStats(Os_TaskIdType TaskId, Os_TaskStatsType* StatsPtr) {
+    if (TaskId >= os_task_count || StatsPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Os_TaskType* task = &os_tasks[TaskId];
+    pthread_mutex_lock(&task->StatsLock);
+    StatsPtr->ActivationCount = task->ActivationCount;
+    StatsPtr->OverrunCount = atomic_load_explicit(&task->OverrunCount, memory_order_relaxed);
+    Os_HistogramSummarize(&task->Jitter, &StatsPtr->Jitter);
+    Os_HistogramSummarize(&task->ExecTime, &StatsPtr->ExecTime);
+    pthread_mutex_unlock(&task->StatsLock);
+    StatsPtr->ScratchPeakBytes = atomic_load_explicit(&task->Scratch.HighWaterMark, memory_order_relaxed);
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   In báo cáo thống kê của tất cả các task
+ * @details Hàm này được bộ lập lịch gọi định kỳ với chu kỳ
+ *          OS_CFG_PROFILE_DUMP_PERIOD_MS, cũng có thể gọi trực tiếp.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_ProfileDump(void) {
+    Os_TaskStatsType stats;
+
+    LOG_INFO(OS, "Task profile (us):             runs overrun | jitter mean/p99/max | exec mean/p99/max | scratch\n");
+    for (Os_TaskIdType id = 0; id < os_task_count; id++) {
+        if (os_tasks[id].Config.Runnable == Os_ProfileDump || Os_GetTaskStats(id, &stats) != E_OK) {
+            continue;
+        }
+        // Giá trị nhỏ nhất được bỏ qua vì mỗi bản ghi log có tối đa LOG_MAX_ARGS tham số
+        LOG_INFO(OS, " - %-28s %6u %6u | %u/%u/%u | %u/%u/%u | %u\n",
+                 os_tasks[id].Config.Name, stats.ActivationCount, stats.OverrunCount,
+                 stats.Jitter.MeanUs, stats.Jitter.P99Us, stats.Jitter.MaxUs,
+                 stats.ExecTime.MeanUs, stats.ExecTime.P99Us, stats.ExecTime.MaxUs,
+                 stats.ScratchPeakBytes);
+    }
+}
+
+/**************************************************************************
+ * @brief   Chọn chế độ thời gian hệ thống (gọi trước Os_Start)
+ * @details Khi đổi chế độ, thời gian hệ thống được giữ nguyên giá trị hiện
+ *          tại để không bị nhảy ngược.
+ * @param   Mode            Chế độ thời gian
+ * @param   ScaleFactor     Hệ số tăng tốc (chỉ dùng cho OS_TIME_MODE_SCALED)
+ * @return 	Std_ReturnType  Trả về E_OK nếu thiết lập thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetTimeMode(Os_TimeModeType Mode, uint32 ScaleFactor) {
+    if (Mode > OS_TIME_MODE_DISCRETE || (Mode == OS_TIME_MODE_SCALED && ScaleFactor == 0)) {
+        LOG_ERROR(OS, "Error: Invalid time mode passed to Os_SetTimeMode.\n");
+        return E_NOT_OK;
+    }
+
+    uint64 now_ns = Os_GetTimeNs();
+
+    uint32 scale = (Mode == OS_TIME_MODE_SCALED) ? ScaleFactor : 1;
+
+    pthread_mutex_lock(&os_time_lock);
+    atomic_store_explicit(&os_virtual_now_ns, now_ns, memory_order_release);
+    Os_TimePublishLocked(Mode, scale, Os_MonotonicNs() - now_ns / scale);
+    pthread_mutex_unlock(&os_time_lock);
+
+    LOG_INFO(OS, "OS time mode: %s\n", (Mode == OS_TIME_MODE_REALTIME) ? "Real time" :
+                                       (Mode == OS_TIME_MODE_SCALED) ? "Scaled" : "Discrete event");
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc thời gian hệ thống hiện tại
+ * @details Ở chế độ REALTIME và SCALED, thời gian hệ thống được tính từ
+ *          CLOCK_MONOTONIC. Ở chế độ DISCRETE, thời gian hệ thống chỉ thay
+ *          đổi khi OS nhảy đến mốc đánh thức tiếp theo. Hàm này không khóa:
+ *          chế độ thời gian được đọc theo seqlock và đọc lại nếu bị đổi
+ *          trong lúc tính.
+ * @param   None
+ * @return 	uint64  Thời gian hệ thống tính từ Os_Init (nano giây)
+ **************************************************************************/
+uint64 Os_GetTimeNs(void) {
+    uint32 seq_begin;
+    uint64 now_ns;
+
+    do {
+        seq_begin = atomic_load_explicit(&os_time_seq, memory_order_acquire);
+        if (seq_begin & 1U) {
+            continue;   // Đang đổi chế độ thời gian, thử lại
+        }
+
+        if (atomic_load_explicit(&os_time_mode, memory_order_relaxed) == OS_TIME_MODE_DISCRETE) {
+            now_ns = atomic_load_explicit(&os_virtual_now_ns, memory_order_acquire);
+        } else {
+            uint64 base_ns = atomic_load_explicit(&os_time_base_ns, memory_order_relaxed);
+            uint32 scale = atomic_load_explicit(&os_time_scale, memory_order_relaxed);
+            now_ns = (Os_MonotonicNs() - base_ns) * scale;
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq_begin & 1U) || seq_begin != atomic_load_explicit(&os_time_seq, memory_order_relaxed));
+
+    return now_ns;
+}
+
+/**************************************************************************
+ * @brief   Ngủ đến một mốc thời gian hệ thống tuyệt đối
+ * @details Ở chế độ REALTIME và SCALED, hàm này quy đổi mốc đánh thức ra
+ *          CLOCK_MONOTONIC rồi ngủ bằng clock_nanosleep với TIMER_ABSTIME.
+ *          Ở chế độ DISCRETE, luồng gọi hàm được tính là không còn chạy và
+ *          chờ đến khi OS nhảy thời gian hệ thống đến mốc đánh thức.
+ * @param   WakeupNs    Mốc thời gian hệ thống cần đánh thức (nano giây)
+ * @return 	None
+ **************************************************************************/
+void Os_SleepUntilNs(uint64 WakeupNs) {
+    if (Os_TimeMode() != OS_TIME_MODE_DISCRETE) {
+        uint64 deadline_ns = atomic_load_explicit(&os_time_base_ns, memory_order_relaxed) +
+                             WakeupNs / atomic_load_explicit(&os_time_scale, memory_order_relaxed);
+
+        struct timespec deadline;
+        deadline.tv_sec = (time_t)(deadline_ns / OS_NS_PER_SEC);
+        deadline.tv_nsec = (long)(deadline_ns % OS_NS_PER_SEC);
+
+        // Lặp lại nếu bị ngắt bởi tín hiệu
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL_PTR) != 0) {
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&os_time_lock);
+    if (WakeupNs > atomic_load_explicit(&os_virtual_now_ns, memory_order_relaxed)) {
+        Os_SleeperType self = {WakeupNs, os_sleepers};
+        os_sleepers = &self;
+        os_busy_count--;
+        Os_TimeAdvanceLocked();
+
+        while (atomic_load_explicit(&os_virtual_now_ns, memory_order_relaxed) < WakeupNs) {
+            pthread_cond_wait(&os_time_cond, &os_time_lock);
+        }
+
+        // Gỡ luồng khỏi danh sách đang ngủ
+        Os_SleeperType** link = &os_sleepers;
+        while (*link != &self) {
+            link = &(*link)->Next;
+        }
+        *link = self.Next;
+        os_busy_count++;
+    }
+
+    pthread_mutex_unlock(&os_time_lock);
+}
+
+/**************************************************************************
+ * @brief   Báo cho OS có thêm một luồng xử lý đang chạy
+ * @details Chỉ có tác dụng ở chế độ DISCRETE, ở các chế độ khác hàm trả về
+ *          ngay mà không khóa.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_TimeBeginBusy(void) {
+    if (Os_TimeMode() != OS_TIME_MODE_DISCRETE) {
+        return;
+    }
+
+    pthread_mutex_lock(&os_time_lock);
+    os_busy_count++;
+    pthread_mutex_unlock(&os_time_lock);
+}
+
+/**************************************************************************
+ * @brief   Báo cho OS bớt đi một luồng xử lý đang chạy
+ * @details Chỉ có tác dụng ở chế độ DISCRETE. Nếu không còn luồng nào đang
+ *          chạy thì thời gian hệ thống nhảy đến mốc đánh thức gần nhất.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_TimeEndBusy(void) {
+    if (Os_TimeMode() != OS_TIME_MODE_DISCRETE) {
+        return;
+    }
+
+    pthread_mutex_lock(&os_time_lock);
+    if (os_busy_count > 0) {
+        os_busy_count--;
+    }
+    Os_TimeAdvanceLocked();
+    pthread_mutex_unlock(&os_time_lock);
+}
+
 /**************************************************************************
  * @brief   Tạo độ trễ (delay)
- * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds).
+ * @details Hàm này dùng để tạo độ trễ mô phỏng (tính theo milliseconds) theo
+ *          thời gian hệ thống của OS.
  * @param   milliseconds    Thời gian độ trễ cần tạo (tính theo mili giây)
  * @return 	None  
  **************************************************************************/
 void Os_Delay(uint32 milliseconds) {
-    usleep(milliseconds * 1000); // Sử dụng usleep cho delay tính theo mili giây
+    Os_SleepUntilNs(Os_GetTimeNs() + (uint64)milliseconds * OS_NS_PER_MS);
+}
+
+/**************************************************************************
+ * @brief   Yêu cầu kết thúc hệ điều hành
+ * @details Các task không được kích hoạt thêm: mốc kích hoạt của task tuần
+ *          hoàn không được đặt lại, luồng của mọi task được đánh thức và
+ *          kết thúc sau khi lần chạy hiện tại (nếu có) xong. Có thể gọi
+ *          nhiều lần, không chờ các luồng kết thúc.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_RequestShutdown(void) {
+    if (atomic_exchange(&os_shutdown_requested, TRUE)) {
+        return;
+    }
+
+    for (uint8 i = 0; i < os_task_count; i++) {
+        if (os_tasks[i].Config.PeriodMs != 0) {
+            (void)Os_Timer_Cancel(&os_tasks[i].Release);
+        }
+        Os_TaskWake(&os_tasks[i]);
+    }
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra hệ điều hành đã được yêu cầu kết thúc hay chưa
+ * @param   None
+ * @return 	boolean     TRUE nếu đã gọi Os_RequestShutdown hoặc Os_Shutdown
+ **************************************************************************/
+boolean Os_ShutdownRequested(void) {
+    return atomic_load(&os_shutdown_requested) ? TRUE : FALSE;
 }
 
 /**************************************************************************
  * @brief   Kết thúc hệ điều hành
- * @details Hàm này được gọi để kết thúc hệ điều hành và chờ các luồng kết thúc.
+ * @details Hàm này yêu cầu kết thúc hệ điều hành (Os_RequestShutdown), chờ
+ *          luồng của các task kết thúc, rồi dừng các worker của runnable
+ *          dạng coroutine và luồng timer. Luồng tạo bằng Os_CreateTask phải
+ *          tự kết thúc khi Os_ShutdownRequested trả về TRUE.
  * @param   None
  * @return 	None  
  **************************************************************************/
 void Os_Shutdown() {
-    printf("Shutting down OS and waiting for tasks to finish...\n");
+    LOG_INFO(OS, "Shutting down OS and waiting for tasks to finish...\n");
+    Os_RequestShutdown();
     for (uint8 i = 0; i < task_count; i++) {
         pthread_join(task_threads[i], NULL_PTR); // Chờ các luồng kết thúc
     }
-    printf("All tasks have completed. OS Shutdown.\n");
+    Os_Co_Stop();
+    Os_Alarm_Stop();
+    LOG_INFO(OS, "All tasks have completed. OS Shutdown.\n");
 }
\ No newline at end of file
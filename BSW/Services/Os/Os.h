@@ -4,8 +4,192 @@
 #include <stdio.h>
 #include <pthread.h>
 #include <unistd.h>
+#include <time.h>
 #include "Std_Types.h"
 
+/**************************************************************************
+ * @typedef Os_TaskIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của một task
+ * @details ID được cấp khi đăng ký task tuần hoàn hoặc task theo sự kiện,
+ *          dùng để kích hoạt task và truy vấn thống kê.
+ **************************************************************************/
+typedef uint8 Os_TaskIdType;
+
+/**************************************************************************
+ * @enum    Os_SchedPolicyType
+ * @brief   Định nghĩa chính sách lập lịch của luồng của một task
+ **************************************************************************/
+typedef enum {
+    OS_SCHED_DEFAULT = 0,       /* Theo Priority của task (xem OS_CFG_TASK_RT_PRIORITY_BASE) */
+    OS_SCHED_FIFO = 1,          /* Thời gian thực, chạy đến khi tự nhường CPU (SCHED_FIFO) */
+    OS_SCHED_RR = 2             /* Thời gian thực, chia lượt giữa các luồng cùng độ ưu tiên (SCHED_RR) */
+} Os_SchedPolicyType;
+
+/**************************************************************************
+ * @struct  Os_TaskAttrType
+ * @brief   Cấu trúc thuộc tính luồng của một task
+ * @details Thuộc tính được áp dụng khi Os_Start tạo luồng của task. Nếu hệ
+ *          điều hành không cho phép (thiếu quyền, core không tồn tại), task
+ *          vẫn chạy với thuộc tính mặc định và OS ghi cảnh báo.
+ **************************************************************************/
+typedef struct {
+    uint64 CoreMask;            /* Các core được phép chạy, bit n là core n (0: không ghim) */
+    Os_SchedPolicyType Policy;  /* Chính sách lập lịch */
+    uint8 RtPriority;           /* Độ ưu tiên thời gian thực 1..99 (OS_SCHED_FIFO/OS_SCHED_RR) */
+    uint32 StackSize;           /* Kích thước stack (byte, 0: mặc định của hệ điều hành) */
+    boolean PrefaultStack;      /* Chạm trước toàn bộ stack để không bị page fault khi chạy */
+} Os_TaskAttrType;
+
+/**************************************************************************
+ * @struct  Os_PeriodicTaskConfigType
+ * @brief   Cấu trúc cấu hình cho một task tuần hoàn
+ * @details Task tuần hoàn được kích hoạt theo các mốc thời gian tuyệt đối
+ *          (epoch + offset + n * period) nên chu kỳ không bị trôi theo thời
+ *          gian thực thi của task.
+ **************************************************************************/
+typedef struct {
+    const char* Name;           /* Tên của task */
+    void (*Runnable)(void);     /* Hàm được gọi mỗi lần task được kích hoạt */
+    uint32 PeriodMs;            /* Chu kỳ kích hoạt (ms) */
+    uint32 OffsetMs;            /* Độ lệch của lần kích hoạt đầu tiên so với epoch (ms) */
+    uint8 Priority;             /* Độ ưu tiên (giá trị lớn hơn được chạy trước) */
+    const Os_TaskAttrType* Attributes;  /* Thuộc tính luồng (NULL: mặc định) */
+} Os_PeriodicTaskConfigType;
+
+/**************************************************************************
+ * @typedef Os_EventMaskType
+ * @brief   Định nghĩa kiểu dữ liệu cho tập sự kiện của một extended task
+ **************************************************************************/
+typedef uint32 Os_EventMaskType;
+
+/**************************************************************************
+ * @struct  Os_EventTaskConfigType
+ * @brief   Cấu trúc cấu hình cho một task theo sự kiện
+ * @details Task chỉ chạy khi được kích hoạt bằng Os_ActivateTask, mỗi lần
+ *          kích hoạt chạy runnable một lần. Basic task chạy hết runnable,
+ *          extended task có thể chờ sự kiện bằng Os_WaitEvent trong runnable.
+ **************************************************************************/
+typedef struct {
+    const char* Name;           /* Tên của task */
+    void (*Runnable)(void);     /* Hàm được gọi mỗi lần task được kích hoạt */
+    uint8 Priority;             /* Độ ưu tiên (giá trị lớn hơn được chạy trước) */
+    uint8 MaxActivations;       /* Số lần kích hoạt tối đa được xếp hàng (tối thiểu 1) */
+    boolean Extended;           /* TRUE: extended task (được chờ sự kiện) */
+    const Os_TaskAttrType* Attributes;  /* Thuộc tính luồng (NULL: mặc định) */
+} Os_EventTaskConfigType;
+
+/**************************************************************************
+ * @typedef Os_ResourceIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của một resource
+ **************************************************************************/
+typedef uint8 Os_ResourceIdType;
+
+/**************************************************************************
+ * @brief Số resource tối đa và số resource một luồng được giữ cùng lúc
+ **************************************************************************/
+#define OS_MAX_RESOURCES                16
+#define OS_MAX_RESOURCE_NESTING         4
+
+/**************************************************************************
+ * @brief Ceiling tự động: độ ưu tiên thời gian thực cao nhất trong các task
+ *        đã đăng ký, được tính khi gọi Os_Start
+ **************************************************************************/
+#define OS_RESOURCE_CEILING_AUTO        0
+
+/**************************************************************************
+ * @struct  Os_ResourceConfigType
+ * @brief   Cấu trúc cấu hình của một resource
+ * @details Resource dùng giao thức priority ceiling tức thời: luồng lấy
+ *          resource được nâng lên SCHED_FIFO với độ ưu tiên CeilingPriority
+ *          trước khi khóa, nên không task nào có độ ưu tiên thấp hơn ceiling
+ *          chen vào được khi resource đang bị giữ. CeilingPriority phải lớn
+ *          hơn hoặc bằng RtPriority của mọi task dùng resource.
+ **************************************************************************/
+typedef struct {
+    const char* Name;           /* Tên của resource */
+    uint8 CeilingPriority;      /* Độ ưu tiên thời gian thực 1..99 (OS_RESOURCE_CEILING_AUTO: tự động) */
+} Os_ResourceConfigType;
+
+/**************************************************************************
+ * @brief Độ ưu tiên thời gian thực của các task không chọn chính sách lập lịch
+ * @details Task có Attributes NULL hoặc Policy OS_SCHED_DEFAULT chạy SCHED_FIFO
+ *          với độ ưu tiên OS_CFG_TASK_RT_PRIORITY_BASE + Priority (thấp hơn
+ *          luồng timer) nếu tiến trình được phép dùng lập lịch thời gian thực
+ *          (root hoặc CAP_SYS_NICE), ngược lại Priority chỉ quyết định thứ tự
+ *          tạo luồng. Đặt bằng 0 để các task này luôn chạy SCHED_OTHER.
+ **************************************************************************/
+#ifndef OS_CFG_TASK_RT_PRIORITY_BASE
+#define OS_CFG_TASK_RT_PRIORITY_BASE    10
+#endif
+
+/**************************************************************************
+ * @brief Chu kỳ in báo cáo thống kê của các task tuần hoàn (ms)
+ * @details Đặt bằng 0 để tắt, ví dụ: -DOS_CFG_PROFILE_DUMP_PERIOD_MS=0
+ **************************************************************************/
+#ifndef OS_CFG_PROFILE_DUMP_PERIOD_MS
+#define OS_CFG_PROFILE_DUMP_PERIOD_MS   10000
+#endif
+
+/**************************************************************************
+ * @brief Kích thước arena vùng nhớ tạm của mỗi task tuần hoàn (byte)
+ * @details Arena được reset sau mỗi lần kích hoạt, xem Mem_ScratchAlloc.
+ **************************************************************************/
+#ifndef OS_CFG_TASK_SCRATCH_SIZE
+#define OS_CFG_TASK_SCRATCH_SIZE        4096
+#endif
+
+/**************************************************************************
+ * @brief Khóa toàn bộ bộ nhớ của tiến trình trong RAM (mlockall) khi gọi
+ *        Os_Start để các task không bị page fault
+ * @details Cần quyền CAP_IPC_LOCK hoặc RLIMIT_MEMLOCK đủ lớn. Vì vùng nhớ
+ *          cấp phát sau đó cũng bị khóa, nên đặt StackSize cho các task.
+ **************************************************************************/
+#ifndef OS_CFG_LOCK_MEMORY
+#define OS_CFG_LOCK_MEMORY              0
+#endif
+
+/**************************************************************************
+ * @struct  Os_TimingStatsType
+ * @brief   Cấu trúc lưu thống kê của một đại lượng thời gian (us)
+ * @details P99 được ước lượng từ histogram nên sai số tối đa khoảng 19%.
+ **************************************************************************/
+typedef struct {
+    uint32 MinUs;               /* Giá trị nhỏ nhất (us) */
+    uint32 MaxUs;               /* Giá trị lớn nhất (us) */
+    uint32 MeanUs;              /* Giá trị trung bình (us) */
+    uint32 P99Us;               /* 99% số lần đo không vượt quá giá trị này (us) */
+} Os_TimingStatsType;
+
+/**************************************************************************
+ * @struct  Os_TaskStatsType
+ * @brief   Cấu trúc lưu thống kê thời gian chạy của một task
+ * @details Jitter là độ trễ giữa mốc kích hoạt dự kiến (task theo sự kiện:
+ *          lúc gọi Os_ActivateTask) và thời điểm task thực sự bắt đầu chạy.
+ *          ExecTime là thời gian từ lúc task bắt đầu đến lúc runnable kết
+ *          thúc. Overrun là số lần task chạy quá mốc kích hoạt tiếp theo
+ *          (task theo sự kiện: số lần kích hoạt bị từ chối do hàng đợi đầy).
+ **************************************************************************/
+typedef struct {
+    uint32 ActivationCount;     /* Số lần task đã được kích hoạt */
+    uint32 OverrunCount;        /* Số lần task chạy vượt quá chu kỳ hoặc bị từ chối kích hoạt */
+    Os_TimingStatsType Jitter;  /* Thống kê jitter khi bắt đầu chạy */
+    Os_TimingStatsType ExecTime;/* Thống kê thời gian thực thi */
+    uint32 ScratchPeakBytes;    /* Vùng nhớ tạm dùng nhiều nhất trong một lần kích hoạt (byte) */
+} Os_TaskStatsType;
+
+/**************************************************************************
+ * @enum    Os_TimeModeType
+ * @brief   Định nghĩa chế độ của thời gian hệ thống
+ * @details Tất cả độ trễ của MCAL và mốc kích hoạt của task đều đi qua thời
+ *          gian hệ thống của OS nên có thể chạy toàn bộ ECU nhanh hơn thời
+ *          gian thực khi chạy kiểm thử hồi quy.
+ **************************************************************************/
+typedef enum {
+    OS_TIME_MODE_REALTIME = 0,  /* Thời gian hệ thống trùng với thời gian thực */
+    OS_TIME_MODE_SCALED = 1,    /* Thời gian hệ thống chạy nhanh gấp ScaleFactor lần */
+    OS_TIME_MODE_DISCRETE = 2   /* Nhảy thẳng đến mốc đánh thức gần nhất khi mọi luồng đều đang chờ */
+} Os_TimeModeType;
+
 /**************************************************************************
  * @brief   Khởi tạo hệ điều hành (OS)
  * @param   None
@@ -21,6 +205,174 @@ void Os_Init(void);
  **************************************************************************/
 void Os_CreateTask(void* (*task_func)(void*), const char* task_name);
 
+/**************************************************************************
+ * @brief   Đăng ký một task tuần hoàn
+ * @param   ConfigPtr       Con trỏ đến cấu hình của task tuần hoàn
+ * @param   TaskIdPtr       Con trỏ lưu ID của task được cấp (có thể NULL)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ hoặc hết chỗ
+ **************************************************************************/
+Std_ReturnType Os_CreatePeriodicTask(const Os_PeriodicTaskConfigType* ConfigPtr, Os_TaskIdType* TaskIdPtr);
+
+/**************************************************************************
+ * @brief   Đăng ký một task theo sự kiện
+ * @param   ConfigPtr       Con trỏ đến cấu hình của task theo sự kiện
+ * @param   TaskIdPtr       Con trỏ lưu ID của task được cấp (có thể NULL)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ hoặc hết chỗ
+ **************************************************************************/
+Std_ReturnType Os_CreateEventTask(const Os_EventTaskConfigType* ConfigPtr, Os_TaskIdType* TaskIdPtr);
+
+/**************************************************************************
+ * @brief   Kích hoạt một task theo sự kiện
+ * @details Có thể gọi từ bất kỳ luồng nào, kể cả hàm thông báo của driver.
+ * @param   TaskId          ID của task theo sự kiện
+ * @return 	Std_ReturnType  Trả về E_OK nếu task được kích hoạt,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc số lần
+ *                                 kích hoạt đang chờ đã đạt MaxActivations
+ **************************************************************************/
+Std_ReturnType Os_ActivateTask(Os_TaskIdType TaskId);
+
+/**************************************************************************
+ * @brief   Đặt sự kiện cho một extended task
+ * @param   TaskId          ID của extended task
+ * @param   Mask            Các sự kiện cần đặt
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc task
+ *                                 không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_SetEvent(Os_TaskIdType TaskId, Os_EventMaskType Mask);
+
+/**************************************************************************
+ * @brief   Chờ đến khi có ít nhất một sự kiện trong Mask được đặt
+ * @details Chỉ được gọi từ runnable của extended task. Các sự kiện được xóa
+ *          khi task bắt đầu một lần kích hoạt mới hoặc khi gọi Os_ClearEvent.
+ * @param   Mask            Các sự kiện cần chờ
+ * @return 	Std_ReturnType  Trả về E_OK khi có sự kiện,
+ *                                 E_NOT_OK nếu luồng gọi không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_WaitEvent(Os_EventMaskType Mask);
+
+/**************************************************************************
+ * @brief   Xóa các sự kiện của extended task đang chạy
+ * @param   Mask            Các sự kiện cần xóa
+ * @return 	Std_ReturnType  Trả về E_OK nếu xóa thành công,
+ *                                 E_NOT_OK nếu luồng gọi không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_ClearEvent(Os_EventMaskType Mask);
+
+/**************************************************************************
+ * @brief   Đọc các sự kiện đang được đặt của một extended task
+ * @param   TaskId          ID của extended task
+ * @param   MaskPtr         Con trỏ lưu các sự kiện
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc task
+ *                                 không phải extended task
+ **************************************************************************/
+Std_ReturnType Os_GetEvent(Os_TaskIdType TaskId, Os_EventMaskType* MaskPtr);
+
+/**************************************************************************
+ * @brief   Tạo một resource
+ * @details Gọi trước Os_Start. Mutex của resource dùng PTHREAD_PRIO_PROTECT
+ *          nếu hệ điều hành hỗ trợ và tiến trình được phép dùng lập lịch
+ *          thời gian thực, nếu không resource chỉ còn là một mutex thường.
+ * @param   ConfigPtr       Con trỏ đến cấu hình của resource
+ * @param   ResIdPtr        Con trỏ lưu ID của resource
+ * @return 	Std_ReturnType  Trả về E_OK nếu tạo thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ hoặc
+ *                                 đã đạt số resource tối đa
+ **************************************************************************/
+Std_ReturnType Os_CreateResource(const Os_ResourceConfigType* ConfigPtr, Os_ResourceIdType* ResIdPtr);
+
+/**************************************************************************
+ * @brief   Lấy một resource
+ * @details Luồng gọi được nâng lên ceiling của resource rồi khóa resource.
+ *          Không được chờ (Os_WaitEvent, Os_Delay) khi đang giữ resource.
+ * @param   ResId           ID của resource
+ * @return 	Std_ReturnType  Trả về E_OK nếu lấy thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ, luồng đã giữ
+ *                                 quá nhiều resource hoặc có độ ưu tiên cao
+ *                                 hơn ceiling
+ **************************************************************************/
+Std_ReturnType Os_GetResource(Os_ResourceIdType ResId);
+
+/**************************************************************************
+ * @brief   Trả một resource
+ * @details Các resource phải được trả theo thứ tự ngược với thứ tự lấy,
+ *          luồng gọi trở về độ ưu tiên trước khi lấy resource.
+ * @param   ResId           ID của resource
+ * @return 	Std_ReturnType  Trả về E_OK nếu trả thành công,
+ *                                 E_NOT_OK nếu resource không phải resource
+ *                                 được lấy gần nhất của luồng gọi
+ **************************************************************************/
+Std_ReturnType Os_ReleaseResource(Os_ResourceIdType ResId);
+
+/**************************************************************************
+ * @brief   Khởi động bộ lập lịch tuần hoàn
+ * @details Tất cả các task tuần hoàn đã đăng ký dùng chung một epoch, luồng
+ *          của các task theo sự kiện cũng được tạo ở đây.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Start(void);
+
+/**************************************************************************
+ * @brief   Đọc thống kê jitter, thời gian thực thi và overrun của một task
+ * @param   TaskId          ID của task
+ * @param   StatsPtr        Con trỏ lưu thống kê đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_GetTaskStats(Os_TaskIdType TaskId, Os_TaskStatsType* StatsPtr);
+
+/**************************************************************************
+ * @brief   In báo cáo thống kê của tất cả các task
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_ProfileDump(void);
+
+/**************************************************************************
+ * @brief   Chọn chế độ thời gian hệ thống (gọi trước Os_Start)
+ * @param   Mode            Chế độ thời gian
+ * @param   ScaleFactor     Hệ số tăng tốc (chỉ dùng cho OS_TIME_MODE_SCALED)
+ * @return 	Std_ReturnType  Trả về E_OK nếu thiết lập thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetTimeMode(Os_TimeModeType Mode, uint32 ScaleFactor);
+
+/**************************************************************************
+ * @brief   Đọc thời gian hệ thống hiện tại
+ * @param   None
+ * @return 	uint64  Thời gian hệ thống tính từ Os_Init (nano giây)
+ **************************************************************************/
+uint64 Os_GetTimeNs(void);
+
+/**************************************************************************
+ * @brief   Ngủ đến một mốc thời gian hệ thống tuyệt đối
+ * @param   WakeupNs    Mốc thời gian hệ thống cần đánh thức (nano giây)
+ * @return 	None
+ **************************************************************************/
+void Os_SleepUntilNs(uint64 WakeupNs);
+
+/**************************************************************************
+ * @brief   Báo cho OS có thêm một luồng xử lý đang chạy
+ * @details Ở chế độ OS_TIME_MODE_DISCRETE, thời gian chỉ được nhảy khi không
+ *          còn luồng nào đang chạy. Luồng chờ trên biến điều kiện riêng
+ *          (không phải Os_SleepUntilNs) phải gọi Os_TimeEndBusy trước khi chờ
+ *          và phía đánh thức gọi Os_TimeBeginBusy thay cho luồng đó.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_TimeBeginBusy(void);
+
+/**************************************************************************
+ * @brief   Báo cho OS bớt đi một luồng xử lý đang chạy
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_TimeEndBusy(void);
+
 /**************************************************************************
  * @brief   Tạo độ trễ (delay)
  * @param   milliseconds    Thời gian độ trễ cần tạo (tính theo mili giây)
@@ -29,7 +381,22 @@ void Os_CreateTask(void* (*task_func)(void*), const char* task_name);
 void Os_Delay(uint32 milliseconds);
 
 /**************************************************************************
- * @brief   Kết thúc hệ điều hành
+ * @brief   Yêu cầu kết thúc hệ điều hành, các task kết thúc sau lần chạy
+ *          hiện tại (không chờ)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_RequestShutdown(void);
+
+/**************************************************************************
+ * @brief   Kiểm tra hệ điều hành đã được yêu cầu kết thúc hay chưa
+ * @param   None
+ * @return 	boolean     TRUE nếu đã gọi Os_RequestShutdown hoặc Os_Shutdown
+ **************************************************************************/
+boolean Os_ShutdownRequested(void);
+
+/**************************************************************************
+ * @brief   Kết thúc hệ điều hành và chờ các luồng của OS kết thúc
  * @param   None
  * @return 	None  
  **************************************************************************/
@@ -0,0 +1,875 @@
+/***************************************************************************
+ * @file    Os_Alarm.c
+ * @brief   Định nghĩa counter, alarm và schedule table của OS
+ * @details File này triển khai một luồng timer duy nhất chạy theo nhịp
+ *          OS_CFG_TIMER_TICK_US. Mọi counter được tính từ số nhịp của luồng
+ *          timer, mốc hết hạn của alarm và schedule table được lưu theo nhịp
+ *          tuyệt đối trong một timer wheel 4 tầng x 256 ô: thêm và hủy là
+ *          O(1), mỗi nhịp chỉ xử lý một ô và thỉnh thoảng chuyển một ô của
+ *          tầng trên xuống tầng dưới. Hành động được thực hiện ngoài khóa nên
+ *          hàm callback có thể gọi lại các API của alarm.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#include "Os_Alarm.h"
+#include <pthread.h>
+#include <sched.h>
+#include "Log.h"
+
+/**************************************************************************
+ * @brief Kích thước của timer wheel
+ * @details Tầng L chứa các mốc cách nhịp hiện tại dưới 2^(8 * (L + 1)) nhịp,
+ *          mốc xa hơn được đặt tạm ở tầng cuối và được xếp lại khi chuyển tầng.
+ **************************************************************************/
+#define OS_WHEEL_LEVELS         4
+#define OS_WHEEL_SLOT_BITS      8
+#define OS_WHEEL_SLOTS          (1U << OS_WHEEL_SLOT_BITS)
+#define OS_WHEEL_SLOT_MASK      (OS_WHEEL_SLOTS - 1U)
+#define OS_WHEEL_MAX_DELTA      ((1ULL << (OS_WHEEL_LEVELS * OS_WHEEL_SLOT_BITS)) - 1ULL)
+
+#define OS_TIMER_TICK_NS        ((uint64)OS_CFG_TIMER_TICK_US * 1000ULL)
+
+/**************************************************************************
+ * @enum    Os_TimerOwnerType
+ * @brief   Định nghĩa loại đối tượng sở hữu một mốc hết hạn
+ **************************************************************************/
+typedef enum {
+    OS_TIMER_ALARM = 0,
+    OS_TIMER_SCHEDULE_TABLE = 1,
+    OS_TIMER_CALLBACK = 2
+} Os_TimerOwnerType;
+
+/**************************************************************************
+ * @struct  Os_AlarmType
+ * @brief   Định nghĩa trạng thái của một alarm
+ **************************************************************************/
+typedef struct {
+    const Os_AlarmConfigType* Config;   /* Cấu hình (NULL_PTR: chưa cấu hình) */
+    Os_TimerType Timer;                 /* Mốc hết hạn tiếp theo */
+    uint64 CycleTicks;                  /* Chu kỳ lặp lại (nhịp timer, 0: một lần) */
+} Os_AlarmType;
+
+/**************************************************************************
+ * @struct  Os_ScheduleTableType
+ * @brief   Định nghĩa trạng thái của một schedule table
+ **************************************************************************/
+typedef struct {
+    const Os_ScheduleTableConfigType* Config;   /* Cấu hình (NULL_PTR: chưa cấu hình) */
+    Os_TimerType Timer;                         /* Mốc hết hạn tiếp theo */
+    uint64 CycleStart;                          /* Tick tuyệt đối của counter lúc bắt đầu chu kỳ */
+    uint8 NextPoint;                            /* Expiry point tiếp theo (NumExpiryPoints: kết thúc bảng) */
+} Os_ScheduleTableType;
+
+static const Os_CounterConfigType* os_counters[OS_MAX_COUNTERS];
+static Os_AlarmType os_alarms[OS_MAX_ALARMS];
+static Os_ScheduleTableType os_tables[OS_MAX_SCHEDULE_TABLES];
+
+/**************************************************************************
+ * @brief Timer wheel và trạng thái của luồng timer, được bảo vệ bởi os_alarm_lock
+ * @details Thứ tự khóa: os_alarm_lock trước, khóa thời gian của OS sau.
+ **************************************************************************/
+static Os_TimerType* os_wheel[OS_WHEEL_LEVELS][OS_WHEEL_SLOTS];
+static uint64 os_wheel_next = 1;            /* Nhịp tiếp theo cần xử lý */
+static uint32 os_wheel_count = 0;           /* Số mốc đang chờ hết hạn */
+static uint64 os_timer_epoch_ns = 0;        /* Thời gian hệ thống ứng với nhịp 0 */
+static boolean os_timer_needed = FALSE;     /* Có module của OS dùng Os_Timer */
+static boolean os_timer_started = FALSE;    /* Luồng timer đã được khởi động */
+static boolean os_timer_idle = FALSE;       /* Luồng timer đang chờ vì wheel rỗng */
+static boolean os_timer_stop = FALSE;       /* Luồng timer cần kết thúc (Os_Alarm_Stop) */
+static pthread_t os_timer_thread;
+static pthread_mutex_t os_alarm_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t os_alarm_cond = PTHREAD_COND_INITIALIZER;
+
+/**************************************************************************
+ * @brief   Gỡ một mốc hết hạn khỏi danh sách đang chứa nó
+ * @param   timer   Mốc hết hạn cần gỡ
+ * @return 	None
+ **************************************************************************/
+static void Os_Wheel_Unlink(Os_TimerType* timer) {
+    *timer->PPrev = timer->Next;
+    if (timer->Next != NULL_PTR) {
+        timer->Next->PPrev = timer->PPrev;
+    }
+    timer->Next = NULL_PTR;
+    timer->PPrev = NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Đặt một mốc hết hạn vào ô tương ứng của timer wheel
+ * @details Mốc đã qua được đặt vào ô của nhịp tiếp theo.
+ * @param   timer   Mốc hết hạn cần đặt (Expires đã được gán)
+ * @return 	None
+ **************************************************************************/
+static void Os_Wheel_Place(Os_TimerType* timer) {
+    uint64 expires = (timer->Expires > os_wheel_next) ? timer->Expires : os_wheel_next;
+    uint64 delta = expires - os_wheel_next;
+    if (delta > OS_WHEEL_MAX_DELTA) {
+        delta = OS_WHEEL_MAX_DELTA;
+        expires = os_wheel_next + delta;
+    }
+
+    uint8 level = 0;
+    while (level < OS_WHEEL_LEVELS - 1 && (delta >> (OS_WHEEL_SLOT_BITS * (level + 1U))) != 0) {
+        level++;
+    }
+
+    Os_TimerType** head = &os_wheel[level][(expires >> (OS_WHEEL_SLOT_BITS * level)) & OS_WHEEL_SLOT_MASK];
+    timer->Next = *head;
+    timer->PPrev = head;
+    if (*head != NULL_PTR) {
+        (*head)->PPrev = &timer->Next;
+    }
+    *head = timer;
+}
+
+/**************************************************************************
+ * @brief   Thêm một mốc hết hạn vào timer wheel
+ * @details Nếu luồng timer đang chờ vì wheel rỗng thì luồng được đánh thức.
+ *          Phía đánh thức gọi Os_TimeBeginBusy cho luồng timer để ở chế độ
+ *          DISCRETE thời gian không nhảy qua nhịp đầu tiên.
+ * @param   timer   Mốc hết hạn cần thêm (Expires đã được gán)
+ * @return 	None
+ **************************************************************************/
+static void Os_Wheel_Add(Os_TimerType* timer) {
+    Os_Wheel_Place(timer);
+    os_wheel_count++;
+
+    if (os_timer_idle) {
+        os_timer_idle = FALSE;
+        Os_TimeBeginBusy();
+        pthread_cond_signal(&os_alarm_cond);
+    }
+}
+
+/**************************************************************************
+ * @brief   Hủy một mốc hết hạn đang chờ
+ * @param   timer   Mốc hết hạn cần hủy
+ * @return 	None
+ **************************************************************************/
+static void Os_Wheel_Remove(Os_TimerType* timer) {
+    Os_Wheel_Unlink(timer);
+    os_wheel_count--;
+}
+
+/**************************************************************************
+ * @brief   Chuyển các mốc của một ô ở tầng trên xuống tầng dưới
+ * @param   level   Tầng cần chuyển (1..OS_WHEEL_LEVELS - 1)
+ * @return 	uint32  Chỉ số của ô vừa chuyển
+ **************************************************************************/
+static uint32 Os_Wheel_Cascade(uint8 level) {
+    uint32 slot = (uint32)(os_wheel_next >> (OS_WHEEL_SLOT_BITS * level)) & OS_WHEEL_SLOT_MASK;
+    Os_TimerType* timer = os_wheel[level][slot];
+    os_wheel[level][slot] = NULL_PTR;
+
+    while (timer != NULL_PTR) {
+        Os_TimerType* next = timer->Next;
+        Os_Wheel_Place(timer);
+        timer = next;
+    }
+    return slot;
+}
+
+/**************************************************************************
+ * @brief   Nhịp hiện tại của luồng timer (nhịp đã xử lý gần nhất)
+ * @details Khi luồng timer đang chờ vì wheel rỗng, nhịp hiện tại được đồng
+ *          bộ với thời gian hệ thống để alarm mới được tính từ bây giờ.
+ * @param   None
+ * @return 	uint64  Nhịp hiện tại
+ **************************************************************************/
+static uint64 Os_Wheel_Now(void) {
+    if (os_timer_started && os_timer_idle) {
+        uint64 now_ns = Os_GetTimeNs();
+        os_wheel_next = ((now_ns > os_timer_epoch_ns) ? (now_ns - os_timer_epoch_ns) / OS_TIMER_TICK_NS : 0U) + 1U;
+    }
+    return os_wheel_next - 1U;
+}
+
+/**************************************************************************
+ * @brief   Kiểm tra cấu hình của một hành động
+ * @param   action          Hành động cần kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu hợp lệ, E_NOT_OK nếu không hợp lệ
+ **************************************************************************/
+static Std_ReturnType Os_CheckAction(const Os_ActionType* action) {
+    switch (action->Kind) {
+    case OS_ACTION_ACTIVATE_TASK:
+        return E_OK;
+    case OS_ACTION_SET_EVENT:
+        return (action->Event != 0) ? E_OK : E_NOT_OK;
+    case OS_ACTION_CALLBACK:
+        return (action->Callback != NULL_PTR) ? E_OK : E_NOT_OK;
+    default:
+        return E_NOT_OK;
+    }
+}
+
+/**************************************************************************
+ * @brief   Thực hiện các hành động (gọi ngoài khóa)
+ * @details Lần kích hoạt bị từ chối vì đã đạt MaxActivations được tính vào
+ *          overrun của task nên không ghi log ở đây.
+ * @param   actions     Các hành động cần thực hiện
+ * @param   count       Số hành động
+ * @return 	None
+ **************************************************************************/
+static void Os_RunActions(const Os_ActionType* actions, uint8 count) {
+    for (uint8 i = 0; i < count; i++) {
+        switch (actions[i].Kind) {
+        case OS_ACTION_ACTIVATE_TASK:
+            (void)Os_ActivateTask(actions[i].TaskId);
+            break;
+        case OS_ACTION_SET_EVENT:
+            (void)Os_SetEvent(actions[i].TaskId, actions[i].Event);
+            break;
+        case OS_ACTION_CALLBACK:
+            actions[i].Callback();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Xử lý một mốc vừa hết hạn (gọi khi giữ khóa)
+ * @details Alarm tuần hoàn và schedule table được đặt lại mốc tiếp theo
+ *          trước khi hành động được thực hiện.
+ * @param   timer       Mốc vừa hết hạn (đã được gỡ khỏi wheel)
+ * @param   CountPtr    Con trỏ lưu số hành động cần thực hiện
+ * @return 	const Os_ActionType*    Các hành động cần thực hiện
+ **************************************************************************/
+static const Os_ActionType* Os_Expire(Os_TimerType* timer, uint8* CountPtr) {
+    if (timer->Owner == OS_TIMER_ALARM) {
+        Os_AlarmType* alarm = &os_alarms[timer->Id];
+        if (alarm->CycleTicks != 0) {
+            timer->Expires += alarm->CycleTicks;
+            Os_Wheel_Place(timer);
+        } else {
+            os_wheel_count--;
+        }
+        *CountPtr = 1;
+        return &alarm->Config->Action;
+    }
+
+    Os_ScheduleTableType* table = &os_tables[timer->Id];
+    const Os_ScheduleTableConfigType* config = table->Config;
+    uint64 ticksPerBase = os_counters[config->Counter]->TicksPerBase;
+    uint8 point = table->NextPoint;
+
+    if (point == config->NumExpiryPoints) {
+        // Hết độ dài của bảng không lặp lại
+        os_wheel_count--;
+        *CountPtr = 0;
+        return NULL_PTR;
+    }
+
+    table->NextPoint++;
+    if (table->NextPoint == config->NumExpiryPoints && config->Repeating) {
+        table->CycleStart += config->Duration;
+        table->NextPoint = 0;
+    }
+    uint64 offset = (table->NextPoint < config->NumExpiryPoints) ?
+                    config->ExpiryPoints[table->NextPoint].Offset : config->Duration;
+    timer->Expires = (table->CycleStart + offset) * ticksPerBase;
+    Os_Wheel_Place(timer);
+
+    *CountPtr = config->ExpiryPoints[point].NumActions;
+    return config->ExpiryPoints[point].Actions;
+}
+
+/**************************************************************************
+ * @brief   Xử lý nhịp tiếp theo của timer wheel (gọi khi giữ khóa)
+ * @details Các mốc của nhịp được tách ra một danh sách riêng rồi xử lý lần
+ *          lượt, khóa được nhả ra khi thực hiện hành động. Mốc bị hủy trong
+ *          lúc đó được gỡ khỏi danh sách riêng như gỡ khỏi wheel.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+static void Os_Wheel_Tick(void) {
+    uint32 slot = (uint32)os_wheel_next & OS_WHEEL_SLOT_MASK;
+    for (uint8 level = 1; slot == 0 && level < OS_WHEEL_LEVELS; level++) {
+        slot = Os_Wheel_Cascade(level);
+    }
+
+    Os_TimerType** head = &os_wheel[0][os_wheel_next & OS_WHEEL_SLOT_MASK];
+    Os_TimerType* expired = *head;
+    *head = NULL_PTR;
+    if (expired != NULL_PTR) {
+        expired->PPrev = &expired;
+    }
+    os_wheel_next++;
+
+    while (expired != NULL_PTR) {
+        Os_TimerType* timer = expired;
+        uint8 count = 0;
+        Os_Wheel_Unlink(timer);
+
+        if (timer->Owner == OS_TIMER_CALLBACK) {
+            // Mốc của module khác trong OS: chỉ hết hạn một lần
+            void (*callback)(void*) = timer->Expired;
+            void* arg = timer->Arg;
+            os_wheel_count--;
+            pthread_mutex_unlock(&os_alarm_lock);
+            callback(arg);
+            pthread_mutex_lock(&os_alarm_lock);
+            continue;
+        }
+
+        const Os_ActionType* actions = Os_Expire(timer, &count);
+
+        if (count != 0) {
+            pthread_mutex_unlock(&os_alarm_lock);
+            Os_RunActions(actions, count);
+            pthread_mutex_lock(&os_alarm_lock);
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Luồng timer
+ * @details Luồng ngủ đến nhịp tiếp theo bằng Os_SleepUntilNs và xử lý mọi
+ *          nhịp đã qua (nếu bị trễ). Khi không còn mốc nào, luồng chờ trên
+ *          biến điều kiện và không còn được tính là đang chạy cho đến khi có
+ *          mốc mới. Luồng kết thúc khi Os_Alarm_Stop được gọi. Luồng chạy
+ *          SCHED_FIFO với độ ưu tiên OS_CFG_TIMER_RT_PRIORITY nếu được phép.
+ * @param   arg     Không dùng
+ * @return 	None
+ **************************************************************************/
+static void* Os_Alarm_TimerMain(void* arg) {
+    (void)arg;
+
+#if (OS_CFG_TIMER_RT_PRIORITY > 0)
+    // Os_Start đã cảnh báo nếu tiến trình không được phép dùng SCHED_FIFO
+    struct sched_param param = {0};
+    param.sched_priority = OS_CFG_TIMER_RT_PRIORITY;
+    (void)pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+#endif
+
+    pthread_mutex_lock(&os_alarm_lock);
+    while (!os_timer_stop) {
+        while (os_wheel_count == 0 && !os_timer_stop) {
+            os_timer_idle = TRUE;
+            Os_TimeEndBusy();
+            while (os_timer_idle) {
+                pthread_cond_wait(&os_alarm_cond, &os_alarm_lock);
+            }
+        }
+        if (os_timer_stop) {
+            break;
+        }
+
+        uint64 wakeup_ns = os_timer_epoch_ns + os_wheel_next * OS_TIMER_TICK_NS;
+        pthread_mutex_unlock(&os_alarm_lock);
+
+        Os_SleepUntilNs(wakeup_ns);
+        uint64 now_tick = (Os_GetTimeNs() - os_timer_epoch_ns) / OS_TIMER_TICK_NS;
+
+        pthread_mutex_lock(&os_alarm_lock);
+        while (os_wheel_next <= now_tick && os_wheel_count != 0) {
+            Os_Wheel_Tick();
+        }
+        if (os_wheel_next <= now_tick) {
+            os_wheel_next = now_tick + 1U;
+        }
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+
+    Os_TimeEndBusy();
+    return NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo counter, alarm và schedule table (gọi từ Os_Init)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Alarm_Init(void) {
+    pthread_mutex_lock(&os_alarm_lock);
+    for (uint8 i = 0; i < OS_MAX_COUNTERS; i++) {
+        os_counters[i] = NULL_PTR;
+    }
+    for (uint16 i = 0; i < OS_MAX_ALARMS; i++) {
+        os_alarms[i].Config = NULL_PTR;
+        os_alarms[i].Timer.PPrev = NULL_PTR;
+    }
+    for (uint8 i = 0; i < OS_MAX_SCHEDULE_TABLES; i++) {
+        os_tables[i].Config = NULL_PTR;
+        os_tables[i].Timer.PPrev = NULL_PTR;
+    }
+    for (uint8 level = 0; level < OS_WHEEL_LEVELS; level++) {
+        for (uint32 slot = 0; slot < OS_WHEEL_SLOTS; slot++) {
+            os_wheel[level][slot] = NULL_PTR;
+        }
+    }
+    os_wheel_next = 1;
+    os_wheel_count = 0;
+    os_timer_needed = FALSE;
+    pthread_mutex_unlock(&os_alarm_lock);
+}
+
+/**************************************************************************
+ * @brief   Khởi động luồng timer nếu có counter được cấu hình hoặc có module
+ *          dùng Os_Timer (gọi từ Os_Start)
+ * @details Nhịp 0 được coi là đã xử lý, mốc hết hạn sớm nhất là nhịp 1. Vì
+ *          vậy Os_Start đặt nhịp 0 sớm hơn epoch chung của các task tuần
+ *          hoàn một nhịp để mốc tại epoch (độ lệch 0) hết hạn đúng lúc. Các
+ *          alarm đã đặt trước đó được tính từ nhịp 0.
+ * @param   EpochNs     Thời gian hệ thống ứng với nhịp 0
+ * @return 	None
+ **************************************************************************/
+void Os_Alarm_Start(uint64 EpochNs) {
+    boolean used = os_timer_needed;
+    for (uint8 i = 0; i < OS_MAX_COUNTERS; i++) {
+        if (os_counters[i] != NULL_PTR) {
+            used = TRUE;
+        }
+    }
+    if (!used || os_timer_started) {
+        return;
+    }
+
+    pthread_mutex_lock(&os_alarm_lock);
+    os_timer_epoch_ns = EpochNs;
+    os_timer_idle = FALSE;
+    os_timer_stop = FALSE;
+    os_timer_started = TRUE;
+    pthread_mutex_unlock(&os_alarm_lock);
+
+    LOG_INFO(OS, "Starting timer thread, tick %d us\n", OS_CFG_TIMER_TICK_US);
+    Os_TimeBeginBusy();
+    if (pthread_create(&os_timer_thread, NULL_PTR, Os_Alarm_TimerMain, NULL_PTR) != 0) {
+        Os_TimeEndBusy();
+        os_timer_started = FALSE;
+        LOG_ERROR(OS, "Error: Cannot create timer thread, alarms will not expire.\n");
+    }
+}
+
+/**************************************************************************
+ * @brief   Dừng luồng timer và chờ luồng kết thúc (gọi từ Os_Shutdown)
+ * @details Các mốc còn trong wheel không hết hạn nữa. Luồng đang chờ vì
+ *          wheel rỗng được đánh thức như khi có mốc mới.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Alarm_Stop(void) {
+    pthread_mutex_lock(&os_alarm_lock);
+    if (!os_timer_started) {
+        pthread_mutex_unlock(&os_alarm_lock);
+        return;
+    }
+    os_timer_stop = TRUE;
+    if (os_timer_idle) {
+        os_timer_idle = FALSE;
+        Os_TimeBeginBusy();
+        pthread_cond_signal(&os_alarm_cond);
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+
+    pthread_join(os_timer_thread, NULL_PTR);
+
+    pthread_mutex_lock(&os_alarm_lock);
+    os_timer_started = FALSE;
+    pthread_mutex_unlock(&os_alarm_lock);
+}
+
+/**************************************************************************
+ * @brief   Cấu hình một counter (gọi trước Os_Start)
+ * @param   CounterId       ID của counter
+ * @param   ConfigPtr       Con trỏ đến cấu hình của counter
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetupCounter(Os_CounterIdType CounterId, const Os_CounterConfigType* ConfigPtr) {
+    if (CounterId >= OS_MAX_COUNTERS || ConfigPtr == NULL_PTR || ConfigPtr->TicksPerBase == 0 ||
+        ConfigPtr->MaxAllowedValue == 0 || ConfigPtr->MinCycle > ConfigPtr->MaxAllowedValue || os_timer_started) {
+        LOG_ERROR(OS, "Error: Invalid counter configuration passed to Os_SetupCounter.\n");
+        return E_NOT_OK;
+    }
+
+    os_counters[CounterId] = ConfigPtr;
+    LOG_INFO(OS, "Counter %s: %d us per tick\n", ConfigPtr->Name,
+             ConfigPtr->TicksPerBase * OS_CFG_TIMER_TICK_US);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Cấu hình một alarm
+ * @param   AlarmId         ID của alarm
+ * @param   ConfigPtr       Con trỏ đến cấu hình của alarm
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetupAlarm(Os_AlarmIdType AlarmId, const Os_AlarmConfigType* ConfigPtr) {
+    if (AlarmId >= OS_MAX_ALARMS || ConfigPtr == NULL_PTR || ConfigPtr->Counter >= OS_MAX_COUNTERS ||
+        os_counters[ConfigPtr->Counter] == NULL_PTR || Os_CheckAction(&ConfigPtr->Action) != E_OK) {
+        LOG_ERROR(OS, "Error: Invalid alarm configuration passed to Os_SetupAlarm.\n");
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (os_alarms[AlarmId].Timer.PPrev == NULL_PTR) {
+        os_alarms[AlarmId].Config = ConfigPtr;
+        os_alarms[AlarmId].Timer.Owner = OS_TIMER_ALARM;
+        os_alarms[AlarmId].Timer.Id = AlarmId;
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Cấu hình một schedule table
+ * @param   TableId         ID của schedule table
+ * @param   ConfigPtr       Con trỏ đến cấu hình của schedule table
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetupScheduleTable(Os_ScheduleTableIdType TableId, const Os_ScheduleTableConfigType* ConfigPtr) {
+    if (TableId >= OS_MAX_SCHEDULE_TABLES || ConfigPtr == NULL_PTR || ConfigPtr->Counter >= OS_MAX_COUNTERS ||
+        os_counters[ConfigPtr->Counter] == NULL_PTR || ConfigPtr->ExpiryPoints == NULL_PTR ||
+        ConfigPtr->NumExpiryPoints == 0 || ConfigPtr->Duration == 0 ||
+        ConfigPtr->Duration > os_counters[ConfigPtr->Counter]->MaxAllowedValue) {
+        LOG_ERROR(OS, "Error: Invalid schedule table configuration passed to Os_SetupScheduleTable.\n");
+        return E_NOT_OK;
+    }
+
+    for (uint8 i = 0; i < ConfigPtr->NumExpiryPoints; i++) {
+        const Os_ExpiryPointType* point = &ConfigPtr->ExpiryPoints[i];
+        boolean valid = (point->Offset < ConfigPtr->Duration) &&
+                        (i == 0 || point->Offset > ConfigPtr->ExpiryPoints[i - 1].Offset) &&
+                        (point->NumActions == 0 || point->Actions != NULL_PTR);
+        for (uint8 k = 0; valid && k < point->NumActions; k++) {
+            valid = (Os_CheckAction(&point->Actions[k]) == E_OK) ? TRUE : FALSE;
+        }
+        if (!valid) {
+            LOG_ERROR(OS, "Error: Invalid expiry point %d in schedule table %d.\n", i, TableId);
+            return E_NOT_OK;
+        }
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (os_tables[TableId].Timer.PPrev == NULL_PTR) {
+        os_tables[TableId].Config = ConfigPtr;
+        os_tables[TableId].Timer.Owner = OS_TIMER_SCHEDULE_TABLE;
+        os_tables[TableId].Timer.Id = TableId;
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Đọc giá trị hiện tại của một counter
+ * @param   CounterId       ID của counter
+ * @param   ValuePtr        Con trỏ lưu giá trị của counter
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu counter chưa được cấu hình
+ **************************************************************************/
+Std_ReturnType Os_GetCounterValue(Os_CounterIdType CounterId, Os_TickType* ValuePtr) {
+    if (CounterId >= OS_MAX_COUNTERS || os_counters[CounterId] == NULL_PTR || ValuePtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    const Os_CounterConfigType* counter = os_counters[CounterId];
+    pthread_mutex_lock(&os_alarm_lock);
+    uint64 ticks = Os_Wheel_Now() / counter->TicksPerBase;
+    pthread_mutex_unlock(&os_alarm_lock);
+
+    *ValuePtr = (Os_TickType)(ticks % ((uint64)counter->MaxAllowedValue + 1U));
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Tính số tick đã trôi qua từ một giá trị trước đó của counter
+ * @param   CounterId       ID của counter
+ * @param   ValuePtr        Vào: giá trị trước đó, ra: giá trị hiện tại
+ * @param   ElapsedPtr      Con trỏ lưu số tick đã trôi qua (có tính quay vòng)
+ * @return 	Std_ReturnType  Trả về E_OK nếu tính thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_GetElapsedValue(Os_CounterIdType CounterId, Os_TickType* ValuePtr, Os_TickType* ElapsedPtr) {
+    Os_TickType now;
+    if (ValuePtr == NULL_PTR || ElapsedPtr == NULL_PTR || Os_GetCounterValue(CounterId, &now) != E_OK ||
+        *ValuePtr > os_counters[CounterId]->MaxAllowedValue) {
+        return E_NOT_OK;
+    }
+
+    uint64 modulo = (uint64)os_counters[CounterId]->MaxAllowedValue + 1U;
+    *ElapsedPtr = (Os_TickType)(((uint64)now + modulo - *ValuePtr) % modulo);
+    *ValuePtr = now;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đặt mốc hết hạn đầu tiên và chu kỳ của một alarm
+ * @param   AlarmId         ID của alarm
+ * @param   Absolute        TRUE: Value là giá trị counter, FALSE: số tick từ bây giờ
+ * @param   Value           Giá trị counter hoặc số tick
+ * @param   Cycle           Chu kỳ lặp lại (tick, 0: chỉ một lần)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu alarm đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+static Std_ReturnType Os_ArmAlarm(Os_AlarmIdType AlarmId, boolean Absolute, Os_TickType Value, Os_TickType Cycle) {
+    if (AlarmId >= OS_MAX_ALARMS || os_alarms[AlarmId].Config == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Os_AlarmType* alarm = &os_alarms[AlarmId];
+    const Os_CounterConfigType* counter = os_counters[alarm->Config->Counter];
+    if (Value > counter->MaxAllowedValue || (!Absolute && Value == 0) || Cycle > counter->MaxAllowedValue ||
+        (Cycle != 0 && Cycle < counter->MinCycle)) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (alarm->Timer.PPrev == NULL_PTR) {
+        uint64 modulo = (uint64)counter->MaxAllowedValue + 1U;
+        uint64 now = Os_Wheel_Now() / counter->TicksPerBase;
+        uint64 delta = Value;
+        if (Absolute) {
+            // Giá trị bằng giá trị hiện tại: hết hạn sau một vòng của counter
+            delta = ((uint64)Value + modulo - now % modulo) % modulo;
+            delta = (delta == 0) ? modulo : delta;
+        }
+        alarm->Timer.Expires = (now + delta) * counter->TicksPerBase;
+        alarm->CycleTicks = (uint64)Cycle * counter->TicksPerBase;
+        Os_Wheel_Add(&alarm->Timer);
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Đặt alarm hết hạn sau một số tick tính từ bây giờ
+ * @param   AlarmId         ID của alarm
+ * @param   Increment       Số tick đến lần hết hạn đầu tiên (tối thiểu 1)
+ * @param   Cycle           Chu kỳ lặp lại (tick, 0: chỉ một lần)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu alarm đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetRelAlarm(Os_AlarmIdType AlarmId, Os_TickType Increment, Os_TickType Cycle) {
+    return Os_ArmAlarm(AlarmId, FALSE, Increment, Cycle);
+}
+
+/**************************************************************************
+ * @brief   Đặt alarm hết hạn khi counter đạt một giá trị
+ * @param   AlarmId         ID của alarm
+ * @param   Start           Giá trị counter của lần hết hạn đầu tiên
+ * @param   Cycle           Chu kỳ lặp lại (tick, 0: chỉ một lần)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu alarm đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetAbsAlarm(Os_AlarmIdType AlarmId, Os_TickType Start, Os_TickType Cycle) {
+    return Os_ArmAlarm(AlarmId, TRUE, Start, Cycle);
+}
+
+/**************************************************************************
+ * @brief   Hủy một alarm
+ * @param   AlarmId         ID của alarm
+ * @return 	Std_ReturnType  Trả về E_OK nếu hủy thành công,
+ *                                 E_NOT_OK nếu alarm không chạy
+ **************************************************************************/
+Std_ReturnType Os_CancelAlarm(Os_AlarmIdType AlarmId) {
+    if (AlarmId >= OS_MAX_ALARMS) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (os_alarms[AlarmId].Timer.PPrev != NULL_PTR) {
+        Os_Wheel_Remove(&os_alarms[AlarmId].Timer);
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Đọc số tick còn lại đến lần hết hạn tiếp theo của alarm
+ * @param   AlarmId         ID của alarm
+ * @param   TicksPtr        Con trỏ lưu số tick còn lại
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu alarm không chạy
+ **************************************************************************/
+Std_ReturnType Os_GetAlarm(Os_AlarmIdType AlarmId, Os_TickType* TicksPtr) {
+    if (AlarmId >= OS_MAX_ALARMS || os_alarms[AlarmId].Config == NULL_PTR || TicksPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Os_AlarmType* alarm = &os_alarms[AlarmId];
+    uint64 ticksPerBase = os_counters[alarm->Config->Counter]->TicksPerBase;
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (alarm->Timer.PPrev != NULL_PTR) {
+        uint64 now = Os_Wheel_Now() / ticksPerBase;
+        uint64 expires = alarm->Timer.Expires / ticksPerBase;
+        *TicksPtr = (Os_TickType)((expires > now) ? (expires - now) : 0U);
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Bắt đầu một schedule table
+ * @param   TableId         ID của schedule table
+ * @param   Absolute        TRUE: Value là giá trị counter, FALSE: số tick từ bây giờ
+ * @param   Value           Giá trị counter hoặc số tick
+ * @return 	Std_ReturnType  Trả về E_OK nếu bắt đầu thành công,
+ *                                 E_NOT_OK nếu bảng đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+static Std_ReturnType Os_StartTable(Os_ScheduleTableIdType TableId, boolean Absolute, Os_TickType Value) {
+    if (TableId >= OS_MAX_SCHEDULE_TABLES || os_tables[TableId].Config == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    Os_ScheduleTableType* table = &os_tables[TableId];
+    const Os_CounterConfigType* counter = os_counters[table->Config->Counter];
+    if (Value > counter->MaxAllowedValue || (!Absolute && Value == 0)) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (table->Timer.PPrev == NULL_PTR) {
+        uint64 modulo = (uint64)counter->MaxAllowedValue + 1U;
+        uint64 now = Os_Wheel_Now() / counter->TicksPerBase;
+        uint64 delta = Value;
+        if (Absolute) {
+            delta = ((uint64)Value + modulo - now % modulo) % modulo;
+            delta = (delta == 0) ? modulo : delta;
+        }
+        table->CycleStart = now + delta;
+        table->NextPoint = 0;
+        table->Timer.Expires = (table->CycleStart + table->Config->ExpiryPoints[0].Offset) * counter->TicksPerBase;
+        Os_Wheel_Add(&table->Timer);
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Bắt đầu schedule table sau một số tick tính từ bây giờ
+ * @param   TableId         ID của schedule table
+ * @param   Offset          Số tick từ bây giờ đến lúc bắt đầu chu kỳ đầu tiên
+ * @return 	Std_ReturnType  Trả về E_OK nếu bắt đầu thành công,
+ *                                 E_NOT_OK nếu bảng đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_StartScheduleTableRel(Os_ScheduleTableIdType TableId, Os_TickType Offset) {
+    return Os_StartTable(TableId, FALSE, Offset);
+}
+
+/**************************************************************************
+ * @brief   Bắt đầu schedule table khi counter đạt một giá trị
+ * @param   TableId         ID của schedule table
+ * @param   Start           Giá trị counter lúc bắt đầu chu kỳ đầu tiên
+ * @return 	Std_ReturnType  Trả về E_OK nếu bắt đầu thành công,
+ *                                 E_NOT_OK nếu bảng đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_StartScheduleTableAbs(Os_ScheduleTableIdType TableId, Os_TickType Start) {
+    return Os_StartTable(TableId, TRUE, Start);
+}
+
+/**************************************************************************
+ * @brief   Dừng schedule table
+ * @param   TableId         ID của schedule table
+ * @return 	Std_ReturnType  Trả về E_OK nếu dừng thành công,
+ *                                 E_NOT_OK nếu bảng không chạy
+ **************************************************************************/
+Std_ReturnType Os_StopScheduleTable(Os_ScheduleTableIdType TableId) {
+    if (TableId >= OS_MAX_SCHEDULE_TABLES) {
+        return E_NOT_OK;
+    }
+
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (os_tables[TableId].Timer.PPrev != NULL_PTR) {
+        Os_Wheel_Remove(&os_tables[TableId].Timer);
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Đọc trạng thái của schedule table
+ * @param   TableId         ID của schedule table
+ * @param   StatusPtr       Con trỏ lưu trạng thái
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu bảng chưa được cấu hình
+ **************************************************************************/
+Std_ReturnType Os_GetScheduleTableStatus(Os_ScheduleTableIdType TableId, Os_ScheduleTableStatusType* StatusPtr) {
+    if (TableId >= OS_MAX_SCHEDULE_TABLES || os_tables[TableId].Config == NULL_PTR || StatusPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    pthread_mutex_lock(&os_alarm_lock);
+    *StatusPtr = (os_tables[TableId].Timer.PPrev != NULL_PTR) ? OS_SCHEDULETABLE_RUNNING : OS_SCHEDULETABLE_STOPPED;
+    pthread_mutex_unlock(&os_alarm_lock);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo một mốc hết hạn dùng hàm callback
+ * @details Gọi trước Os_Start, luồng timer được khởi động nếu có mốc được
+ *          khởi tạo.
+ * @param   Timer           Mốc hết hạn cần khởi tạo
+ * @param   Expired         Hàm được gọi khi hết hạn (trong luồng timer, phải ngắn)
+ * @param   Arg             Tham số của hàm callback
+ * @return 	None
+ **************************************************************************/
+void Os_Timer_Init(Os_TimerType* Timer, void (*Expired)(void* Arg), void* Arg) {
+    pthread_mutex_lock(&os_alarm_lock);
+    Timer->Next = NULL_PTR;
+    Timer->PPrev = NULL_PTR;
+    Timer->Owner = OS_TIMER_CALLBACK;
+    Timer->Id = 0;
+    Timer->Expired = Expired;
+    Timer->Arg = Arg;
+    os_timer_needed = TRUE;
+    pthread_mutex_unlock(&os_alarm_lock);
+}
+
+/**************************************************************************
+ * @brief   Đặt mốc hết hạn tại một thời điểm tuyệt đối
+ * @details Mốc được làm tròn lên nhịp tiếp theo của luồng timer, mốc đã qua
+ *          hết hạn ở nhịp tiếp theo.
+ * @param   Timer           Mốc hết hạn (đã khởi tạo bằng Os_Timer_Init)
+ * @param   WakeupNs        Thời gian hệ thống cần hết hạn (nano giây)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu mốc đang chờ hết hạn
+ **************************************************************************/
+Std_ReturnType Os_Timer_StartAbs(Os_TimerType* Timer, uint64 WakeupNs) {
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (Timer->PPrev == NULL_PTR) {
+        uint64 now = Os_Wheel_Now();
+        uint64 tick = (WakeupNs > os_timer_epoch_ns) ?
+                      (WakeupNs - os_timer_epoch_ns + OS_TIMER_TICK_NS - 1U) / OS_TIMER_TICK_NS : 0U;
+        Timer->Expires = (tick > now) ? tick : now + 1U;
+        Os_Wheel_Add(Timer);
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Hủy một mốc hết hạn
+ * @param   Timer           Mốc hết hạn
+ * @return 	Std_ReturnType  Trả về E_OK nếu hủy thành công,
+ *                                 E_NOT_OK nếu mốc không chờ hết hạn
+ **************************************************************************/
+Std_ReturnType Os_Timer_Cancel(Os_TimerType* Timer) {
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&os_alarm_lock);
+    if (Timer->PPrev != NULL_PTR) {
+        Os_Wheel_Remove(Timer);
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&os_alarm_lock);
+    return ret;
+}
@@ -0,0 +1,314 @@
+/***************************************************************************
+ * @file    Os_Alarm.h
+ * @brief   Khai báo counter, alarm và schedule table của OS
+ * @details File này cung cấp counter, alarm và schedule table theo OSEK/
+ *          AUTOSAR OS. Tất cả được phục vụ bởi một luồng timer duy nhất chạy
+ *          theo nhịp OS_CFG_TIMER_TICK_US, các mốc hết hạn được lưu trong một
+ *          timer wheel phân cấp nên mỗi nhịp chỉ tốn một lần đánh thức dù có
+ *          bao nhiêu alarm đang chạy.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef OS_ALARM_H
+#define OS_ALARM_H
+
+#include "Os.h"
+
+/**************************************************************************
+ * @brief Chu kỳ nhịp của luồng timer (us), là độ phân giải nhỏ nhất của
+ *        mọi counter
+ **************************************************************************/
+#ifndef OS_CFG_TIMER_TICK_US
+#define OS_CFG_TIMER_TICK_US            1000
+#endif
+
+/**************************************************************************
+ * @brief Độ ưu tiên SCHED_FIFO của luồng timer, cao hơn mọi task để việc
+ *        kích hoạt task tuần hoàn không bị task đang chạy làm trễ (0: không
+ *        dùng SCHED_FIFO)
+ **************************************************************************/
+#ifndef OS_CFG_TIMER_RT_PRIORITY
+#define OS_CFG_TIMER_RT_PRIORITY        90
+#endif
+
+/**************************************************************************
+ * @brief Số counter, alarm và schedule table tối đa
+ **************************************************************************/
+#define OS_MAX_COUNTERS                 4
+#define OS_MAX_ALARMS                   256
+#define OS_MAX_SCHEDULE_TABLES          8
+
+/**************************************************************************
+ * @typedef Os_CounterIdType, Os_AlarmIdType, Os_ScheduleTableIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của counter, alarm và schedule table
+ **************************************************************************/
+typedef uint8 Os_CounterIdType;
+typedef uint16 Os_AlarmIdType;
+typedef uint8 Os_ScheduleTableIdType;
+
+/**************************************************************************
+ * @typedef Os_TickType
+ * @brief   Định nghĩa kiểu dữ liệu cho giá trị của counter (tick)
+ **************************************************************************/
+typedef uint32 Os_TickType;
+
+/**************************************************************************
+ * @struct  Os_CounterConfigType
+ * @brief   Cấu trúc cấu hình của một counter
+ * @details Counter tăng 1 sau mỗi TicksPerBase nhịp của luồng timer và quay
+ *          về 0 sau MaxAllowedValue.
+ **************************************************************************/
+typedef struct {
+    const char* Name;               /* Tên của counter */
+    uint32 TicksPerBase;            /* Số nhịp timer cho mỗi tick của counter (tối thiểu 1) */
+    Os_TickType MaxAllowedValue;    /* Giá trị lớn nhất của counter */
+    Os_TickType MinCycle;           /* Chu kỳ nhỏ nhất được phép của alarm tuần hoàn (tick) */
+} Os_CounterConfigType;
+
+/**************************************************************************
+ * @enum    Os_ActionKindType
+ * @brief   Định nghĩa loại hành động khi alarm hoặc expiry point hết hạn
+ **************************************************************************/
+typedef enum {
+    OS_ACTION_ACTIVATE_TASK = 0,    /* Kích hoạt một task theo sự kiện */
+    OS_ACTION_SET_EVENT = 1,        /* Đặt sự kiện cho một extended task */
+    OS_ACTION_CALLBACK = 2          /* Gọi một hàm (trong luồng timer, phải ngắn) */
+} Os_ActionKindType;
+
+/**************************************************************************
+ * @struct  Os_ActionType
+ * @brief   Cấu trúc một hành động khi alarm hoặc expiry point hết hạn
+ **************************************************************************/
+typedef struct {
+    Os_ActionKindType Kind;         /* Loại hành động */
+    Os_TaskIdType TaskId;           /* Task cần kích hoạt hoặc đặt sự kiện */
+    Os_EventMaskType Event;         /* Sự kiện cần đặt (OS_ACTION_SET_EVENT) */
+    void (*Callback)(void);         /* Hàm cần gọi (OS_ACTION_CALLBACK) */
+} Os_ActionType;
+
+/**************************************************************************
+ * @struct  Os_AlarmConfigType
+ * @brief   Cấu trúc cấu hình của một alarm
+ **************************************************************************/
+typedef struct {
+    Os_CounterIdType Counter;       /* Counter điều khiển alarm */
+    Os_ActionType Action;           /* Hành động khi alarm hết hạn */
+} Os_AlarmConfigType;
+
+/**************************************************************************
+ * @struct  Os_ExpiryPointType
+ * @brief   Cấu trúc một expiry point của schedule table
+ **************************************************************************/
+typedef struct {
+    Os_TickType Offset;             /* Độ lệch so với lúc bắt đầu chu kỳ của bảng (tick) */
+    const Os_ActionType* Actions;   /* Các hành động tại expiry point */
+    uint8 NumActions;               /* Số hành động */
+} Os_ExpiryPointType;
+
+/**************************************************************************
+ * @struct  Os_ScheduleTableConfigType
+ * @brief   Cấu trúc cấu hình của một schedule table
+ * @details Các expiry point phải có Offset tăng dần và nhỏ hơn Duration.
+ **************************************************************************/
+typedef struct {
+    Os_CounterIdType Counter;               /* Counter điều khiển bảng */
+    Os_TickType Duration;                   /* Độ dài một chu kỳ của bảng (tick) */
+    boolean Repeating;                      /* TRUE: bắt đầu lại sau Duration */
+    const Os_ExpiryPointType* ExpiryPoints; /* Các expiry point */
+    uint8 NumExpiryPoints;                  /* Số expiry point (tối thiểu 1) */
+} Os_ScheduleTableConfigType;
+
+/**************************************************************************
+ * @enum    Os_ScheduleTableStatusType
+ * @brief   Định nghĩa trạng thái của một schedule table
+ **************************************************************************/
+typedef enum {
+    OS_SCHEDULETABLE_STOPPED = 0,   /* Bảng không chạy */
+    OS_SCHEDULETABLE_RUNNING = 1    /* Bảng đang chạy */
+} Os_ScheduleTableStatusType;
+
+/**************************************************************************
+ * @struct  Os_TimerType
+ * @brief   Định nghĩa một mốc hết hạn trong timer wheel
+ * @details Phần tử của danh sách liên kết đôi được nhúng trong alarm,
+ *          schedule table và đối tượng của các module khác trong OS nên
+ *          timer wheel không cần cấp phát bộ nhớ. Các trường chỉ được truy
+ *          cập bởi Os_Alarm.c.
+ **************************************************************************/
+typedef struct Os_TimerType {
+    uint64 Expires;                 /* Nhịp hết hạn tuyệt đối */
+    struct Os_TimerType* Next;      /* Phần tử tiếp theo trong ô */
+    struct Os_TimerType** PPrev;    /* Con trỏ đang trỏ đến phần tử này (NULL_PTR: không nằm trong wheel) */
+    uint8 Owner;                    /* Loại đối tượng sở hữu */
+    uint16 Id;                      /* ID của alarm hoặc schedule table */
+    void (*Expired)(void* Arg);     /* Hàm được gọi khi hết hạn (mốc của module khác) */
+    void* Arg;                      /* Tham số của hàm Expired */
+} Os_TimerType;
+
+/**************************************************************************
+ * @brief   Khởi tạo counter, alarm và schedule table (gọi từ Os_Init)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Alarm_Init(void);
+
+/**************************************************************************
+ * @brief   Khởi động luồng timer nếu có counter được cấu hình hoặc có module
+ *          dùng Os_Timer (gọi từ Os_Start)
+ * @param   EpochNs     Thời gian hệ thống ứng với nhịp 0
+ * @return 	None
+ **************************************************************************/
+void Os_Alarm_Start(uint64 EpochNs);
+
+/**************************************************************************
+ * @brief   Dừng luồng timer và chờ luồng kết thúc (gọi từ Os_Shutdown)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Alarm_Stop(void);
+
+/**************************************************************************
+ * @brief   Khởi tạo một mốc hết hạn dùng hàm callback (dùng trong OS)
+ * @param   Timer           Mốc hết hạn cần khởi tạo
+ * @param   Expired         Hàm được gọi khi hết hạn (trong luồng timer, phải ngắn)
+ * @param   Arg             Tham số của hàm callback
+ * @return 	None
+ **************************************************************************/
+void Os_Timer_Init(Os_TimerType* Timer, void (*Expired)(void* Arg), void* Arg);
+
+/**************************************************************************
+ * @brief   Đặt mốc hết hạn tại một thời điểm tuyệt đối (dùng trong OS)
+ * @param   Timer           Mốc hết hạn (đã khởi tạo bằng Os_Timer_Init)
+ * @param   WakeupNs        Thời gian hệ thống cần hết hạn (nano giây)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu mốc đang chờ hết hạn
+ **************************************************************************/
+Std_ReturnType Os_Timer_StartAbs(Os_TimerType* Timer, uint64 WakeupNs);
+
+/**************************************************************************
+ * @brief   Hủy một mốc hết hạn (dùng trong OS)
+ * @param   Timer           Mốc hết hạn
+ * @return 	Std_ReturnType  Trả về E_OK nếu hủy thành công,
+ *                                 E_NOT_OK nếu mốc không chờ hết hạn
+ **************************************************************************/
+Std_ReturnType Os_Timer_Cancel(Os_TimerType* Timer);
+
+/**************************************************************************
+ * @brief   Cấu hình một counter (gọi trước Os_Start)
+ * @param   CounterId       ID của counter
+ * @param   ConfigPtr       Con trỏ đến cấu hình của counter
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetupCounter(Os_CounterIdType CounterId, const Os_CounterConfigType* ConfigPtr);
+
+/**************************************************************************
+ * @brief   Cấu hình một alarm
+ * @param   AlarmId         ID của alarm
+ * @param   ConfigPtr       Con trỏ đến cấu hình của alarm
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetupAlarm(Os_AlarmIdType AlarmId, const Os_AlarmConfigType* ConfigPtr);
+
+/**************************************************************************
+ * @brief   Cấu hình một schedule table
+ * @param   TableId         ID của schedule table
+ * @param   ConfigPtr       Con trỏ đến cấu hình của schedule table
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetupScheduleTable(Os_ScheduleTableIdType TableId, const Os_ScheduleTableConfigType* ConfigPtr);
+
+/**************************************************************************
+ * @brief   Đọc giá trị hiện tại của một counter
+ * @param   CounterId       ID của counter
+ * @param   ValuePtr        Con trỏ lưu giá trị của counter
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu counter chưa được cấu hình
+ **************************************************************************/
+Std_ReturnType Os_GetCounterValue(Os_CounterIdType CounterId, Os_TickType* ValuePtr);
+
+/**************************************************************************
+ * @brief   Tính số tick đã trôi qua từ một giá trị trước đó của counter
+ * @param   CounterId       ID của counter
+ * @param   ValuePtr        Vào: giá trị trước đó, ra: giá trị hiện tại
+ * @param   ElapsedPtr      Con trỏ lưu số tick đã trôi qua (có tính quay vòng)
+ * @return 	Std_ReturnType  Trả về E_OK nếu tính thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_GetElapsedValue(Os_CounterIdType CounterId, Os_TickType* ValuePtr, Os_TickType* ElapsedPtr);
+
+/**************************************************************************
+ * @brief   Đặt alarm hết hạn sau một số tick tính từ bây giờ
+ * @param   AlarmId         ID của alarm
+ * @param   Increment       Số tick đến lần hết hạn đầu tiên (tối thiểu 1)
+ * @param   Cycle           Chu kỳ lặp lại (tick, 0: chỉ một lần)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu alarm đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetRelAlarm(Os_AlarmIdType AlarmId, Os_TickType Increment, Os_TickType Cycle);
+
+/**************************************************************************
+ * @brief   Đặt alarm hết hạn khi counter đạt một giá trị
+ * @param   AlarmId         ID của alarm
+ * @param   Start           Giá trị counter của lần hết hạn đầu tiên
+ * @param   Cycle           Chu kỳ lặp lại (tick, 0: chỉ một lần)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu alarm đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetAbsAlarm(Os_AlarmIdType AlarmId, Os_TickType Start, Os_TickType Cycle);
+
+/**************************************************************************
+ * @brief   Hủy một alarm
+ * @param   AlarmId         ID của alarm
+ * @return 	Std_ReturnType  Trả về E_OK nếu hủy thành công,
+ *                                 E_NOT_OK nếu alarm không chạy
+ **************************************************************************/
+Std_ReturnType Os_CancelAlarm(Os_AlarmIdType AlarmId);
+
+/**************************************************************************
+ * @brief   Đọc số tick còn lại đến lần hết hạn tiếp theo của alarm
+ * @param   AlarmId         ID của alarm
+ * @param   TicksPtr        Con trỏ lưu số tick còn lại
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu alarm không chạy
+ **************************************************************************/
+Std_ReturnType Os_GetAlarm(Os_AlarmIdType AlarmId, Os_TickType* TicksPtr);
+
+/**************************************************************************
+ * @brief   Bắt đầu schedule table sau một số tick tính từ bây giờ
+ * @param   TableId         ID của schedule table
+ * @param   Offset          Số tick từ bây giờ đến lúc bắt đầu chu kỳ đầu tiên
+ * @return 	Std_ReturnType  Trả về E_OK nếu bắt đầu thành công,
+ *                                 E_NOT_OK nếu bảng đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_StartScheduleTableRel(Os_ScheduleTableIdType TableId, Os_TickType Offset);
+
+/**************************************************************************
+ * @brief   Bắt đầu schedule table khi counter đạt một giá trị
+ * @param   TableId         ID của schedule table
+ * @param   Start           Giá trị counter lúc bắt đầu chu kỳ đầu tiên
+ * @return 	Std_ReturnType  Trả về E_OK nếu bắt đầu thành công,
+ *                                 E_NOT_OK nếu bảng đang chạy hoặc tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_StartScheduleTableAbs(Os_ScheduleTableIdType TableId, Os_TickType Start);
+
+/**************************************************************************
+ * @brief   Dừng schedule table
+ * @param   TableId         ID của schedule table
+ * @return 	Std_ReturnType  Trả về E_OK nếu dừng thành công,
+ *                                 E_NOT_OK nếu bảng không chạy
+ **************************************************************************/
+Std_ReturnType Os_StopScheduleTable(Os_ScheduleTableIdType TableId);
+
+/**************************************************************************
+ * @brief   Đọc trạng thái của schedule table
+ * @param   TableId         ID của schedule table
+ * @param   StatusPtr       Con trỏ lưu trạng thái
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu bảng chưa được cấu hình
+ **************************************************************************/
+Std_ReturnType Os_GetScheduleTableStatus(Os_ScheduleTableIdType TableId, Os_ScheduleTableStatusType* StatusPtr);
+
+#endif /* OS_ALARM_H */
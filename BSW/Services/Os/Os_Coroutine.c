@@ -0,0 +1,460 @@
+/***************************************************************************
+ * @file    Os_Coroutine.c
+ * @brief   Định nghĩa runnable dạng coroutine không stack của OS
+ * @details File này triển khai nhóm luồng worker, mỗi worker có một hàng
+ *          đợi runnable sẵn sàng riêng và được ghim lên một core. Runnable
+ *          được gán cố định cho một worker khi đăng ký nên không bao giờ di
+ *          chuyển giữa các core. Độ trễ và mốc kích hoạt tuần hoàn đi qua
+ *          timer wheel của luồng timer (Os_Timer), sự kiện và kích hoạt từ
+ *          hàm thông báo chỉ đưa runnable vào hàng đợi của worker.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         // pthread_setaffinity_np, CPU_SET
+#endif
+#include "Os_Coroutine.h"
+#include "Os_Alarm.h"
+#include <sched.h>
+#include "Log.h"
+#include "Mem.h"
+
+#define OS_CO_NS_PER_MS     1000000ULL
+#define OS_CO_CORE_NONE     0xFFU       /* Worker không được ghim lên core nào */
+
+/**************************************************************************
+ * @enum    Os_CoStateType
+ * @brief   Định nghĩa trạng thái của một runnable dạng coroutine
+ **************************************************************************/
+typedef enum {
+    OS_CO_STATE_IDLE = 0,       /* Không có lần kích hoạt nào (runnable theo sự kiện) */
+    OS_CO_STATE_READY = 1,      /* Đang nằm trong hàng đợi của worker */
+    OS_CO_STATE_RUNNING = 2,    /* Worker đang chạy một bước của runnable */
+    OS_CO_STATE_DELAYED = 3,    /* Chờ mốc thời gian (độ trễ hoặc lần kích hoạt tiếp theo) */
+    OS_CO_STATE_WAITING = 4     /* Chờ sự kiện */
+} Os_CoStateType;
+
+struct Os_CoWorkerType;
+
+/**************************************************************************
+ * @struct  Os_CoInstanceType
+ * @brief   Cấu trúc lưu trạng thái nội bộ của một runnable dạng coroutine
+ * @details State, Activations và Next được bảo vệ bởi khóa của worker.
+ **************************************************************************/
+typedef struct Os_CoInstanceType {
+    Os_CoRunnableConfigType Config;     /* Cấu hình của runnable */
+    Os_CoContextType Context;           /* Ngữ cảnh được truyền cho runnable */
+    Os_TimerType Timer;                 /* Mốc hết chờ hoặc mốc kích hoạt tiếp theo */
+    struct Os_CoWorkerType* Worker;     /* Worker chạy runnable */
+    struct Os_CoInstanceType* Next;     /* Phần tử tiếp theo trong hàng đợi sẵn sàng */
+    Os_CoStateType State;               /* Trạng thái */
+    uint8 Activations;                  /* Số lần kích hoạt đang chờ, kể cả lần đang chạy */
+    uint64 ReleaseNs;                   /* Mốc kích hoạt hiện tại (runnable tuần hoàn) */
+} Os_CoInstanceType;
+
+/**************************************************************************
+ * @struct  Os_CoWorkerType
+ * @brief   Cấu trúc lưu trạng thái của một luồng worker
+ **************************************************************************/
+typedef struct Os_CoWorkerType {
+    pthread_t Thread;
+    pthread_mutex_t Lock;               /* Bảo vệ hàng đợi và trạng thái của các runnable */
+    pthread_cond_t Cond;                /* Đánh thức worker khi hàng đợi có runnable */
+    Os_CoInstanceType* Head;            /* Đầu hàng đợi sẵn sàng */
+    Os_CoInstanceType* Tail;            /* Cuối hàng đợi sẵn sàng */
+    boolean Idle;                       /* Worker đang chờ vì hàng đợi rỗng */
+    boolean Started;                    /* Luồng worker đã được tạo */
+    boolean Stop;                       /* Worker cần kết thúc (Os_Co_Stop) */
+    uint8 Core;                         /* Core được ghim (OS_CO_CORE_NONE: không ghim) */
+    uint16 RunnableCount;               /* Số runnable được gán */
+    Mem_ArenaType Scratch;              /* Vùng nhớ tạm, reset sau mỗi bước */
+} Os_CoWorkerType;
+
+static Os_CoInstanceType os_co_runnables[OS_CO_MAX_RUNNABLES];
+static uint16 os_co_count = 0;
+static Os_CoWorkerType os_co_workers[OS_CO_MAX_WORKERS];
+static uint8 os_co_worker_count = 0;
+
+/**************************************************************************
+ * @brief   Đưa runnable vào cuối hàng đợi của worker (gọi khi giữ khóa worker)
+ * @details Phía đánh thức gọi Os_TimeBeginBusy cho worker đang chờ để ở chế
+ *          độ DISCRETE thời gian hệ thống không nhảy khi runnable chưa chạy.
+ * @param   inst    Runnable cần đưa vào hàng đợi
+ * @return 	None
+ **************************************************************************/
+static void Os_Co_PushLocked(Os_CoInstanceType* inst) {
+    Os_CoWorkerType* worker = inst->Worker;
+    inst->State = OS_CO_STATE_READY;
+    inst->Next = NULL_PTR;
+    if (worker->Tail == NULL_PTR) {
+        worker->Head = inst;
+    } else {
+        worker->Tail->Next = inst;
+    }
+    worker->Tail = inst;
+
+    if (worker->Idle) {
+        worker->Idle = FALSE;
+        Os_TimeBeginBusy();
+        pthread_cond_signal(&worker->Cond);
+    }
+}
+
+/**************************************************************************
+ * @brief   Hàm được luồng timer gọi khi mốc của runnable hết hạn
+ * @param   arg     Con trỏ đến Os_CoInstanceType của runnable
+ * @return 	None
+ **************************************************************************/
+static void Os_Co_TimerExpired(void* arg) {
+    Os_CoInstanceType* inst = (Os_CoInstanceType*)arg;
+    pthread_mutex_lock(&inst->Worker->Lock);
+    if (inst->State == OS_CO_STATE_DELAYED) {
+        Os_Co_PushLocked(inst);
+    }
+    pthread_mutex_unlock(&inst->Worker->Lock);
+}
+
+/**************************************************************************
+ * @brief   Xử lý runnable vừa chạy xong một lần kích hoạt (gọi khi giữ khóa worker)
+ * @details Runnable tuần hoàn chờ mốc kích hoạt tiếp theo, tính từ mốc trước
+ *          nên chu kỳ không bị trôi, các mốc đã lỡ bị bỏ qua. Runnable theo
+ *          sự kiện chạy tiếp nếu còn lần kích hoạt đang chờ.
+ * @param   inst    Runnable vừa chạy xong
+ * @return 	None
+ **************************************************************************/
+static void Os_Co_FinishLocked(Os_CoInstanceType* inst) {
+    if (inst->Config.PeriodMs == 0) {
+        inst->Activations--;
+        if (inst->Activations > 0) {
+            Os_Co_PushLocked(inst);
+        } else {
+            inst->State = OS_CO_STATE_IDLE;
+        }
+        return;
+    }
+
+    uint64 period_ns = (uint64)inst->Config.PeriodMs * OS_CO_NS_PER_MS;
+    uint64 now_ns = Os_GetTimeNs();
+    inst->ReleaseNs += period_ns;
+    while (now_ns >= inst->ReleaseNs) {
+        inst->ReleaseNs += period_ns;
+    }
+    inst->State = OS_CO_STATE_DELAYED;
+    Os_Timer_StartAbs(&inst->Timer, inst->ReleaseNs);
+}
+
+/**************************************************************************
+ * @brief   Luồng worker
+ * @details Worker lấy runnable ở đầu hàng đợi, chạy một bước (đến điểm chờ
+ *          tiếp theo) ngoài khóa rồi xếp runnable theo kết quả của bước.
+ *          Các sự kiện của runnable được xóa khi bắt đầu một lần kích hoạt.
+ *          Khi hàng đợi rỗng, worker chờ trên biến điều kiện và không còn
+ *          được tính là đang chạy. Worker kết thúc khi Os_Co_Stop được gọi,
+ *          các runnable còn trong hàng đợi không được chạy nữa.
+ * @param   arg     Con trỏ đến Os_CoWorkerType của worker
+ * @return 	None
+ **************************************************************************/
+static void* Os_Co_WorkerMain(void* arg) {
+    Os_CoWorkerType* worker = (Os_CoWorkerType*)arg;
+
+#ifdef __linux__
+    if (worker->Core != OS_CO_CORE_NONE) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(worker->Core, &cpus);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+            LOG_WARN(OS, "Coroutine worker cannot pin to core %d\n", worker->Core);
+        }
+    }
+#endif
+    Mem_Arena_Bind(&worker->Scratch);
+
+    pthread_mutex_lock(&worker->Lock);
+    while (!worker->Stop) {
+        while (worker->Head == NULL_PTR && !worker->Stop) {
+            worker->Idle = TRUE;
+            Os_TimeEndBusy();
+            while (worker->Idle) {
+                pthread_cond_wait(&worker->Cond, &worker->Lock);
+            }
+        }
+        if (worker->Stop) {
+            break;
+        }
+
+        Os_CoInstanceType* inst = worker->Head;
+        worker->Head = inst->Next;
+        if (worker->Head == NULL_PTR) {
+            worker->Tail = NULL_PTR;
+        }
+        inst->State = OS_CO_STATE_RUNNING;
+        if (inst->Context.Line == 0) {
+            atomic_store(&inst->Context.Events, 0);
+        }
+        pthread_mutex_unlock(&worker->Lock);
+
+        Os_CoStatusType status = inst->Config.Runnable(&inst->Context);
+        Mem_Arena_Reset(&worker->Scratch);
+
+        pthread_mutex_lock(&worker->Lock);
+        switch (status) {
+        case OS_CO_YIELDED:
+            Os_Co_PushLocked(inst);
+            break;
+        case OS_CO_DELAYED:
+            inst->State = OS_CO_STATE_DELAYED;
+            Os_Timer_StartAbs(&inst->Timer, inst->Context.WakeupNs);
+            break;
+        case OS_CO_WAITING:
+            // Sự kiện đã được đặt trong lúc runnable chạy: chạy tiếp ngay
+            if ((atomic_load(&inst->Context.Events) & inst->Context.WaitMask) != 0) {
+                Os_Co_PushLocked(inst);
+            } else {
+                inst->State = OS_CO_STATE_WAITING;
+            }
+            break;
+        default:
+            inst->Context.Line = 0;
+            Os_Co_FinishLocked(inst);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&worker->Lock);
+
+    Os_TimeEndBusy();
+    return NULL_PTR;
+}
+
+/**************************************************************************
+ * @brief   Đọc số core đang chạy
+ * @param   None
+ * @return 	uint32  Số core đang chạy (1 nếu hệ điều hành không cho biết)
+ **************************************************************************/
+static uint32 Os_Co_OnlineCores(void) {
+    long cores = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+    cores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (cores < 1) {
+        cores = 1;
+    } else if (cores > 64) {
+        cores = 64;     // Giới hạn của OS_CFG_CO_ISOLATED_CORE_MASK
+    }
+    return (uint32)cores;
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo chế độ runnable dạng coroutine (gọi từ Os_Init)
+ * @details Số worker là OS_CFG_CO_WORKERS, hoặc bằng số core đang chạy không
+ *          nằm trong OS_CFG_CO_ISOLATED_CORE_MASK. Worker được ghim lần lượt
+ *          lên các core đó, nếu mọi core đều bị cách ly thì worker không được
+ *          ghim.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Co_Init(void) {
+    uint8 usable[OS_CO_MAX_WORKERS];
+    uint8 usable_count = 0;
+    uint32 online = Os_Co_OnlineCores();
+
+    for (uint32 core = 0; core < online && usable_count < OS_CO_MAX_WORKERS; core++) {
+        if ((OS_CFG_CO_ISOLATED_CORE_MASK & (1ULL << core)) == 0) {
+            usable[usable_count++] = (uint8)core;
+        }
+    }
+
+    long workers = (OS_CFG_CO_WORKERS > 0) ? OS_CFG_CO_WORKERS : usable_count;
+    if (workers < 1) {
+        workers = 1;
+    } else if (workers > OS_CO_MAX_WORKERS) {
+        workers = OS_CO_MAX_WORKERS;
+    }
+
+    os_co_count = 0;
+    os_co_worker_count = (uint8)workers;
+    for (uint8 i = 0; i < os_co_worker_count; i++) {
+        Os_CoWorkerType* worker = &os_co_workers[i];
+        pthread_mutex_init(&worker->Lock, NULL_PTR);
+        pthread_cond_init(&worker->Cond, NULL_PTR);
+        worker->Head = NULL_PTR;
+        worker->Tail = NULL_PTR;
+        worker->Idle = FALSE;
+        worker->Started = FALSE;
+        worker->Stop = FALSE;
+        worker->Core = (usable_count != 0) ? usable[i % usable_count] : OS_CO_CORE_NONE;
+        worker->RunnableCount = 0;
+    }
+}
+
+/**************************************************************************
+ * @brief   Khởi động các luồng worker nếu có runnable (gọi từ Os_Start)
+ * @details Gọi sau Os_Alarm_Start. Lần kích hoạt đầu tiên của runnable tuần
+ *          hoàn là EpochNs + OffsetMs. Các worker được tính là đang chạy từ
+ *          trước khi tạo luồng.
+ * @param   EpochNs     Epoch chung của các task tuần hoàn
+ * @return 	None
+ **************************************************************************/
+void Os_Co_Start(uint64 EpochNs) {
+    if (os_co_count == 0) {
+        return;
+    }
+
+    for (uint16 i = 0; i < os_co_count; i++) {
+        Os_CoInstanceType* inst = &os_co_runnables[i];
+        if (inst->Config.PeriodMs != 0) {
+            inst->ReleaseNs = EpochNs + (uint64)inst->Config.OffsetMs * OS_CO_NS_PER_MS;
+            inst->State = OS_CO_STATE_DELAYED;
+            Os_Timer_StartAbs(&inst->Timer, inst->ReleaseNs);
+        }
+    }
+
+    LOG_INFO(OS, "Starting %d coroutine workers for %d runnables\n", os_co_worker_count, os_co_count);
+    for (uint8 i = 0; i < os_co_worker_count; i++) {
+        Os_CoWorkerType* worker = &os_co_workers[i];
+        if (worker->RunnableCount == 0) {
+            continue;
+        }
+        if (Mem_Arena_Create(&worker->Scratch, OS_CFG_TASK_SCRATCH_SIZE) != E_OK) {
+            LOG_WARN(OS, "Coroutine worker %d has no scratch arena, Mem_ScratchAlloc will fail\n", i);
+        }
+        Os_TimeBeginBusy();
+        if (pthread_create(&worker->Thread, NULL_PTR, Os_Co_WorkerMain, worker) != 0) {
+            Os_TimeEndBusy();
+            LOG_ERROR(OS, "Error: Cannot create coroutine worker %d.\n", i);
+        } else {
+            worker->Started = TRUE;
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Dừng các luồng worker và chờ chúng kết thúc (gọi từ Os_Shutdown)
+ * @details Gọi trước Os_Alarm_Stop. Worker đang chạy một bước của runnable
+ *          kết thúc sau khi bước đó xong.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Co_Stop(void) {
+    for (uint8 i = 0; i < os_co_worker_count; i++) {
+        Os_CoWorkerType* worker = &os_co_workers[i];
+        if (!worker->Started) {
+            continue;
+        }
+
+        pthread_mutex_lock(&worker->Lock);
+        worker->Stop = TRUE;
+        if (worker->Idle) {
+            worker->Idle = FALSE;
+            Os_TimeBeginBusy();
+            pthread_cond_signal(&worker->Cond);
+        }
+        pthread_mutex_unlock(&worker->Lock);
+
+        pthread_join(worker->Thread, NULL_PTR);
+        worker->Started = FALSE;
+    }
+}
+
+/**************************************************************************
+ * @brief   Đăng ký một runnable dạng coroutine (gọi trước Os_Start)
+ * @details Runnable được gán lần lượt cho các worker.
+ * @param   ConfigPtr       Con trỏ đến cấu hình của runnable
+ * @param   IdPtr           Con trỏ lưu ID của runnable (có thể là NULL)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ, chưa
+ *                                 gọi Os_Init hoặc đã đạt số runnable tối đa
+ **************************************************************************/
+Std_ReturnType Os_CreateCoRunnable(const Os_CoRunnableConfigType* ConfigPtr, Os_CoRunnableIdType* IdPtr) {
+    if (ConfigPtr == NULL_PTR || ConfigPtr->Runnable == NULL_PTR ||
+        (ConfigPtr->PeriodMs == 0 && ConfigPtr->MaxActivations == 0)) {
+        LOG_ERROR(OS, "Error: Invalid configuration passed to Os_CreateCoRunnable.\n");
+        return E_NOT_OK;
+    }
+    if (os_co_worker_count == 0) {
+        LOG_ERROR(OS, "Error: Os_CreateCoRunnable called before Os_Init.\n");
+        return E_NOT_OK;
+    }
+    if (os_co_count >= OS_CO_MAX_RUNNABLES) {
+        LOG_ERROR(OS, "Cannot create more coroutine runnables. Maximum count reached.\n");
+        return E_NOT_OK;
+    }
+
+    Os_CoInstanceType* inst = &os_co_runnables[os_co_count];
+    inst->Config = *ConfigPtr;
+    inst->Context.Line = 0;
+    inst->Context.WakeupNs = 0;
+    inst->Context.WaitMask = 0;
+    atomic_store(&inst->Context.Events, 0);
+    inst->Context.Data = ConfigPtr->Data;
+    inst->Worker = &os_co_workers[os_co_count % os_co_worker_count];
+    inst->Worker->RunnableCount++;
+    inst->Next = NULL_PTR;
+    inst->State = OS_CO_STATE_IDLE;
+    inst->Activations = 0;
+    Os_Timer_Init(&inst->Timer, Os_Co_TimerExpired, inst);
+
+    if (IdPtr != NULL_PTR) {
+        *IdPtr = os_co_count;
+    }
+    os_co_count++;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Kích hoạt một runnable theo sự kiện
+ * @param   Id              ID của runnable
+ * @return 	Std_ReturnType  Trả về E_OK nếu runnable được kích hoạt,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc số lần
+ *                                 kích hoạt đang chờ đã đạt MaxActivations
+ **************************************************************************/
+Std_ReturnType Os_ActivateCoRunnable(Os_CoRunnableIdType Id) {
+    if (Id >= os_co_count || os_co_runnables[Id].Config.PeriodMs != 0) {
+        return E_NOT_OK;
+    }
+
+    Os_CoInstanceType* inst = &os_co_runnables[Id];
+    Std_ReturnType ret = E_NOT_OK;
+    pthread_mutex_lock(&inst->Worker->Lock);
+    if (inst->Activations < inst->Config.MaxActivations) {
+        inst->Activations++;
+        if (inst->State == OS_CO_STATE_IDLE) {
+            Os_Co_PushLocked(inst);
+        }
+        ret = E_OK;
+    }
+    pthread_mutex_unlock(&inst->Worker->Lock);
+    return ret;
+}
+
+/**************************************************************************
+ * @brief   Đặt sự kiện cho một runnable
+ * @param   Id              ID của runnable
+ * @param   Mask            Các sự kiện cần đặt
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetCoEvent(Os_CoRunnableIdType Id, Os_EventMaskType Mask) {
+    if (Id >= os_co_count) {
+        return E_NOT_OK;
+    }
+
+    Os_CoInstanceType* inst = &os_co_runnables[Id];
+    atomic_fetch_or(&inst->Context.Events, Mask);
+
+    pthread_mutex_lock(&inst->Worker->Lock);
+    if (inst->State == OS_CO_STATE_WAITING && (Mask & inst->Context.WaitMask) != 0) {
+        Os_Co_PushLocked(inst);
+    }
+    pthread_mutex_unlock(&inst->Worker->Lock);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Xóa sự kiện của runnable đang chạy
+ * @param   Ctx             Ngữ cảnh của runnable
+ * @param   Mask            Các sự kiện cần xóa
+ * @return 	None
+ **************************************************************************/
+void Os_ClearCoEvent(Os_CoContextType* Ctx, Os_EventMaskType Mask) {
+    atomic_fetch_and(&Ctx->Events, ~Mask);
+}
@@ -0,0 +1,200 @@
+/***************************************************************************
+ * @file    Os_Coroutine.h
+ * @brief   Khai báo runnable dạng coroutine không stack của OS
+ * @details File này cung cấp chế độ chạy runnable dạng coroutine không stack
+ *          (máy trạng thái viết bằng các macro OS_CO_*). Runnable trả quyền
+ *          điều khiển khi phải chờ (độ trễ, sự kiện từ hàm thông báo của
+ *          driver như ADC chuyển đổi xong, CAN gửi xong) thay vì chặn luồng,
+ *          nên hàng trăm runnable dùng chung một nhóm nhỏ luồng worker (mỗi
+ *          core một luồng) thay vì mỗi runnable một luồng và một stack.
+ *
+ *          Ví dụ một runnable:
+ *
+ *              static Os_CoStatusType Swc_Runnable(Os_CoContextType* Ctx) {
+ *                  OS_CO_BEGIN(Ctx);
+ *                  Adc_StartGroupConversion(SWC_ADC_GROUP);
+ *                  OS_CO_WAIT_EVENT(Ctx, SWC_EVENT_ADC_DONE);
+ *                  Os_ClearCoEvent(Ctx, SWC_EVENT_ADC_DONE);
+ *                  ...
+ *                  OS_CO_DELAY(Ctx, 5);
+ *                  ...
+ *                  OS_CO_END(Ctx);
+ *              }
+ *
+ *          Biến cục bộ không được giữ qua các điểm chờ, trạng thái cần giữ
+ *          phải nằm trong dữ liệu của runnable (Ctx->Data). Không dùng các
+ *          macro OS_CO_* bên trong một lệnh switch của runnable.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef OS_COROUTINE_H
+#define OS_COROUTINE_H
+
+#include "Os.h"
+#include <stdatomic.h>
+
+/**************************************************************************
+ * @brief Số runnable dạng coroutine tối đa
+ **************************************************************************/
+#define OS_CO_MAX_RUNNABLES             512
+
+/**************************************************************************
+ * @brief Số luồng worker (0: bằng số core đang chạy, tối đa OS_CO_MAX_WORKERS)
+ **************************************************************************/
+#ifndef OS_CFG_CO_WORKERS
+#define OS_CFG_CO_WORKERS               0
+#endif
+#define OS_CO_MAX_WORKERS               8
+
+/**************************************************************************
+ * @brief Các core không ghim worker, bit n là core n (mặc định core 1, core
+ *        được cách ly cho task điều khiển lực kéo, xem TRACTION_CONTROL_CORE_MASK
+ *        trong Main.c). Khi OS_CFG_CO_WORKERS bằng 0, các core này cũng
+ *        không được tính vào số worker
+ **************************************************************************/
+#ifndef OS_CFG_CO_ISOLATED_CORE_MASK
+#define OS_CFG_CO_ISOLATED_CORE_MASK    0x2ULL
+#endif
+
+/**************************************************************************
+ * @typedef Os_CoRunnableIdType
+ * @brief   Định nghĩa kiểu dữ liệu cho ID của một runnable dạng coroutine
+ **************************************************************************/
+typedef uint16 Os_CoRunnableIdType;
+
+/**************************************************************************
+ * @enum    Os_CoStatusType
+ * @brief   Định nghĩa kết quả của một bước chạy của runnable
+ **************************************************************************/
+typedef enum {
+    OS_CO_DONE = 0,             /* Runnable chạy xong lần kích hoạt */
+    OS_CO_YIELDED = 1,          /* Nhường worker, chạy tiếp ngay khi đến lượt */
+    OS_CO_DELAYED = 2,          /* Chờ đến WakeupNs */
+    OS_CO_WAITING = 3           /* Chờ một trong các sự kiện WaitMask */
+} Os_CoStatusType;
+
+/**************************************************************************
+ * @struct  Os_CoContextType
+ * @brief   Cấu trúc ngữ cảnh của một runnable dạng coroutine
+ * @details Line là vị trí chạy tiếp, được cập nhật bởi các macro OS_CO_*.
+ **************************************************************************/
+typedef struct {
+    uint32 Line;                /* Vị trí chạy tiếp (0: đầu runnable) */
+    uint64 WakeupNs;            /* Thời điểm hết chờ (OS_CO_DELAYED) */
+    Os_EventMaskType WaitMask;  /* Các sự kiện đang chờ (OS_CO_WAITING) */
+    atomic_uint Events;         /* Các sự kiện đã được đặt */
+    void* Data;                 /* Dữ liệu của runnable (từ cấu hình) */
+} Os_CoContextType;
+
+/**************************************************************************
+ * @typedef Os_CoRunnableType
+ * @brief   Định nghĩa kiểu hàm của runnable dạng coroutine
+ **************************************************************************/
+typedef Os_CoStatusType (*Os_CoRunnableType)(Os_CoContextType* Ctx);
+
+/**************************************************************************
+ * @struct  Os_CoRunnableConfigType
+ * @brief   Cấu trúc cấu hình của một runnable dạng coroutine
+ * @details Runnable tuần hoàn được kích hoạt theo epoch chung của các task
+ *          tuần hoàn (độ phân giải là nhịp OS_CFG_TIMER_TICK_US), runnable có
+ *          PeriodMs = 0 chỉ chạy khi được kích hoạt bằng Os_ActivateCoRunnable.
+ **************************************************************************/
+typedef struct {
+    const char* Name;           /* Tên của runnable */
+    Os_CoRunnableType Runnable; /* Hàm của runnable */
+    uint32 PeriodMs;            /* Chu kỳ kích hoạt (ms, 0: theo sự kiện) */
+    uint32 OffsetMs;            /* Độ lệch của lần kích hoạt đầu tiên so với epoch (ms) */
+    uint8 MaxActivations;       /* Số lần kích hoạt tối đa được xếp hàng (runnable theo sự kiện) */
+    void* Data;                 /* Dữ liệu của runnable (Ctx->Data) */
+} Os_CoRunnableConfigType;
+
+/**************************************************************************
+ * @brief Các macro viết runnable dạng coroutine
+ * @details OS_CO_BEGIN/OS_CO_END bao toàn bộ thân runnable. OS_CO_YIELD
+ *          nhường worker cho runnable khác. OS_CO_DELAY chờ một số mili giây
+ *          theo thời gian hệ thống. OS_CO_WAIT_EVENT chờ đến khi có ít nhất
+ *          một sự kiện trong Mask (sự kiện không bị xóa). OS_CO_WAIT_UNTIL
+ *          kiểm tra lại điều kiện mỗi lần đến lượt (chỉ dùng cho chờ ngắn).
+ **************************************************************************/
+#define OS_CO_BEGIN(Ctx)                switch ((Ctx)->Line) { case 0:
+
+#define OS_CO_END(Ctx)                  } (Ctx)->Line = 0; return OS_CO_DONE
+
+#define OS_CO_YIELD(Ctx)                do { (Ctx)->Line = __LINE__; return OS_CO_YIELDED; \
+                                             case __LINE__:; } while (0)
+
+#define OS_CO_DELAY(Ctx, Ms)            do { (Ctx)->WakeupNs = Os_GetTimeNs() + (uint64)(Ms) * 1000000ULL; \
+                                             (Ctx)->Line = __LINE__; return OS_CO_DELAYED; \
+                                             case __LINE__:; } while (0)
+
+#define OS_CO_WAIT_EVENT(Ctx, Mask)     do { (Ctx)->WaitMask = (Mask); (Ctx)->Line = __LINE__; \
+                                             case __LINE__: \
+                                             if ((atomic_load(&(Ctx)->Events) & (Mask)) == 0) { return OS_CO_WAITING; } \
+                                        } while (0)
+
+#define OS_CO_WAIT_UNTIL(Ctx, Cond)     do { (Ctx)->Line = __LINE__; \
+                                             case __LINE__: \
+                                             if (!(Cond)) { return OS_CO_YIELDED; } \
+                                        } while (0)
+
+/**************************************************************************
+ * @brief   Khởi tạo chế độ runnable dạng coroutine (gọi từ Os_Init)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Co_Init(void);
+
+/**************************************************************************
+ * @brief   Khởi động các luồng worker nếu có runnable (gọi từ Os_Start)
+ * @param   EpochNs     Epoch chung của các task tuần hoàn
+ * @return 	None
+ **************************************************************************/
+void Os_Co_Start(uint64 EpochNs);
+
+/**************************************************************************
+ * @brief   Dừng các luồng worker và chờ chúng kết thúc (gọi từ Os_Shutdown)
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void Os_Co_Stop(void);
+
+/**************************************************************************
+ * @brief   Đăng ký một runnable dạng coroutine (gọi sau Os_Init, trước Os_Start)
+ * @param   ConfigPtr       Con trỏ đến cấu hình của runnable
+ * @param   IdPtr           Con trỏ lưu ID của runnable (có thể là NULL)
+ * @return 	Std_ReturnType  Trả về E_OK nếu đăng ký thành công,
+ *                                 E_NOT_OK nếu cấu hình không hợp lệ, chưa
+ *                                 gọi Os_Init hoặc đã đạt số runnable tối đa
+ **************************************************************************/
+Std_ReturnType Os_CreateCoRunnable(const Os_CoRunnableConfigType* ConfigPtr, Os_CoRunnableIdType* IdPtr);
+
+/**************************************************************************
+ * @brief   Kích hoạt một runnable theo sự kiện
+ * @details Có thể gọi từ hàm thông báo của driver.
+ * @param   Id              ID của runnable
+ * @return 	Std_ReturnType  Trả về E_OK nếu runnable được kích hoạt,
+ *                                 E_NOT_OK nếu ID không hợp lệ hoặc số lần
+ *                                 kích hoạt đang chờ đã đạt MaxActivations
+ **************************************************************************/
+Std_ReturnType Os_ActivateCoRunnable(Os_CoRunnableIdType Id);
+
+/**************************************************************************
+ * @brief   Đặt sự kiện cho một runnable
+ * @details Có thể gọi từ hàm thông báo của driver. Runnable đang chờ một
+ *          trong các sự kiện này được chạy tiếp.
+ * @param   Id              ID của runnable
+ * @param   Mask            Các sự kiện cần đặt
+ * @return 	Std_ReturnType  Trả về E_OK nếu đặt thành công,
+ *                                 E_NOT_OK nếu ID không hợp lệ
+ **************************************************************************/
+Std_ReturnType Os_SetCoEvent(Os_CoRunnableIdType Id, Os_EventMaskType Mask);
+
+/**************************************************************************
+ * @brief   Xóa sự kiện của runnable đang chạy
+ * @param   Ctx             Ngữ cảnh của runnable
+ * @param   Mask            Các sự kiện cần xóa
+ * @return 	None
+ **************************************************************************/
+void Os_ClearCoEvent(Os_CoContextType* Ctx, Os_EventMaskType Mask);
+
+#endif /* OS_COROUTINE_H */
@@ -0,0 +1,143 @@
+#include "Pdu_Buffer.h"
+
+/**************************************************************************
+ * @struct  PduBuf_BufferType
+ * @brief   Cấu trúc một bộ đệm PDU trong vùng đệm
+ **************************************************************************/
+typedef struct {
+    atomic_uint RefCount;               /* Số module đang giữ bộ đệm */
+    PduBuf_HandleType Next;             /* Bộ đệm trống tiếp theo trong danh sách trống */
+    PduLengthType Length;               /* Độ dài dữ liệu của PDU */
+    uint8 Data[PDUBUF_BUFFER_SIZE];     /* Dữ liệu của PDU */
+} PduBuf_BufferType;
+
+/**************************************************************************
+ * @brief Vùng đệm và danh sách các bộ đệm trống
+ * @details Đỉnh danh sách trống gồm handle (16 bit thấp) và bộ đếm phiên bản
+ *          (các bit cao) để tránh lỗi ABA khi nhiều luồng lấy/trả đồng thời.
+ **************************************************************************/
+static PduBuf_BufferType PduBuf_Buffers[PDUBUF_NUM_BUFFERS];
+static atomic_ullong PduBuf_FreeHead = PDUBUF_INVALID_HANDLE;   /* Rỗng cho đến khi gọi PduBuf_Init */
+static atomic_uint PduBuf_FreeCount;
+
+/**************************************************************************
+ * @brief   Đưa một bộ đệm vào danh sách trống
+ * @param   Handle      Handle của bộ đệm
+ * @return 	None
+ **************************************************************************/
+static void PduBuf_PushFree(PduBuf_HandleType Handle) {
+    uint64 head = atomic_load_explicit(&PduBuf_FreeHead, memory_order_relaxed);
+    uint64 new_head;
+
+    do {
+        PduBuf_Buffers[Handle].Next = (PduBuf_HandleType)(head & 0xFFFFU);
+        new_head = ((head >> 16) + 1) << 16 | Handle;
+    } while (!atomic_compare_exchange_weak_explicit(&PduBuf_FreeHead, &head, new_head,
+                                                    memory_order_release, memory_order_relaxed));
+    atomic_fetch_add_explicit(&PduBuf_FreeCount, 1, memory_order_relaxed);
+}
+
+/**************************************************************************
+ * @brief   Khởi tạo vùng đệm PDU
+ * @details Hàm này đưa tất cả các bộ đệm vào danh sách trống, phải được gọi
+ *          trước khi các module truyền thông bắt đầu chạy.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void PduBuf_Init() {
+    atomic_store_explicit(&PduBuf_FreeHead, PDUBUF_INVALID_HANDLE, memory_order_relaxed);
+    atomic_store_explicit(&PduBuf_FreeCount, 0, memory_order_relaxed);
+
+    for (uint32 i = PDUBUF_NUM_BUFFERS; i > 0; i--) {
+        atomic_store_explicit(&PduBuf_Buffers[i - 1].RefCount, 0, memory_order_relaxed);
+        PduBuf_PushFree((PduBuf_HandleType)(i - 1));
+    }
+}
+
+/**************************************************************************
+ * @brief   Lấy một bộ đệm trống từ vùng đệm (số tham chiếu bằng 1)
+ * @details Người gọi ghi dữ liệu vào bộ đệm qua PduBuf_GetInfo trước khi
+ *          chuyển handle cho module khác.
+ * @param   Length          Độ dài dữ liệu của PDU (byte)
+ * @param   HandlePtr       Con trỏ lưu handle của bộ đệm
+ * @return 	Std_ReturnType  Trả về E_OK nếu lấy được bộ đệm,
+ *                                 E_NOT_OK nếu hết bộ đệm hoặc PDU quá dài
+ **************************************************************************/
+Std_ReturnType PduBuf_Alloc(PduLengthType Length, PduBuf_HandleType* HandlePtr) {
+    if (HandlePtr == NULL_PTR || Length > PDUBUF_BUFFER_SIZE) {
+        return E_NOT_OK;
+    }
+
+    uint64 head = atomic_load_explicit(&PduBuf_FreeHead, memory_order_acquire);
+    uint64 new_head;
+    PduBuf_HandleType handle;
+
+    do {
+        handle = (PduBuf_HandleType)(head & 0xFFFFU);
+        if (handle == PDUBUF_INVALID_HANDLE) {
+            return E_NOT_OK;    // Hết bộ đệm
+        }
+        new_head = ((head >> 16) + 1) << 16 | PduBuf_Buffers[handle].Next;
+    } while (!atomic_compare_exchange_weak_explicit(&PduBuf_FreeHead, &head, new_head,
+                                                    memory_order_acquire, memory_order_acquire));
+    atomic_fetch_sub_explicit(&PduBuf_FreeCount, 1, memory_order_relaxed);
+
+    PduBuf_Buffers[handle].Length = Length;
+    atomic_store_explicit(&PduBuf_Buffers[handle].RefCount, 1, memory_order_relaxed);
+    *HandlePtr = handle;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Tăng số tham chiếu của bộ đệm
+ * @details Module nhận handle từ module khác gọi hàm này nếu cần giữ bộ đệm
+ *          sau khi hàm nhận handle kết thúc.
+ * @param   Handle      Handle của bộ đệm
+ * @return 	None
+ **************************************************************************/
+void PduBuf_Retain(PduBuf_HandleType Handle) {
+    if (Handle >= PDUBUF_NUM_BUFFERS) {
+        return;
+    }
+    atomic_fetch_add_explicit(&PduBuf_Buffers[Handle].RefCount, 1, memory_order_relaxed);
+}
+
+/**************************************************************************
+ * @brief   Giảm số tham chiếu của bộ đệm, trả bộ đệm lại khi bằng 0
+ * @param   Handle      Handle của bộ đệm
+ * @return 	None
+ **************************************************************************/
+void PduBuf_Release(PduBuf_HandleType Handle) {
+    if (Handle >= PDUBUF_NUM_BUFFERS) {
+        return;
+    }
+    if (atomic_fetch_sub_explicit(&PduBuf_Buffers[Handle].RefCount, 1, memory_order_acq_rel) == 1) {
+        PduBuf_PushFree(Handle);
+    }
+}
+
+/**************************************************************************
+ * @brief   Đọc thông tin (con trỏ dữ liệu và độ dài) của bộ đệm
+ * @param   Handle          Handle của bộ đệm
+ * @param   PduInfoPtr      Con trỏ lưu thông tin của PDU
+ * @return 	Std_ReturnType  Trả về E_OK nếu handle hợp lệ,
+ *                                 E_NOT_OK nếu handle không hợp lệ
+ **************************************************************************/
+Std_ReturnType PduBuf_GetInfo(PduBuf_HandleType Handle, PduInfoType* PduInfoPtr) {
+    if (Handle >= PDUBUF_NUM_BUFFERS || PduInfoPtr == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    PduInfoPtr->SduDataPtr = PduBuf_Buffers[Handle].Data;
+    PduInfoPtr->SduLength = PduBuf_Buffers[Handle].Length;
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Đọc số bộ đệm còn trống
+ * @param   None
+ * @return 	uint32  Số bộ đệm còn trống
+ **************************************************************************/
+uint32 PduBuf_GetFreeCount() {
+    return atomic_load_explicit(&PduBuf_FreeCount, memory_order_relaxed);
+}
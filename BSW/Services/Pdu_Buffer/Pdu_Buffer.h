@@ -0,0 +1,71 @@
+#ifndef PDU_BUFFER_H
+#define PDU_BUFFER_H
+
+#include <stdatomic.h>
+#include "Std_Types.h"
+#include "ComStack_Types.h"
+
+/**************************************************************************
+ * @brief Số bộ đệm trong vùng đệm PDU và kích thước dữ liệu của một bộ đệm
+ **************************************************************************/
+#define PDUBUF_NUM_BUFFERS      256
+#define PDUBUF_BUFFER_SIZE      64      /* Byte, đủ cho CAN và các PDU nhỏ của LIN/Ethernet */
+
+/**************************************************************************
+ * @typedef PduBuf_HandleType
+ * @brief   Định nghĩa kiểu dữ liệu cho handle của một bộ đệm PDU
+ * @details Các module truyền thông (Can, PduR, ...) chuyển PDU cho nhau bằng
+ *          handle thay vì sao chép dữ liệu. Mỗi module giữ bộ đệm phải gọi
+ *          PduBuf_Retain và gọi PduBuf_Release khi không dùng nữa, bộ đệm
+ *          được trả lại vùng đệm khi không còn module nào giữ.
+ **************************************************************************/
+typedef uint16 PduBuf_HandleType;
+#define PDUBUF_INVALID_HANDLE   (PduBuf_HandleType)0xFFFF
+
+/**************************************************************************
+ * @brief   Khởi tạo vùng đệm PDU
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void PduBuf_Init(void);
+
+/**************************************************************************
+ * @brief   Lấy một bộ đệm trống từ vùng đệm (số tham chiếu bằng 1)
+ * @param   Length          Độ dài dữ liệu của PDU (byte)
+ * @param   HandlePtr       Con trỏ lưu handle của bộ đệm
+ * @return 	Std_ReturnType  Trả về E_OK nếu lấy được bộ đệm,
+ *                                 E_NOT_OK nếu hết bộ đệm hoặc PDU quá dài
+ **************************************************************************/
+Std_ReturnType PduBuf_Alloc(PduLengthType Length, PduBuf_HandleType* HandlePtr);
+
+/**************************************************************************
+ * @brief   Tăng số tham chiếu của bộ đệm
+ * @param   Handle      Handle của bộ đệm
+ * @return 	None
+ **************************************************************************/
+void PduBuf_Retain(PduBuf_HandleType Handle);
+
+/**************************************************************************
+ * @brief   Giảm số tham chiếu của bộ đệm, trả bộ đệm lại khi bằng 0
+ * @param   Handle      Handle của bộ đệm
+ * @return 	None
+ **************************************************************************/
+void PduBuf_Release(PduBuf_HandleType Handle);
+
+/**************************************************************************
+ * @brief   Đọc thông tin (con trỏ dữ liệu và độ dài) của bộ đệm
+ * @param   Handle          Handle của bộ đệm
+ * @param   PduInfoPtr      Con trỏ lưu thông tin của PDU
+ * @return 	Std_ReturnType  Trả về E_OK nếu handle hợp lệ,
+ *                                 E_NOT_OK nếu handle không hợp lệ
+ **************************************************************************/
+Std_ReturnType PduBuf_GetInfo(PduBuf_HandleType Handle, PduInfoType* PduInfoPtr);
+
+/**************************************************************************
+ * @brief   Đọc số bộ đệm còn trống
+ * @param   None
+ * @return 	uint32  Số bộ đệm còn trống
+ **************************************************************************/
+uint32 PduBuf_GetFreeCount(void);
+
+#endif /* PDU_BUFFER_H */
@@ -1,4 +1,20 @@
 #include "Pdu_Router.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+
+/**************************************************************************
+ * @brief Bảng ánh xạ ID thông điệp CAN chuẩn sang PDU nguồn, được dựng từ
+ *        PduR_CanRxPdus trong PduR_Init để tra cứu trong O(1)
+ **************************************************************************/
+static PduIdType PduR_CanRxPduMap[PDUR_CAN_STANDARD_IDS];
+
+/**************************************************************************
+ * @brief Bảng hàm xử lý PDU theo giao thức, đánh chỉ số bằng protocol_id
+ **************************************************************************/
+static void (* const PduR_ProtocolHandlers[PROTOCOL_COUNT])(Pdu_Type*) = {
+    [PROTOCOL_CAN] = PduR_CanHandler,
+    [PROTOCOL_LIN] = PduR_LinHandler,
+    [PROTOCOL_ETHERNET] = PduR_EthernetHandler,
+};
 
 /**************************************************************************
  * @brief   Khởi tạo hệ thống PDU Router
@@ -7,35 +23,172 @@
  * @return 	None  
  **************************************************************************/
 void PduR_Init() {
-    printf("PDU Router Initialized.\n");
+    for (uint16 id = 0; id < PDUR_CAN_STANDARD_IDS; id++) {
+        PduR_CanRxPduMap[id] = PDUR_INVALID_PDU_ID;
+    }
+    for (uint16 i = 0; i < PduR_CanRxPduCount; i++) {
+        if (PduR_CanRxPdus[i].CanId < PDUR_CAN_STANDARD_IDS && PduR_CanRxPdus[i].PduId < PduR_RoutingTableSize) {
+            PduR_CanRxPduMap[PduR_CanRxPdus[i].CanId] = PduR_CanRxPdus[i].PduId;
+        }
+    }
+
+    for (PduIdType src = 0; src < PduR_RoutingTableSize; src++) {
+        for (uint8 i = 0; i < PduR_RoutingTable[src].NumDestinations; i++) {
+            PduR_RoutingTable[src].Destinations[i].Buffer->Pending = PDUBUF_INVALID_HANDLE;
+        }
+    }
+
+    LOG_INFO(PDUR, "PDU Router Initialized.\n");
+}
+
+/**************************************************************************
+ * @brief   Định tuyến một PDU nhận được đến tất cả các đích của nó
+ * @details Đường định tuyến được tra trực tiếp trong bảng bằng RxPduId. Tất
+ *          cả các đích nhận cùng một bộ đệm PDU, khi module đích đang bận
+ *          bộ đệm gateway chỉ giữ thêm một tham chiếu, dữ liệu không bị sao
+ *          chép. Hàm và PduR_MainFunction phải được gọi từ cùng một task.
+ * @param   RxPduId         ID của PDU nguồn
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Trả về E_OK nếu PDU được chuyển hoặc lưu vào bộ
+ *                                 đệm gateway ở tất cả các đích,
+ *                                 E_NOT_OK nếu PDU không có đường định tuyến
+ **************************************************************************/
+Std_ReturnType PduR_RxIndication(PduIdType RxPduId, PduBuf_HandleType Buffer) {
+    if (RxPduId >= PduR_RoutingTableSize || Buffer == PDUBUF_INVALID_HANDLE) {
+        return E_NOT_OK;
+    }
+
+    const PduR_RoutingPathType* path = &PduR_RoutingTable[RxPduId];
+
+    for (uint8 i = 0; i < path->NumDestinations; i++) {
+        const PduR_DestinationType* dest = &path->Destinations[i];
+        PduR_GatewayBufferType* gateway = dest->Buffer;
+
+        // PDU cũ đang chờ thì PDU mới thay thế nó trong bộ đệm gateway
+        if (gateway->Pending == PDUBUF_INVALID_HANDLE && dest->Transmit(dest->DestPduId, Buffer) == E_OK) {
+            continue;
+        }
+
+        PduBuf_Retain(Buffer);
+        if (gateway->Pending != PDUBUF_INVALID_HANDLE) {
+            PduBuf_Release(gateway->Pending);
+        }
+        gateway->Pending = Buffer;
+    }
+
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Hàm báo nhận thông điệp cho mailbox nhận của CAN
+ * @details Hàm này được đăng ký làm RxIndication của mailbox nhận, tra PDU
+ *          nguồn theo ID thông điệp rồi định tuyến bộ đệm nhận của driver
+ *          CAN. Thông điệp không có trong bảng bị bỏ qua.
+ * @param   Hrh         Mailbox nhận (không dùng, định tuyến chỉ theo CanId)
+ * @param   CanId       ID của thông điệp CAN nhận được
+ * @param   Buffer      Bộ đệm chứa dữ liệu của thông điệp
+ * @return 	None
+ **************************************************************************/
+void PduR_CanRxIndication(Can_HwHandleType Hrh, Can_IdType CanId, PduBuf_HandleType Buffer) {
+    (void)Hrh;
+
+    if (CanId >= PDUR_CAN_STANDARD_IDS) {
+        return;
+    }
+
+    PduIdType pdu_id = PduR_CanRxPduMap[CanId];
+    if (pdu_id == PDUR_INVALID_PDU_ID) {
+        return;
+    }
+
+    PduR_RxIndication(pdu_id, Buffer);
+}
+
+/**************************************************************************
+ * @brief   Gửi lại các PDU đang chờ trong các bộ đệm gateway
+ * @details Hàm này được gọi định kỳ, cùng task với PduR_RxIndication.
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void PduR_MainFunction() {
+    for (PduIdType src = 0; src < PduR_RoutingTableSize; src++) {
+        const PduR_RoutingPathType* path = &PduR_RoutingTable[src];
+        for (uint8 i = 0; i < path->NumDestinations; i++) {
+            const PduR_DestinationType* dest = &path->Destinations[i];
+            PduBuf_HandleType pending = dest->Buffer->Pending;
+            if (pending == PDUBUF_INVALID_HANDLE) {
+                continue;
+            }
+
+            if (dest->Transmit(dest->DestPduId, pending) == E_OK) {
+                dest->Buffer->Pending = PDUBUF_INVALID_HANDLE;
+                PduBuf_Release(pending);
+            }
+        }
+    }
+}
+
+/**************************************************************************
+ * @brief   Chuyển PDU đến CAN (đích của đường định tuyến)
+ * @details Hàm này tra mailbox gửi và ID thông điệp CAN của PDU đích rồi
+ *          đưa bộ đệm PDU vào mailbox gửi.
+ * @param   DestPduId       ID của PDU trong bảng PduR_CanTxPdus
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Trả về E_OK nếu PDU được đưa vào mailbox gửi,
+ *                                 E_NOT_OK nếu mailbox đầy
+ **************************************************************************/
+Std_ReturnType PduR_CanTransmit(PduIdType DestPduId, PduBuf_HandleType Buffer) {
+    if (DestPduId >= PduR_CanTxPduCount) {
+        return E_NOT_OK;
+    }
+
+    return Can_WriteBuffer(PduR_CanTxPdus[DestPduId].Hth, DestPduId, PduR_CanTxPdus[DestPduId].CanId, Buffer);
+}
+
+/**************************************************************************
+ * @brief   Chuyển PDU đến LIN (đích của đường định tuyến, giả lập)
+ * @param   DestPduId       ID của PDU ở LIN
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Luôn trả về E_OK
+ **************************************************************************/
+Std_ReturnType PduR_LinTransmit(PduIdType DestPduId, PduBuf_HandleType Buffer) {
+    PduInfoType pdu_info = {NULL_PTR, 0};
+
+    PduBuf_GetInfo(Buffer, &pdu_info);
+    LOG_DEBUG(PDUR, "LIN PDU %u transmitted, Length = %u\n", DestPduId, pdu_info.SduLength);
+    return E_OK;
+}
+
+/**************************************************************************
+ * @brief   Chuyển PDU đến Ethernet (đích của đường định tuyến, giả lập)
+ * @param   DestPduId       ID của PDU ở Ethernet
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Luôn trả về E_OK
+ **************************************************************************/
+Std_ReturnType PduR_EthernetTransmit(PduIdType DestPduId, PduBuf_HandleType Buffer) {
+    PduInfoType pdu_info = {NULL_PTR, 0};
+
+    PduBuf_GetInfo(Buffer, &pdu_info);
+    LOG_DEBUG(PDUR, "Ethernet PDU %u transmitted, Length = %u\n", DestPduId, pdu_info.SduLength);
+    return E_OK;
 }
 
 /**************************************************************************
  * @brief   Định tuyến PDU dựa trên giao thức
  * @details Hàm này sẽ định tuyến một PDU đến hàm xử lý tương ứng với giao 
- *          thức của PDU.
+ *          thức của PDU, hàm xử lý được tra trực tiếp trong bảng theo
+ *          protocol_id.
  * @param   pdu     Con trỏ đến PDU cần định tuyến
  * @return 	None  
  **************************************************************************/
 void PduR_RoutePdu(Pdu_Type* pdu) {
-    printf("Routing PDU: Protocol ID = 0x%x, Data = %s, Length = %d\n", pdu->protocol_id, pdu->data, pdu->length);
-
-    switch (pdu->protocol_id) {
-        case PROTOCOL_CAN:
-            PduR_CanHandler(pdu);
-            break;
-
-        case PROTOCOL_LIN:
-            PduR_LinHandler(pdu);
-            break;
-
-        case PROTOCOL_ETHERNET:
-            PduR_EthernetHandler(pdu);
-            break;
+    LOG_DEBUG(PDUR, "Routing PDU: Protocol ID = 0x%x, Data = %s, Length = %d\n", pdu->protocol_id, pdu->data, pdu->length);
 
-        default:
-            printf("Unknown protocol ID: 0x%x\n", pdu->protocol_id);
-            break;
+    // Tra hàm xử lý trực tiếp trong bảng theo giao thức
+    if (pdu->protocol_id < PROTOCOL_COUNT && PduR_ProtocolHandlers[pdu->protocol_id] != NULL_PTR) {
+        PduR_ProtocolHandlers[pdu->protocol_id](pdu);
+    } else {
+        LOG_WARN(PDUR, "Unknown protocol ID: 0x%x\n", pdu->protocol_id);
     }
 }
 
@@ -46,7 +199,7 @@ void PduR_RoutePdu(Pdu_Type* pdu) {
  * @return 	None  
  **************************************************************************/
 void PduR_CanHandler(Pdu_Type* pdu) {
-    printf("Handling CAN PDU: Data = %s, Length = %d\n", pdu->data, pdu->length);
+    LOG_DEBUG(PDUR, "Handling CAN PDU: Data = %s, Length = %d\n", pdu->data, pdu->length);
     // Xử lý dữ liệu theo giao thức CAN
 }
 
@@ -57,7 +210,7 @@ void PduR_CanHandler(Pdu_Type* pdu) {
  * @return 	None  
  **************************************************************************/
 void PduR_LinHandler(Pdu_Type* pdu) {
-    printf("Handling LIN PDU: Data = %s, Length = %d\n", pdu->data, pdu->length);
+    LOG_DEBUG(PDUR, "Handling LIN PDU: Data = %s, Length = %d\n", pdu->data, pdu->length);
     // Xử lý dữ liệu theo giao thức LIN
 }
 
@@ -68,6 +221,6 @@ void PduR_LinHandler(Pdu_Type* pdu) {
  * @return 	None  
  **************************************************************************/
 void PduR_EthernetHandler(Pdu_Type* pdu) {
-    printf("Handling Ethernet PDU: Data = %s, Length = %d\n", pdu->data, pdu->length);
+    LOG_DEBUG(PDUR, "Handling Ethernet PDU: Data = %s, Length = %d\n", pdu->data, pdu->length);
     // Xử lý dữ liệu theo giao thức Ethernet
 }
\ No newline at end of file
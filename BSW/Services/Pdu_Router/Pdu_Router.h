@@ -4,6 +4,9 @@
 #include <stdio.h>
 #include <string.h>
 #include "Std_Types.h"
+#include "ComStack_Types.h"
+#include "Can.h"
+#include "Pdu_Buffer.h"
 
 /**************************************************************************
  * @brief Định nghĩa các giao thức truyền thông giả lập
@@ -11,6 +14,7 @@
 #define PROTOCOL_CAN        0x01        /* Giao thức CAN */
 #define PROTOCOL_LIN        0x02        /* Giao thức LIN */
 #define PROTOCOL_ETHERNET   0x03        /* Giao thức Ethernet */
+#define PROTOCOL_COUNT      0x04        /* Số giao thức (dùng làm kích thước bảng xử lý) */
 
 /**************************************************************************
  * @struct  Pdu_Type
@@ -24,6 +28,81 @@ typedef struct {
     uint8 length;       /* Độ dài dữ liệu */
 } Pdu_Type;
 
+/**************************************************************************
+ * @typedef PduR_TransmitFunctionType
+ * @brief   Định nghĩa kiểu hàm chuyển PDU đến module đích
+ * @details Hàm trả về E_NOT_OK khi module đích đang bận, khi đó PDU được
+ *          giữ trong bộ đệm gateway của đường định tuyến và gửi lại trong
+ *          PduR_MainFunction. Module đích muốn giữ bộ đệm sau khi hàm kết
+ *          thúc phải gọi PduBuf_Retain.
+ **************************************************************************/
+typedef Std_ReturnType (*PduR_TransmitFunctionType)(PduIdType DestPduId, PduBuf_HandleType Buffer);
+
+/**************************************************************************
+ * @struct  PduR_GatewayBufferType
+ * @brief   Bộ đệm gateway của một đường định tuyến
+ * @details Bộ đệm chỉ được dùng khi module đích đang bận, chỉ giữ PDU mới
+ *          nhất (PDU cũ chưa gửi được sẽ bị thay thế). PDU đang chờ được giữ
+ *          bằng một tham chiếu đến bộ đệm PDU nên không cần sao chép.
+ **************************************************************************/
+typedef struct {
+    PduBuf_HandleType Pending;      /* Bộ đệm PDU đang chờ gửi lại (PDUBUF_INVALID_HANDLE nếu không có) */
+} PduR_GatewayBufferType;
+
+/**************************************************************************
+ * @struct  PduR_DestinationType
+ * @brief   Cấu hình một đích của đường định tuyến
+ **************************************************************************/
+typedef struct {
+    PduR_TransmitFunctionType Transmit;     /* Hàm chuyển PDU đến module đích */
+    PduIdType DestPduId;                    /* ID của PDU ở module đích */
+    PduR_GatewayBufferType* Buffer;         /* Bộ đệm gateway riêng của đích này */
+} PduR_DestinationType;
+
+/**************************************************************************
+ * @struct  PduR_RoutingPathType
+ * @brief   Cấu hình đường định tuyến của một PDU nguồn
+ * @details Bảng định tuyến được đánh chỉ số trực tiếp bằng ID của PDU nguồn.
+ **************************************************************************/
+typedef struct {
+    const PduR_DestinationType* Destinations;   /* Danh sách các đích */
+    uint8 NumDestinations;                      /* Số đích */
+} PduR_RoutingPathType;
+
+/**************************************************************************
+ * @struct  PduR_CanRxPduConfigType
+ * @brief   Cấu hình ánh xạ ID thông điệp CAN nhận được sang PDU nguồn
+ **************************************************************************/
+typedef struct {
+    Can_IdType CanId;       /* ID của thông điệp CAN (11 bit) */
+    PduIdType PduId;        /* ID của PDU nguồn */
+} PduR_CanRxPduConfigType;
+
+/**************************************************************************
+ * @struct  PduR_CanTxPduConfigType
+ * @brief   Cấu hình một PDU đích được gửi qua CAN
+ **************************************************************************/
+typedef struct {
+    Can_HwHandleType Hth;   /* Mailbox gửi */
+    Can_IdType CanId;       /* ID của thông điệp CAN */
+} PduR_CanTxPduConfigType;
+
+/**************************************************************************
+ * @brief ID không hợp lệ của PDU và số ID thông điệp CAN chuẩn (11 bit)
+ **************************************************************************/
+#define PDUR_INVALID_PDU_ID     (PduIdType)0xFFFF
+#define PDUR_CAN_STANDARD_IDS   2048
+
+/**************************************************************************
+ * @brief Bảng định tuyến được sinh ra (Pdu_Router_Cfg.c)
+ **************************************************************************/
+extern const PduR_RoutingPathType PduR_RoutingTable[];
+extern const PduIdType PduR_RoutingTableSize;
+extern const PduR_CanRxPduConfigType PduR_CanRxPdus[];
+extern const uint16 PduR_CanRxPduCount;
+extern const PduR_CanTxPduConfigType PduR_CanTxPdus[];
+extern const PduIdType PduR_CanTxPduCount;
+
 /**************************************************************************
  * @brief   Khởi tạo hệ thống PDU Router
  * @param   None
@@ -31,6 +110,59 @@ typedef struct {
  **************************************************************************/
 void PduR_Init(void);
 
+/**************************************************************************
+ * @brief   Định tuyến một PDU nhận được đến tất cả các đích của nó
+ * @details Tất cả các đích dùng chung bộ đệm PDU của nguồn, người gọi vẫn
+ *          giữ tham chiếu của mình sau khi hàm kết thúc.
+ * @param   RxPduId         ID của PDU nguồn
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Trả về E_OK nếu PDU được chuyển hoặc lưu vào bộ
+ *                                 đệm gateway ở tất cả các đích,
+ *                                 E_NOT_OK nếu PDU không có đường định tuyến
+ **************************************************************************/
+Std_ReturnType PduR_RxIndication(PduIdType RxPduId, PduBuf_HandleType Buffer);
+
+/**************************************************************************
+ * @brief   Hàm báo nhận thông điệp cho mailbox nhận của CAN
+ * @param   Hrh         Mailbox nhận (không dùng, định tuyến chỉ theo CanId)
+ * @param   CanId       ID của thông điệp CAN nhận được
+ * @param   Buffer      Bộ đệm chứa dữ liệu của thông điệp
+ * @return 	None
+ **************************************************************************/
+void PduR_CanRxIndication(Can_HwHandleType Hrh, Can_IdType CanId, PduBuf_HandleType Buffer);
+
+/**************************************************************************
+ * @brief   Gửi lại các PDU đang chờ trong các bộ đệm gateway
+ * @param   None
+ * @return 	None
+ **************************************************************************/
+void PduR_MainFunction(void);
+
+/**************************************************************************
+ * @brief   Chuyển PDU đến CAN (đích của đường định tuyến)
+ * @param   DestPduId       ID của PDU trong bảng PduR_CanTxPdus
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Trả về E_OK nếu PDU được đưa vào mailbox gửi,
+ *                                 E_NOT_OK nếu mailbox đầy
+ **************************************************************************/
+Std_ReturnType PduR_CanTransmit(PduIdType DestPduId, PduBuf_HandleType Buffer);
+
+/**************************************************************************
+ * @brief   Chuyển PDU đến LIN (đích của đường định tuyến, giả lập)
+ * @param   DestPduId       ID của PDU ở LIN
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Luôn trả về E_OK
+ **************************************************************************/
+Std_ReturnType PduR_LinTransmit(PduIdType DestPduId, PduBuf_HandleType Buffer);
+
+/**************************************************************************
+ * @brief   Chuyển PDU đến Ethernet (đích của đường định tuyến, giả lập)
+ * @param   DestPduId       ID của PDU ở Ethernet
+ * @param   Buffer          Bộ đệm chứa dữ liệu của PDU
+ * @return 	Std_ReturnType  Luôn trả về E_OK
+ **************************************************************************/
+Std_ReturnType PduR_EthernetTransmit(PduIdType DestPduId, PduBuf_HandleType Buffer);
+
 /**************************************************************************
  * @brief   Định tuyến PDU dựa trên giao thức
  * @param   pdu     Con trỏ đến PDU cần định tuyến
@@ -0,0 +1,48 @@
+#include "Pdu_Router_Cfg.h"
+
+/**************************************************************************
+ * @brief Bộ đệm gateway của từng đích (mỗi đường định tuyến một bộ đệm)
+ **************************************************************************/
+static PduR_GatewayBufferType PduR_Buffer_VehicleStatus_Can;
+static PduR_GatewayBufferType PduR_Buffer_VehicleStatus_Lin;
+static PduR_GatewayBufferType PduR_Buffer_VehicleStatus_Eth;
+static PduR_GatewayBufferType PduR_Buffer_BatteryStatus_Eth;
+
+/**************************************************************************
+ * @brief Các đích của từng PDU nguồn
+ **************************************************************************/
+static const PduR_DestinationType PduR_Dest_VehicleStatus[] = {
+    {PduR_CanTransmit, PDUR_CAN_TX_PDU_VEHICLE_STATUS_GW, &PduR_Buffer_VehicleStatus_Can},
+    {PduR_LinTransmit, PDUR_LIN_PDU_VEHICLE_STATUS, &PduR_Buffer_VehicleStatus_Lin},
+    {PduR_EthernetTransmit, PDUR_ETH_PDU_VEHICLE_STATUS, &PduR_Buffer_VehicleStatus_Eth},
+};
+
+static const PduR_DestinationType PduR_Dest_BatteryStatus[] = {
+    {PduR_EthernetTransmit, PDUR_ETH_PDU_BATTERY_STATUS, &PduR_Buffer_BatteryStatus_Eth},
+};
+
+/**************************************************************************
+ * @brief Bảng định tuyến, đánh chỉ số trực tiếp bằng ID của PDU nguồn
+ **************************************************************************/
+const PduR_RoutingPathType PduR_RoutingTable[PDUR_NUM_SRC_PDUS] = {
+    [PDUR_SRC_PDU_VEHICLE_STATUS] = {PduR_Dest_VehicleStatus, sizeof(PduR_Dest_VehicleStatus) / sizeof(PduR_Dest_VehicleStatus[0])},
+    [PDUR_SRC_PDU_BATTERY_STATUS] = {PduR_Dest_BatteryStatus, sizeof(PduR_Dest_BatteryStatus) / sizeof(PduR_Dest_BatteryStatus[0])},
+};
+const PduIdType PduR_RoutingTableSize = PDUR_NUM_SRC_PDUS;
+
+/**************************************************************************
+ * @brief Ánh xạ ID thông điệp CAN nhận được sang PDU nguồn
+ **************************************************************************/
+const PduR_CanRxPduConfigType PduR_CanRxPdus[] = {
+    {0x100, PDUR_SRC_PDU_VEHICLE_STATUS},
+    {0x200, PDUR_SRC_PDU_BATTERY_STATUS},
+};
+const uint16 PduR_CanRxPduCount = sizeof(PduR_CanRxPdus) / sizeof(PduR_CanRxPdus[0]);
+
+/**************************************************************************
+ * @brief Các PDU đích được gửi qua CAN, đánh chỉ số bằng ID của PDU đích
+ **************************************************************************/
+const PduR_CanTxPduConfigType PduR_CanTxPdus[PDUR_NUM_CAN_TX_PDUS] = {
+    [PDUR_CAN_TX_PDU_VEHICLE_STATUS_GW] = {CAN_HOH_TX_DEFAULT, 0x300},
+};
+const PduIdType PduR_CanTxPduCount = PDUR_NUM_CAN_TX_PDUS;
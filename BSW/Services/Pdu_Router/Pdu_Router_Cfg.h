@@ -0,0 +1,24 @@
+#ifndef PDU_ROUTER_CFG_H
+#define PDU_ROUTER_CFG_H
+
+#include "Pdu_Router.h"
+
+/**************************************************************************
+ * @brief Định nghĩa ID của các PDU nguồn (chỉ số của bảng định tuyến)
+ **************************************************************************/
+#define PDUR_SRC_PDU_VEHICLE_STATUS         (PduIdType)0    /* Trạng thái xe (CAN 0x100) */
+#define PDUR_SRC_PDU_BATTERY_STATUS         (PduIdType)1    /* Trạng thái pin (CAN 0x200) */
+#define PDUR_NUM_SRC_PDUS                   2
+
+/**************************************************************************
+ * @brief Định nghĩa ID của các PDU đích ở từng module
+ **************************************************************************/
+#define PDUR_CAN_TX_PDU_VEHICLE_STATUS_GW   (PduIdType)0    /* Gateway trạng thái xe (CAN 0x300) */
+#define PDUR_NUM_CAN_TX_PDUS                1
+
+#define PDUR_LIN_PDU_VEHICLE_STATUS         (PduIdType)0    /* Trạng thái xe trên LIN */
+
+#define PDUR_ETH_PDU_VEHICLE_STATUS         (PduIdType)0    /* Trạng thái xe trên Ethernet */
+#define PDUR_ETH_PDU_BATTERY_STATUS         (PduIdType)1    /* Trạng thái pin trên Ethernet */
+
+#endif /* PDU_ROUTER_CFG_H */
@@ -8,156 +8,342 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Os.h"
+#include "Log.h"
+#include "Mem.h"
+#include "Can.h"
+#include "Can_VirtualBus.h"
+#include "Dem.h"
+#include "NvM.h"
+#include "Pdu_Buffer.h"
+#include "Pdu_Router.h"
 #include "Torque_Control.h"
 #include "Regen_Brake_Control.h"
 #include "Traction_Control.h"
 #include <stdio.h>
+#include <signal.h>
 
 /**************************************************************************
- * @brief   Biến mutex để bảo vệ việc truy cập tài nguyên chia sẻ
- * @details Mutex được sử dụng để đồng bộ hóa việc truy cập vào tài nguyên 
- *          chia sẻ, đảm bảo các task không gây ra xung đột khi truy cập
- *          các phần dữ liệu chung hoặc khi in ra màn hình console.
- *          Mutex sẽ được khóa khi một task cần truy cập tài nguyên và sẽ 
- *          mở khóa khi không còn cần sử dụng tài nguyên nữa.
+ * @brief Chế độ thời gian hệ thống, có thể chọn khi biên dịch, ví dụ:
+ *        -DOS_CFG_TIME_MODE=OS_TIME_MODE_DISCRETE để chạy kiểm thử hồi quy
  **************************************************************************/
-pthread_mutex_t mtx;
+#ifndef OS_CFG_TIME_MODE
+#define OS_CFG_TIME_MODE                OS_TIME_MODE_REALTIME
+#endif
+#ifndef OS_CFG_TIME_SCALE
+#define OS_CFG_TIME_SCALE               100     /* Hệ số tăng tốc cho OS_TIME_MODE_SCALED */
+#endif
 
 /**************************************************************************
- * @brief Các hàm task được sử dụng để khởi tạo và liên tục cập nhật các 
- *        hệ thống điều khiển.
+ * @brief Thời gian chạy của chương trình (ms, thời gian hệ thống), ví dụ:
+ *        -DMAIN_CFG_RUN_TIME_MS=60000. Bằng 0 thì chạy đến khi nhận SIGINT
+ *        (Ctrl+C) hoặc SIGTERM
  **************************************************************************/
-void* Task_TorqueControl(); // Điều khiển mô-men xoắn
-void* Task_RegenBrakeControl(); // Điều khiển phanh tái sinh
-void* Task_TractionControl(); // Điều khiển lực kéo
+#ifndef MAIN_CFG_RUN_TIME_MS
+#define MAIN_CFG_RUN_TIME_MS            0
+#endif
+#define MAIN_STOP_POLL_MS               100     /* Chu kỳ kiểm tra yêu cầu dừng */
 
 /**************************************************************************
- * @brief   Hàm chạy chương trình chính
- * @details Trong chương trình chính sẽ khởi tạo hệ điều hành và các task,
- *          các task sẽ khởi tạo và cập nhật liên tục thông tin của các 
- *          hệ thống và in ra màn hình console.
+ * @brief Tên bus CAN ảo để nhiều tiến trình ECU trao đổi thông điệp, ví dụ:
+ *        -DCAN_CFG_VIRTUAL_BUS=\"vcan0\" (không định nghĩa: chế độ loopback)
  **************************************************************************/
-int main() {
-    /* Khởi tạo hệ điều hành */ 
-    Os_Init();
-    
-    // Khởi tạo mutex
-    pthread_mutex_init(&mtx, NULL_PTR);
 
-    /* Tạo các task */  
-    // Điều khiển mô-men xoắn
-    Os_CreateTask(Task_TorqueControl, "Torque Control"); 
+/**************************************************************************
+ * @brief Chu kỳ, độ lệch và độ ưu tiên của các task tuần hoàn
+ * @details Task có chu kỳ ngắn hơn có độ ưu tiên cao hơn. Độ ưu tiên được OS
+ *          áp dụng bằng SCHED_FIFO khi được phép (xem
+ *          OS_CFG_TASK_RT_PRIORITY_BASE), task điều khiển lực kéo dùng độ
+ *          ưu tiên riêng TRACTION_CONTROL_RT_PRIORITY.
+ **************************************************************************/
+#define TORQUE_CONTROL_PERIOD_MS        10      /* Chu kỳ điều khiển mô-men xoắn */
+#define TORQUE_CONTROL_OFFSET_MS        0
+#define TORQUE_CONTROL_PRIORITY         3
 
-    // Điều khiển phanh tái sinh
-    Os_CreateTask(Task_RegenBrakeControl, "Regenerative Braking Control"); 
+#define REGEN_BRAKE_CONTROL_PERIOD_MS   100     /* Chu kỳ điều khiển phanh tái sinh */
+#define REGEN_BRAKE_CONTROL_OFFSET_MS   5
+#define REGEN_BRAKE_CONTROL_PRIORITY    2
 
-    // Điều khiển lực kéo
-    Os_CreateTask(Task_TractionControl, "Traction Control"); 
+#define TRACTION_CONTROL_PERIOD_MS      1       /* Chu kỳ điều khiển lực kéo */
+#define TRACTION_CONTROL_OFFSET_MS      0
+#define TRACTION_CONTROL_PRIORITY       4
 
-    /* Chờ các task hoàn thành */
-    Os_Shutdown();
-    
-    // Hủy mutex khi không sử dụng nữa 
-    pthread_mutex_destroy(&mtx);
+/**************************************************************************
+ * @brief Thuộc tính luồng của task điều khiển lực kéo: ghim lên một core
+ *        riêng (nên cách ly core này, ví dụ khởi động Linux với isolcpus=1),
+ *        lập lịch SCHED_FIFO, stack cố định được chạm trước
+ **************************************************************************/
+#ifndef TRACTION_CONTROL_CORE_MASK
+#define TRACTION_CONTROL_CORE_MASK      0x2ULL  /* Core 1 */
+#endif
+#define TRACTION_CONTROL_RT_PRIORITY    80
+#define TRACTION_CONTROL_STACK_SIZE     (256U * 1024U)
 
-    return 0;
-}
+#define CAN_MAIN_FUNCTION_PERIOD_MS     10      /* Chu kỳ xử lý các mailbox gửi CAN */
+#define CAN_MAIN_FUNCTION_OFFSET_MS     0
+#define CAN_MAIN_FUNCTION_PRIORITY      5
+
+#define CAN_RX_PRIORITY                 6       /* Task đọc mailbox nhận, kích hoạt khi nhận được thông điệp */
+#define CAN_RX_MAX_ACTIVATIONS          (CAN_QUEUE_SIZE / CAN_MAIN_FUNCTION_BATCH)
+
+#define DEM_MAIN_FUNCTION_PERIOD_MS     10      /* Chu kỳ xử lý các kết quả kiểm tra của DEM */
+#define DEM_MAIN_FUNCTION_OFFSET_MS     5
+#define DEM_MAIN_FUNCTION_PRIORITY      1
+
+#define NVM_MAIN_FUNCTION_PERIOD_MS     100     /* Chu kỳ ghi các khối NvM đang chờ xuống Fee */
+#define NVM_MAIN_FUNCTION_OFFSET_MS     50
+#define NVM_MAIN_FUNCTION_PRIORITY      0
+
+#define MEM_REPORT_PERIOD_MS            10000   /* Chu kỳ in báo cáo sử dụng bộ nhớ khi chạy dài */
+#define MEM_REPORT_OFFSET_MS            5000
+#define MEM_REPORT_PRIORITY             0
 
 /**************************************************************************
- * @brief   Task hệ thống điều khiển mô-men xoắn  
- * @details Hàm này sẽ khởi tạo và liên tục cập nhật các thông số cho hệ thống 
- *          điều khiển mô-men xoắn như trạng thái bàn đạp ga, tốc độ xe,
- *          tải trọng xe, mô-men xoắn của mô-tơ.  
+ * @brief Các hàm task được bộ lập lịch gọi mỗi chu kỳ để cập nhật các
+ *        hệ thống điều khiển.
+ * @details Dữ liệu dùng chung giữa các hệ thống được trao đổi qua bộ đệm
+ *          tín hiệu của RTE nên các task chạy song song mà không cần khóa chung.
  **************************************************************************/
-void* Task_TorqueControl() {
-    // Khóa mutex trước khi gọi hàm khởi tạo
-    pthread_mutex_lock(&mtx);
+void Task_TorqueControl(void); // Điều khiển mô-men xoắn
+void Task_RegenBrakeControl(void); // Điều khiển phanh tái sinh
+void Task_TractionControl(void); // Điều khiển lực kéo
+void Task_CanMainFunction(void); // Xử lý các mailbox gửi CAN và PDU Router
+void Task_CanRx(void); // Đọc các mailbox nhận CAN và gửi lại các PDU của gateway
+void Task_DemMainFunction(void); // Xử lý các kết quả kiểm tra của DEM
+void Task_NvMMainFunction(void); // Ghi các khối NvM đang chờ xuống Fee
+void Task_MemReport(void); // In báo cáo sử dụng bộ nhớ
 
-    // Gọi hàm khởi tạo Torque Control
-    TorqueControl_Init();
+/**************************************************************************
+ * @brief Thuộc tính luồng của các task cần độ trễ thấp
+ **************************************************************************/
+static const Os_TaskAttrType traction_control_attr = {
+    TRACTION_CONTROL_CORE_MASK, OS_SCHED_FIFO, TRACTION_CONTROL_RT_PRIORITY, TRACTION_CONTROL_STACK_SIZE, TRUE
+};
 
-    // Mở khóa mutex sau khi khởi tạo xong
-    pthread_mutex_unlock(&mtx);
+/**************************************************************************
+ * @brief Cấu hình các task tuần hoàn
+ **************************************************************************/
+static const Os_PeriodicTaskConfigType periodic_task_configs[] = {
+    {"Torque Control", Task_TorqueControl, TORQUE_CONTROL_PERIOD_MS, TORQUE_CONTROL_OFFSET_MS, TORQUE_CONTROL_PRIORITY, NULL_PTR},
+    {"Regenerative Braking Control", Task_RegenBrakeControl, REGEN_BRAKE_CONTROL_PERIOD_MS, REGEN_BRAKE_CONTROL_OFFSET_MS, REGEN_BRAKE_CONTROL_PRIORITY, NULL_PTR},
+    {"Traction Control", Task_TractionControl, TRACTION_CONTROL_PERIOD_MS, TRACTION_CONTROL_OFFSET_MS, TRACTION_CONTROL_PRIORITY, &traction_control_attr},
+    {"Can MainFunction", Task_CanMainFunction, CAN_MAIN_FUNCTION_PERIOD_MS, CAN_MAIN_FUNCTION_OFFSET_MS, CAN_MAIN_FUNCTION_PRIORITY, NULL_PTR},
+    {"Dem MainFunction", Task_DemMainFunction, DEM_MAIN_FUNCTION_PERIOD_MS, DEM_MAIN_FUNCTION_OFFSET_MS, DEM_MAIN_FUNCTION_PRIORITY, NULL_PTR},
+    {"NvM MainFunction", Task_NvMMainFunction, NVM_MAIN_FUNCTION_PERIOD_MS, NVM_MAIN_FUNCTION_OFFSET_MS, NVM_MAIN_FUNCTION_PRIORITY, NULL_PTR},
+    {"Mem Report", Task_MemReport, MEM_REPORT_PERIOD_MS, MEM_REPORT_OFFSET_MS, MEM_REPORT_PRIORITY, NULL_PTR},
+};
 
-    // Liên tục cập nhật hệ thống điều khiển mô-men xoắn
-    while (1) {
-        // Khóa mutex trước khi cập nhật
-        pthread_mutex_lock(&mtx);
+/**************************************************************************
+ * @brief Cấu hình task đọc mailbox nhận CAN
+ * @details Mỗi lần kích hoạt đọc tối đa CAN_MAIN_FUNCTION_BATCH thông điệp
+ *          nên CAN_RX_MAX_ACTIVATIONS lần kích hoạt xếp hàng đủ đọc hết một
+ *          mailbox đầy.
+ **************************************************************************/
+static const Os_EventTaskConfigType can_rx_task_config = {
+    "Can Rx", Task_CanRx, CAN_RX_PRIORITY, CAN_RX_MAX_ACTIVATIONS, FALSE, NULL_PTR
+};
 
-        TorqueControl_Update();
+/**************************************************************************
+ * @brief ID của task đọc mailbox nhận CAN
+ **************************************************************************/
+static Os_TaskIdType can_rx_task_id;
+static boolean can_rx_event_driven = FALSE;     /* TRUE nếu đã tạo được task đọc mailbox nhận */
 
-        // Mở khóa mutex trước sau cập nhật
-        pthread_mutex_unlock(&mtx);
+/**************************************************************************
+ * @brief Cờ yêu cầu dừng chương trình, được đặt trong hàm xử lý tín hiệu
+ **************************************************************************/
+static volatile sig_atomic_t main_stop_requested = 0;
 
-        // Tạm dừng 1 giây trước khi cập nhật tiếp
-        Os_Delay(1000);
+/**************************************************************************
+ * @brief   Hàm xử lý tín hiệu SIGINT và SIGTERM
+ * @details Chỉ đặt cờ, việc dừng OS và lưu dữ liệu được làm trong main.
+ **************************************************************************/
+static void Main_SignalHandler(int sig) {
+    (void)sig;
+    main_stop_requested = 1;
+}
+
+/**************************************************************************
+ * @brief   Chờ đến khi có yêu cầu dừng hoặc hết MAIN_CFG_RUN_TIME_MS
+ * @details Luồng chính được tính là đang chạy trong lúc chờ để ở chế độ
+ *          DISCRETE việc ngủ bằng Os_Delay đúng với cách OS tính luồng đang
+ *          chạy.
+ **************************************************************************/
+static void Main_WaitForStop(void) {
+    uint64 stop_ns = Os_GetTimeNs() + (uint64)MAIN_CFG_RUN_TIME_MS * 1000000ULL;
+
+    Os_TimeBeginBusy();
+    while (!main_stop_requested && (MAIN_CFG_RUN_TIME_MS == 0 || Os_GetTimeNs() < stop_ns)) {
+        Os_Delay(MAIN_STOP_POLL_MS);
     }
+    Os_TimeEndBusy();
+}
 
-    return NULL_PTR;
+/**************************************************************************
+ * @brief   Hàm báo có thông điệp mới trong mailbox nhận CAN
+ * @details Kích hoạt task đọc mailbox nhận thay vì chờ chu kỳ tiếp theo.
+ **************************************************************************/
+static void Main_CanRxNotification(void) {
+    Os_ActivateTask(can_rx_task_id);
 }
 
 /**************************************************************************
- * @brief   Task hệ thống điều khiển phanh tái sinh 
- * @details Hàm này sẽ khởi tạo và liên tục cập nhật các thông số cho hệ thống 
- *          điều khiển phanh tái sinh như trạng thái bàn đạp phanh, tốc độ xe,
- *          tải trọng xe, góc nghiêng của xe so với mặt đất, trạng thái pin.
+ * @brief Mailbox nhận mặc định chuyển mọi thông điệp nhận được cho PDU Router
  **************************************************************************/
-void* Task_RegenBrakeControl() {
-    // Khóa mutex trước khi gọi hàm khởi tạo
-    pthread_mutex_lock(&mtx);
+static const Can_HardwareObjectConfigType can_rx_default_config = {
+    CAN_OBJECT_TYPE_RECEIVE, 0, 0, NULL_PTR, PduR_CanRxIndication
+};
 
-    // Gọi hàm khởi tạo Regenerative Braking Control
+/**************************************************************************
+ * @brief   Hàm chạy chương trình chính
+ * @details Trong chương trình chính sẽ khởi tạo hệ điều hành và các task,
+ *          các task sẽ khởi tạo và cập nhật liên tục thông tin của các 
+ *          hệ thống và in ra màn hình console.
+ **************************************************************************/
+int main() {
+    /* Khởi tạo dịch vụ log, quản lý bộ nhớ và hệ điều hành */ 
+    Log_Init();
+    Mem_Init();
+    Os_Init();
+    Os_SetTimeMode(OS_CFG_TIME_MODE, OS_CFG_TIME_SCALE);
+
+    /* Nạp dữ liệu không bay hơi trước khi khởi tạo các module dùng NvM */
+    NvM_Init();
+    NvM_ReadAll();
+
+    /* Khởi tạo DEM, CAN, PDU Router và các hệ thống điều khiển trước khi bắt đầu lập lịch */
+    Dem_Init();
+    PduBuf_Init();
+    Can_Init();
+    PduR_Init();
+    Can_SetupHardwareObject(CAN_HOH_RX_DEFAULT, &can_rx_default_config);
+    if (Os_CreateEventTask(&can_rx_task_config, &can_rx_task_id) == E_OK) {
+        can_rx_event_driven = TRUE;
+        Can_SetRxNotification(Main_CanRxNotification);
+    }
+#ifdef CAN_CFG_VIRTUAL_BUS
+    Can_VirtualBus_Attach(CAN_CFG_VIRTUAL_BUS);
+#endif
+    TorqueControl_Init();
     RegenBrakeControl_Init();
+    TractionControl_Init();
 
-    // Mở khóa mutex sau khi khởi tạo xong
-    pthread_mutex_unlock(&mtx);
+    /* Đăng ký các task tuần hoàn */
+    for (uint8 i = 0; i < sizeof(periodic_task_configs) / sizeof(periodic_task_configs[0]); i++) {
+        Os_CreatePeriodicTask(&periodic_task_configs[i], NULL_PTR);
+    }
 
-    // Liên tục cập nhật hệ thống điều khiển phanh tái sinh
-    while (1) {
-        // Khóa mutex trước khi cập nhật
-        pthread_mutex_lock(&mtx);
+    /* Bắt đầu lập lịch theo các mốc thời gian tuyệt đối */
+    signal(SIGINT, Main_SignalHandler);
+    signal(SIGTERM, Main_SignalHandler);
+    Os_Start();
 
-        RegenBrakeControl_Update();
+    /* Chạy đến khi có yêu cầu dừng rồi chờ các task kết thúc */
+    Main_WaitForStop();
+    Os_Shutdown();
+    Dem_SetOperationCycleState(DEM_CYCLE_STATE_END);
+    NvM_WriteAll();
+#ifdef CAN_CFG_VIRTUAL_BUS
+    Can_VirtualBus_Detach();
+#endif
 
-        // Mở khóa mutex trước sau cập nhật
-        pthread_mutex_unlock(&mtx);
+    /* Vùng nhớ còn được cấp phát lúc này là vùng nhớ bị rò rỉ, các task đã
+       dừng nên việc kiểm tra byte bảo vệ cho kết quả chính xác */
+    (void)Mem_CheckIntegrity();
+    Mem_Report();
 
-        // Tạm dừng 1 giây trước khi cập nhật tiếp
-        Os_Delay(1000);
-    }
+    /* In ra các bản ghi log còn lại trước khi kết thúc */
+    Log_Flush();
 
-    return NULL_PTR;    
+    return 0;
 }
 
 /**************************************************************************
- * @brief   Task hệ thống điều khiển phanh tái sinh 
- * @details Hàm này sẽ khởi tạo và liên tục cập nhật các thông số cho hệ thống 
- *          điều khiển phanh tái sinh như trạng thái bàn đạp ga, bàn đạp phanh, 
- *          tốc độ xe, vận tốc góc các bánh xe.
+ * @brief   Task hệ thống điều khiển mô-men xoắn  
+ * @details Hàm này được bộ lập lịch gọi mỗi chu kỳ để cập nhật các thông số
+ *          cho hệ thống điều khiển mô-men xoắn như trạng thái bàn đạp ga,
+ *          tốc độ xe, tải trọng xe, mô-men xoắn của mô-tơ.  
  **************************************************************************/
-void* Task_TractionControl() {
-    // Khóa mutex trước khi gọi hàm khởi tạo
-    pthread_mutex_lock(&mtx);
+void Task_TorqueControl() {
+    TorqueControl_Update();
+}
 
-    // Gọi hàm khởi tạo Traction Control
-    TractionControl_Init();
+/**************************************************************************
+ * @brief   Task hệ thống điều khiển phanh tái sinh 
+ * @details Hàm này được bộ lập lịch gọi mỗi chu kỳ để cập nhật các thông số
+ *          cho hệ thống điều khiển phanh tái sinh như trạng thái bàn đạp phanh,
+ *          tốc độ xe, tải trọng xe, góc nghiêng của xe so với mặt đất, trạng
+ *          thái pin.
+ **************************************************************************/
+void Task_RegenBrakeControl() {
+    RegenBrakeControl_Update();
+}
 
-    // Mở khóa mutex sau khi khởi tạo xong
-    pthread_mutex_unlock(&mtx);
+/**************************************************************************
+ * @brief   Task hệ thống điều khiển lực kéo 
+ * @details Hàm này được bộ lập lịch gọi mỗi chu kỳ để cập nhật các thông số
+ *          cho hệ thống điều khiển lực kéo như trạng thái bàn đạp ga, bàn đạp
+ *          phanh, tốc độ xe, vận tốc góc các bánh xe.
+ **************************************************************************/
+void Task_TractionControl() {
+    TractionControl_Update();
+}
 
-    // Liên tục cập nhật hệ thống điều khiển lực kéo
-    while (1) {
-        // Khóa mutex trước khi cập nhật
-        pthread_mutex_lock(&mtx);
+/**************************************************************************
+ * @brief   Task xử lý các mailbox gửi CAN và PDU Router
+ * @details Hàm này được bộ lập lịch gọi mỗi chu kỳ để gửi các thông điệp
+ *          đang chờ trong các mailbox gửi. PduR_RxIndication và
+ *          PduR_MainFunction phải chạy trên cùng một task nên khi có task
+ *          đọc mailbox nhận, việc gửi lại các PDU đang chờ trong bộ đệm
+ *          gateway được giao cho task đó bằng một lần kích hoạt. Nếu không,
+ *          các mailbox nhận được đọc ở đây.
+ **************************************************************************/
+void Task_CanMainFunction() {
+    Can_MainFunction_Write();
+    if (can_rx_event_driven) {
+        (void)Os_ActivateTask(can_rx_task_id);
+    } else {
+        Can_MainFunction_Read();
+        PduR_MainFunction();
+    }
+}
 
-        TractionControl_Update();
+/**************************************************************************
+ * @brief   Task đọc các mailbox nhận CAN
+ * @details Hàm này được gọi mỗi khi task được kích hoạt từ hàm báo nhận
+ *          của CAN hoặc từ Task_CanMainFunction, chuyển các thông điệp đã
+ *          nhận cho PDU Router rồi gửi lại các PDU đang chờ trong bộ đệm
+ *          gateway.
+ **************************************************************************/
+void Task_CanRx() {
+    Can_MainFunction_Read();
+    PduR_MainFunction();
+}
 
-        // Mở khóa mutex trước sau cập nhật
-        pthread_mutex_unlock(&mtx);
+/**************************************************************************
+ * @brief   Task xử lý các kết quả kiểm tra của DEM
+ * @details Hàm này được bộ lập lịch gọi mỗi chu kỳ để gom các kết quả kiểm
+ *          tra mà các SWC đã đưa vào hàng đợi và cập nhật trạng thái sự kiện.
+ **************************************************************************/
+void Task_DemMainFunction() {
+    Dem_MainFunction();
+}
 
-        // Tạm dừng 1 giây trước khi cập nhật tiếp
-        Os_Delay(1000);
-    }
+/**************************************************************************
+ * @brief   Task ghi các khối NvM đang chờ xuống Fee
+ * @details Hàm này được bộ lập lịch gọi mỗi chu kỳ với độ ưu tiên thấp nhất,
+ *          các task điều khiển chỉ sao chép dữ liệu vào bản sao RAM còn việc
+ *          ghi và đồng bộ file giả lập flash được thực hiện ở đây.
+ **************************************************************************/
+void Task_NvMMainFunction() {
+    NvM_MainFunction();
+}
 
-    return NULL_PTR;
-}
\ No newline at end of file
+/**************************************************************************
+ * @brief   Task in báo cáo sử dụng bộ nhớ
+ * @details Hàm này được bộ lập lịch gọi định kỳ để theo dõi số byte đang
+ *          dùng và mức cao nhất của các pool khi chạy dài. Byte bảo vệ chỉ
+ *          được duyệt khi kết thúc vì các task khác đang cấp phát đồng thời.
+ **************************************************************************/
+void Task_MemReport() {
+    Mem_Report();
+}
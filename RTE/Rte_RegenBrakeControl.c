@@ -10,6 +10,15 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Rte_RegenBrakeControl.h"
+#include "Dem_Cfg.h"   // Mã các sự kiện chẩn đoán
+
+/* Các cảm biến trong tập thu thập của Regen Brake Control */
+static const IoHwAb_SensorIdType rte_regen_inputs[RTE_REGEN_NUM_INPUTS] = {
+    [RTE_REGEN_INPUT_BRAKE]         = IOHWAB_SENSOR_BRAKE,
+    [RTE_REGEN_INPUT_INCLINATION]   = IOHWAB_SENSOR_INCLINATION,
+    [RTE_REGEN_INPUT_BATTERY_SOC]   = IOHWAB_SENSOR_BATTERY_SOC,
+    [RTE_REGEN_INPUT_BATTERY_TEMP]  = IOHWAB_SENSOR_BATTERY_TEMP,
+};
 
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến bàn đạp phanh
@@ -63,6 +72,37 @@ Std_ReturnType Rte_Call_Rp_InclinationSensor_Init() {
     return IoHwAb_InclinationSensor_Init(&inclinationConfig);   // Gọi API từ IoHwAb để khởi tạo cảm biến góc nghiêng
 }
 
+/**************************************************************************
+ * @brief 	Cấu hình tập thu thập các cảm biến đầu vào của Regen Brake Control
+ * @details	Hàm này gom bàn đạp phanh, góc nghiêng và hai cảm biến pin vào
+ *          một tập để mỗi chu kỳ chỉ cần một lần chuyển đổi ADC.
+ * @param   None       
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpRegenBrakeInputs_Init(void) {
+    IoHwAb_AcqSetConfigType acqConfig = {
+        .Sensors = rte_regen_inputs,
+        .NumSensors = RTE_REGEN_NUM_INPUTS
+    };
+    return IoHwAb_Acquisition_SetupSet(IOHWAB_ACQ_SET_REGEN_BRAKE, &acqConfig);
+}
+
+/**************************************************************************
+ * @brief 	Đọc tất cả các cảm biến đầu vào của Regen Brake Control trong
+ *          một lần quét
+ * @details	Mọi giá trị trong kết quả dùng chung một mốc thời gian lấy mẫu.
+ * @param   Inputs          Con trỏ lưu kết quả, đánh chỉ số bằng RTE_REGEN_INPUT_*
+ * @return 	Std_ReturnType  Trả về E_OK nếu quét thành công,
+ *                                 E_NOT_OK nếu quét không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpRegenBrakeInputs_Scan(IoHwAb_AcqResultType* Inputs) {
+    if (Inputs == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    return IoHwAb_Acquisition_Scan(IOHWAB_ACQ_SET_REGEN_BRAKE, Inputs);
+}
+
 /**************************************************************************
  * @brief 	Đọc giá trị từ cảm biến bàn đạp phanh
  * @details	Hàm này được gọi để đọc giá trị từ cảm biến bàn đạp phanh, thông qua
@@ -108,4 +148,90 @@ Std_ReturnType Rte_Read_RpInclinationSensor_Inclination(float32* Inclination) {
         return E_NOT_OK;
     }
     return IoHwAb_InclinationSensor_Read(Inclination);    // Gọi API từ IoHwAb để đọc giá trị từ cảm biến góc nghiêng
+}
+
+/**************************************************************************
+ * @brief 	Đọc giá trị trạng thái bàn đạp phanh mới nhất
+ * @details	Hàm này trả về mẫu trạng thái bàn đạp phanh mới nhất trong bộ đệm của
+ *          IoHwAb, do tập thu thập sở hữu cảm biến lấy mẫu.
+ * @param   BrakePosition   Con trỏ lưu giá trị trạng thái bàn đạp phanh đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpBrakeInput_BrakePosition(float32* BrakePosition) {
+    if (BrakePosition == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    return IoHwAb_Acquisition_ReadLatest(IOHWAB_SENSOR_BRAKE, BrakePosition);  // Đọc mẫu mới nhất, không chuyển đổi ADC
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến bàn đạp phanh cho DEM
+ * @details	Kết quả được đưa vào hàng đợi của DEM, hàm không bị chặn.
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemBrakeSensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_BRAKE_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến trạng thái pin cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemBatterySensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_BATTERY_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra nhiệt độ pin cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemBatteryOverTemp_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_BATTERY_OVER_TEMP, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến góc nghiêng cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemInclinationSensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_INCLINATION_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Đọc tham số hiệu chỉnh phanh tái sinh từ NvM
+ * @param   CalibrationPtr  Con trỏ lưu tham số hiệu chỉnh
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMRegenBrakeCalibration_ReadBlock(NvM_RegenBrakeCalibrationType* CalibrationPtr) {
+    return NvM_ReadBlock(NVM_BLOCK_REGEN_CALIBRATION, CalibrationPtr);
+}
+
+/**************************************************************************
+ * @brief 	Đọc giá trị học được của phanh tái sinh từ NvM
+ * @param   LearnedPtr      Con trỏ lưu giá trị học được
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMRegenBrakeLearned_ReadBlock(NvM_RegenBrakeLearnedType* LearnedPtr) {
+    return NvM_ReadBlock(NVM_BLOCK_REGEN_LEARNED, LearnedPtr);
+}
+
+/**************************************************************************
+ * @brief 	Lưu giá trị học được của phanh tái sinh vào NvM
+ * @param   LearnedPtr      Con trỏ đến giá trị học được
+ * @return 	Std_ReturnType  Trả về E_OK nếu dữ liệu được ghi nhận,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMRegenBrakeLearned_WriteBlock(const NvM_RegenBrakeLearnedType* LearnedPtr) {
+    return NvM_WriteBlock(NVM_BLOCK_REGEN_LEARNED, LearnedPtr);
 }
\ No newline at end of file
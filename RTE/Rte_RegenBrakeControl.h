@@ -17,8 +17,21 @@
 #include "IoHwAb_LoadSensor.h"          // API IoHwAb để đọc cảm biến tải trọng
 #include "IoHwAb_BatterySOC.h"          // API IoHwAb để đọc trạng thái pin
 #include "IoHwAb_InclinationSensor.h"   // API IoHwAb để đọc cảm biến góc nghiêng
+#include "IoHwAb_Acquisition.h"         // API IoHwAb để đọc các cảm biến trong một lần quét
+#include "Dem.h"                          // Báo kết quả kiểm tra cho DEM
+#include "NvM_Cfg.h"                      // Dữ liệu hiệu chỉnh và giá trị học được lưu trong NvM
 #include "Std_Types.h"  
 
+/**************************************************************************
+ * @brief Thứ tự các cảm biến trong tập thu thập của Regen Brake Control
+ *        (chỉ số trong IoHwAb_AcqResultType)
+ **************************************************************************/
+#define RTE_REGEN_INPUT_BRAKE           0   /* Vị trí bàn đạp phanh (0..1) */
+#define RTE_REGEN_INPUT_INCLINATION     1   /* Góc nghiêng (độ) */
+#define RTE_REGEN_INPUT_BATTERY_SOC     2   /* Trạng thái pin (%) */
+#define RTE_REGEN_INPUT_BATTERY_TEMP    3   /* Nhiệt độ pin (°C) */
+#define RTE_REGEN_NUM_INPUTS            4
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến tốc độ
  * @param   None       
@@ -51,6 +64,22 @@ extern Std_ReturnType Rte_Read_RpSpeedSensor_Speed(float32* Speed);
  **************************************************************************/
 extern Std_ReturnType Rte_Read_RpLoadSensor_LoadWeight(float32* LoadWeight);
 
+/**************************************************************************
+ * @brief 	Đọc giá trị tốc độ xe mới nhất
+ * @param   Speed           Con trỏ lưu giá trị tốc độ xe đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+extern Std_ReturnType Rte_Read_RpVehicleSpeed_Speed(float32* Speed);
+
+/**************************************************************************
+ * @brief 	Đọc giá trị tải trọng xe mới nhất
+ * @param   LoadWeight      Con trỏ lưu giá trị tải trọng xe đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+extern Std_ReturnType Rte_Read_RpVehicleLoad_LoadWeight(float32* LoadWeight);
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến bàn đạp phanh
  * @param   None       
@@ -75,6 +104,25 @@ Std_ReturnType Rte_Call_Rp_BatterySOC_Init(void);
  **************************************************************************/
 Std_ReturnType Rte_Call_Rp_InclinationSensor_Init(void);
 
+/**************************************************************************
+ * @brief 	Cấu hình tập thu thập các cảm biến đầu vào của Regen Brake Control
+ * @details	Các cảm biến bàn đạp phanh, góc nghiêng và pin phải được khởi
+ *          tạo trước.
+ * @param   None       
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpRegenBrakeInputs_Init(void);
+
+/**************************************************************************
+ * @brief 	Đọc tất cả các cảm biến đầu vào của Regen Brake Control trong
+ *          một lần quét
+ * @param   Inputs          Con trỏ lưu kết quả, đánh chỉ số bằng RTE_REGEN_INPUT_*
+ * @return 	Std_ReturnType  Trả về E_OK nếu quét thành công,
+ *                                 E_NOT_OK nếu quét không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpRegenBrakeInputs_Scan(IoHwAb_AcqResultType* Inputs);
+
 /**************************************************************************
  * @brief 	Đọc giá trị từ cảm biến bàn đạp phanh
  * @param   BrakePosition   Con trỏ lưu giá trị bàn đạp phanh đọc được       
@@ -100,4 +148,68 @@ Std_ReturnType Rte_Read_RpBatterySOC_BatterySOC(uint16* BatterySOC, float32* Bat
  **************************************************************************/
 Std_ReturnType Rte_Read_RpInclinationSensor_Inclination(float32* Inclination);
 
+/**************************************************************************
+ * @brief 	Đọc giá trị trạng thái bàn đạp phanh mới nhất
+ * @param   BrakePosition   Con trỏ lưu giá trị trạng thái bàn đạp phanh đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpBrakeInput_BrakePosition(float32* BrakePosition);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến bàn đạp phanh cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemBrakeSensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến trạng thái pin cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemBatterySensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra nhiệt độ pin cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemBatteryOverTemp_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến góc nghiêng cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemInclinationSensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Đọc tham số hiệu chỉnh phanh tái sinh từ NvM
+ * @param   CalibrationPtr  Con trỏ lưu tham số hiệu chỉnh
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMRegenBrakeCalibration_ReadBlock(NvM_RegenBrakeCalibrationType* CalibrationPtr);
+
+/**************************************************************************
+ * @brief 	Đọc giá trị học được của phanh tái sinh từ NvM
+ * @param   LearnedPtr      Con trỏ lưu giá trị học được
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMRegenBrakeLearned_ReadBlock(NvM_RegenBrakeLearnedType* LearnedPtr);
+
+/**************************************************************************
+ * @brief 	Lưu giá trị học được của phanh tái sinh vào NvM
+ * @param   LearnedPtr      Con trỏ đến giá trị học được
+ * @return 	Std_ReturnType  Trả về E_OK nếu dữ liệu được ghi nhận,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMRegenBrakeLearned_WriteBlock(const NvM_RegenBrakeLearnedType* LearnedPtr);
+
 #endif /* RTE_REGENBRAKECONTROL_H */
\ No newline at end of file
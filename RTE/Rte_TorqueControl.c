@@ -9,6 +9,15 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Rte_TorqueControl.h"
+#include "Dem_Cfg.h"   // Mã các sự kiện chẩn đoán
+
+/* Các cảm biến trong tập thu thập của Torque Control */
+static const IoHwAb_SensorIdType rte_torque_inputs[RTE_TORQUE_NUM_INPUTS] = {
+    [RTE_TORQUE_INPUT_THROTTLE] = IOHWAB_SENSOR_THROTTLE,
+    [RTE_TORQUE_INPUT_SPEED]    = IOHWAB_SENSOR_SPEED,
+    [RTE_TORQUE_INPUT_LOAD]     = IOHWAB_SENSOR_LOAD,
+    [RTE_TORQUE_INPUT_TORQUE]   = IOHWAB_SENSOR_TORQUE,
+};
 
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến bàn đạp ga
@@ -94,6 +103,37 @@ Std_ReturnType Rte_Call_PpMotorDriver_Init() {
     return IoHwAb_MotorDriver_Init(&motorDriverConfig);  // Gọi API từ IoHwAb để khởi tạo bộ điều khiển mô-men xoắn
 }
 
+/**************************************************************************
+ * @brief 	Cấu hình tập thu thập các cảm biến đầu vào của Torque Control
+ * @details	Hàm này gom bốn cảm biến đầu vào vào một tập để mỗi chu kỳ chỉ
+ *          cần một lần chuyển đổi ADC.
+ * @param   None       
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpTorqueInputs_Init(void) {
+    IoHwAb_AcqSetConfigType acqConfig = {
+        .Sensors = rte_torque_inputs,
+        .NumSensors = RTE_TORQUE_NUM_INPUTS
+    };
+    return IoHwAb_Acquisition_SetupSet(IOHWAB_ACQ_SET_TORQUE_CONTROL, &acqConfig);
+}
+
+/**************************************************************************
+ * @brief 	Đọc tất cả các cảm biến đầu vào của Torque Control trong một lần
+ *          quét
+ * @details	Mọi giá trị trong kết quả dùng chung một mốc thời gian lấy mẫu.
+ * @param   Inputs          Con trỏ lưu kết quả, đánh chỉ số bằng RTE_TORQUE_INPUT_*
+ * @return 	Std_ReturnType  Trả về E_OK nếu quét thành công,
+ *                                 E_NOT_OK nếu quét không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpTorqueInputs_Scan(IoHwAb_AcqResultType* Inputs) {
+    if (Inputs == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    return IoHwAb_Acquisition_Scan(IOHWAB_ACQ_SET_TORQUE_CONTROL, Inputs);
+}
+
 /**************************************************************************
  * @brief 	Đọc giá trị từ cảm biến bàn đạp ga
  * @details	Hàm này được gọi để đọc giá trị từ cảm biến bàn đạp ga, thông qua
@@ -164,4 +204,110 @@ Std_ReturnType Rte_Read_RpTorqueSensor_ActualTorque(float32* ActualTorque) {
  **************************************************************************/
 Std_ReturnType Rte_Write_PpMotorDriver_SetTorque(float32 TorqueValue) {
     return IoHwAb_MotorDriver_SetTorque(TorqueValue);  // Gọi API từ IoHwAb để ghi mô-men xoắn yêu cầu tới động cơ
+}
+
+/**************************************************************************
+ * @brief 	Đọc giá trị tốc độ xe mới nhất
+ * @details	Hàm này trả về mẫu tốc độ xe mới nhất trong bộ đệm của
+ *          IoHwAb, do tập thu thập sở hữu cảm biến lấy mẫu.
+ * @param   Speed           Con trỏ lưu giá trị tốc độ xe đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpVehicleSpeed_Speed(float32* Speed) {
+    if (Speed == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    return IoHwAb_Acquisition_ReadLatest(IOHWAB_SENSOR_SPEED, Speed);  // Đọc mẫu mới nhất, không chuyển đổi ADC
+}
+
+/**************************************************************************
+ * @brief 	Đọc giá trị tải trọng xe mới nhất
+ * @details	Hàm này trả về mẫu tải trọng xe mới nhất trong bộ đệm của
+ *          IoHwAb, do tập thu thập sở hữu cảm biến lấy mẫu.
+ * @param   LoadWeight      Con trỏ lưu giá trị tải trọng xe đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpVehicleLoad_LoadWeight(float32* LoadWeight) {
+    if (LoadWeight == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    return IoHwAb_Acquisition_ReadLatest(IOHWAB_SENSOR_LOAD, LoadWeight);  // Đọc mẫu mới nhất, không chuyển đổi ADC
+}
+
+/**************************************************************************
+ * @brief 	Đọc giá trị trạng thái bàn đạp ga mới nhất
+ * @details	Hàm này trả về mẫu trạng thái bàn đạp ga mới nhất trong bộ đệm của
+ *          IoHwAb, do tập thu thập sở hữu cảm biến lấy mẫu.
+ * @param   ThrottlePosition    Con trỏ lưu giá trị trạng thái bàn đạp ga đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpThrottleInput_ThrottlePosition(float32* ThrottlePosition) {
+    if (ThrottlePosition == NULL_PTR) {
+        return E_NOT_OK;
+    }
+    return IoHwAb_Acquisition_ReadLatest(IOHWAB_SENSOR_THROTTLE, ThrottlePosition);  // Đọc mẫu mới nhất, không chuyển đổi ADC
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến bàn đạp ga cho DEM
+ * @details	Kết quả được đưa vào hàng đợi của DEM, hàm không bị chặn.
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemThrottleSensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_THROTTLE_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến tốc độ cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemSpeedSensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_SPEED_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến tải trọng cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemLoadSensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_LOAD_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến mô-men xoắn cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemTorqueSensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_TORQUE_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra bộ điều khiển động cơ cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemMotorDriver_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_MOTOR_DRIVER, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Đọc tham số hiệu chỉnh điều khiển mô-men xoắn từ NvM
+ * @param   CalibrationPtr  Con trỏ lưu tham số hiệu chỉnh
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMTorqueCalibration_ReadBlock(NvM_TorqueCalibrationType* CalibrationPtr) {
+    return NvM_ReadBlock(NVM_BLOCK_TORQUE_CALIBRATION, CalibrationPtr);
 }
\ No newline at end of file
@@ -16,8 +16,21 @@
 #include "IoHwAb_LoadSensor.h"      // API IoHwAb để đọc cảm biến tải trọng
 #include "IoHwAb_TorqueSensor.h"    // API IoHwAb để đọc mô-men xoắn thực tế
 #include "IoHwAb_MotorDriver.h"     // API IoHwAb để điều khiển mô-men xoắn động cơ
+#include "IoHwAb_Acquisition.h"     // API IoHwAb để đọc các cảm biến trong một lần quét
+#include "Dem.h"                      // Báo kết quả kiểm tra cho DEM
+#include "NvM_Cfg.h"                  // Tham số hiệu chỉnh lưu trong NvM
 #include "Std_Types.h"  
 
+/**************************************************************************
+ * @brief Thứ tự các cảm biến trong tập thu thập của Torque Control (chỉ số
+ *        trong IoHwAb_AcqResultType)
+ **************************************************************************/
+#define RTE_TORQUE_INPUT_THROTTLE   0   /* Vị trí bàn đạp ga (0..1) */
+#define RTE_TORQUE_INPUT_SPEED      1   /* Tốc độ xe (km/h) */
+#define RTE_TORQUE_INPUT_LOAD       2   /* Tải trọng (kg) */
+#define RTE_TORQUE_INPUT_TORQUE     3   /* Mô-men xoắn thực tế (Nm) */
+#define RTE_TORQUE_NUM_INPUTS       4
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến bàn đạp ga
  * @param   None       
@@ -60,6 +73,25 @@ Std_ReturnType Rte_Call_RpTorqueSensor_Init(void);
  **************************************************************************/
 Std_ReturnType Rte_Call_PpMotorDriver_Init(void);
 
+/**************************************************************************
+ * @brief 	Cấu hình tập thu thập các cảm biến đầu vào của Torque Control
+ * @details	Các cảm biến bàn đạp ga, tốc độ, tải trọng và mô-men xoắn phải
+ *          được khởi tạo trước.
+ * @param   None       
+ * @return 	Std_ReturnType  Trả về E_OK nếu cấu hình thành công,
+ *                                 E_NOT_OK nếu cấu hình không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpTorqueInputs_Init(void);
+
+/**************************************************************************
+ * @brief 	Đọc tất cả các cảm biến đầu vào của Torque Control trong một lần
+ *          quét
+ * @param   Inputs          Con trỏ lưu kết quả, đánh chỉ số bằng RTE_TORQUE_INPUT_*
+ * @return 	Std_ReturnType  Trả về E_OK nếu quét thành công,
+ *                                 E_NOT_OK nếu quét không thành công
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpTorqueInputs_Scan(IoHwAb_AcqResultType* Inputs);
+
 /**************************************************************************
  * @brief 	Đọc giá trị từ cảm biến bàn đạp ga
  * @param   ThrottlePosition    Con trỏ lưu giá trị bàn đạp ga đọc được       
@@ -100,4 +132,76 @@ Std_ReturnType Rte_Read_RpTorqueSensor_ActualTorque(float32* ActualTorque);
  **************************************************************************/
 Std_ReturnType Rte_Write_PpMotorDriver_SetTorque(float32 TorqueValue);
 
+/**************************************************************************
+ * @brief 	Đọc giá trị tốc độ xe mới nhất
+ * @param   Speed           Con trỏ lưu giá trị tốc độ xe đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpVehicleSpeed_Speed(float32* Speed);
+
+/**************************************************************************
+ * @brief 	Đọc giá trị tải trọng xe mới nhất
+ * @param   LoadWeight      Con trỏ lưu giá trị tải trọng xe đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpVehicleLoad_LoadWeight(float32* LoadWeight);
+
+/**************************************************************************
+ * @brief 	Đọc giá trị trạng thái bàn đạp ga mới nhất
+ * @param   ThrottlePosition    Con trỏ lưu giá trị trạng thái bàn đạp ga đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu mẫu hợp lệ,
+ *                                 E_NOT_OK nếu mẫu chưa có, không hợp lệ hoặc quá cũ
+ **************************************************************************/
+Std_ReturnType Rte_Read_RpThrottleInput_ThrottlePosition(float32* ThrottlePosition);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến bàn đạp ga cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemThrottleSensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến tốc độ cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemSpeedSensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến tải trọng cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemLoadSensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến mô-men xoắn cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemTorqueSensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra bộ điều khiển động cơ cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemMotorDriver_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Đọc tham số hiệu chỉnh điều khiển mô-men xoắn từ NvM
+ * @param   CalibrationPtr  Con trỏ lưu tham số hiệu chỉnh
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMTorqueCalibration_ReadBlock(NvM_TorqueCalibrationType* CalibrationPtr);
+
 #endif /* RTE_TORQUECONTROL_H */ 
\ No newline at end of file
@@ -10,6 +10,7 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Rte_TractionControl.h"
+#include "Dem_Cfg.h"   // Mã các sự kiện chẩn đoán
 
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến vận tốc góc
@@ -40,4 +41,45 @@ Std_ReturnType Rte_Call_RpWheelAngularVelSensor_Init() {
  **************************************************************************/
 Std_ReturnType Rte_Read_RpWheelAngularVelSensor_AngularVel(float32 AngularVel[WHEEL_NUMBERS]) {
     return IoHwAb_WheelAngularVel_Read(AngularVel); // Gọi API từ IoHwAb để đọc giá trị từ cảm biến vận tốc góc
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến vận tốc góc bánh xe cho DEM
+ * @details	Kết quả được đưa vào hàng đợi của DEM, hàm không bị chặn.
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemWheelSpeedSensor_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_WHEEL_SPEED_SENSOR, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra xung đột bàn đạp ga và phanh cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemPedalConflict_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_PEDAL_CONFLICT, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra độ trượt bánh xe cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemHighWheelSlip_SetEventStatus(Dem_EventStatusType EventStatus) {
+    return Dem_SetEventStatus(DEM_EVENT_HIGH_WHEEL_SLIP, EventStatus);
+}
+
+/**************************************************************************
+ * @brief 	Đọc tham số hiệu chỉnh điều khiển lực kéo từ NvM
+ * @param   CalibrationPtr  Con trỏ lưu tham số hiệu chỉnh
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMTractionCalibration_ReadBlock(NvM_TractionCalibrationType* CalibrationPtr) {
+    return NvM_ReadBlock(NVM_BLOCK_TRACTION_CALIBRATION, CalibrationPtr);
 }
\ No newline at end of file
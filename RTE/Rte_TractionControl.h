@@ -16,6 +16,9 @@
 #include "IoHwAb_BrakeSensor.h"             // API IoHwAb để đọc cảm biến bàn đạp phanh
 #include "IoHwAb_SpeedSensor.h"             // API IoHwAb để đọc cảm biến tốc độ
 #include "IoHwAb_ThrottleSensor.h"          // API IoHwAb để đọc cảm biến bàn đạp ga
+#include "IoHwAb_Acquisition.h"             // Mẫu cảm biến dùng chung giữa các SWC
+#include "Dem.h"                            // Báo kết quả kiểm tra cho DEM
+#include "NvM_Cfg.h"                        // Tham số hiệu chỉnh lưu trong NvM
 
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến tốc độ
@@ -65,6 +68,30 @@ extern Std_ReturnType Rte_Read_RpThrottleSensor_ThrottlePosition(float32* Thrott
  **************************************************************************/
 extern Std_ReturnType Rte_Read_RpBrakeSensor_BrakePosition(float32* BrakePosition);
 
+/**************************************************************************
+ * @brief 	Đọc giá trị tốc độ xe mới nhất
+ * @param   Speed           Con trỏ lưu giá trị tốc độ xe đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu tín hiệu hợp lệ,
+ *                                 E_NOT_OK nếu tín hiệu chưa được ghi hoặc không hợp lệ
+ **************************************************************************/
+extern Std_ReturnType Rte_Read_RpVehicleSpeed_Speed(float32* Speed);
+
+/**************************************************************************
+ * @brief 	Đọc giá trị trạng thái bàn đạp ga mới nhất
+ * @param   ThrottlePosition    Con trỏ lưu giá trị trạng thái bàn đạp ga đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu tín hiệu hợp lệ,
+ *                                 E_NOT_OK nếu tín hiệu chưa được ghi hoặc không hợp lệ
+ **************************************************************************/
+extern Std_ReturnType Rte_Read_RpThrottleInput_ThrottlePosition(float32* ThrottlePosition);
+
+/**************************************************************************
+ * @brief 	Đọc giá trị trạng thái bàn đạp phanh mới nhất
+ * @param   BrakePosition   Con trỏ lưu giá trị trạng thái bàn đạp phanh đọc được
+ * @return 	Std_ReturnType  Trả về E_OK nếu tín hiệu hợp lệ,
+ *                                 E_NOT_OK nếu tín hiệu chưa được ghi hoặc không hợp lệ
+ **************************************************************************/
+extern Std_ReturnType Rte_Read_RpBrakeInput_BrakePosition(float32* BrakePosition);
+
 /**************************************************************************
  * @brief 	Khởi tạo cảm biến vận tốc góc
  * @param   None       
@@ -81,4 +108,36 @@ Std_ReturnType Rte_Call_RpWheelAngularVelSensor_Init(void);
  **************************************************************************/
 Std_ReturnType Rte_Read_RpWheelAngularVelSensor_AngularVel(float32 AngularVel[WHEEL_NUMBERS]);
 
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra cảm biến vận tốc góc bánh xe cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemWheelSpeedSensor_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra xung đột bàn đạp ga và phanh cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemPedalConflict_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Báo kết quả kiểm tra độ trượt bánh xe cho DEM
+ * @param   EventStatus     Kết quả kiểm tra
+ * @return 	Std_ReturnType  Trả về E_OK nếu kết quả được ghi nhận,
+ *                                 E_NOT_OK nếu không ghi nhận được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpDemHighWheelSlip_SetEventStatus(Dem_EventStatusType EventStatus);
+
+/**************************************************************************
+ * @brief 	Đọc tham số hiệu chỉnh điều khiển lực kéo từ NvM
+ * @param   CalibrationPtr  Con trỏ lưu tham số hiệu chỉnh
+ * @return 	Std_ReturnType  Trả về E_OK nếu đọc thành công,
+ *                                 E_NOT_OK nếu khối NvM không dùng được
+ **************************************************************************/
+Std_ReturnType Rte_Call_RpNvMTractionCalibration_ReadBlock(NvM_TractionCalibrationType* CalibrationPtr);
+
 #endif /* RTE_TRACTIONCONTROL_H */
\ No newline at end of file
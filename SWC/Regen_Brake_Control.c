@@ -10,16 +10,22 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Rte_RegenBrakeControl.h"   // Bao gồm interface của RTE cho Regen Brake Control
+#include "Log.h"                // Ghi log qua dịch vụ Log
+#include "Mem.h"                // Vùng nhớ tạm của mỗi lần kích hoạt
 #include "Regen_Brake_Control.h"
 #include <stdio.h>
 
-float32 brake_input = 0.0f;             // Trạng thái bàn đạp phanh
-extern float32 current_speed;           // Tốc độ xe hiện tại (km/h)
-extern float32 load_weight;             // Tải trọng của xe (kg)
-float32 inclination_angle = 0.0f;       // Góc nghiêng của xe (độ)
-uint16 battery_soc = 0;                 // Trạng thái pin (SOC) (%)
-float32 battery_temp = 0.0f;            // Nhiệt độ pin
-boolean regenbrake_active = FALSE;      // Trạng thái phanh tái sinh
+static float32 brake_input = 0.0f;          // Trạng thái bàn đạp phanh
+static float32 current_speed = 0.0f;        // Tốc độ xe hiện tại (km/h), đọc từ RTE
+static float32 load_weight = 0.0f;          // Tải trọng của xe (kg), đọc từ RTE
+static float32 inclination_angle = 0.0f;    // Góc nghiêng của xe (độ)
+static uint16 battery_soc = 0;              // Trạng thái pin (SOC) (%)
+static float32 battery_temp = 0.0f;         // Nhiệt độ pin
+static boolean regenbrake_active = FALSE;   // Trạng thái phanh tái sinh
+static NvM_RegenBrakeCalibrationType calibration = {   // Tham số hiệu chỉnh, nạp từ NvM
+    BRAKE_INPUT_THRESHOLD, SPEED_THRESHOLD, BRAKE_COEFFICIENT, MAX_BATTERY_TEMP, INCLINATION_THRESHOLD
+};
+static NvM_RegenBrakeLearnedType learned = {0.0, 0};  // Năng lượng đã tái sinh qua các lần chạy
 
 /**************************************************************************
  * @brief 	Khởi tạo hệ thống điều khiển phanh tái sinh 
@@ -31,14 +37,25 @@ boolean regenbrake_active = FALSE;      // Trạng thái phanh tái sinh
 void RegenBrakeControl_Init() {
     Std_ReturnType status;
 
-    printf("Initializing Regenerative Braking Control system...\n");
+    LOG_INFO(SWC, "Initializing Regenerative Braking Control system...\n");
+
+    // Nạp tham số hiệu chỉnh và giá trị học được đã lưu
+    if (Rte_Call_RpNvMRegenBrakeCalibration_ReadBlock(&calibration) == E_OK) {
+        LOG_INFO(SWC, "Regen brake calibration: speed threshold %.2f km/h, brake coefficient %.2f\n",
+                      calibration.SpeedThreshold, calibration.BrakeCoefficient);
+    } else {
+        LOG_WARN(SWC, "Regen brake calibration unavailable, using defaults.\n");
+    }
+    if (Rte_Call_RpNvMRegenBrakeLearned_ReadBlock(&learned) == E_OK) {
+        LOG_INFO(SWC, "Total regenerated energy: %.2f Wh in %u activations\n", learned.RegeneratedEnergyWh, learned.ActivationCount);
+    }
 
     // Khởi tạo cảm biến bàn đạp phanh
     status = Rte_Call_RpBrakeSensor_Init();
     if (status == E_OK) {
-        printf("Brake sensor has been initialized successfully.\n");
+        LOG_INFO(SWC, "Brake sensor has been initialized successfully.\n");
     } else {
-        printf("Error initializing brake sensor.\n");
+        LOG_ERROR(SWC, "Error initializing brake sensor.\n");
         brake_input = -1.0f;
         return;
     }
@@ -64,22 +81,31 @@ void RegenBrakeControl_Init() {
     // Khởi tạo cảm biến trạng thái pin 
     status = Rte_Call_Rp_BatterySOC_Init();
     if (status == E_OK) {
-        printf("Battery SOC has been initialized successfully.\n");
+        LOG_INFO(SWC, "Battery SOC has been initialized successfully.\n");
     } else {
-        printf("Error initializing battery SOC.\n");
+        LOG_ERROR(SWC, "Error initializing battery SOC.\n");
         return;
     }
 
     // Khởi tạo cảm biến góc nghiêng
     status = Rte_Call_Rp_InclinationSensor_Init();
     if (status == E_OK) {
-        printf("Inclination sensor has been initialized successfully.\n");
+        LOG_INFO(SWC, "Inclination sensor has been initialized successfully.\n");
+    } else {
+        LOG_ERROR(SWC, "Error initializing inclination sensor.\n");
+        return;
+    }
+
+    // Gom các cảm biến đầu vào vào một tập thu thập
+    status = Rte_Call_RpRegenBrakeInputs_Init();
+    if (status == E_OK) {
+        LOG_INFO(SWC, "Regenerative braking inputs have been configured successfully.\n");
     } else {
-        printf("Error initializing inclination sensor.\n");
+        LOG_ERROR(SWC, "Error configuring regenerative braking inputs.\n");
         return;
     }
 
-    printf("The Regenerative Braking Control system is ready.\n");
+    LOG_INFO(SWC, "The Regenerative Braking Control system is ready.\n");
 }
 
 /**************************************************************************
@@ -91,27 +117,31 @@ void RegenBrakeControl_Init() {
  **************************************************************************/
 void RegenBrakeControl_Update() {
     // Đọc dữ liệu từ cảm biến tốc độ
-    // if (Rte_Read_RpSpeedSensor_Speed(&current_speed) == E_OK) {
-    //     printf("Current vehicle speed: %.2f km/h\n", current_speed);
-    // } else {
-    //     printf("Error reading speed sensor!\n");
-    // }
-    if (current_speed != -1.0f) {
-        printf("Current vehicle speed: %.2f km/h\n", current_speed);
+    if (Rte_Read_RpVehicleSpeed_Speed(&current_speed) == E_OK) {
+        LOG_INFO(SWC, "Current vehicle speed: %.2f km/h\n", current_speed);
     } else {
-        printf("Error reading speed sensor!\n");
+        LOG_ERROR(SWC, "Error reading speed sensor!\n");
+        current_speed = -1.0f;
     }
 
+    // Đọc tất cả các cảm biến đầu vào trong một lần quét, kết quả quét chỉ
+    // dùng trong chu kỳ này nên nằm trong vùng nhớ tạm của task
+    IoHwAb_AcqResultType* inputs = (IoHwAb_AcqResultType*)Mem_ScratchAlloc(sizeof(IoHwAb_AcqResultType));
+    boolean scanned = (inputs != NULL_PTR && Rte_Read_RpRegenBrakeInputs_Scan(inputs) == E_OK);
+
     // Đọc dữ liệu từ cảm biến bàn đạp phanh
-    if (Rte_Read_RpBrakeSensor_BrakePosition(&brake_input) == E_OK) {
-        printf("Brake pedal value: %.2f%%\n", brake_input * 100);
+    if (scanned && inputs->Valid[RTE_REGEN_INPUT_BRAKE]) {
+        brake_input = inputs->Values[RTE_REGEN_INPUT_BRAKE];
+        LOG_INFO(SWC, "Brake pedal value: %.2f%%\n", brake_input * 100);
+        Rte_Call_RpDemBrakeSensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     } else {
-        printf("Error reading throttle sensor!\n");
+        LOG_ERROR(SWC, "Error reading throttle sensor!\n");
+        Rte_Call_RpDemBrakeSensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
         brake_input = -1.0f;
     }
 
     // Tính lực phanh tái sinh
-    float32 regenbrake_force = (current_speed - SPEED_THRESHOLD) * BRAKE_COEFFICIENT * (brake_input / 100);
+    float32 regenbrake_force = (current_speed - calibration.SpeedThreshold) * calibration.BrakeCoefficient * (brake_input / 100);
 
     // Tính công suất tái sinh
     float32 regen_power = regenbrake_force * current_speed * KINETIC_CONVERSION_EFF;
@@ -120,98 +150,108 @@ void RegenBrakeControl_Update() {
     float32 regen_energy = regen_power * (TIME_REGEN / 3600.0f) * CHARGING_EFFICIENCY;
 
     // Kiểm tra điều kiện kích hoạt phanh tái sinh
-    if (current_speed < SPEED_THRESHOLD) {
+    if (current_speed < calibration.SpeedThreshold) {
         // Tốc độ quá thấp, không kích hoạt phanh tái sinh
-        printf("No regenerative braking because the speed is too low.\n");
-    } else if (brake_input < BRAKE_INPUT_THRESHOLD) {
+        LOG_INFO(SWC, "No regenerative braking because the speed is too low.\n");
+    } else if (brake_input < calibration.BrakeInputThreshold) {
         // Chưa nhấn phanh hoặc nhấn quá nhẹ, không kích hoạt phanh tái sinh
-        printf("No regenerative braking becausethe brake is not pressed or pressing it insufficiently.\n");
+        LOG_INFO(SWC, "No regenerative braking becausethe brake is not pressed or pressing it insufficiently.\n");
     } else {
         // Kích hoạt phanh tái sinh
         regenbrake_active = TRUE;
-        printf("Regenerative brake force activated: %.2f N\n", regenbrake_force);
-        printf("Regenerative power from regenerative brake force: %.2f W\n", regen_power);
-        printf("Regenerative energy in %.0f seconds: %.2f Wh\n", TIME_REGEN, regen_energy);
+        LOG_INFO(SWC, "Regenerative brake force activated: %.2f N\n", regenbrake_force);
+        LOG_INFO(SWC, "Regenerative power from regenerative brake force: %.2f W\n", regen_power);
+        LOG_INFO(SWC, "Regenerative energy in %.0f seconds: %.2f Wh\n", TIME_REGEN, regen_energy);
 
         // Chuyển đổi năng lượng tái sinh thành % pin nạp vào
         float32 delta_SOC = (regen_energy / BATTERY_CAPACITY) * 100;
         
         // Đọc dữ liệu từ cảm biến đo trạng thái và nhiệt độ pin
-        if (Rte_Read_RpBatterySOC_BatterySOC(&battery_soc, &battery_temp) == E_OK) {
-            if (battery_temp < MAX_BATTERY_TEMP) {
-                printf("Battery temperature is stable, and regenerative braking is available. Proceeding with recharging...\n");
-                printf("Percentage of battery recharged: %.3f%%\n", delta_SOC);
-                printf("Recharging process completed!\n");
+        if (scanned && inputs->Valid[RTE_REGEN_INPUT_BATTERY_SOC] && inputs->Valid[RTE_REGEN_INPUT_BATTERY_TEMP]) {
+            battery_soc = (uint16)(inputs->Values[RTE_REGEN_INPUT_BATTERY_SOC] + 0.5f);
+            battery_temp = inputs->Values[RTE_REGEN_INPUT_BATTERY_TEMP];
+            Rte_Call_RpDemBatterySensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
+            Rte_Call_RpDemBatteryOverTemp_SetEventStatus((battery_temp < calibration.MaxBatteryTemp) ? DEM_EVENT_STATUS_PREPASSED : DEM_EVENT_STATUS_PREFAILED);
+            if (battery_temp < calibration.MaxBatteryTemp) {
+                LOG_INFO(SWC, "Battery temperature is stable, and regenerative braking is available. Proceeding with recharging...\n");
+                LOG_INFO(SWC, "Percentage of battery recharged: %.3f%%\n", delta_SOC);
+                LOG_INFO(SWC, "Recharging process completed!\n");
+
+                // Cập nhật giá trị học được, NvM chỉ sao chép vào RAM và ghi xuống sau
+                learned.RegeneratedEnergyWh += regen_energy;
+                learned.ActivationCount++;
+                Rte_Call_RpNvMRegenBrakeLearned_WriteBlock(&learned);
             } else {
-                printf("Battery temperature is too high! Recharging paused.\n");
+                LOG_WARN(SWC, "Battery temperature is too high! Recharging paused.\n");
             }
+        } else {
+            Rte_Call_RpDemBatterySensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
         }
     }
     
     // Đọc dữ liệu từ cảm biến góc nghiêng
-    if (Rte_Read_RpInclinationSensor_Inclination(&inclination_angle) == E_OK) {
-        printf("Current vehicle inclination angle: %.2f\u00b0\n", inclination_angle); 
+    if (scanned && inputs->Valid[RTE_REGEN_INPUT_INCLINATION]) {
+        inclination_angle = inputs->Values[RTE_REGEN_INPUT_INCLINATION];
+        LOG_INFO(SWC, "Current vehicle inclination angle: %.2f\u00b0\n", inclination_angle); 
+        Rte_Call_RpDemInclinationSensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     } else {
-        printf("Error reading inclination sensor!\n");
+        LOG_ERROR(SWC, "Error reading inclination sensor!\n");
+        Rte_Call_RpDemInclinationSensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
     }
 
     // Đọc dữ liệu từ cảm biến tải trọng
-    // if (Rte_Read_RpLoadSensor_LoadWeight(&load_weight) == E_OK) {
-    //     printf("Current vehicle load: %.2f kg\n", load_weight);
-    // } else {
-    //     printf("Error reading load sensor!\n");
-    // }
-    if (load_weight != -1.0f) {
-        printf("Current vehicle load: %.2f kg\n", load_weight);
+    if (Rte_Read_RpVehicleLoad_LoadWeight(&load_weight) == E_OK) {
+        LOG_INFO(SWC, "Current vehicle load: %.2f kg\n", load_weight);
     } else {
-        printf("Error reading load sensor!\n");
+        LOG_ERROR(SWC, "Error reading load sensor!\n");
+        load_weight = -1.0f;
     }
 
     // Điều chỉnh lực phanh tái sinh theo góc nghiêng
     float32 adjusted_brakeforce = regenbrake_force * (1.0f+ (inclination_angle / 100)); 
 
     // Điều chỉnh lực phanh tái sinh theo điều kiện địa hình
-    printf("Adjusting regenerative braking force...\n");
+    LOG_INFO(SWC, "Adjusting regenerative braking force...\n");
 
     // Xe đang lên dốc
-    if (inclination_angle > INCLINATION_THRESHOLD) {    
+    if (inclination_angle > calibration.InclinationThreshold) {    
         adjusted_brakeforce *= 1.2f; // Tăng 20% lực phanh tái sinh khi lên dốc
-        printf("The vehicle is going uphill...\n");
+        LOG_INFO(SWC, "The vehicle is going uphill...\n");
 
         // Điều chỉnh theo tải trọng
         if (load_weight > 400.0f) {
             adjusted_brakeforce *= 1.1f; // Tăng thêm lực phanh cho xe nặng
-            printf("Heavy load. Increased regenerative braking force: %.2f N\n", adjusted_brakeforce);
+            LOG_INFO(SWC, "Heavy load. Increased regenerative braking force: %.2f N\n", adjusted_brakeforce);
         } else {
-            printf("Light load. Adjusted regenerative braking force appropriately: %.2f N\n", adjusted_brakeforce);
+            LOG_INFO(SWC, "Light load. Adjusted regenerative braking force appropriately: %.2f N\n", adjusted_brakeforce);
         }
     } 
     // Xe đang xuống dốc
-    else if (inclination_angle < - INCLINATION_THRESHOLD) {   
+    else if (inclination_angle < - calibration.InclinationThreshold) {   
         adjusted_brakeforce *= 0.8f; // Giảm 20% lực phanh tái sinh khi xuống dốc
-        printf("The vehicle í going downhill...\n");
+        LOG_INFO(SWC, "The vehicle í going downhill...\n");
 
         // Điều chỉnh theo tải trọng
         if (load_weight > 400.0f) {
             adjusted_brakeforce *= 1.05f; // Xe nặng vẫn cần giữ lực phanh
-            printf("Heavy load. Slightly reduced braking force but maintained: %.2f N\n", adjusted_brakeforce);
+            LOG_INFO(SWC, "Heavy load. Slightly reduced braking force but maintained: %.2f N\n", adjusted_brakeforce);
         } else {
-            printf("Light load. Reduced regenerative braking force slightly: %.2f N\n", adjusted_brakeforce);
+            LOG_INFO(SWC, "Light load. Reduced regenerative braking force slightly: %.2f N\n", adjusted_brakeforce);
         }        
     }
     // Xe đang đi trên đường bằng
     else {
-        printf("The vehicle is moving on a flat surface...\n");
+        LOG_INFO(SWC, "The vehicle is moving on a flat surface...\n");
 
         // Điều chỉnh theo tải trọng
         if (load_weight > 400.0f) {
             adjusted_brakeforce *= 1.05f; // Xe nặng tăng thêm lực phanh
-            printf("Heavy load. Increased regenerative braking force: %.2f N\n", adjusted_brakeforce);
+            LOG_INFO(SWC, "Heavy load. Increased regenerative braking force: %.2f N\n", adjusted_brakeforce);
         } else {
-            printf("Light load. Normal regenerative braking force: %.2f N\n", adjusted_brakeforce);
+            LOG_INFO(SWC, "Light load. Normal regenerative braking force: %.2f N\n", adjusted_brakeforce);
         }
     }
 
     // Hoàn tất quá trình cập nhật
-    printf("Regenerative braking control system update completed!\n");
+    LOG_INFO(SWC, "Regenerative braking control system update completed!\n");
 }
\ No newline at end of file
@@ -15,6 +15,8 @@
 
 /**************************************************************************
  * @brief Định nghĩa các thông số cho hệ thống phanh tái sinh
+ * @details Các ngưỡng và hệ số phanh là giá trị mặc định của tham số hiệu
+ *          chỉnh, giá trị đang dùng được nạp từ NvM khi khởi tạo.
  **************************************************************************/
 #define CHARGING_EFFICIENCY 0.85f       /* Hiệu suất sạc pin (85%) */
 #define KINETIC_CONVERSION_EFF 0.8f     /* Hiệu suất chuyển đổi động năng (80%) */
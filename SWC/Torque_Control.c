@@ -10,14 +10,17 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Rte_TorqueControl.h"   // Bao gồm interface của RTE cho Torque Control
+#include "Log.h"                // Ghi log qua dịch vụ Log
+#include "Mem.h"                // Vùng nhớ tạm của mỗi lần kích hoạt
 #include "Torque_Control.h"
 #include <stdio.h>  
 
-float32 throttle_input = 0.0f;  // Trạng thái bàn đạp ga
-float32 current_speed = 0.0f;   // Tốc độ xe hiện tại (km/h)
-float32 load_weight = 0.0f;     // Tải trọng của xe (kg)
-float32 actual_torque = 0.0f;   // Mô-men xoắn thực tế (Nm)
-float32 desired_torque = 0.0f;  // Mô-men xoắn yêu cầu (Nm)
+static float32 throttle_input = 0.0f;  // Trạng thái bàn đạp ga
+static float32 current_speed = 0.0f;   // Tốc độ xe hiện tại (km/h)
+static float32 load_weight = 0.0f;     // Tải trọng của xe (kg)
+static float32 actual_torque = 0.0f;   // Mô-men xoắn thực tế (Nm)
+static float32 desired_torque = 0.0f;  // Mô-men xoắn yêu cầu (Nm)
+static NvM_TorqueCalibrationType calibration = {MAX_TORQUE, MIN_TORQUE};   // Tham số hiệu chỉnh, nạp từ NvM
 
 /**************************************************************************
  * @brief 	Khởi tạo hệ thống điều khiển mô-men xoắn  
@@ -30,14 +33,21 @@ void TorqueControl_Init() {
     // Khởi tạo các cảm biến bàn đạp ga, tốc độ và tải trọng
     Std_ReturnType status;
 
-    printf("Initializing Torque Control system...\n");
+    LOG_INFO(SWC, "Initializing Torque Control system...\n");
+
+    // Nạp tham số hiệu chỉnh đã lưu (giữ giá trị mặc định nếu không đọc được)
+    if (Rte_Call_RpNvMTorqueCalibration_ReadBlock(&calibration) == E_OK) {
+        LOG_INFO(SWC, "Torque calibration: max %.2f Nm, min %.2f Nm\n", calibration.MaxTorque, calibration.MinTorque);
+    } else {
+        LOG_WARN(SWC, "Torque calibration unavailable, using defaults.\n");
+    }
 
     // Khởi tạo cảm biến bàn đạp ga
     status = Rte_Call_RpThrottleSensor_Init();
     if (status == E_OK) {
-        printf("Throttle sensor has been initialized successfully.\n");
+        LOG_INFO(SWC, "Throttle sensor has been initialized successfully.\n");
     } else {
-        printf("Error initializing throttle sensor.\n");
+        LOG_ERROR(SWC, "Error initializing throttle sensor.\n");
         throttle_input = -1.0f;
         return;
     }
@@ -45,9 +55,9 @@ void TorqueControl_Init() {
     // Khởi tạo cảm biến tốc độ
     status = Rte_Call_RpSpeedSensor_Init();
     if (status == E_OK) {
-        printf("Speed sensor has been initialized successfully.\n");
+        LOG_INFO(SWC, "Speed sensor has been initialized successfully.\n");
     } else {
-        printf("Error initializing speed sensor.\n");
+        LOG_ERROR(SWC, "Error initializing speed sensor.\n");
         current_speed = -1.0f;
         return;
     }
@@ -55,9 +65,9 @@ void TorqueControl_Init() {
     // Khởi tạo cảm biến tải trọng
     status = Rte_Call_RpLoadSensor_Init();
     if (status == E_OK) {
-        printf("Load sensor has been initialized successfully.\n");
+        LOG_INFO(SWC, "Load sensor has been initialized successfully.\n");
     } else {
-        printf("Error initializing load sensor.\n");
+        LOG_ERROR(SWC, "Error initializing load sensor.\n");
         load_weight = -1.0f;
         return;
     }
@@ -65,22 +75,31 @@ void TorqueControl_Init() {
     // Khởi tạo cảm biến mô-men xoắn thực tế
     status = Rte_Call_RpTorqueSensor_Init();
     if (status == E_OK) {
-        printf("Torque sensor has been initialized successfully.\n");
+        LOG_INFO(SWC, "Torque sensor has been initialized successfully.\n");
     } else {
-        printf("Error initializing torque sensor.\n");
+        LOG_ERROR(SWC, "Error initializing torque sensor.\n");
+        return;
+    }
+
+    // Gom các cảm biến đầu vào vào một tập thu thập
+    status = Rte_Call_RpTorqueInputs_Init();
+    if (status == E_OK) {
+        LOG_INFO(SWC, "Torque control inputs have been configured successfully.\n");
+    } else {
+        LOG_ERROR(SWC, "Error configuring torque control inputs.\n");
         return;
     }
 
     // Khởi tạo bộ điều khiển mô-men xoắn (có thể là PWM hoặc module điều khiển động cơ)
     status = Rte_Call_PpMotorDriver_Init();
     if (status == E_OK) {
-        printf("Motor driver has been initialized successfully.\n");
+        LOG_INFO(SWC, "Motor driver has been initialized successfully.\n");
     } else {
-        printf("Error initializing motor driver.\n");
+        LOG_ERROR(SWC, "Error initializing motor driver.\n");
         return;
     }
 
-    printf("The Torque Control system is ready.\n");
+    LOG_INFO(SWC, "The Torque Control system is ready.\n");
 }
 
 /**************************************************************************
@@ -91,32 +110,46 @@ void TorqueControl_Init() {
  * @return 	None
  **************************************************************************/
 void TorqueControl_Update() {
+    // Đọc tất cả các cảm biến đầu vào trong một lần quét, kết quả quét nằm
+    // trong vùng nhớ tạm của task
+    IoHwAb_AcqResultType* inputs = (IoHwAb_AcqResultType*)Mem_ScratchAlloc(sizeof(IoHwAb_AcqResultType));
+    boolean scanned = (inputs != NULL_PTR && Rte_Read_RpTorqueInputs_Scan(inputs) == E_OK);
+
     // Đọc dữ liệu từ cảm biến bàn đạp ga
-    if (Rte_Read_RpThrottleSensor_ThrottlePosition(&throttle_input) == E_OK) {
-        printf("Throttle pedal value: %.2f%%\n", throttle_input * 100);
+    if (scanned && inputs->Valid[RTE_TORQUE_INPUT_THROTTLE]) {
+        throttle_input = inputs->Values[RTE_TORQUE_INPUT_THROTTLE];
+        LOG_INFO(SWC, "Throttle pedal value: %.2f%%\n", throttle_input * 100);
+        Rte_Call_RpDemThrottleSensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     } else {
-        printf("Error reading throttle sensor!\n");
+        LOG_ERROR(SWC, "Error reading throttle sensor!\n");
+        Rte_Call_RpDemThrottleSensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
         throttle_input = -1.0f;
     }
 
     // Đọc dữ liệu từ cảm biến tốc độ
-    if (Rte_Read_RpSpeedSensor_Speed(&current_speed) == E_OK) {
-        printf("Current vehicle speed: %.2f km/h\n", current_speed);
+    if (scanned && inputs->Valid[RTE_TORQUE_INPUT_SPEED]) {
+        current_speed = inputs->Values[RTE_TORQUE_INPUT_SPEED];
+        LOG_INFO(SWC, "Current vehicle speed: %.2f km/h\n", current_speed);
+        Rte_Call_RpDemSpeedSensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     } else {
-        printf("Error reading speed sensor!\n");
+        LOG_ERROR(SWC, "Error reading speed sensor!\n");
+        Rte_Call_RpDemSpeedSensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
         current_speed = -1.0f;
     }
 
     // Đọc dữ liệu từ cảm biến tải trọng
-    if (Rte_Read_RpLoadSensor_LoadWeight(&load_weight) == E_OK) {
-        printf("Current load weight: %.2f kg\n", load_weight);
+    if (scanned && inputs->Valid[RTE_TORQUE_INPUT_LOAD]) {
+        load_weight = inputs->Values[RTE_TORQUE_INPUT_LOAD];
+        LOG_INFO(SWC, "Current load weight: %.2f kg\n", load_weight);
+        Rte_Call_RpDemLoadSensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     } else {
-        printf("Error reading load sensor!\n");
+        LOG_ERROR(SWC, "Error reading load sensor!\n");
+        Rte_Call_RpDemLoadSensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
         load_weight = -1.0f;
     }
 
     // Tính toán mô-men xoắn yêu cầu
-    desired_torque = throttle_input * MAX_TORQUE;
+    desired_torque = throttle_input * calibration.MaxTorque;
     if (current_speed > 50.0f) {
         desired_torque *= 0.8f;  // Giảm mô-men xoắn nếu tốc độ cao
     }
@@ -125,36 +158,41 @@ void TorqueControl_Update() {
     }
 
     // Giới hạn mô-men xoắn trong phạm vi an toàn
-    if (desired_torque > MAX_TORQUE) {
-        desired_torque = MAX_TORQUE;
-    } else if (desired_torque < MIN_TORQUE) {
-        desired_torque = MIN_TORQUE;
+    if (desired_torque > calibration.MaxTorque) {
+        desired_torque = calibration.MaxTorque;
+    } else if (desired_torque < calibration.MinTorque) {
+        desired_torque = calibration.MinTorque;
     }
 
     // In ra mô-men xoắn yêu cầu
-    printf("Desired torque: %.2f Nm\n", desired_torque);
+    LOG_INFO(SWC, "Desired torque: %.2f Nm\n", desired_torque);
 
     // Ghi mô-men xoắn yêu cầu tới bộ điều khiển động cơ
     if (Rte_Write_PpMotorDriver_SetTorque(desired_torque) == E_OK) {
-        printf("Desired torque has been sent to the motor.\n");
+        LOG_INFO(SWC, "Desired torque has been sent to the motor.\n");
+        Rte_Call_RpDemMotorDriver_SetEventStatus(DEM_EVENT_STATUS_PASSED);
     } else {
-        printf("Error sending torque to the motor!\n");
+        LOG_ERROR(SWC, "Error sending torque to the motor!\n");
+        Rte_Call_RpDemMotorDriver_SetEventStatus(DEM_EVENT_STATUS_FAILED);
     }
 
-    // Đọc mô-men xoắn thực tế để so sánh với mô-men xoắn yêu cầu
-    if (Rte_Read_RpTorqueSensor_ActualTorque(&actual_torque) == E_OK) {
-        printf("Actual torque: %.2f Nm\n", actual_torque);
+    // Mô-men xoắn thực tế (lấy mẫu cùng lúc với các đầu vào) để so sánh với mô-men xoắn yêu cầu
+    if (scanned && inputs->Valid[RTE_TORQUE_INPUT_TORQUE]) {
+        actual_torque = inputs->Values[RTE_TORQUE_INPUT_TORQUE];
+        LOG_INFO(SWC, "Actual torque: %.2f Nm\n", actual_torque);
+        Rte_Call_RpDemTorqueSensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     } else {
-        printf("Error reading actual torque!\n");
+        LOG_ERROR(SWC, "Error reading actual torque!\n");
+        Rte_Call_RpDemTorqueSensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
     }
 
     // So sánh và điều chỉnh nếu có sự sai lệch giữa mô-men xoắn thực tế và yêu cầu
     if (actual_torque < desired_torque) {
-        printf("Increase torque to reach the desired torque.\n");
+        LOG_INFO(SWC, "Increase torque to reach the desired torque.\n");
     } else if (actual_torque > desired_torque) {
-        printf("Decrease torque to reach the desired torque.\n");
+        LOG_INFO(SWC, "Decrease torque to reach the desired torque.\n");
     }
 
     // Hoàn tất quá trình cập nhật 
-    printf("Torque control system update completed!\n");
+    LOG_INFO(SWC, "Torque control system update completed!\n");
 }
\ No newline at end of file
@@ -15,6 +15,8 @@
 
 /**************************************************************************
  * @brief Định nghĩa giá trị mô-men xoắn tối đa và tối thiểu
+ * @details Đây là giá trị mặc định của tham số hiệu chỉnh, giá trị đang dùng
+ *          được nạp từ NvM khi khởi tạo.
  **************************************************************************/
 #define MAX_TORQUE 100.0f   /* Giá trị mô-men xoắn tối đa */
 #define MIN_TORQUE 0.0f     /* Giá trị mô-men xoắn tối thiểu */
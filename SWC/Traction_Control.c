@@ -10,14 +10,18 @@
  * @author  Tran Quang Khai
  ***************************************************************************/
 #include "Rte_TractionControl.h"   // Bao gồm interface của RTE cho Traction Control
+#include "Log.h"                // Ghi log qua dịch vụ Log
+#include "Mem.h"                // Vùng nhớ tạm của mỗi lần kích hoạt
 #include "Traction_Control.h"
+#include "Traction_WheelSlip.h"    // Tính độ trượt của các bánh xe
 #include <stdio.h>
-#include <math.h>
 
-extern float32 throttle_input;      // Trạng thái bàn đạp ga
-extern float32 brake_input;         // Trạng thái bàn đạp phanh
-extern float32 current_speed;       // Tốc độ xe hiện tại (km/h)
-float32 wheel_angular_vel[WHEEL_NUMBERS] = {0.0f};  // Vận tốc góc các bánh xe (rad/s)
+static float32 throttle_input = 0.0f;   // Trạng thái bàn đạp ga, đọc từ RTE
+static float32 brake_input = 0.0f;      // Trạng thái bàn đạp phanh, đọc từ RTE
+static float32 current_speed = 0.0f;    // Tốc độ xe hiện tại (km/h), đọc từ RTE
+static float32 wheel_angular_vel[WHEEL_NUMBERS] = {0.0f};  // Vận tốc góc các bánh xe (rad/s)
+static boolean pedal_conflict = FALSE;  // Hai bàn đạp đang được nhấn cùng lúc (chỉ cảnh báo khi bắt đầu)
+static NvM_TractionCalibrationType calibration = {SLIP_THRESHOLD, BRAKE_THRESHOLD};   // Tham số hiệu chỉnh, nạp từ NvM
 
 /**************************************************************************
  * @brief 	Khởi tạo hệ thống điều khiển lực kéo
@@ -29,7 +33,15 @@ float32 wheel_angular_vel[WHEEL_NUMBERS] = {0.0f};  // Vận tốc góc các bá
 void TractionControl_Init() {
     Std_ReturnType status;
 
-    printf("Initializing Traction Control system...\n");
+    LOG_INFO(SWC, "Initializing Traction Control system...\n");
+
+    // Nạp tham số hiệu chỉnh đã lưu (giữ giá trị mặc định nếu không đọc được)
+    if (Rte_Call_RpNvMTractionCalibration_ReadBlock(&calibration) == E_OK) {
+        LOG_INFO(SWC, "Traction calibration: slip threshold %.2f, brake threshold %.2f\n",
+                      calibration.SlipThreshold, calibration.BrakeThreshold);
+    } else {
+        LOG_WARN(SWC, "Traction calibration unavailable, using defaults.\n");
+    }
 
     // // Khởi tạo cảm biến bàn đạp ga (nếu chưa khởi tạo)
     // status = Rte_Call_RpThrottleSensor_Init();
@@ -61,13 +73,13 @@ void TractionControl_Init() {
     // Khởi tạo cảm biến vận tốc góc
     status = Rte_Call_RpWheelAngularVelSensor_Init();
     if (status == E_OK) {
-        printf("Wheel angular velocity sensor has been initialized successfully.\n");
+        LOG_INFO(SWC, "Wheel angular velocity sensor has been initialized successfully.\n");
     } else {
-        printf("Error initializing wheel angular velocity sensor.\n");
+        LOG_ERROR(SWC, "Error initializing wheel angular velocity sensor.\n");
         return;
     }
 
-    printf("The Traction Control system is ready.\n");
+    LOG_INFO(SWC, "The Traction Control system is ready.\n");
 }
 
 /**************************************************************************
@@ -79,91 +91,88 @@ void TractionControl_Init() {
  **************************************************************************/
 void TractionControl_Update() {
     // Đọc dữ liệu từ cảm biến bàn đạp ga
-    // if (Rte_Read_RpThrottleSensor_ThrottlePosition(&throttle_input) == E_OK) {
-    //     printf("Throttle pedal value: %.2f%%\n", throttle_input * 100);
-    // } else {
-    //     printf("Error reading throttle sensor!\n");
-    // }
-    if (current_speed != -1.0f) {
-        printf("Current vehicle speed: %.2f km/h\n", current_speed);
+    if (Rte_Read_RpThrottleInput_ThrottlePosition(&throttle_input) != E_OK) {
+        throttle_input = -1.0f;
+    }
+
+    // Đọc dữ liệu từ cảm biến tốc độ
+    if (Rte_Read_RpVehicleSpeed_Speed(&current_speed) == E_OK) {
+        LOG_INFO(SWC, "Current vehicle speed: %.2f km/h\n", current_speed);
     } else {
-        printf("Error reading speed sensor!\n");
+        LOG_ERROR(SWC, "Error reading speed sensor!\n");
+        current_speed = -1.0f;
     }
 
     // Đọc dữ liệu từ cảm biến bàn đạp phanh
-    // if (Rte_Read_RpBrakeSensor_BrakePosition(&brake_input) == E_OK) {
-    //     printf("Brake pedal value: %.2f%%\n", brake_input * 100);
-    // } else {
-    //     printf("Error reading throttle sensor!\n");
-    // }
-    if (brake_input != -1.0f) {
-        printf("Brake pedal value: %.2f%%\n", brake_input * 100);
+    if (Rte_Read_RpBrakeInput_BrakePosition(&brake_input) == E_OK) {
+        LOG_INFO(SWC, "Brake pedal value: %.2f%%\n", brake_input * 100);
     } else {
-        printf("Error reading throttle sensor!\n");
+        LOG_ERROR(SWC, "Error reading throttle sensor!\n");
+        brake_input = -1.0f;
     }
 
+    // Task chạy mỗi 1 ms nên chỉ cảnh báo khi xung đột bắt đầu, DEM vẫn nhận kết quả mỗi chu kỳ
     if (throttle_input > 0 && brake_input > 0) {
-        printf("Warning: Accelerator and brake pedals pressed at the same time!\n");
-    }
-
-    // Đọc dữ liệu từ cảm biến tốc độ
-    // if (Rte_Read_RpSpeedSensor_Speed(&current_speed) == E_OK) {
-    //     printf("Current vehicle speed: %.2f km/h\n", current_speed);
-    // } else {
-    //     printf("Error reading speed sensor!\n");
-    // }
-    if (current_speed != -1.0f) {
-        printf("Current vehicle speed: %.2f km/h\n", current_speed);
+        if (!pedal_conflict) {
+            LOG_WARN(SWC, "Warning: Accelerator and brake pedals pressed at the same time!\n");
+        }
+        pedal_conflict = TRUE;
+        Rte_Call_RpDemPedalConflict_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
     } else {
-        printf("Error reading speed sensor!\n");
+        pedal_conflict = FALSE;
+        Rte_Call_RpDemPedalConflict_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     }
 
     // Đọc dữ liệu từ cảm biến vận tốc góc
-    if (Rte_Read_RpWheelAngularVelSensor_AngularVel(wheel_angular_vel) == E_OK) {
-        printf("Front right wheel angular velocity: %.2f rad/s\n", wheel_angular_vel[0]); // Bánh xe trước bên phải
-        printf("Front left wheel angular velocity: %.2f rad/s\n", wheel_angular_vel[1]); // Bánh xe trước bên trái
-        printf("Rear right wheel angular velocity: %.2f rad/s\n", wheel_angular_vel[2]); // Bánh xe sau bên phải
-        printf("Rear left wheel angular velocity: %.2f rad/s\n", wheel_angular_vel[3]); // Bánh xe sau bên trái    
-        // Thông tin các bánh xe khác nếu nhiều hơn 4 bánh xe    
+    boolean wheels_valid = (Rte_Read_RpWheelAngularVelSensor_AngularVel(wheel_angular_vel) == E_OK);
+    if (wheels_valid) {
+        Rte_Call_RpDemWheelSpeedSensor_SetEventStatus(DEM_EVENT_STATUS_PREPASSED);
     } else {
-        printf("Error reading wheel angular velocity sensor!\n");
+        LOG_ERROR(SWC, "Error reading wheel angular velocity sensor!\n");
+        Rte_Call_RpDemWheelSpeedSensor_SetEventStatus(DEM_EVENT_STATUS_PREFAILED);
     }
-    
-    uint8 i;
-    float32 slip_ratio = 0.0f;  // Độ trượt bánh xe
-    float32 max_slip_ratio = 0.0f; // Độ trượt lớn nhất
-    uint16 wheel_with_max_slip; // Bánh xe trượt nhiều nhất
-    for (i = 0; i < WHEEL_NUMBERS; i++) {
-        slip_ratio = (fabs((wheel_angular_vel[i] * (WHEEL_RADIUS)) - (current_speed / (3.6f)))) 
-                    / (wheel_angular_vel[i] * (WHEEL_RADIUS));
-
-        // Giới hạn độ trượt nằm trong phạm vi từ 0.0f đến 1.0f
-        if (slip_ratio < 0) slip_ratio = 0.0f;
-        if (slip_ratio > 1) slip_ratio = 1.0f;
-
-        // Cập nhật độ trượt lớn nhất và bánh xe có độ trượt lớn nhất
-        if (slip_ratio > max_slip_ratio) {
-            max_slip_ratio = slip_ratio;
-            wheel_with_max_slip = i;
-        }
+
+    // Không có tốc độ xe hoặc vận tốc góc thì không đánh giá được độ trượt
+    if (!wheels_valid || current_speed == -1.0f) {
+        LOG_WARN(SWC, "Wheel slip not evaluated this cycle.\n");
+        return;
     }
 
+    // Độ trượt từng bánh xe chỉ dùng trong chu kỳ này nên nằm trong vùng nhớ
+    // tạm của task (NULL: chỉ tính độ trượt lớn nhất)
+    float32* wheel_slip = (float32*)Mem_ScratchAlloc(WHEEL_NUMBERS * sizeof(float32));
+    Traction_WheelSlipResultType slip;
+    if (Traction_WheelSlip_Compute(wheel_angular_vel, WHEEL_NUMBERS, WHEEL_RADIUS, current_speed / 3.6f,
+                                   wheel_slip, &slip) != E_OK) {
+        return;
+    }
+    for (uint16 i = 0; wheel_slip != NULL_PTR && i < WHEEL_NUMBERS; i++) {
+        LOG_INFO(SWC, "Wheel %d angular velocity: %.2f rad/s, slip %.2f\n", i, wheel_angular_vel[i], wheel_slip[i]);
+    }
+    float32 max_slip_ratio = slip.MaxSlip;     // Độ trượt lớn nhất
+    if (max_slip_ratio > 0.0f) {
+        LOG_INFO(SWC, "Wheel with max slip: %d\n", slip.MaxSlipWheel);
+    }
+
+    // Báo độ trượt cho DEM, lỗi khi độ trượt cao kéo dài
+    Rte_Call_RpDemHighWheelSlip_SetEventStatus((max_slip_ratio > calibration.BrakeThreshold) ? DEM_EVENT_STATUS_PREFAILED : DEM_EVENT_STATUS_PREPASSED);
+
     // Kiểm tra độ trượt và điều chỉnh  
-    if (max_slip_ratio > BRAKE_THRESHOLD) {
+    if (max_slip_ratio > calibration.BrakeThreshold) {
         // Độ trượt quá lớn, tăng chân phanh
         brake_input *= 2.0f;  
         if (brake_input > 1.0f) brake_input = 1.0f;
 
-        printf("High slip detected: %.2f, reducing throttle pedal to %.2f%%\n", 
-                max_slip_ratio, brake_input * 100);
+        LOG_INFO(SWC, "High slip detected: %.2f, reducing throttle pedal to %.2f%%\n", 
+                       max_slip_ratio, brake_input * 100);
 
-    } else if (max_slip_ratio > SLIP_THRESHOLD && max_slip_ratio < BRAKE_THRESHOLD) {
+    } else if (max_slip_ratio > calibration.SlipThreshold && max_slip_ratio < calibration.BrakeThreshold) {
         // Giảm chân ga nếu độ trượt lớn
         throttle_input *= 0.5f;  
-        printf("High slip detected: %.2f, reducing throttle pedal to %.2f%%\n", 
-                max_slip_ratio, throttle_input * 100);
+        LOG_INFO(SWC, "High slip detected: %.2f, reducing throttle pedal to %.2f%%\n", 
+                       max_slip_ratio, throttle_input * 100);
     }
     
     // Hoàn tất quá trình cập nhật 
-    printf("Traction control system update completed!\n");                           
+    LOG_INFO(SWC, "Traction control system update completed!\n");                           
 }
\ No newline at end of file
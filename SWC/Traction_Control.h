@@ -15,6 +15,8 @@
 
 /**************************************************************************
  * @brief Định nghĩa các thông số cho hệ thống điều khiển lực kéo
+ * @details SLIP_THRESHOLD và BRAKE_THRESHOLD là giá trị mặc định của tham số
+ *          hiệu chỉnh, giá trị đang dùng được nạp từ NvM khi khởi tạo.
  **************************************************************************/
 #define WHEEL_RADIUS 0.35f               /* Bán kính bánh xe (m) */               
 #define SLIP_THRESHOLD 0.2f             /* Ngưỡng trượt (20% trượt) */ 
@@ -0,0 +1,184 @@
+/***************************************************************************
+ * @file    Traction_WheelSlip.c
+ * @brief   Định nghĩa hàm tính độ trượt của các bánh xe cho điều khiển lực kéo
+ * @details File này triển khai việc tính độ trượt cho 4 bánh xe cùng lúc
+ *          bằng lệnh SSE2, các bánh xe còn lại được tính bằng vòng lặp thường
+ *          với cùng các phép toán nên kết quả của hai cách tính giống nhau.
+ *          Với 8..18 bánh xe, AVX chỉ chạy được 1..2 vòng lặp và không nhanh
+ *          hơn SSE2 nên không được dùng. Hàm không chia cho 0 khi bánh xe
+ *          đứng yên.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#include "Traction_WheelSlip.h"
+#include "Log.h"   // Ghi log qua dịch vụ Log
+
+#if (TRACTION_CFG_USE_SIMD == 1) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**************************************************************************
+ * @brief   Tính độ trượt của một bánh xe
+ * @details |w * r - v| được giới hạn bởi |w * r| nên kết quả nằm trong 0..1
+ *          mà không cần so sánh sau phép chia.
+ * @param   AngularVel      Vận tốc góc của bánh xe (rad/s)
+ * @param   WheelRadius     Bán kính bánh xe (m)
+ * @param   VehicleSpeed    Tốc độ xe (m/s)
+ * @return 	float32         Độ trượt (0..1)
+ **************************************************************************/
+static float32 Traction_WheelSlip_Scalar(float32 AngularVel, float32 WheelRadius, float32 VehicleSpeed) {
+    float32 wheelSpeed = AngularVel * WheelRadius;
+    float32 diff = wheelSpeed - VehicleSpeed;
+    float32 den = (wheelSpeed < 0.0f) ? -wheelSpeed : wheelSpeed;
+    float32 num = (diff < 0.0f) ? -diff : diff;
+
+    if (!(den >= TRACTION_WHEEL_MIN_SPEED)) {
+        // Bánh xe đứng yên (hoặc giá trị không hợp lệ): bó cứng nếu xe đang chạy
+        return (VehicleSpeed > TRACTION_WHEEL_MIN_SPEED) ? 1.0f : 0.0f;
+    }
+    return ((num < den) ? num : den) / den;
+}
+
+/**************************************************************************
+ * @brief   Cập nhật độ trượt lớn nhất
+ * @details Chỉ cập nhật khi lớn hơn hẳn để giữ bánh xe đầu tiên khi bằng nhau.
+ * @param   Slip            Độ trượt của bánh xe
+ * @param   Wheel           Chỉ số bánh xe
+ * @param   Result          Kết quả cần cập nhật
+ * @return 	None
+ **************************************************************************/
+static void Traction_WheelSlip_UpdateMax(float32 Slip, uint16 Wheel, Traction_WheelSlipResultType* Result) {
+    if (Slip > Result->MaxSlip) {
+        Result->MaxSlip = Slip;
+        Result->MaxSlipWheel = Wheel;
+    }
+}
+
+#if (TRACTION_CFG_USE_SIMD == 1) && defined(__SSE2__)
+/**************************************************************************
+ * @brief   Gộp kết quả của các làn SIMD
+ * @details Chọn độ trượt lớn nhất, khi bằng nhau chọn bánh xe có chỉ số nhỏ
+ *          nhất để giống với cách tính từng bánh xe.
+ * @param   LaneSlip        Độ trượt lớn nhất của từng làn
+ * @param   LaneIndex       Chỉ số bánh xe tương ứng của từng làn
+ * @param   NumLanes        Số làn
+ * @param   Result          Kết quả cần cập nhật
+ * @return 	None
+ **************************************************************************/
+static void Traction_WheelSlip_MergeLanes(const float32* LaneSlip, const float32* LaneIndex, uint8 NumLanes,
+                                          Traction_WheelSlipResultType* Result) {
+    float32 maxSlip = Result->MaxSlip;
+    for (uint8 lane = 0; lane < NumLanes; lane++) {
+        maxSlip = (LaneSlip[lane] > maxSlip) ? LaneSlip[lane] : maxSlip;
+    }
+    if (!(maxSlip > Result->MaxSlip)) {
+        return;
+    }
+
+    // Chọn không rẽ nhánh để tránh dự đoán sai khi dữ liệu thay đổi liên tục
+    float32 wheel = 65536.0f;
+    for (uint8 lane = 0; lane < NumLanes; lane++) {
+        wheel = (LaneSlip[lane] == maxSlip && LaneIndex[lane] < wheel) ? LaneIndex[lane] : wheel;
+    }
+    Result->MaxSlip = maxSlip;
+    Result->MaxSlipWheel = (uint16)wheel;
+}
+
+#define TRACTION_SIMD_WIDTH     4
+
+/**************************************************************************
+ * @brief   Tính độ trượt của các bánh xe theo nhóm 4 bánh xe (SSE2)
+ * @details Mỗi làn giữ độ trượt lớn nhất và chỉ số bánh xe của nó, các làn
+ *          được gộp lại ở cuối. SSE2 không có lệnh blend nên việc chọn giá
+ *          trị dùng mặt nạ AND/ANDNOT.
+ * @param   AngularVel      Vận tốc góc của các bánh xe (rad/s)
+ * @param   NumWheels       Số bánh xe
+ * @param   WheelRadius     Bán kính bánh xe (m)
+ * @param   VehicleSpeed    Tốc độ xe (m/s)
+ * @param   SlipRatios      Mảng lưu độ trượt (NULL_PTR nếu không cần)
+ * @param   Result          Kết quả cần cập nhật
+ * @return 	uint16          Số bánh xe đã tính
+ **************************************************************************/
+static uint16 Traction_WheelSlip_Vector(const float32* AngularVel, uint16 NumWheels, float32 WheelRadius,
+                                        float32 VehicleSpeed, float32* SlipRatios,
+                                        Traction_WheelSlipResultType* Result) {
+    uint16 count = (uint16)(NumWheels - (NumWheels % TRACTION_SIMD_WIDTH));
+    if (count == 0) {
+        return 0;
+    }
+
+    const __m128 radius = _mm_set1_ps(WheelRadius);
+    const __m128 speed = _mm_set1_ps(VehicleSpeed);
+    const __m128 minSpeed = _mm_set1_ps(TRACTION_WHEEL_MIN_SPEED);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 step = _mm_set1_ps((float32)TRACTION_SIMD_WIDTH);
+    // Độ trượt khi bánh xe đứng yên giống nhau cho mọi bánh xe
+    const __m128 stopped = _mm_set1_ps((VehicleSpeed > TRACTION_WHEEL_MIN_SPEED) ? 1.0f : 0.0f);
+
+    __m128 index = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    __m128 maxSlip = _mm_setzero_ps();
+    __m128 maxIndex = _mm_setzero_ps();
+
+    for (uint16 i = 0; i < count; i += TRACTION_SIMD_WIDTH) {
+        __m128 wheelSpeed = _mm_mul_ps(_mm_loadu_ps(&AngularVel[i]), radius);
+        __m128 den = _mm_and_ps(wheelSpeed, absMask);
+        __m128 num = _mm_and_ps(_mm_sub_ps(wheelSpeed, speed), absMask);
+        __m128 moving = _mm_cmpge_ps(den, minSpeed);
+        __m128 ratio = _mm_div_ps(_mm_min_ps(num, den), _mm_max_ps(den, minSpeed));
+        __m128 slip = _mm_or_ps(_mm_and_ps(moving, ratio), _mm_andnot_ps(moving, stopped));
+
+        if (SlipRatios != NULL_PTR) {
+            _mm_storeu_ps(&SlipRatios[i], slip);
+        }
+        __m128 greater = _mm_cmpgt_ps(slip, maxSlip);
+        maxSlip = _mm_or_ps(_mm_and_ps(greater, slip), _mm_andnot_ps(greater, maxSlip));
+        maxIndex = _mm_or_ps(_mm_and_ps(greater, index), _mm_andnot_ps(greater, maxIndex));
+        index = _mm_add_ps(index, step);
+    }
+
+    float32 laneSlip[TRACTION_SIMD_WIDTH];
+    float32 laneIndex[TRACTION_SIMD_WIDTH];
+    _mm_storeu_ps(laneSlip, maxSlip);
+    _mm_storeu_ps(laneIndex, maxIndex);
+    Traction_WheelSlip_MergeLanes(laneSlip, laneIndex, TRACTION_SIMD_WIDTH, Result);
+    return count;
+}
+#endif
+
+/**************************************************************************
+ * @brief   Tính độ trượt của các bánh xe
+ * @param   AngularVel      Vận tốc góc của các bánh xe (rad/s)
+ * @param   NumWheels       Số bánh xe (tối thiểu 1)
+ * @param   WheelRadius     Bán kính bánh xe (m)
+ * @param   VehicleSpeed    Tốc độ xe (m/s)
+ * @param   SlipRatios      Mảng lưu độ trượt của từng bánh xe (NULL_PTR nếu
+ *                          không cần)
+ * @param   Result          Con trỏ lưu độ trượt lớn nhất
+ * @return 	Std_ReturnType  Trả về E_OK nếu tính thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Traction_WheelSlip_Compute(const float32* AngularVel, uint16 NumWheels, float32 WheelRadius,
+                                          float32 VehicleSpeed, float32* SlipRatios,
+                                          Traction_WheelSlipResultType* Result) {
+    if (AngularVel == NULL_PTR || Result == NULL_PTR || NumWheels == 0 || !(WheelRadius > 0.0f)) {
+        LOG_ERROR(SWC, "Error: Invalid parameters passed to Traction_WheelSlip_Compute.\n");
+        return E_NOT_OK;
+    }
+
+    Result->MaxSlip = 0.0f;
+    Result->MaxSlipWheel = 0;
+
+    uint16 i = 0;
+#ifdef TRACTION_SIMD_WIDTH
+    i = Traction_WheelSlip_Vector(AngularVel, NumWheels, WheelRadius, VehicleSpeed, SlipRatios, Result);
+#endif
+    for (; i < NumWheels; i++) {
+        float32 slip = Traction_WheelSlip_Scalar(AngularVel[i], WheelRadius, VehicleSpeed);
+        if (SlipRatios != NULL_PTR) {
+            SlipRatios[i] = slip;
+        }
+        Traction_WheelSlip_UpdateMax(slip, i, Result);
+    }
+
+    return E_OK;
+}
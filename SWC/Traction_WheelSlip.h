@@ -0,0 +1,57 @@
+/***************************************************************************
+ * @file    Traction_WheelSlip.h
+ * @brief   Khai báo hàm tính độ trượt của các bánh xe cho điều khiển lực kéo
+ * @details File này cung cấp hàm tính độ trượt của từng bánh xe, độ trượt
+ *          lớn nhất và bánh xe trượt nhiều nhất cho số bánh xe bất kỳ (xe
+ *          tải, rơ-moóc). Hàm dùng lệnh SIMD (SSE2) nếu trình biên dịch hỗ
+ *          trợ và dùng vòng lặp thường cho phần còn lại.
+ * @version 1.0
+ * @date    2026-10-17
+ ***************************************************************************/
+#ifndef TRACTION_WHEELSLIP_H
+#define TRACTION_WHEELSLIP_H
+
+#include "Std_Types.h"
+
+/**************************************************************************
+ * @brief Bật (1) hoặc tắt (0) phần tính bằng lệnh SIMD
+ **************************************************************************/
+#ifndef TRACTION_CFG_USE_SIMD
+#define TRACTION_CFG_USE_SIMD       1
+#endif
+
+/**************************************************************************
+ * @brief Tốc độ dài nhỏ nhất của bánh xe (m/s), nhỏ hơn được coi là bánh
+ *        xe đứng yên
+ * @details Khi bánh xe đứng yên: độ trượt là 1 nếu xe đang chạy (bánh xe bị
+ *          bó cứng) và là 0 nếu xe cũng đứng yên.
+ **************************************************************************/
+#define TRACTION_WHEEL_MIN_SPEED    0.1f
+
+/**************************************************************************
+ * @struct  Traction_WheelSlipResultType
+ * @brief   Định nghĩa cấu trúc kết quả tính độ trượt
+ **************************************************************************/
+typedef struct {
+    float32 MaxSlip;            /* Độ trượt lớn nhất (0..1) */
+    uint16 MaxSlipWheel;        /* Bánh xe trượt nhiều nhất (bánh đầu tiên nếu bằng nhau) */
+} Traction_WheelSlipResultType;
+
+/**************************************************************************
+ * @brief   Tính độ trượt của các bánh xe
+ * @details Độ trượt = |w * r - v| / |w * r|, giới hạn trong 0..1.
+ * @param   AngularVel      Vận tốc góc của các bánh xe (rad/s)
+ * @param   NumWheels       Số bánh xe (tối thiểu 1)
+ * @param   WheelRadius     Bán kính bánh xe (m)
+ * @param   VehicleSpeed    Tốc độ xe (m/s)
+ * @param   SlipRatios      Mảng lưu độ trượt của từng bánh xe (NULL_PTR nếu
+ *                          không cần)
+ * @param   Result          Con trỏ lưu độ trượt lớn nhất
+ * @return 	Std_ReturnType  Trả về E_OK nếu tính thành công,
+ *                                 E_NOT_OK nếu tham số không hợp lệ
+ **************************************************************************/
+Std_ReturnType Traction_WheelSlip_Compute(const float32* AngularVel, uint16 NumWheels, float32 WheelRadius,
+                                          float32 VehicleSpeed, float32* SlipRatios,
+                                          Traction_WheelSlipResultType* Result);
+
+#endif /* TRACTION_WHEELSLIP_H */